@@ -139,12 +139,9 @@ static celix_status_t endpointDescriptorWriter_writeEndpoint(endpoint_descriptor
     } else {
         xmlTextWriterStartElement(writer->writer, ENDPOINT_DESCRIPTION);
 
-        hash_map_iterator_pt iter = hashMapIterator_create(endpoint->properties);
-        while (hashMapIterator_hasNext(iter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
-
-            void* propertyName = hashMapEntry_getKey(entry);
-			const xmlChar* propertyValue = (const xmlChar*) hashMapEntry_getValue(entry);
+        const char *propertyName;
+        CELIX_PROPERTIES_FOR_EACH(endpoint->properties, propertyName) {
+			const xmlChar* propertyValue = (const xmlChar*) celix_properties_get(endpoint->properties, propertyName, NULL);
 
             xmlTextWriterStartElement(writer->writer, PROPERTY);
             xmlTextWriterWriteAttribute(writer->writer, NAME, propertyName);
@@ -162,7 +159,6 @@ static celix_status_t endpointDescriptorWriter_writeEndpoint(endpoint_descriptor
 
             xmlTextWriterEndElement(writer->writer);
         }
-        hashMapIterator_destroy(iter);
 
         xmlTextWriterEndElement(writer->writer);
     }
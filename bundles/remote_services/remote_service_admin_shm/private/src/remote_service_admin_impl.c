@@ -740,10 +740,9 @@ celix_status_t remoteServiceAdmin_installEndpoint(remote_service_admin_t *admin,
 		}
 	}
 
-	hash_map_entry_pt entry = hashMap_getEntry(endpointProperties, (void *) OSGI_FRAMEWORK_SERVICE_ID);
-
-	char* key = hashMapEntry_getKey(entry);
-	char *serviceId = (char *) hashMap_remove(endpointProperties, (void *) OSGI_FRAMEWORK_SERVICE_ID);
+	const char *svcIdStr = celix_properties_get(endpointProperties, (char *) OSGI_FRAMEWORK_SERVICE_ID, NULL);
+	char *serviceId = svcIdStr == NULL ? NULL : strdup(svcIdStr);
+	celix_properties_unset(endpointProperties, (char *) OSGI_FRAMEWORK_SERVICE_ID);
 	const char *uuid = NULL;
 
 	uuid_t endpoint_uid;
@@ -788,7 +787,6 @@ celix_status_t remoteServiceAdmin_installEndpoint(remote_service_admin_t *admin,
 	remoteServiceAdmin_createEndpointDescription(admin, reference, endpointProperties, interface, &endpointDescription);
 	exportRegistration_setEndpointDescription(registration, endpointDescription);
 
-	free(key);
 	free(serviceId);
 	free(keys);
 
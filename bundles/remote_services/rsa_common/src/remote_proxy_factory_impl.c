@@ -185,15 +185,11 @@ static celix_status_t remoteProxyFactory_registerProxyService(remote_proxy_facto
 	if (status == CELIX_SUCCESS) {
 		celix_properties_set(proxy_instance_ptr->properties, "proxy.interface", remote_proxy_factory_ptr->service);
 
-		hash_map_iterator_pt iter = hashMapIterator_create(endpointDescription->properties);
-		while (hashMapIterator_hasNext(iter)) {
-			hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
-			char *key = hashMapEntry_getKey(entry);
-			char *value = hashMapEntry_getValue(entry);
-
+		const char *key;
+		CELIX_PROPERTIES_FOR_EACH(endpointDescription->properties, key) {
+			const char *value = celix_properties_get(endpointDescription->properties, key, NULL);
 			celix_properties_set(proxy_instance_ptr->properties, key, value);
 		}
-		hashMapIterator_destroy(iter);
 	}
 
 	if (status == CELIX_SUCCESS) {
@@ -401,19 +401,15 @@ extern "C" {
         for (unsigned int i = 0; i < arrayList_size(epList); i++) {
             endpoint_description_t *ep = (endpoint_description_t *) arrayList_get(epList, i);
             celix_properties_t *props = ep->properties;
-            hash_map_entry_pt entry = hashMap_getEntry(props, (void*)"key2");
-            char* value = (char*) hashMapEntry_getValue(entry);
+            const char* value = celix_properties_get(props, "key2", NULL);
             STRCMP_EQUAL("inaetics", value);
             /*
             printf("Service: %s ", ep->service);
-            hash_map_iterator_pt iter = hashMapIterator_create(props);
-            while (hashMapIterator_hasNext(iter)) {
-                hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
-                printf("%s - %s\n", (char*)hashMapEntry_getKey(entry),
-                                   (char*)hashMapEntry_getValue(entry));
+            const char* key;
+            CELIX_PROPERTIES_FOR_EACH(props, key) {
+                printf("%s - %s\n", key, celix_properties_get(props, key, ""));
             }
             printf("\n");
-            hashMapIterator_destroy(iter);
             */
         }
         printf("End: %s\n", __func__);
@@ -437,8 +433,7 @@ extern "C" {
         for (unsigned int i = 0; i < arrayList_size(epList); i++) {
             endpoint_description_t *ep = (endpoint_description_t *) arrayList_get(epList, i);
             celix_properties_t *props = ep->properties;
-            hash_map_entry_pt entry = hashMap_getEntry(props, (void*)"key2");
-            char* value = (char*) hashMapEntry_getValue(entry);
+            const char* value = celix_properties_get(props, "key2", NULL);
             STRCMP_EQUAL("inaetics", value);
         }
         printf("End: %s\n", __func__);
@@ -462,8 +457,7 @@ extern "C" {
         for (unsigned int i = 0; i < arrayList_size(epList); i++) {
             endpoint_description_t *ep = (endpoint_description_t *) arrayList_get(epList, i);
             celix_properties_t *props = ep->properties;
-            hash_map_entry_pt entry = hashMap_getEntry(props, (void *)"key2");
-            char* value = (char*) hashMapEntry_getValue(entry);
+            const char* value = celix_properties_get(props, "key2", NULL);
             STRCMP_EQUAL("inaetics", value);
         }
         printf("End: %s\n", __func__);
@@ -487,10 +481,9 @@ extern "C" {
         for (unsigned int i = 0; i < arrayList_size(epList); i++) {
             endpoint_description_t *ep = (endpoint_description_t *) arrayList_get(epList, i);
             celix_properties_t *props = ep->properties;
-            hash_map_entry_pt entry = hashMap_getEntry(props, (void*)"zone");
-            char* value = (char*) hashMapEntry_getValue(entry);
+            const char* value = celix_properties_get(props, "zone", NULL);
             STRCMP_EQUAL("inaetics", value);
-            CHECK_TRUE((entry == NULL));
+            CHECK_TRUE((value == NULL));
         }
         printf("End: %s\n", __func__);
     }*/
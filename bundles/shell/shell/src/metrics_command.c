@@ -0,0 +1,121 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "celix_api.h"
+#include "celix_framework_metrics_service.h"
+#include "std_commands.h"
+
+typedef struct metrics_command_options {
+    bool reset;
+    FILE* out;
+} metrics_command_options_t;
+
+static void metricsCommand_printHistogram(FILE* out, const char* name, const celix_framework_metrics_histogram_t* histogram) {
+    double avg = histogram->count > 0 ? (double)histogram->sum / (double)histogram->count : 0.0;
+    fprintf(out, "  %-26s %10" PRIu64 " %10.1f %10" PRIu64 " %10" PRIu64 " %10" PRIu64 "\n",
+            name,
+            histogram->count,
+            avg,
+            celix_frameworkMetrics_percentile(histogram, 0.5),
+            celix_frameworkMetrics_percentile(histogram, 0.99),
+            histogram->max);
+}
+
+static void metricsCommand_printHeader(FILE* out, const char* title) {
+    fprintf(out, "%s\n", title);
+    fprintf(out, "  %-26s %10s %10s %10s %10s %10s\n", "", "Count", "Avg", "P50", "P99", "Max");
+}
+
+static void metricsCommand_print(celix_framework_event_metrics_t* metrics, FILE* out) {
+    metricsCommand_printHeader(out, "Event queue:");
+    metricsCommand_printHistogram(out, "depth", &metrics->queueDepth);
+    metricsCommand_printHistogram(out, "latency (us)", &metrics->queueLatencyInUs);
+
+    metricsCommand_printHeader(out, "Event handle time (us):");
+    for (int i = 0; i < CELIX_FRAMEWORK_METRICS_NR_OF_EVENT_TYPES; ++i) {
+        metricsCommand_printHistogram(out, celix_frameworkMetrics_eventTypeToString(i), &metrics->handleTimeInUs[i]);
+    }
+
+    metricsCommand_printHeader(out, "Generic event handle time per bundle (us):");
+    for (int i = 0; i < celix_arrayList_size(metrics->bundles); ++i) {
+        celix_framework_bundle_event_metrics_t* entry = celix_arrayList_get(metrics->bundles, i);
+        char name[128];
+        snprintf(name, sizeof(name), "%s [%li]", entry->bndSymbolicName, entry->bndId);
+        metricsCommand_printHistogram(out, name, &entry->handleTimeInUs);
+    }
+
+    fprintf(out, "Slowest events:\n");
+    fprintf(out, "  %12s  %-26s %s\n", "Time (us)", "Type", "Bundle / Event");
+    for (int i = 0; i < celix_arrayList_size(metrics->blockingEvents); ++i) {
+        celix_framework_blocking_event_t* event = celix_arrayList_get(metrics->blockingEvents, i);
+        fprintf(out, "  %12" PRIu64 "  %-26s ", event->handleTimeInUs, celix_frameworkMetrics_eventTypeToString(event->type));
+        if (event->bndId >= 0) {
+            fprintf(out, "%s [%li]", event->bndSymbolicName, event->bndId);
+        } else {
+            fprintf(out, "-");
+        }
+        if (event->eventName[0] != '\0') {
+            fprintf(out, " / %s", event->eventName);
+        }
+        fprintf(out, "\n");
+    }
+}
+
+static void metricsCommand_useMetricsService(void* handle, void* svc) {
+    metrics_command_options_t* opts = handle;
+    celix_framework_metrics_service_t* metricsSvc = svc;
+    celix_framework_event_metrics_t* metrics = metricsSvc->createEventMetrics(metricsSvc->handle);
+    metricsCommand_print(metrics, opts->out);
+    metricsSvc->destroyEventMetrics(metricsSvc->handle, metrics);
+    if (opts->reset) {
+        metricsSvc->reset(metricsSvc->handle);
+    }
+}
+
+bool metricsCommand_execute(void *handle, const char *const_line, FILE *outStream, FILE *errStream) {
+    celix_bundle_context_t* ctx = handle;
+    metrics_command_options_t opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.out = outStream;
+
+    char *line = celix_utils_strdup(const_line);
+    char *savePtr = NULL;
+    strtok_r(line, OSGI_SHELL_COMMAND_SEPARATOR, &savePtr); //ignore command name
+    char *tok = strtok_r(NULL, OSGI_SHELL_COMMAND_SEPARATOR, &savePtr);
+    while (tok != NULL) {
+        if (strcmp(tok, "-r") == 0) {
+            opts.reset = true;
+        } else {
+            fprintf(errStream, "Skipping unknown argument: %s\n", tok);
+        }
+        tok = strtok_r(NULL, OSGI_SHELL_COMMAND_SEPARATOR, &savePtr);
+    }
+
+    bool called = celix_bundleContext_useService(ctx, CELIX_FRAMEWORK_METRICS_SERVICE_NAME, &opts, metricsCommand_useMetricsService);
+    if (!called) {
+        fprintf(errStream, "Framework event metrics are not enabled. Set the framework property %s to true to enable event metrics.\n", CELIX_FRAMEWORK_EVENT_METRICS_ENABLED);
+    }
+    free(line);
+    return called;
+}
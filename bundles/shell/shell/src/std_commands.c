@@ -25,7 +25,7 @@
 #include "celix_constants.h"
 #include "celix_shell_command.h"
 
-#define NUMBER_OF_COMMANDS 13
+#define NUMBER_OF_COMMANDS 14
 
 struct celix_shell_command_register_entry {
     bool (*exec)(void *handle, const char *commandLine, FILE *out, FILE *err);
@@ -133,6 +133,25 @@ celix_std_commands_t* celix_stdCommands_create(celix_bundle_context_t* ctx) {
                     .usage = "quit"
             };
     commands->std_commands[11] =
+            (struct celix_shell_command_register_entry) {
+                    .exec = traceCommand_execute,
+                    .name = "celix::trace",
+                    .description = "Print the framework startup and lifecycle trace." \
+                    "\nRequires framework tracing to be enabled (CELIX_FRAMEWORK_TRACE_ENABLED=true)." \
+                    "\n\tIf the -j option is provided, the trace is written as Chrome trace-event JSON to the provided file." \
+                    "\n\tIf the -c option is provided, the trace is cleared afterwards.",
+                    .usage = "trace [-j <file>] [-c]"
+            };
+    commands->std_commands[12] =
+            (struct celix_shell_command_register_entry) {
+                    .exec = metricsCommand_execute,
+                    .name = "celix::metrics",
+                    .description = "Print the framework event loop metrics." \
+                    "\nRequires framework event metrics to be enabled (CELIX_FRAMEWORK_EVENT_METRICS_ENABLED=true)." \
+                    "\n\tIf the -r option is provided, the metrics are reset afterwards.",
+                    .usage = "metrics [-r]"
+            };
+    commands->std_commands[13] =
             (struct celix_shell_command_register_entry) {
                     .exec = NULL
             };
@@ -56,6 +56,9 @@ bool dmListCommand_execute(void *handle, const char *commandLine, FILE *out, FIL
 
 bool quitCommand_execute(void *handle, const char *commandLine, FILE *sout, FILE *serr);
 
+bool traceCommand_execute(void *handle, const char *commandLine, FILE *outStream, FILE *errStream);
+bool metricsCommand_execute(void *handle, const char *commandLine, FILE *outStream, FILE *errStream);
+
 #ifdef __cplusplus
 }
 #endif
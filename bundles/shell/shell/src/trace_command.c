@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "celix_api.h"
+#include "celix_framework_trace_service.h"
+#include "std_commands.h"
+
+#define TRACE_NR_OF_BUNDLE_TYPES (CELIX_FRAMEWORK_TRACE_START_BUNDLE + 1)
+
+typedef struct trace_bundle_summary {
+    long bndId;
+    char bndSymbolicName[64];
+    double durationsInMs[TRACE_NR_OF_BUNDLE_TYPES]; //last recorded duration per bundle trace type, < 0 if not recorded
+} trace_bundle_summary_t;
+
+typedef struct trace_command_options {
+    const char* chromeTraceFile;
+    bool clear;
+    FILE* out;
+    FILE* err;
+    bool succeeded;
+} trace_command_options_t;
+
+static trace_bundle_summary_t* traceCommand_findOrAddSummary(celix_array_list_t* summaries, const celix_framework_trace_entry_t* entry) {
+    for (int i = 0; i < celix_arrayList_size(summaries); ++i) {
+        trace_bundle_summary_t* summary = celix_arrayList_get(summaries, i);
+        if (summary->bndId == entry->bndId) {
+            return summary;
+        }
+    }
+    trace_bundle_summary_t* summary = calloc(1, sizeof(*summary));
+    summary->bndId = entry->bndId;
+    snprintf(summary->bndSymbolicName, sizeof(summary->bndSymbolicName), "%s", entry->bndSymbolicName);
+    for (int i = 0; i < TRACE_NR_OF_BUNDLE_TYPES; ++i) {
+        summary->durationsInMs[i] = -1.0;
+    }
+    celix_arrayList_add(summaries, summary);
+    return summary;
+}
+
+static void traceCommand_printDuration(FILE* out, double durationInMs) {
+    if (durationInMs < 0) {
+        fprintf(out, " %10s", "-");
+    } else {
+        fprintf(out, " %10.3f", durationInMs);
+    }
+}
+
+static void traceCommand_printSummary(celix_framework_trace_service_t* svc, FILE* out) {
+    celix_array_list_t* entries = svc->getEntries(svc->handle);
+    celix_array_list_t* summaries = celix_arrayList_create();
+    size_t nrOfEvents = 0;
+    double totalWaitInMs = 0.0;
+    double maxWaitInMs = 0.0;
+    long maxWaitBndId = -1L;
+    for (int i = 0; i < celix_arrayList_size(entries); ++i) {
+        celix_framework_trace_entry_t* entry = celix_arrayList_get(entries, i);
+        double durationInMs = (double)entry->durationInNs / 1000000.0;
+        if (entry->type == CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT) {
+            nrOfEvents += 1;
+            totalWaitInMs += durationInMs;
+            if (durationInMs > maxWaitInMs) {
+                maxWaitInMs = durationInMs;
+                maxWaitBndId = entry->bndId;
+            }
+        } else if (entry->type < TRACE_NR_OF_BUNDLE_TYPES) {
+            trace_bundle_summary_t* summary = traceCommand_findOrAddSummary(summaries, entry);
+            summary->durationsInMs[entry->type] = durationInMs;
+        }
+        free(entry);
+    }
+    celix_arrayList_destroy(entries);
+
+    fprintf(out, "Bundle trace (durations in ms):\n");
+    fprintf(out, "  %4s %10s %10s %10s %10s %10s  %s\n", "ID", "Install", "Libraries", "Create", "Start", "Total", "Name");
+    for (int i = 0; i < celix_arrayList_size(summaries); ++i) {
+        trace_bundle_summary_t* summary = celix_arrayList_get(summaries, i);
+        fprintf(out, "  %4li", summary->bndId);
+        traceCommand_printDuration(out, summary->durationsInMs[CELIX_FRAMEWORK_TRACE_INSTALL_BUNDLE]);
+        traceCommand_printDuration(out, summary->durationsInMs[CELIX_FRAMEWORK_TRACE_LOAD_BUNDLE_LIBRARIES]);
+        traceCommand_printDuration(out, summary->durationsInMs[CELIX_FRAMEWORK_TRACE_ACTIVATOR_CREATE]);
+        traceCommand_printDuration(out, summary->durationsInMs[CELIX_FRAMEWORK_TRACE_ACTIVATOR_START]);
+        traceCommand_printDuration(out, summary->durationsInMs[CELIX_FRAMEWORK_TRACE_START_BUNDLE]);
+        fprintf(out, "  %s\n", summary->bndSymbolicName);
+        free(summary);
+    }
+    celix_arrayList_destroy(summaries);
+
+    fprintf(out, "Event queue wait: %zu events", nrOfEvents);
+    if (nrOfEvents > 0) {
+        fprintf(out, ", avg %.3f ms, max %.3f ms (bundle id %li)", totalWaitInMs / (double)nrOfEvents, maxWaitInMs, maxWaitBndId);
+    }
+    fprintf(out, "\n");
+}
+
+static void traceCommand_useTraceService(void* handle, void* svc) {
+    trace_command_options_t* opts = handle;
+    celix_framework_trace_service_t* traceSvc = svc;
+    if (opts->chromeTraceFile != NULL) {
+        FILE* file = fopen(opts->chromeTraceFile, "w");
+        if (file == NULL) {
+            fprintf(opts->err, "Cannot open file '%s' for writing\n", opts->chromeTraceFile);
+            opts->succeeded = false;
+        } else {
+            celix_status_t status = traceSvc->writeChromeTrace(traceSvc->handle, file);
+            fclose(file);
+            if (status == CELIX_SUCCESS) {
+                fprintf(opts->out, "Written Chrome trace-event JSON to '%s'\n", opts->chromeTraceFile);
+            } else {
+                fprintf(opts->err, "Error writing Chrome trace-event JSON to '%s'\n", opts->chromeTraceFile);
+                opts->succeeded = false;
+            }
+        }
+    } else {
+        traceCommand_printSummary(traceSvc, opts->out);
+    }
+    if (opts->clear) {
+        traceSvc->clear(traceSvc->handle);
+    }
+}
+
+bool traceCommand_execute(void *handle, const char *const_line, FILE *outStream, FILE *errStream) {
+    celix_bundle_context_t* ctx = handle;
+    trace_command_options_t opts;
+    memset(&opts, 0, sizeof(opts));
+    opts.out = outStream;
+    opts.err = errStream;
+    opts.succeeded = true;
+
+    char *line = celix_utils_strdup(const_line);
+    char *savePtr = NULL;
+    strtok_r(line, OSGI_SHELL_COMMAND_SEPARATOR, &savePtr); //ignore command name
+    char *tok = strtok_r(NULL, OSGI_SHELL_COMMAND_SEPARATOR, &savePtr);
+    while (tok != NULL) {
+        if (strcmp(tok, "-c") == 0) {
+            opts.clear = true;
+        } else if (strcmp(tok, "-j") == 0) {
+            opts.chromeTraceFile = strtok_r(NULL, OSGI_SHELL_COMMAND_SEPARATOR, &savePtr);
+            if (opts.chromeTraceFile == NULL) {
+                fprintf(errStream, "Missing file argument for -j\n");
+                free(line);
+                return false;
+            }
+        } else {
+            fprintf(errStream, "Skipping unknown argument: %s\n", tok);
+        }
+        tok = strtok_r(NULL, OSGI_SHELL_COMMAND_SEPARATOR, &savePtr);
+    }
+
+    bool called = celix_bundleContext_useService(ctx, CELIX_FRAMEWORK_TRACE_SERVICE_NAME, &opts, traceCommand_useTraceService);
+    if (!called) {
+        fprintf(errStream, "Framework tracing is not enabled. Set the framework property %s to true to enable tracing.\n", CELIX_FRAMEWORK_TRACE_ENABLED);
+    }
+    free(line);
+    return called && opts.succeeded;
+}
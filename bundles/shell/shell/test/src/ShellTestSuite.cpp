@@ -101,6 +101,8 @@ TEST_F(ShellTestSuite, testAllCommandsAreCallable) {
     callCommand(ctx, "start 15", false);
     callCommand(ctx, "uninstall 15", false);
     callCommand(ctx, "update 15", false);
+    callCommand(ctx, "trace", false); //note tracing not enabled
+    callCommand(ctx, "metrics", false); //note event metrics not enabled
 }
 
 TEST_F(ShellTestSuite, quitTest) {
@@ -151,6 +153,95 @@ TEST_F(ShellTestSuite, queryTest) {
     EXPECT_TRUE(called);
 }
 
+TEST_F(ShellTestSuite, traceTest) {
+    //restart framework with tracing enabled
+    auto properties = properties_create();
+    properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    properties_set(properties, "org.osgi.framework.storage", ".cacheShellTestSuiteTrace");
+    properties_set(properties, CELIX_FRAMEWORK_TRACE_ENABLED, "true");
+    auto* cFw = celix_frameworkFactory_createFramework(properties);
+    auto* cCtx = celix_framework_getFrameworkContext(cFw);
+    long shellBundleId = celix_bundleContext_installBundle(cCtx, SHELL_BUNDLE_LOCATION, true);
+    EXPECT_GE(shellBundleId, 0);
+
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = CELIX_SHELL_COMMAND_SERVICE_NAME;
+    opts.filter.filter = "(command.name=celix::trace)";
+    opts.waitTimeoutInSeconds = 1.0;
+    opts.use = [](void */*handle*/, void *svc) {
+        auto *command = static_cast<celix_shell_command_t*>(svc);
+        {
+            char *buf = nullptr;
+            size_t len;
+            FILE *sout = open_memstream(&buf, &len);
+            bool succeeded = command->executeCommand(command->handle, "trace", sout, sout);
+            fclose(sout);
+            EXPECT_TRUE(succeeded);
+            EXPECT_TRUE(strstr(buf, "apache_celix_c_shell") != nullptr || strstr(buf, "apache::celix::CxxShell") != nullptr);
+            EXPECT_TRUE(strstr(buf, "Event queue wait") != nullptr);
+            free(buf);
+        }
+        {
+            char *buf = nullptr;
+            size_t len;
+            FILE *sout = open_memstream(&buf, &len);
+            bool succeeded = command->executeCommand(command->handle, "trace -j .shellTestSuiteTrace.json -c", sout, sout);
+            fclose(sout);
+            EXPECT_TRUE(succeeded);
+            free(buf);
+
+            FILE* json = fopen(".shellTestSuiteTrace.json", "r");
+            ASSERT_TRUE(json != nullptr);
+            char content[64];
+            size_t read = fread(content, 1, sizeof(content) - 1, json);
+            content[read] = '\0';
+            fclose(json);
+            EXPECT_TRUE(strstr(content, "traceEvents") != nullptr);
+        }
+    };
+    bool called = celix_bundleContext_useServiceWithOptions(cCtx, &opts);
+    EXPECT_TRUE(called);
+    celix_frameworkFactory_destroyFramework(cFw);
+}
+
+TEST_F(ShellTestSuite, metricsTest) {
+    //restart framework with event metrics enabled
+    auto properties = properties_create();
+    properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    properties_set(properties, "org.osgi.framework.storage", ".cacheShellTestSuiteMetrics");
+    properties_set(properties, CELIX_FRAMEWORK_EVENT_METRICS_ENABLED, "true");
+    auto* cFw = celix_frameworkFactory_createFramework(properties);
+    auto* cCtx = celix_framework_getFrameworkContext(cFw);
+    long shellBundleId = celix_bundleContext_installBundle(cCtx, SHELL_BUNDLE_LOCATION, true);
+    EXPECT_GE(shellBundleId, 0);
+
+    long eventId = celix_framework_nextEventId(cFw);
+    celix_framework_fireGenericEvent(cFw, eventId, shellBundleId, "shell test event", nullptr, nullptr, nullptr, nullptr);
+    celix_framework_waitForGenericEvent(cFw, eventId);
+
+    celix_service_use_options_t opts{};
+    opts.filter.serviceName = CELIX_SHELL_COMMAND_SERVICE_NAME;
+    opts.filter.filter = "(command.name=celix::metrics)";
+    opts.waitTimeoutInSeconds = 1.0;
+    opts.use = [](void */*handle*/, void *svc) {
+        auto *command = static_cast<celix_shell_command_t*>(svc);
+        char *buf = nullptr;
+        size_t len;
+        FILE *sout = open_memstream(&buf, &len);
+        bool succeeded = command->executeCommand(command->handle, "metrics -r", sout, sout);
+        fclose(sout);
+        EXPECT_TRUE(succeeded);
+        EXPECT_TRUE(strstr(buf, "Event queue") != nullptr);
+        EXPECT_TRUE(strstr(buf, "generic event") != nullptr);
+        EXPECT_TRUE(strstr(buf, "Slowest events") != nullptr);
+        EXPECT_TRUE(strstr(buf, "apache_celix_c_shell") != nullptr || strstr(buf, "apache::celix::CxxShell") != nullptr);
+        free(buf);
+    };
+    bool called = celix_bundleContext_useServiceWithOptions(cCtx, &opts);
+    EXPECT_TRUE(called);
+    celix_frameworkFactory_destroyFramework(cFw);
+}
+
 TEST_F(ShellTestSuite, localNameClashTest) {
     callCommand(ctx, "lb", true);
 
@@ -17,6 +17,8 @@
  * under the License.
  */
 
+#include <atomic>
+
 #include <benchmark/benchmark.h>
 #include "celix/FrameworkFactory.h"
 
@@ -36,6 +38,12 @@ public:
 class TestComponent : public IService {
 };
 
+class SuspendableTestComponent {
+public:
+    void start() {}
+    void stop() {}
+};
+
 /**
  * Benchmark to measure to time needed create, make active and destroy (simple) dependency manager components in
  * Celix framework where the framework already contains more or less registered services.
@@ -113,8 +121,52 @@ static void DependencyManagerBenchmark_cxxCreateAndDestroyComponentTest(benchmar
     createAndDestroyComponentTest(state, false);
 }
 
+/**
+ * Benchmark to measure the time needed to inject a burst of (async) registered services in a dependency manager
+ * component using the suspend strategy. Service events handled in the same event loop batch result in a single
+ * suspend/resume cycle of the component; the number of resumes is reported as a counter.
+ */
+static void DependencyManagerBenchmark_cxxSuspendStrategyServiceBurstTest(benchmark::State& state) {
+    DependencyManagerBenchmark benchmark{0};
+    auto ctx = benchmark.fw->getFrameworkBundleContext();
+    auto man = ctx->getDependencyManager();
+
+    std::atomic<size_t> count{0};
+    auto& cmp = man->createComponent<SuspendableTestComponent>();
+    cmp.setCallbacks(nullptr, &SuspendableTestComponent::start, &SuspendableTestComponent::stop, nullptr);
+    cmp.createServiceDependency<IService>(IService::NAME)
+        .setStrategy(DependencyUpdateStrategy::suspend)
+        .setCallbacks(
+            [&count](const std::shared_ptr<IService>&) { count.fetch_add(1, std::memory_order_relaxed); },
+            [&count](const std::shared_ptr<IService>&) { count.fetch_sub(1, std::memory_order_relaxed); });
+    man->build();
+
+    std::vector<std::shared_ptr<celix::ServiceRegistration>> registrations{};
+    registrations.reserve(state.range(0));
+    for (auto _ : state) {
+        // This code gets timed
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            registrations.emplace_back(
+                    ctx->registerService<IService>(std::make_shared<ServiceImpl>(), IService::NAME).build());
+        }
+        ctx->waitForEvents();
+        assert(count.load() == (size_t)state.range(0));
+        registrations.clear();
+        ctx->waitForEvents();
+        assert(count.load() == 0);
+    }
+
+    dm_component_info_pt info = nullptr;
+    celix_dmComponent_getComponentInfo(cmp.cComponent(), &info);
+    state.counters["nrOfTimesResumed"] = benchmark::Counter{(double)info->nrOfTimesResumed, benchmark::Counter::kAvgIterations};
+    celix_dmComponent_destroyComponentInfo(info);
+    man->clear();
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 #define CELIX_BENCHMARK(name) \
     BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMillisecond)
 
 CELIX_BENCHMARK(DependencyManagerBenchmark_cCreateAndDestroyComponentTest)->RangeMultiplier(10)->Range(1, 10000);
 CELIX_BENCHMARK(DependencyManagerBenchmark_cxxCreateAndDestroyComponentTest)->RangeMultiplier(10)->Range(1, 10000);
+CELIX_BENCHMARK(DependencyManagerBenchmark_cxxSuspendStrategyServiceBurstTest)->RangeMultiplier(10)->Range(1, 1000);
@@ -32,13 +32,30 @@ public:
     ~ServiceImpl() noexcept override = default;
 };
 
+class IOtherService {
+public:
+    static constexpr const char * const NAME = "IOtherService";
+    virtual ~IOtherService() noexcept = default;
+};
+
+class OtherServiceImpl : public IOtherService {
+public:
+    ~OtherServiceImpl() noexcept override = default;
+};
+
 /**
  * Benchmark to measure to lookup/track services in Celix framework already containing more
  * or less registered services.
+ *
+ * Optionally services with a different service name can be registered, to measure
+ * the lookup of services in a framework containing many unrelated services.
  */
 class LookupServicesBenchmark {
 public:
-    explicit LookupServicesBenchmark(int64_t _nrOfServiceRegistrations) : nrOfServiceRegistrations{_nrOfServiceRegistrations}, fw{createFw()} {
+    explicit LookupServicesBenchmark(int64_t _nrOfServiceRegistrations, int64_t _nrOfOtherServiceRegistrations = 0) :
+            nrOfServiceRegistrations{_nrOfServiceRegistrations},
+            nrOfOtherServiceRegistrations{_nrOfOtherServiceRegistrations},
+            fw{createFw()} {
         auto ctx = fw->getFrameworkBundleContext();
         for (int i = 0; i < nrOfServiceRegistrations; ++i) {
             auto reg = ctx->registerService<IService>(std::make_shared<ServiceImpl>(), IService::NAME)
@@ -46,6 +63,12 @@ public:
                     .build();
             registrations.emplace_back(std::move(reg));
         }
+        for (int i = 0; i < nrOfOtherServiceRegistrations; ++i) {
+            auto reg = ctx->registerService<IOtherService>(std::make_shared<OtherServiceImpl>(), IOtherService::NAME)
+                    .addProperty("key", std::string{"value"} + std::to_string(i))
+                    .build();
+            registrations.emplace_back(std::move(reg));
+        }
         ctx->waitForEvents();
     }
 
@@ -57,6 +80,7 @@ public:
     }
 
     const int64_t nrOfServiceRegistrations;
+    const int64_t nrOfOtherServiceRegistrations;
     const std::shared_ptr<celix::Framework> fw;
 
     std::vector<std::shared_ptr<celix::ServiceRegistration>> registrations{};
@@ -114,6 +138,55 @@ static void findSingleService(benchmark::State& state, bool cTest, bool useFilte
     state.SetItemsProcessed(state.iterations());
 }
 
+static void findServiceAmongOtherServices(benchmark::State& state, bool cTest) {
+    LookupServicesBenchmark benchmark{1, state.range(0)};
+    auto ctx = benchmark.fw->getFrameworkBundleContext();
+    auto* cCtx = ctx->getCBundleContext();
+
+    if (cTest) {
+        for (auto _ : state) {
+            // This code gets timed
+            long svcId = celix_bundleContext_findService(cCtx, IService::NAME);
+            if (svcId < 0) {
+                state.SkipWithError("invalid svc id");
+            }
+        }
+    } else {
+        for (auto _ : state) {
+            // This code gets timed
+            long svcId = ctx->findServiceWithName(IService::NAME);
+            if (svcId < 0) {
+                state.SkipWithError("invalid svc id");
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static std::unique_ptr<LookupServicesBenchmark> concurrentBenchmark{};
+
+/**
+ * Finds a service from multiple threads using a shared framework, to measure the (lock-free) read path
+ * of the service registry.
+ */
+static void LookupServicesBenchmark_cConcurrentFindService(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        concurrentBenchmark.reset(new LookupServicesBenchmark{state.range(0)});
+    }
+    for (auto _ : state) {
+        // This code gets timed
+        auto* cCtx = concurrentBenchmark->fw->getFrameworkBundleContext()->getCBundleContext();
+        long svcId = celix_bundleContext_findService(cCtx, IService::NAME);
+        if (svcId < 0) {
+            state.SkipWithError("invalid svc id");
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0) {
+        concurrentBenchmark.reset();
+    }
+}
+
 static void createDestroyServiceTracker(benchmark::State& state, bool cTest) {
     LookupServicesBenchmark benchmark{state.range(0)};
     auto ctx = benchmark.fw->getFrameworkBundleContext();
@@ -155,6 +228,14 @@ static void LookupServicesBenchmark_cxxFindServiceWithFilter(benchmark::State& s
     findSingleService(state, false, true);
 }
 
+static void LookupServicesBenchmark_cFindServiceAmongOtherServices(benchmark::State& state) {
+    findServiceAmongOtherServices(state, true);
+}
+
+static void LookupServicesBenchmark_cxxFindServiceAmongOtherServices(benchmark::State& state) {
+    findServiceAmongOtherServices(state, false);
+}
+
 static void LookupServicesBenchmark_cCreateDestroyTracker(benchmark::State& state) {
     createDestroyServiceTracker(state, true);
 }
@@ -172,5 +253,10 @@ CELIX_BENCHMARK(LookupServicesBenchmark_cxxFindSingleService)->RangeMultiplier(1
 CELIX_BENCHMARK(LookupServicesBenchmark_cFindServiceWithFilter)->RangeMultiplier(10)->Range(1, 10000);
 CELIX_BENCHMARK(LookupServicesBenchmark_cxxFindServiceWithFilter)->RangeMultiplier(10)->Range(1, 10000);
 
+CELIX_BENCHMARK(LookupServicesBenchmark_cFindServiceAmongOtherServices)->RangeMultiplier(10)->Range(10, 100000);
+CELIX_BENCHMARK(LookupServicesBenchmark_cxxFindServiceAmongOtherServices)->RangeMultiplier(10)->Range(10, 100000);
+
+CELIX_BENCHMARK(LookupServicesBenchmark_cConcurrentFindService)->Arg(100)->ThreadRange(1, 16);
+
 CELIX_BENCHMARK(LookupServicesBenchmark_cCreateDestroyTracker)->RangeMultiplier(10)->Range(1, 1000);
 CELIX_BENCHMARK(LookupServicesBenchmark_cxxCreateDestroyTracker)->RangeMultiplier(10)->Range(1, 1000);
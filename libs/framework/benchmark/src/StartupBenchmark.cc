@@ -0,0 +1,97 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <ftw.h>
+#include <cstdio>
+#include "celix/FrameworkFactory.h"
+
+/**
+ * Benchmark to measure the time needed to create (start) a Celix framework which auto starts a set of bundles,
+ * without a content cache dir, with a empty (cold) content cache dir and with a filled (warm) content cache dir.
+ */
+namespace {
+    const char* const CONTENT_CACHE_DIR = ".startupBenchmarkContentCache";
+
+    int removeFile(const char* path, const struct stat*, int, struct FTW*) {
+        return remove(path);
+    }
+
+    void removeContentCacheDir() {
+        nftw(CONTENT_CACHE_DIR, removeFile, 16, FTW_DEPTH | FTW_PHYS);
+    }
+
+    std::shared_ptr<celix::Framework> createFw(bool useContentCache) {
+        celix::Properties config{};
+        config.set("CELIX_LOGGING_DEFAULT_ACTIVE_LOG_LEVEL", "error");
+        config.set(celix::FRAMEWORK_STORAGE, ".startupBenchmarkCache");
+        config.set(celix::AUTO_START_1, STARTUP_BENCHMARK_BUNDLES);
+        if (useContentCache) {
+            config.set(celix::FRAMEWORK_CONTENT_CACHE_DIR, CONTENT_CACHE_DIR);
+        }
+        return celix::createFramework(config);
+    }
+}
+
+static void StartupBenchmark_startWithoutContentCache(benchmark::State& state) {
+    for (auto _ : state) {
+        // This code gets timed
+        auto fw = createFw(false);
+        state.PauseTiming();
+        fw.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void StartupBenchmark_coldStartWithContentCache(benchmark::State& state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        removeContentCacheDir();
+        state.ResumeTiming();
+        // This code gets timed
+        auto fw = createFw(true);
+        state.PauseTiming();
+        fw.reset();
+        state.ResumeTiming();
+    }
+    removeContentCacheDir();
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void StartupBenchmark_warmStartWithContentCache(benchmark::State& state) {
+    removeContentCacheDir();
+    createFw(true); //fill the content cache dir
+    for (auto _ : state) {
+        // This code gets timed
+        auto fw = createFw(true);
+        state.PauseTiming();
+        fw.reset();
+        state.ResumeTiming();
+    }
+    removeContentCacheDir();
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMillisecond)
+
+CELIX_BENCHMARK(StartupBenchmark_startWithoutContentCache);
+CELIX_BENCHMARK(StartupBenchmark_coldStartWithContentCache);
+CELIX_BENCHMARK(StartupBenchmark_warmStartWithContentCache);
@@ -668,8 +668,8 @@ TEST_F(DependencyManagerTestSuite, UnneededSuspendIsPrevented) {
 
     EXPECT_EQ(cmp1.getInstance().startCount, 1); //only once during creation
     EXPECT_EQ(cmp1.getInstance().stopCount, 0);
-    EXPECT_EQ(cmp2.getInstance().startCount, 3); //1x creation, 1x suspend for set, 1x suspend for add
-    EXPECT_EQ(cmp2.getInstance().stopCount, 2); //1x suspend for set, 1x suspend for add
+    EXPECT_EQ(cmp2.getInstance().startCount, 2); //1x creation, 1x resume after the batched set and add
+    EXPECT_EQ(cmp2.getInstance().stopCount, 1); //1x suspend for both set and add (same event batch)
 
     cmp1.getInstance().startCount = 0;
     cmp1.getInstance().stopCount = 0;
@@ -679,8 +679,8 @@ TEST_F(DependencyManagerTestSuite, UnneededSuspendIsPrevented) {
 
     EXPECT_EQ(cmp1.getInstance().startCount, 0);
     EXPECT_EQ(cmp1.getInstance().stopCount, 0);
-    EXPECT_EQ(cmp2.getInstance().startCount, 2); //1x suspend for set nullptr, 1x suspend for rem
-    EXPECT_EQ(cmp2.getInstance().stopCount, 2); //1x suspend for set nullptr, 1x suspend for rem
+    EXPECT_EQ(cmp2.getInstance().startCount, 1); //1x resume after the batched set nullptr and rem
+    EXPECT_EQ(cmp2.getInstance().stopCount, 1); //1x suspend for both set nullptr and rem (same event batch)
 }
 
 TEST_F(DependencyManagerTestSuite, ExceptionsInLifecycle) {
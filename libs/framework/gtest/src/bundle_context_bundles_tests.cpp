@@ -25,9 +25,17 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <string>
+#include <dirent.h>
+#include <unistd.h>
 #include <celix_log_utils.h>
 
 #include "celix_api.h"
+#include "celix_framework_trace_service.h"
+#include "celix_framework_metrics_service.h"
+extern "C" {
+#include "framework_private.h"
+}
 
 class CelixBundleContextBundlesTests : public ::testing::Test {
 public:
@@ -580,4 +588,437 @@ TEST_F(CelixBundleContextBundlesTests, startStopBundleTrackerAsync) {
     celix_bundleContext_stopTrackerAsync(ctx, trkId, &count, cb);
     celix_bundleContext_waitForAsyncStopTracker(ctx, trkId);
     EXPECT_EQ(2, count.load()); //1x tracker started, 1x tracker stopped
-}
\ No newline at end of file
+}
+TEST_F(CelixBundleContextBundlesTests, multipleEventLoopsTest) {
+    //restart the framework with multiple event loops
+    celix_frameworkFactory_destroyFramework(fw);
+    properties = properties_create();
+    properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+    properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
+    celix_properties_setLong(properties, CELIX_FRAMEWORK_NR_OF_EVENT_LOOPS, 3);
+    celix_properties_setLong(properties, CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE, 16); //ensure overflow is used
+    fw = celix_frameworkFactory_createFramework(properties);
+    ctx = framework_getContext(fw);
+
+    std::atomic<int> count{0};
+    celix_service_tracking_options_t trkOpts{};
+    trkOpts.filter.serviceName = "test";
+    trkOpts.callbackHandle = &count;
+    trkOpts.add = [](void* handle, void*) {
+        auto* c = static_cast<std::atomic<int>*>(handle);
+        (*c)++;
+    };
+    trkOpts.remove = [](void* handle, void*) {
+        auto* c = static_cast<std::atomic<int>*>(handle);
+        (*c)--;
+    };
+    long trkId = celix_bundleContext_trackServicesWithOptions(ctx, &trkOpts);
+    EXPECT_GE(trkId, 0);
+
+    const int nrOfRegistrations = 100;
+    std::vector<long> bndIds{};
+    bndIds.push_back(celix_bundleContext_installBundle(ctx, TEST_BND1_LOC, true));
+    bndIds.push_back(celix_bundleContext_installBundle(ctx, TEST_BND2_LOC, true));
+    bndIds.push_back(celix_bundleContext_installBundle(ctx, TEST_BND3_LOC, true));
+    std::vector<std::thread> threads{};
+    for (auto bndId : bndIds) {
+        EXPECT_GE(bndId, 0);
+        threads.emplace_back([this, bndId]{
+            celix_bundleContext_useBundle(ctx, bndId, nullptr, [](void*, const celix_bundle_t* bnd) {
+                celix_bundle_context_t* bndCtx = nullptr;
+                bundle_getContext(bnd, &bndCtx);
+                std::vector<long> svcIds{};
+                for (int i = 0; i < nrOfRegistrations; ++i) {
+                    svcIds.push_back(celix_bundleContext_registerServiceAsync(bndCtx, (void*)0x42, "test", nullptr));
+                }
+                for (auto id : svcIds) {
+                    celix_bundleContext_waitForAsyncRegistration(bndCtx, id);
+                    EXPECT_TRUE(celix_bundleContext_isServiceRegistered(bndCtx, id));
+                }
+                for (auto id : svcIds) {
+                    celix_bundleContext_unregisterServiceAsync(bndCtx, id, nullptr, nullptr);
+                }
+                celix_bundleContext_waitForAsyncUnregistration(bndCtx, svcIds.back());
+                EXPECT_FALSE(celix_bundleContext_isServiceRegistered(bndCtx, svcIds.back()));
+            });
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    celix_framework_waitForEmptyEventQueue(fw);
+    EXPECT_EQ(0, count.load());
+
+    //generic events for different bundles are handled on (different) event loop threads
+    struct generic_event_data {
+        celix_framework_t* fw;
+        std::atomic<int> onEventLoopCount;
+    };
+    generic_event_data data{fw, {0}};
+    for (auto bndId : bndIds) {
+        long eventId = celix_framework_fireGenericEvent(fw, -1, bndId, "test", &data, [](void *handle) {
+            auto* d = static_cast<generic_event_data*>(handle);
+            if (celix_framework_isCurrentThreadTheEventLoop(d->fw)) {
+                d->onEventLoopCount++;
+            }
+        }, nullptr, nullptr);
+        celix_framework_waitForGenericEvent(fw, eventId);
+    }
+    EXPECT_EQ(3, data.onEventLoopCount.load());
+    EXPECT_FALSE(celix_framework_isCurrentThreadTheEventLoop(fw));
+
+    //on the event loop of one bundle, work for a bundle handled by another event loop goes through that event loop
+    struct other_loop_data {
+        celix_framework_t* fw;
+        long bndId;
+        celix_bundle_context_t* otherCtx;
+        bool onBndLoop;
+        bool onOtherBndLoop;
+        long svcId;
+        bool registered;
+    };
+    celix_bundle_context_t* otherCtx = nullptr;
+    bundle_getContext(framework_getBundleById(fw, bndIds[1]), &otherCtx);
+    other_loop_data otherData{fw, bndIds[0], otherCtx, false, true, -1L, false};
+    long eventId = celix_framework_fireGenericEvent(fw, -1, bndIds[0], "test", &otherData, [](void *handle) {
+        auto* d = static_cast<other_loop_data*>(handle);
+        d->onBndLoop = celix_framework_isCurrentThreadTheEventLoopForBnd(d->fw, d->bndId);
+        d->onOtherBndLoop = celix_framework_isCurrentThreadTheEventLoopForBnd(d->fw, celix_bundleContext_getBundleId(d->otherCtx));
+        d->svcId = celix_bundleContext_registerService(d->otherCtx, (void*)0x42, "test", nullptr);
+        d->registered = celix_bundleContext_isServiceRegistered(d->otherCtx, d->svcId);
+        celix_bundleContext_unregisterService(d->otherCtx, d->svcId);
+    }, nullptr, nullptr);
+    celix_framework_waitForGenericEvent(fw, eventId);
+    EXPECT_TRUE(otherData.onBndLoop);
+    EXPECT_FALSE(otherData.onOtherBndLoop);
+    EXPECT_GE(otherData.svcId, 0);
+    EXPECT_TRUE(otherData.registered);
+    EXPECT_FALSE(celix_bundleContext_isServiceRegistered(otherCtx, otherData.svcId));
+
+    celix_bundleContext_stopTracker(ctx, trkId);
+}
+
+TEST_F(CelixBundleContextBundlesTests, eventLoopsWaitingOnEachOtherTest) {
+    //restart the framework with multiple event loops
+    celix_frameworkFactory_destroyFramework(fw);
+    properties = properties_create();
+    properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+    properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
+    celix_properties_setLong(properties, CELIX_FRAMEWORK_NR_OF_EVENT_LOOPS, 2);
+    fw = celix_frameworkFactory_createFramework(properties);
+    ctx = framework_getContext(fw);
+
+    long bndId1 = celix_bundleContext_installBundle(ctx, TEST_BND1_LOC, true);
+    long bndId2 = celix_bundleContext_installBundle(ctx, TEST_BND2_LOC, true);
+    ASSERT_GE(bndId1, 0);
+    ASSERT_GE(bndId2, 0);
+    ASSERT_NE(bndId1 % 2, bndId2 % 2); //note the bundles must be handled by different event loops
+
+    struct wait_data {
+        celix_framework_t* fw;
+        long bndId1;
+        long bndId2;
+    };
+    wait_data data{fw, bndId1, bndId2};
+
+    //event on the event loop of bundle 2, which waits on the event loop of bundle 1 while that loop waits on it.
+    long eventId2 = celix_framework_fireGenericEvent(fw, -1, bndId2, "wait on loop of bundle 1", &data, [](void *handle) {
+        auto* d = static_cast<wait_data*>(handle);
+        celix_framework_event_loop_t* loop1 = &d->fw->dispatcher.loops[d->bndId1 % 2];
+        bool loop1Waiting = false;
+        while (!loop1Waiting) {
+            celixThreadMutex_lock(&d->fw->dispatcher.waitMutex);
+            loop1Waiting = loop1->waitingForLoop != nullptr;
+            celixThreadMutex_unlock(&d->fw->dispatcher.waitMutex);
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+        }
+        celix_framework_waitUntilNoEventsForBnd(d->fw, d->bndId1); //note rejected, would deadlock
+    }, nullptr, nullptr);
+    long eventId1 = celix_framework_fireGenericEvent(fw, -1, bndId1, "wait on loop of bundle 2", &data, [](void *handle) {
+        auto* d = static_cast<wait_data*>(handle);
+        celix_framework_waitUntilNoEventsForBnd(d->fw, d->bndId2);
+    }, nullptr, nullptr);
+    celix_framework_waitForGenericEvent(fw, eventId2);
+    celix_framework_waitForGenericEvent(fw, eventId1);
+}
+
+TEST_F(CelixBundleContextBundlesTests, autoStartBundlesTest) {
+    for (bool parallel : {false, true}) {
+        //restart the framework with auto start bundles
+        celix_frameworkFactory_destroyFramework(fw);
+        properties = properties_create();
+        properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+        properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+        properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
+        std::string level1 = std::string{TEST_BND1_LOC} + " " + TEST_BND2_LOC + " " + TEST_BND1_LOC; //note duplicate
+        properties_set(properties, CELIX_AUTO_START_1, level1.c_str());
+        properties_set(properties, CELIX_AUTO_START_2, TEST_BND3_LOC);
+        properties_set(properties, CELIX_AUTO_START_3, "non-existing-bundle.zip");
+        celix_properties_setBool(properties, CELIX_AUTO_START_PARALLEL, parallel);
+        fw = celix_frameworkFactory_createFramework(properties);
+        ASSERT_TRUE(fw != nullptr);
+        ctx = framework_getContext(fw);
+
+        //bundle ids are assigned in the configured order
+        celix_array_list_t* bndIds = celix_bundleContext_listBundles(ctx);
+        ASSERT_EQ(3, celix_arrayList_size(bndIds));
+        EXPECT_EQ(1, celix_arrayList_getLong(bndIds, 0));
+        EXPECT_EQ(2, celix_arrayList_getLong(bndIds, 1));
+        EXPECT_EQ(3, celix_arrayList_getLong(bndIds, 2));
+        celix_arrayList_destroy(bndIds);
+
+        EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, 1));
+        EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, 2));
+        EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, 3));
+        auto name = celix_bundleContext_getBundleSymbolicName(ctx, 3);
+        EXPECT_STREQ("simple_test_bundle3", name);
+        free(name);
+    }
+}
+
+TEST_F(CelixBundleContextBundlesTests, contentCacheTest) {
+    const char* contentCacheDir = ".cacheBundleContextTestContent";
+    system("rm -rf .cacheBundleContextTestContent");
+
+    auto countEntries = [contentCacheDir]() {
+        int count = 0;
+        DIR* dir = opendir(contentCacheDir);
+        if (dir != nullptr) {
+            for (struct dirent* dent = readdir(dir); dent != nullptr; dent = readdir(dir)) {
+                if (dent->d_name[0] != '.') {
+                    count += 1;
+                }
+            }
+            closedir(dir);
+        }
+        return count;
+    };
+
+    for (int i = 0; i < 2; ++i) {
+        //restart the framework with a content cache dir, the second run should reuse the extracted bundles
+        celix_frameworkFactory_destroyFramework(fw);
+        properties = properties_create();
+        properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+        properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+        properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
+        properties_set(properties, CELIX_FRAMEWORK_CONTENT_CACHE_DIR, contentCacheDir);
+        fw = celix_frameworkFactory_createFramework(properties);
+        ctx = framework_getContext(fw);
+
+        long bndId1 = celix_bundleContext_installBundle(ctx, TEST_BND1_LOC, true);
+        long bndId2 = celix_bundleContext_installBundle(ctx, SIMPLE_CXX_BUNDLE_LOC, true); //note has a library
+        EXPECT_GE(bndId1, 0);
+        EXPECT_GE(bndId2, 0);
+        EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, bndId1));
+        EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, bndId2));
+        auto name = celix_bundleContext_getBundleSymbolicName(ctx, bndId1);
+        EXPECT_STREQ("simple_test_bundle1", name);
+        free(name);
+
+        EXPECT_EQ(2, countEntries());
+    }
+    system("rm -rf .cacheBundleContextTestContent");
+}
+
+TEST_F(CelixBundleContextBundlesTests, loadBundlesFromZipTest) {
+    const char* contentCacheDir = ".cacheBundleContextTestZipContent";
+    system("rm -rf .cacheBundleContextTestZipContent");
+
+    celix_frameworkFactory_destroyFramework(fw);
+    properties = properties_create();
+    properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+    properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
+    properties_set(properties, CELIX_FRAMEWORK_CONTENT_CACHE_DIR, contentCacheDir);
+    properties_set(properties, CELIX_LOAD_BUNDLES_FROM_ZIP, "true");
+    fw = celix_frameworkFactory_createFramework(properties);
+    ctx = framework_getContext(fw);
+
+    long bndId1 = celix_bundleContext_installBundle(ctx, TEST_BND1_LOC, true);
+    long bndId2 = celix_bundleContext_installBundle(ctx, SIMPLE_CXX_BUNDLE_LOC, true); //note has a library
+    EXPECT_GE(bndId1, 0);
+    EXPECT_GE(bndId2, 0);
+    EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, bndId1));
+    EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, bndId2));
+    auto name = celix_bundleContext_getBundleSymbolicName(ctx, bndId2);
+    EXPECT_STREQ("simple_cxx_bundle", name);
+    free(name);
+
+    //bundles only containing a manifest and libraries are not extracted, also not to the content cache
+    std::string manifestPath = ".cacheBundleContextTestFramework/bundle" + std::to_string(bndId2) + "/version0.0/META-INF/MANIFEST.MF";
+    EXPECT_NE(0, access(manifestPath.c_str(), F_OK));
+    EXPECT_NE(0, access(contentCacheDir, F_OK));
+
+    celix_bundleContext_useBundle(ctx, bndId2, nullptr, [](void*, const celix_bundle_t* bnd) {
+        char* entry = celix_bundle_getEntry(bnd, "META-INF/MANIFEST.MF");
+        EXPECT_EQ(nullptr, entry);
+        free(entry);
+    });
+
+    //stop/start should reuse the loaded libraries and uninstall should unload them
+    EXPECT_TRUE(celix_bundleContext_stopBundle(ctx, bndId2));
+    EXPECT_TRUE(celix_bundleContext_startBundle(ctx, bndId2));
+    EXPECT_TRUE(celix_bundleContext_isBundleActive(ctx, bndId2));
+    EXPECT_TRUE(celix_bundleContext_uninstallBundle(ctx, bndId2));
+}
+
+TEST_F(CelixBundleContextBundlesTests, startupTraceTest) {
+    celix_frameworkFactory_destroyFramework(fw);
+    properties = properties_create();
+    properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+    properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
+    properties_set(properties, CELIX_FRAMEWORK_TRACE_ENABLED, "true");
+    properties_set(properties, CELIX_FRAMEWORK_TRACE_BUFFER_SIZE, "64");
+    fw = celix_frameworkFactory_createFramework(properties);
+    ctx = framework_getContext(fw);
+
+    long bndId = celix_bundleContext_installBundle(ctx, SIMPLE_CXX_BUNDLE_LOC, true); //note has a library
+    EXPECT_GE(bndId, 0);
+    celix_framework_waitForEmptyEventQueue(fw);
+
+    struct trace_test_data {
+        long bndId;
+        int count[CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT + 1];
+    } data{};
+    data.bndId = bndId;
+    bool called = celix_bundleContext_useService(ctx, CELIX_FRAMEWORK_TRACE_SERVICE_NAME, &data, [](void *handle, void *svc) {
+        auto* d = static_cast<trace_test_data*>(handle);
+        auto* traceSvc = static_cast<celix_framework_trace_service_t*>(svc);
+        auto* entries = traceSvc->getEntries(traceSvc->handle);
+        for (int i = 0; i < celix_arrayList_size(entries); ++i) {
+            auto* entry = static_cast<celix_framework_trace_entry_t*>(celix_arrayList_get(entries, i));
+            if (entry->bndId == d->bndId || entry->type == CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT) {
+                d->count[entry->type] += 1;
+            }
+            if (entry->type != CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT && entry->bndId == d->bndId) {
+                EXPECT_STREQ("simple_cxx_bundle", entry->bndSymbolicName);
+            }
+            free(entry);
+        }
+        celix_arrayList_destroy(entries);
+
+        char *buf = nullptr;
+        size_t len;
+        FILE *stream = open_memstream(&buf, &len);
+        EXPECT_EQ(CELIX_SUCCESS, traceSvc->writeChromeTrace(traceSvc->handle, stream));
+        fclose(stream);
+        EXPECT_TRUE(strstr(buf, "\"traceEvents\"") != nullptr);
+        EXPECT_TRUE(strstr(buf, "start bundle simple_cxx_bundle") != nullptr);
+        free(buf);
+
+        traceSvc->clear(traceSvc->handle);
+        entries = traceSvc->getEntries(traceSvc->handle);
+        EXPECT_EQ(0, celix_arrayList_size(entries));
+        celix_arrayList_destroy(entries);
+    });
+    EXPECT_TRUE(called);
+    EXPECT_EQ(1, data.count[CELIX_FRAMEWORK_TRACE_INSTALL_BUNDLE]);
+    EXPECT_EQ(1, data.count[CELIX_FRAMEWORK_TRACE_LOAD_BUNDLE_LIBRARIES]);
+    EXPECT_EQ(1, data.count[CELIX_FRAMEWORK_TRACE_ACTIVATOR_CREATE]);
+    EXPECT_EQ(1, data.count[CELIX_FRAMEWORK_TRACE_ACTIVATOR_START]);
+    EXPECT_EQ(1, data.count[CELIX_FRAMEWORK_TRACE_START_BUNDLE]);
+    EXPECT_GT(data.count[CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT], 0);
+
+    //a lot of events should only keep the last (64) trace entries
+    for (int i = 0; i < 100; ++i) {
+        celix_bundleContext_stopBundle(ctx, bndId);
+        celix_bundleContext_startBundle(ctx, bndId);
+    }
+    celix_bundleContext_useService(ctx, CELIX_FRAMEWORK_TRACE_SERVICE_NAME, nullptr, [](void *, void *svc) {
+        auto* traceSvc = static_cast<celix_framework_trace_service_t*>(svc);
+        auto* entries = traceSvc->getEntries(traceSvc->handle);
+        EXPECT_GT(celix_arrayList_size(entries), 0);
+        EXPECT_LE(celix_arrayList_size(entries), 64);
+        for (int i = 0; i < celix_arrayList_size(entries); ++i) {
+            free(celix_arrayList_get(entries, i));
+        }
+        celix_arrayList_destroy(entries);
+    });
+}
+
+TEST_F(CelixBundleContextBundlesTests, eventMetricsTest) {
+    celix_frameworkFactory_destroyFramework(fw);
+    properties = properties_create();
+    properties_set(properties, "LOGHELPER_ENABLE_STDOUT_FALLBACK", "true");
+    properties_set(properties, "org.osgi.framework.storage.clean", "onFirstInit");
+    properties_set(properties, "org.osgi.framework.storage", ".cacheBundleContextTestFramework");
+    properties_set(properties, CELIX_FRAMEWORK_EVENT_METRICS_ENABLED, "true");
+    fw = celix_frameworkFactory_createFramework(properties);
+    ctx = framework_getContext(fw);
+
+    long bndId = celix_bundleContext_installBundle(ctx, SIMPLE_TEST_BUNDLE1_LOCATION, true);
+    EXPECT_GE(bndId, 0);
+
+    //a generic event for the bundle which blocks the event loop for 20ms
+    long eventId = celix_framework_nextEventId(fw);
+    celix_framework_fireGenericEvent(fw, eventId, bndId, "slow event", nullptr, [](void*) {
+        std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    }, nullptr, nullptr);
+    celix_framework_waitForGenericEvent(fw, eventId);
+    celix_framework_waitForEmptyEventQueue(fw);
+
+    bool called = celix_bundleContext_useService(ctx, CELIX_FRAMEWORK_METRICS_SERVICE_NAME, &bndId, [](void *handle, void *svc) {
+        long id = *static_cast<long*>(handle);
+        auto* metricsSvc = static_cast<celix_framework_metrics_service_t*>(svc);
+        auto* metrics = metricsSvc->createEventMetrics(metricsSvc->handle);
+        EXPECT_GT(metrics->queueDepth.count, 0);
+        EXPECT_GT(metrics->queueLatencyInUs.count, 0);
+        EXPECT_GT(metrics->handleTimeInUs[CELIX_FRAMEWORK_METRICS_BUNDLE_EVENT].count, 0);
+        EXPECT_GE(metrics->handleTimeInUs[CELIX_FRAMEWORK_METRICS_GENERIC_EVENT].count, 1);
+        EXPECT_GE(metrics->handleTimeInUs[CELIX_FRAMEWORK_METRICS_GENERIC_EVENT].max, 20000);
+
+        celix_framework_bundle_event_metrics_t* bndMetrics = nullptr; //note the framework also fires generic events
+        for (int i = 0; i < celix_arrayList_size(metrics->bundles); ++i) {
+            auto* entry = static_cast<celix_framework_bundle_event_metrics_t*>(celix_arrayList_get(metrics->bundles, i));
+            if (entry->bndId == id) {
+                bndMetrics = entry;
+            }
+        }
+        ASSERT_TRUE(bndMetrics != nullptr);
+        EXPECT_STREQ("simple_test_bundle1", bndMetrics->bndSymbolicName);
+        EXPECT_EQ(1, bndMetrics->handleTimeInUs.count);
+
+        //the slow event should be the event which blocked the event loop the longest
+        ASSERT_GT(celix_arrayList_size(metrics->blockingEvents), 0);
+        EXPECT_LE(celix_arrayList_size(metrics->blockingEvents), CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS);
+        auto* slowest = static_cast<celix_framework_blocking_event_t*>(celix_arrayList_get(metrics->blockingEvents, 0));
+        EXPECT_EQ(CELIX_FRAMEWORK_METRICS_GENERIC_EVENT, slowest->type);
+        EXPECT_EQ(id, slowest->bndId);
+        EXPECT_STREQ("simple_test_bundle1", slowest->bndSymbolicName);
+        EXPECT_STREQ("slow event", slowest->eventName);
+        EXPECT_GE(slowest->handleTimeInUs, 20000);
+        for (int i = 0; i < celix_arrayList_size(metrics->blockingEvents); ++i) {
+            auto* event = static_cast<celix_framework_blocking_event_t*>(celix_arrayList_get(metrics->blockingEvents, i));
+            EXPECT_GT(event->handleTimeInUs, CELIX_FRAMEWORK_DEFAULT_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US);
+        }
+        uint64_t p99 = celix_frameworkMetrics_percentile(&bndMetrics->handleTimeInUs, 0.99);
+        EXPECT_EQ(bndMetrics->handleTimeInUs.max, p99); //note single value, so percentile is capped at max
+        metricsSvc->destroyEventMetrics(metricsSvc->handle, metrics);
+
+        metricsSvc->reset(metricsSvc->handle);
+        metrics = metricsSvc->createEventMetrics(metricsSvc->handle);
+        EXPECT_EQ(0, metrics->handleTimeInUs[CELIX_FRAMEWORK_METRICS_GENERIC_EVENT].count);
+        EXPECT_EQ(0, celix_arrayList_size(metrics->bundles));
+        EXPECT_EQ(0, celix_arrayList_size(metrics->blockingEvents));
+        metricsSvc->destroyEventMetrics(metricsSvc->handle, metrics);
+    });
+    EXPECT_TRUE(called);
+}
+
+TEST_F(CelixBundleContextBundlesTests, metricsPercentileTest) {
+    celix_framework_metrics_histogram_t histogram{};
+    EXPECT_EQ(0, celix_frameworkMetrics_percentile(&histogram, 0.5));
+
+    //90 values of 3 (bucket [2,4)) and 10 values of 100 (bucket [64,128))
+    histogram.count = 100;
+    histogram.sum = 90 * 3 + 10 * 100;
+    histogram.max = 100;
+    histogram.buckets[2] = 90;
+    histogram.buckets[7] = 10;
+    EXPECT_EQ(3, celix_frameworkMetrics_percentile(&histogram, 0.5));
+    EXPECT_EQ(3, celix_frameworkMetrics_percentile(&histogram, 0.9));
+    EXPECT_EQ(100, celix_frameworkMetrics_percentile(&histogram, 0.99)); //note capped at max
+}
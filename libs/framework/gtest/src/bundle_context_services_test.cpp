@@ -27,11 +27,14 @@
 #include <condition_variable>
 #include <string.h>
 #include <future>
+#include <vector>
+#include <atomic>
 
 #include "celix_api.h"
 #include "celix_framework_factory.h"
 #include "celix_service_factory.h"
 #include "service_tracker_private.h"
+#include "bundle_context_private.h"
 
 class CelixBundleContextServicesTests : public ::testing::Test {
 public:
@@ -303,6 +306,167 @@ TEST_F(CelixBundleContextServicesTests, registerAsyncAndUseServiceWithTimeout) {
     }
 }
 
+TEST_F(CelixBundleContextServicesTests, useServiceReusesCachedTracker) {
+    struct calc {
+        int (*calc)(int);
+    };
+    struct calc svc{};
+    svc.calc = [](int n) -> int {
+        return n * 42;
+    };
+
+    std::atomic<int> nrOfTrackers{0};
+    long metaTrkId = celix_bundleContext_trackServiceTrackers(ctx, "calc", &nrOfTrackers, [](void *handle, const celix_service_tracker_info_t*) {
+        auto* count = static_cast<std::atomic<int>*>(handle);
+        count->fetch_add(1);
+    }, nullptr);
+    ASSERT_GE(metaTrkId, 0);
+
+    long svcId = celix_bundleContext_registerService(ctx, &svc, "calc", nullptr);
+    ASSERT_GE(svcId, 0);
+
+    int total = 0;
+    for (int i = 0; i < 100; ++i) {
+        bool called = celix_bundleContext_useService(ctx, "calc", &total, [](void *handle, void *voidSvc) {
+            auto* t = static_cast<int*>(handle);
+            auto* c = static_cast<struct calc*>(voidSvc);
+            *t += c->calc(1);
+        });
+        EXPECT_TRUE(called);
+    }
+    size_t count = celix_bundleContext_useServices(ctx, "calc", nullptr, [](void *, void *) {/*nop*/});
+    EXPECT_EQ(1, count);
+    EXPECT_EQ(4200, total);
+    EXPECT_EQ(1, nrOfTrackers.load()); //all use calls with the same filter share a single cached tracker
+
+    celix_bundleContext_unregisterService(ctx, svcId);
+    celix_bundleContext_stopTracker(ctx, metaTrkId);
+}
+
+TEST_F(CelixBundleContextServicesTests, useServiceWithDifferentLanguagesUsesDifferentTrackers) {
+    std::atomic<int> nrOfTrackers{0};
+    long metaTrkId = celix_bundleContext_trackServiceTrackers(ctx, "lang-test", &nrOfTrackers, [](void *handle, const celix_service_tracker_info_t*) {
+        auto* count = static_cast<std::atomic<int>*>(handle);
+        count->fetch_add(1);
+    }, nullptr);
+    ASSERT_GE(metaTrkId, 0);
+
+    auto useWithLanguage = [this](const char* lang, bool ignoreLang) {
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = "lang-test";
+        opts.filter.serviceLanguage = lang;
+        opts.filter.ignoreServiceLanguage = ignoreLang;
+        opts.use = [](void*, void*) {/*nop*/};
+        celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    };
+
+    //note use calls which only differ in service language should not share a cached tracker
+    useWithLanguage(nullptr, false);
+    useWithLanguage(nullptr, false);
+    EXPECT_EQ(1, nrOfTrackers.load());
+    useWithLanguage(CELIX_FRAMEWORK_SERVICE_CXX_LANGUAGE, false);
+    EXPECT_EQ(2, nrOfTrackers.load());
+    useWithLanguage(nullptr, true);
+    EXPECT_EQ(3, nrOfTrackers.load());
+    useWithLanguage(CELIX_FRAMEWORK_SERVICE_CXX_LANGUAGE, false);
+    EXPECT_EQ(3, nrOfTrackers.load());
+
+    celix_bundleContext_stopTracker(ctx, metaTrkId);
+}
+
+TEST_F(CelixBundleContextServicesTests, useServiceWithIdDoesNotCacheTracker) {
+    std::atomic<int> nrOfActiveTrackers{0};
+    long metaTrkId = celix_bundleContext_trackServiceTrackers(ctx, "id-test", &nrOfActiveTrackers, [](void *handle, const celix_service_tracker_info_t*) {
+        static_cast<std::atomic<int>*>(handle)->fetch_add(1);
+    }, [](void *handle, const celix_service_tracker_info_t*) {
+        static_cast<std::atomic<int>*>(handle)->fetch_sub(1);
+    });
+    ASSERT_GE(metaTrkId, 0);
+
+    int svc = 42;
+    for (int i = 0; i < 10; ++i) {
+        long svcId = celix_bundleContext_registerService(ctx, &svc, "id-test", nullptr);
+        EXPECT_TRUE(celix_bundleContext_useServiceWithId(ctx, svcId, "id-test", nullptr, [](void*, void*) {/*nop*/}));
+        EXPECT_EQ(0, nrOfActiveTrackers.load()); //note use tracker for a service id is destroyed after the use call
+        celix_bundleContext_unregisterService(ctx, svcId);
+    }
+
+    celix_bundleContext_stopTracker(ctx, metaTrkId);
+}
+
+TEST_F(CelixBundleContextServicesTests, useServiceTrackerCacheIsBounded) {
+    std::atomic<int> nrOfActiveTrackers{0};
+    long metaTrkId = celix_bundleContext_trackServiceTrackers(ctx, "bound-test", &nrOfActiveTrackers, [](void *handle, const celix_service_tracker_info_t*) {
+        static_cast<std::atomic<int>*>(handle)->fetch_add(1);
+    }, [](void *handle, const celix_service_tracker_info_t*) {
+        static_cast<std::atomic<int>*>(handle)->fetch_sub(1);
+    });
+    ASSERT_GE(metaTrkId, 0);
+
+    for (int i = 0; i < CELIX_BUNDLE_CONTEXT_USE_TRACKER_MAX_ENTRIES * 2; ++i) {
+        std::string filter = "(id=" + std::to_string(i) + ")";
+        celix_service_use_options_t opts{};
+        opts.filter.serviceName = "bound-test";
+        opts.filter.filter = filter.c_str();
+        opts.use = [](void*, void*) {/*nop*/};
+        celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    }
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(CELIX_BUNDLE_CONTEXT_USE_TRACKER_MAX_ENTRIES, nrOfActiveTrackers.load());
+
+    celix_bundleContext_stopTracker(ctx, metaTrkId);
+}
+
+TEST_F(CelixBundleContextServicesTests, useServiceTrackerIsEvictedWhenServiceIsUnregistered) {
+    std::atomic<int> nrOfActiveTrackers{0};
+    long metaTrkId = celix_bundleContext_trackServiceTrackers(ctx, "evict-test", &nrOfActiveTrackers, [](void *handle, const celix_service_tracker_info_t*) {
+        static_cast<std::atomic<int>*>(handle)->fetch_add(1);
+    }, [](void *handle, const celix_service_tracker_info_t*) {
+        static_cast<std::atomic<int>*>(handle)->fetch_sub(1);
+    });
+    ASSERT_GE(metaTrkId, 0);
+
+    int svc = 42;
+    long svcId = celix_bundleContext_registerService(ctx, &svc, "evict-test", nullptr);
+    EXPECT_TRUE(celix_bundleContext_useService(ctx, "evict-test", nullptr, [](void*, void*) {/*nop*/}));
+    EXPECT_EQ(1, nrOfActiveTrackers.load()); //note cached use tracker
+
+    celix_bundleContext_unregisterService(ctx, svcId);
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_EQ(0, nrOfActiveTrackers.load()); //note use tracker is evicted when the tracked service is removed
+
+    celix_bundleContext_stopTracker(ctx, metaTrkId);
+}
+
+TEST_F(CelixBundleContextServicesTests, useServiceReleasesServiceFactoryService) {
+    struct counts {
+        std::atomic<int> get{0};
+        std::atomic<int> unget{0};
+    } counts{};
+
+    celix_service_factory_t fac;
+    memset(&fac, 0, sizeof(fac));
+    fac.handle = (void*)&counts;
+    fac.getService = [](void *handle, const celix_bundle_t *, const celix_properties_t *) -> void* {
+        static int svc = 42;
+        static_cast<struct counts*>(handle)->get.fetch_add(1);
+        return &svc;
+    };
+    fac.ungetService = [](void *handle, const celix_bundle_t *, const celix_properties_t *) {
+        static_cast<struct counts*>(handle)->unget.fetch_add(1);
+    };
+    long facId = celix_bundleContext_registerServiceFactory(ctx, &fac, "factory-test", nullptr);
+    ASSERT_GE(facId, 0);
+
+    for (int i = 1; i <= 3; ++i) {
+        EXPECT_TRUE(celix_bundleContext_useService(ctx, "factory-test", nullptr, [](void*, void*) {/*nop*/}));
+        EXPECT_EQ(i, counts.get.load());
+        EXPECT_EQ(i, counts.unget.load()); //note service factory service is released when the use call returns
+    }
+
+    celix_bundleContext_unregisterService(ctx, facId);
+}
+
 TEST_F(CelixBundleContextServicesTests, registerAndUseServiceWithCorrectVersion) {
     struct calc {
         int (*calc)(int);
@@ -827,6 +991,51 @@ TEST_F(CelixBundleContextServicesTests, servicesTrackerSetTest) {
     ASSERT_EQ(4, count); //check if the set is called the expected times
 }
 
+TEST_F(CelixBundleContextServicesTests, useServicesInRankingOrder) {
+    void *svc1 = (void*)0x100; //no ranking
+    void *svc2 = (void*)0x200; //5 ranking
+    void *svc3 = (void*)0x300; //10 ranking
+    void *svc4 = (void*)0x400; //5 ranking
+
+    long svcId1 = celix_bundleContext_registerService(ctx, svc1, "NA", nullptr);
+    properties_t *props2 = celix_properties_create();
+    celix_properties_set(props2, OSGI_FRAMEWORK_SERVICE_RANKING, "5");
+    long svcId2 = celix_bundleContext_registerService(ctx, svc2, "NA", props2);
+    properties_t *props3 = celix_properties_create();
+    celix_properties_set(props3, OSGI_FRAMEWORK_SERVICE_RANKING, "10");
+    long svcId3 = celix_bundleContext_registerService(ctx, svc3, "NA", props3);
+    properties_t *props4 = celix_properties_create();
+    celix_properties_set(props4, OSGI_FRAMEWORK_SERVICE_RANKING, "5");
+    long svcId4 = celix_bundleContext_registerService(ctx, svc4, "NA", props4);
+
+    std::vector<long> used{};
+    size_t count = celix_bundleContext_useServices(ctx, "NA", &used, [](void *handle, void *svc) {
+        auto* u = static_cast<std::vector<long>*>(handle);
+        u->push_back((long)svc);
+    });
+    EXPECT_EQ(4, count);
+    std::vector<long> expected{0x300, 0x200, 0x400, 0x100}; //ranking desc, service id asc
+    EXPECT_EQ(expected, used);
+
+    long highest = 0;
+    bool called = celix_bundleContext_useService(ctx, "NA", &highest, [](void *handle, void *svc) {
+        *static_cast<long*>(handle) = (long)svc;
+    });
+    EXPECT_TRUE(called);
+    EXPECT_EQ(0x300, highest);
+
+    celix_bundleContext_unregisterService(ctx, svcId3);
+    called = celix_bundleContext_useService(ctx, "NA", &highest, [](void *handle, void *svc) {
+        *static_cast<long*>(handle) = (long)svc;
+    });
+    EXPECT_TRUE(called);
+    EXPECT_EQ(0x200, highest); //equal ranking, lowest service id
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    celix_bundleContext_unregisterService(ctx, svcId4);
+}
+
 TEST_F(CelixBundleContextServicesTests, trackAllServices) {
     std::atomic<size_t> count{0};
 
@@ -859,6 +1068,35 @@ TEST_F(CelixBundleContextServicesTests, trackAllServices) {
     celix_bundleContext_stopTracker(ctx, trackerId);
 }
 
+TEST_F(CelixBundleContextServicesTests, trackServicesWithOrFilter) {
+    std::atomic<int> count{0};
+
+    celix_service_tracking_options_t opts{};
+    opts.filter.filter = "(|(objectClass=svc_type1)(objectClass=svc_type2))";
+    opts.callbackHandle = (void *) &count;
+    opts.add = [](void *handle, void *) {
+        auto c = (std::atomic<int> *) handle;
+        c->fetch_add(1);
+    };
+    opts.remove = [](void *handle, void *) {
+        auto c = (std::atomic<int> *) handle;
+        c->fetch_sub(1);
+    };
+    long trackerId = celix_bundleContext_trackServicesWithOptions(ctx, &opts);
+    EXPECT_GE(trackerId, 0);
+
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "svc_type1", nullptr);
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x200, "svc_type2", nullptr);
+    long svcId3 = celix_bundleContext_registerService(ctx, (void*)0x300, "svc_type3", nullptr);
+    EXPECT_EQ(2, count.load());
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    celix_bundleContext_unregisterService(ctx, svcId3);
+    EXPECT_EQ(0, count.load());
+    celix_bundleContext_stopTracker(ctx, trackerId);
+}
+
 TEST_F(CelixBundleContextServicesTests, metaTrackAllServiceTrackers) {
     std::atomic<size_t> count{0};
     auto add = [](void *handle, const celix_service_tracker_info_t*) {
@@ -966,6 +1204,67 @@ TEST_F(CelixBundleContextServicesTests, asyncServiceFactoryTest) {
     celix_bundleContext_unregisterServiceAsync(ctx, facId, nullptr, nullptr);
 }
 
+TEST_F(CelixBundleContextServicesTests, concurrentGetAndUngetServiceFactoryTest) {
+    //note service usage counting is lock-free, but the get/unget of a service factory should still be called once per
+    //first/last usage.
+    struct counts {
+        std::atomic<int> get{0};
+        std::atomic<int> unget{0};
+    } counts{};
+    celix_service_factory_t fac;
+    memset(&fac, 0, sizeof(fac));
+    fac.handle = (void*)&counts;
+    fac.getService = [](void *handle, const celix_bundle_t *, const celix_properties_t *) -> void* {
+        auto *c = (struct counts*)handle;
+        c->get++;
+        return (void*)0x42;
+    };
+    fac.ungetService = [](void *handle, const celix_bundle_t *, const celix_properties_t *) {
+        auto *c = (struct counts*)handle;
+        c->unget++;
+    };
+    long facId = celix_bundleContext_registerServiceFactory(ctx, &fac, "CALC", nullptr);
+    ASSERT_TRUE(facId >= 0);
+
+    service_reference_pt ref = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_getServiceReference(ctx, "CALC", &ref));
+    ASSERT_TRUE(ref != nullptr);
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> users{};
+    for (int i = 0; i < 4; ++i) {
+        users.emplace_back([&]{
+            for (int k = 0; k < 1000; ++k) {
+                void* svc = nullptr;
+                bundleContext_getService(ctx, ref, &svc);
+                if (svc != (void*)0x42) {
+                    failures++;
+                }
+                bool result;
+                bundleContext_ungetService(ctx, ref, &result);
+            }
+        });
+    }
+    for (auto& t : users) {
+        t.join();
+    }
+    EXPECT_EQ(0, failures.load());
+    EXPECT_GE(counts.get.load(), 1);
+    EXPECT_EQ(counts.get.load(), counts.unget.load());
+
+    //usage count should be back to 0, so the next get should call the factory again
+    int getCount = counts.get.load();
+    void* svc = nullptr;
+    bundleContext_getService(ctx, ref, &svc);
+    EXPECT_EQ(getCount + 1, counts.get.load());
+    bool result;
+    bundleContext_ungetService(ctx, ref, &result);
+    EXPECT_EQ(counts.get.load(), counts.unget.load());
+
+    bundleContext_ungetServiceReference(ctx, ref);
+    celix_bundleContext_unregisterService(ctx, facId);
+}
+
 TEST_F(CelixBundleContextServicesTests, findServicesTest) {
     long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", nullptr);
     long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x100, "example", nullptr);
@@ -999,6 +1298,138 @@ TEST_F(CelixBundleContextServicesTests, findServicesTest) {
     celix_bundleContext_unregisterService(ctx, svcId2);
 }
 
+TEST_F(CelixBundleContextServicesTests, setPropertiesDoesNotChangeObjectClassTest) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, OSGI_FRAMEWORK_OBJECTCLASS, "example2"); //note objectClass differs from the service name
+    service_registration_t* reg = nullptr;
+    ASSERT_EQ(CELIX_SUCCESS, bundleContext_registerService(ctx, "example1", (void*)0x100, props, &reg));
+    long svcId = serviceRegistration_getServiceId(reg);
+
+    auto* newProps = celix_properties_create();
+    celix_properties_set(newProps, OSGI_FRAMEWORK_OBJECTCLASS, "example3");
+    celix_properties_set(newProps, "key", "value");
+    EXPECT_EQ(CELIX_SUCCESS, serviceRegistration_setProperties(reg, newProps));
+
+    celix_service_filter_options_t opts{};
+    opts.filter = "(objectClass=example3)";
+    EXPECT_LT(celix_bundleContext_findServiceWithOptions(ctx, &opts), 0);
+    opts.filter = "(&(objectClass=example2)(key=value))";
+    EXPECT_EQ(svcId, celix_bundleContext_findServiceWithOptions(ctx, &opts));
+
+    EXPECT_EQ(CELIX_SUCCESS, serviceRegistration_setProperties(reg, nullptr));
+    opts.filter = "(objectClass=example2)";
+    EXPECT_EQ(svcId, celix_bundleContext_findServiceWithOptions(ctx, &opts));
+
+    serviceRegistration_unregister(reg);
+}
+
+TEST_F(CelixBundleContextServicesTests, findServicesWithAndWithoutServiceNameIndexTest) {
+    long svcId1 = celix_bundleContext_registerService(ctx, (void*)0x100, "example1", nullptr);
+    long svcId2 = celix_bundleContext_registerService(ctx, (void*)0x100, "example2", nullptr);
+    auto* props = celix_properties_create();
+    celix_properties_set(props, OSGI_FRAMEWORK_OBJECTCLASS, "example3"); //note objectClass differs from the service name
+    long svcId3 = celix_bundleContext_registerService(ctx, (void*)0x100, "example4", props);
+
+    celix_service_filter_options_t opts{};
+    opts.filter = "(objectClass=example1)";
+    celix_array_list_t* list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    ASSERT_EQ(1, celix_arrayList_size(list));
+    EXPECT_EQ(svcId1, celix_arrayList_getLong(list, 0));
+    celix_arrayList_destroy(list);
+
+    opts.filter = "(|(objectClass=example1)(objectClass=example2))"; //cannot use index
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    EXPECT_EQ(2, celix_arrayList_size(list));
+    celix_arrayList_destroy(list);
+
+    opts.filter = "(&(objectClass=example*)(!(objectClass=example2)))"; //cannot use index
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    EXPECT_EQ(2, celix_arrayList_size(list));
+    celix_arrayList_destroy(list);
+
+    opts.filter = "(objectClass=example3)";
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    ASSERT_EQ(1, celix_arrayList_size(list));
+    EXPECT_EQ(svcId3, celix_arrayList_getLong(list, 0));
+    celix_arrayList_destroy(list);
+
+    celix_bundleContext_unregisterService(ctx, svcId1);
+    celix_bundleContext_unregisterService(ctx, svcId2);
+    celix_bundleContext_unregisterService(ctx, svcId3);
+
+    opts.filter = "(objectClass=example3)";
+    list = celix_bundleContext_findServicesWithOptions(ctx, &opts);
+    EXPECT_EQ(0, celix_arrayList_size(list));
+    celix_arrayList_destroy(list);
+}
+
+TEST_F(CelixBundleContextServicesTests, findServicesWhileRegisteringServicesTest) {
+    //note service lookups are lock-free and use a snapshot of the registered services, replaced for every (un)registration
+    long stableSvcId = celix_bundleContext_registerService(ctx, (void*)0x100, "stable", nullptr);
+    std::atomic<bool> running{true};
+    std::atomic<int> failures{0};
+
+    std::vector<std::thread> readers{};
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&]{
+            while (running) {
+                if (celix_bundleContext_findService(ctx, "stable") != stableSvcId) {
+                    failures++;
+                }
+                if (!celix_bundleContext_isServiceRegistered(ctx, stableSvcId)) {
+                    failures++;
+                }
+                celix_array_list_t* ids = celix_bundleContext_findServices(ctx, "changing");
+                celix_arrayList_destroy(ids);
+            }
+        });
+    }
+
+    for (int i = 0; i < 500; ++i) {
+        long svcId = celix_bundleContext_registerService(ctx, (void*)0x200, "changing", nullptr);
+        EXPECT_TRUE(celix_bundleContext_isServiceRegistered(ctx, svcId));
+        celix_bundleContext_unregisterService(ctx, svcId);
+        EXPECT_FALSE(celix_bundleContext_isServiceRegistered(ctx, svcId));
+    }
+    running = false;
+    for (auto& t : readers) {
+        t.join();
+    }
+    EXPECT_EQ(0, failures.load());
+    celix_bundleContext_unregisterService(ctx, stableSvcId);
+}
+
+TEST_F(CelixBundleContextServicesTests, findServicesWithManyRegisteredServicesTest) {
+    //note the service registry snapshot is divided in segments, register enough services to split and merge segments
+    std::vector<long> svcIds{};
+    for (int i = 0; i < 1000; ++i) {
+        const char* name = i % 3 == 0 ? "A" : (i % 3 == 1 ? "B" : "C");
+        svcIds.push_back(celix_bundleContext_registerService(ctx, (void*)0x100, name, nullptr));
+    }
+    celix_array_list_t* ids = celix_bundleContext_findServices(ctx, "B");
+    EXPECT_EQ(333, celix_arrayList_size(ids));
+    celix_arrayList_destroy(ids);
+    EXPECT_EQ(svcIds[1], celix_bundleContext_findService(ctx, "B"));
+
+    //unregister every other service
+    for (size_t i = 0; i < svcIds.size(); i += 2) {
+        celix_bundleContext_unregisterService(ctx, svcIds[i]);
+        EXPECT_FALSE(celix_bundleContext_isServiceRegistered(ctx, svcIds[i]));
+    }
+    for (size_t i = 1; i < svcIds.size(); i += 2) {
+        EXPECT_TRUE(celix_bundleContext_isServiceRegistered(ctx, svcIds[i]));
+    }
+    ids = celix_bundleContext_findServices(ctx, "A");
+    EXPECT_EQ(167, celix_arrayList_size(ids));
+    celix_arrayList_destroy(ids);
+    EXPECT_EQ(svcIds[3], celix_bundleContext_findService(ctx, "A"));
+
+    for (size_t i = 1; i < svcIds.size(); i += 2) {
+        celix_bundleContext_unregisterService(ctx, svcIds[i]);
+    }
+    EXPECT_EQ(-1L, celix_bundleContext_findService(ctx, "A"));
+}
+
 TEST_F(CelixBundleContextServicesTests, trackServiceTrackerTest) {
 
     int count = 0;
@@ -1096,6 +1527,41 @@ TEST_F(CelixBundleContextServicesTests, floodEventLoopTest) {
     }
 }
 
+TEST_F(CelixBundleContextServicesTests, floodEventLoopFromMultipleThreadsTest) {
+    //test concurrent producers on the event queue, including overflowing the static event queue
+    const int nrOfThreads = 8;
+    const int nrOfRegistrationsPerThread = 200;
+    std::vector<std::vector<long>> svcIds(nrOfThreads);
+    std::vector<std::thread> threads{};
+    for (int t = 0; t < nrOfThreads; ++t) {
+        threads.emplace_back([&, t]{
+            for (int i = 0; i < nrOfRegistrationsPerThread; ++i) {
+                long id = celix_bundleContext_registerServiceAsync(ctx, (void*)0x42, "test", nullptr);
+                EXPECT_GE(id, 0);
+                svcIds[t].push_back(id);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    celix_bundleContext_waitForEvents(ctx);
+    celix_array_list_t* found = celix_bundleContext_findServices(ctx, "test");
+    EXPECT_EQ(celix_arrayList_size(found), nrOfThreads * nrOfRegistrationsPerThread);
+    celix_arrayList_destroy(found);
+
+    for (auto& ids : svcIds) {
+        for (auto id : ids) {
+            celix_bundleContext_unregisterServiceAsync(ctx, id, nullptr, nullptr);
+        }
+        celix_bundleContext_waitForAsyncUnregistration(ctx, ids.back());
+        EXPECT_FALSE(celix_bundleContext_isServiceRegistered(ctx, ids.back()));
+    }
+    celix_bundleContext_waitForEvents(ctx);
+    EXPECT_LT(celix_bundleContext_findService(ctx, "test"), 0L);
+}
+
 
 TEST_F(CelixBundleContextServicesTests, serviceOnDemandWithAsyncRegisterTest) {
     //NOTE that even though service are registered async, they should be found by a useService call.
@@ -1225,6 +1691,37 @@ TEST_F(CelixBundleContextServicesTests, unregisterSvcBeforeAsyncRegistration) {
     EXPECT_EQ(0, cbData.count.load()); //note create tracker canceled -> no callback
 }
 
+TEST_F(CelixBundleContextServicesTests, unregisterAsyncRegisteredSvcDuringEventBatch) {
+    struct callback_data {
+        std::promise<void> queued{};
+        celix_bundle_context_t* ctx{nullptr};
+        long svcId{-1};
+    };
+    callback_data cbData{};
+    cbData.ctx = ctx;
+    long bndId = celix_bundle_getId(celix_framework_getFrameworkBundle(fw));
+
+    //note blocking the event loop, so that the service registration and unregistration events end up in a single batch
+    celix_framework_fireGenericEvent(fw, -1, bndId, "block", (void*)&cbData, [](void *data) {
+        auto cbd = static_cast<struct callback_data*>(data);
+        cbd->queued.get_future().wait();
+    }, nullptr, nullptr);
+
+    cbData.svcId = celix_bundleContext_registerServiceAsync(ctx, (void*)0x42, "test-service", nullptr);
+    EXPECT_GE(cbData.svcId, 0);
+
+    celix_framework_fireGenericEvent(fw, -1, bndId, "unregister", (void*)&cbData, [](void *data) {
+        auto cbd = static_cast<struct callback_data*>(data);
+        //note the registration event is already processed, but the batch is still in progress -> should unregister.
+        celix_bundleContext_unregisterService(cbd->ctx, cbd->svcId);
+    }, nullptr, nullptr);
+    cbData.queued.set_value();
+
+    celix_bundleContext_waitForEvents(ctx);
+    long svcId = celix_bundleContext_findService(ctx, "test-service");
+    EXPECT_LT(svcId, 0);
+}
+
 TEST_F(CelixBundleContextServicesTests, stopSvcTrackerBeforeAsyncTrackerIsCreated) {
     struct callback_data {
         std::atomic<int> count{};
@@ -30,7 +30,10 @@
 #ifndef ARCHIVE_H_
 #define ARCHIVE_H_
 
+#include <stddef.h>
+
 #include "celix_errno.h"
+#include "celix_array_list.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +51,50 @@ extern "C" {
  */
 celix_status_t extractBundle(const char *bundleName, const char *revisionRoot);
 
+/**
+ * Lists the entries (files and directories) of the bundle pointed to by bundleName, without extracting the bundle.
+ *
+ * @param bundleName location of the bundle.
+ * @param[out] entries A array list with the (malloc'ed) entry names. The caller is owner of the list and the names.
+ *
+ * @return Status code indication failure or success:
+ * 		- CELIX_SUCCESS when no errors are encountered.
+ * 		- CELIX_FILE_IO_EXCEPTION If the zip file cannot be read.
+ */
+celix_status_t listBundleEntries(const char *bundleName, celix_array_list_t **entries);
+
+/**
+ * Reads a single entry of the bundle pointed to by bundleName in memory, without extracting the bundle.
+ *
+ * @param bundleName location of the bundle.
+ * @param entryName name of the entry in the bundle, e.g. "META-INF/MANIFEST.MF".
+ * @param[out] data The (malloc'ed and '\0' terminated) content of the entry. The caller is owner.
+ * @param[out] size The size of the entry content.
+ *
+ * @return Status code indication failure or success:
+ * 		- CELIX_SUCCESS when no errors are encountered.
+ * 		- CELIX_FILE_IO_EXCEPTION If the zip file cannot be read or does not contain the entry.
+ */
+celix_status_t readBundleEntry(const char *bundleName, const char *entryName, char **data, size_t *size);
+
+/**
+ * Writes the content of a single entry of the bundle pointed to by bundleName to the given file descriptor,
+ * without extracting the bundle.
+ *
+ * A stored (uncompressed) entry is written directly from a memory map of the bundle zip, a compressed entry is
+ * inflated.
+ *
+ * @param bundleName location of the bundle.
+ * @param entryName name of the entry in the bundle.
+ * @param fd The file descriptor to write the entry content to.
+ *
+ * @return Status code indication failure or success:
+ * 		- CELIX_SUCCESS when no errors are encountered.
+ * 		- CELIX_FILE_IO_EXCEPTION If the zip file cannot be read, does not contain the entry or the content cannot
+ * 		  be written.
+ */
+celix_status_t writeBundleEntry(const char *bundleName, const char *entryName, int fd);
+
 #ifdef __cplusplus
 }
 #endif
@@ -45,10 +45,25 @@ extern "C" {
 celix_status_t bundleArchive_create(const char *archiveRoot, long id, const char *location, const char *inputFile,
                                     bundle_archive_pt *bundle_archive);
 
+/**
+ * Same as bundleArchive_create, but the revisions of the archive are created with the provided options.
+ * @see bundleRevision_createWithOptions
+ */
+celix_status_t bundleArchive_createWithOptions(const char *archiveRoot, const celix_bundle_revision_options_t *opts,
+                                               long id, const char *location, const char *inputFile,
+                                               bundle_archive_pt *bundle_archive);
+
 celix_status_t bundleArchive_createSystemBundleArchive(bundle_archive_pt *bundle_archive);
 
 celix_status_t bundleArchive_recreate(const char *archiveRoot, bundle_archive_pt *bundle_archive);
 
+/**
+ * Same as bundleArchive_recreate, but the revisions of the archive are created with the provided options.
+ * @see bundleRevision_createWithOptions
+ */
+celix_status_t bundleArchive_recreateWithOptions(const char *archiveRoot, const celix_bundle_revision_options_t *opts,
+                                                 bundle_archive_pt *bundle_archive);
+
 celix_status_t bundleArchive_destroy(bundle_archive_pt archive);
 
 FRAMEWORK_EXPORT celix_status_t bundleArchive_getId(bundle_archive_pt archive, long *id);
@@ -31,6 +31,7 @@
 #define BUNDLE_REVISION_H_
 
 #include <stdio.h>
+#include <stdbool.h>
 
 #include "celix_types.h"
 
@@ -70,6 +71,53 @@ extern "C" {
 celix_status_t bundleRevision_create(const char *root, const char *location, long revisionNr, const char *inputFile,
                                      bundle_revision_pt *bundle_revision);
 
+/**
+ * Options for creating a bundle revision.
+ */
+typedef struct celix_bundle_revision_options {
+    /**
+     * The (optional) content cache dir, see CELIX_FRAMEWORK_CONTENT_CACHE_DIR.
+     *
+     * If not NULL and the revision is created for a location (and not an inputFile), the bundle zip is extracted to
+     * a content cache entry keyed by the hash and modification time of the bundle zip instead of to the revision root.
+     * If the entry already exists, the bundle zip is not extracted again and the manifest is read from the
+     * pre-serialized manifest of the entry. The root of the created revision is then the content dir of the entry.
+     */
+    const char *contentCacheDir;
+
+    /**
+     * Whether the bundle should be loaded directly from the bundle zip, see CELIX_LOAD_BUNDLES_FROM_ZIP.
+     *
+     * If true, the revision is created for a location and the bundle zip only contains a manifest and the libraries
+     * mentioned in the manifest, the bundle zip is not extracted. The manifest is read from the bundle zip and the
+     * libraries are loaded from the bundle zip using a memory file.
+     */
+    bool loadFromZip;
+} celix_bundle_revision_options_t;
+
+#define CELIX_EMPTY_BUNDLE_REVISION_OPTIONS {.contentCacheDir = NULL, .loadFromZip = false}
+
+/**
+ * Creates a new revision for the given inputFile or location using the provided options.
+ * The root parameter is always used to store the state of the revision, but - depending on the options - the content
+ * of the bundle can be located elsewhere.
+ *
+ * @param root The root for this revision in which the state is stored.
+ * @param opts The revision options. If NULL this is the same as bundleRevision_create.
+ * @param location The location associated with the revision
+ * @param revisionNr The number of the revision
+ * @param inputFile The (optional) location of the file to use as input for this revision
+ * @param[out] bundle_revision The output parameter for the created revision.
+ *
+ * @return Status code indication failure or success:
+ * 		- CELIX_SUCCESS when no errors are encountered.
+ * 		- CELIX_ENOMEM If allocating memory for <code>bundle_revision</code> failed.
+ * 		- CELIX_FILE_IO_EXCEPTION If the bundle zip could not be read or extracted.
+ */
+celix_status_t bundleRevision_createWithOptions(const char *root, const celix_bundle_revision_options_t *opts,
+                                                const char *location, long revisionNr, const char *inputFile,
+                                                bundle_revision_pt *bundle_revision);
+
 celix_status_t bundleRevision_destroy(bundle_revision_pt revision);
 
 /**
@@ -109,6 +109,64 @@ namespace celix {
      */
     constexpr const char * const FRAMEWORK_STATIC_EVENT_QUEUE_SIZE = CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE;
 
+    /**
+     * @brief Celix framework environment property (named "CELIX_FRAMEWORK_NR_OF_EVENT_LOOPS") which configures
+     * the number of event loop threads used by the Celix framework.
+     *
+     * Events are assigned to an event loop based on the bundle id of the event, so that the events for a single bundle
+     * are still handled in order. Events without a bundle (e.g. framework events) are handled by the first event loop.
+     *
+     * Default is CELIX_FRAMEWORK_DEFAULT_NR_OF_EVENT_LOOPS which is 1, but can be override with a compiler
+     * define (same name).
+     */
+    constexpr const char * const FRAMEWORK_NR_OF_EVENT_LOOPS = CELIX_FRAMEWORK_NR_OF_EVENT_LOOPS;
+
+    /**
+     * @brief Celix framework environment property (named "CELIX_FRAMEWORK_CONTENT_CACHE_DIR") which configures a
+     * persistent, content addressed, cache dir for extracted bundles.
+     *
+     * Default is not set. If set, an installed bundle zip is extracted once to a entry in this dir, keyed by the hash
+     * and modification time of the bundle zip. Unchanged bundles reuse their already extracted entry and
+     * pre-serialized manifest on the next start.
+     */
+    constexpr const char * const FRAMEWORK_CONTENT_CACHE_DIR = CELIX_FRAMEWORK_CONTENT_CACHE_DIR;
+
+    /**
+     * @brief Celix framework environment property (named "CELIX_LOAD_BUNDLES_FROM_ZIP") which configures whether
+     * bundles are loaded directly from their bundle zip, without extracting the bundle zip.
+     *
+     * Default is false. If true (Linux only), bundle zips containing only a manifest and the libraries mentioned in
+     * the manifest are not extracted and their libraries are loaded from an in-memory file.
+     */
+    constexpr const char * const LOAD_BUNDLES_FROM_ZIP = CELIX_LOAD_BUNDLES_FROM_ZIP;
+
+    /**
+     * @brief Celix framework environment property (named "CELIX_FRAMEWORK_TRACE_ENABLED") which configures whether
+     * the framework records a startup and lifecycle trace.
+     *
+     * Default is false. If true, the trace is accessible through the framework trace service and the shell
+     * trace command.
+     */
+    constexpr const char * const FRAMEWORK_TRACE_ENABLED = CELIX_FRAMEWORK_TRACE_ENABLED;
+
+    /**
+     * @brief Celix framework environment property (named "CELIX_FRAMEWORK_TRACE_BUFFER_SIZE") which configures the
+     * number of trace entries kept by the framework.
+     *
+     * Default is CELIX_FRAMEWORK_DEFAULT_TRACE_BUFFER_SIZE which is 4096, but can be override with a compiler
+     * define (same name).
+     */
+    constexpr const char * const FRAMEWORK_TRACE_BUFFER_SIZE = CELIX_FRAMEWORK_TRACE_BUFFER_SIZE;
+
+    /**
+     * @brief Celix framework environment property (named "CELIX_FRAMEWORK_EVENT_METRICS_ENABLED") which configures
+     * whether the framework keeps event loop metrics.
+     *
+     * Default is false. If true, the metrics are accessible through the framework metrics service and the shell
+     * metrics command.
+     */
+    constexpr const char * const FRAMEWORK_EVENT_METRICS_ENABLED = CELIX_FRAMEWORK_EVENT_METRICS_ENABLED;
+
     /**
      * @brief Celix framework environment property (named "CELIX_AUTO_START_0") which specified a (ordered) space
      * separated set of bundles to load and auto start when the Celix framework is started.
@@ -151,6 +209,15 @@ namespace celix {
      */
     constexpr const char * const AUTO_START_6 = CELIX_AUTO_START_6;
 
+    /**
+     * @brief Celix framework environment property (named "CELIX_AUTO_START_PARALLEL") which configures if the bundles
+     * of a single auto start level (AUTO_START_0 - AUTO_START_6) are started concurrently.
+     *
+     * Default is false. If true, the bundles of a auto start level are started concurrently and the framework waits
+     * until all bundles of a level are started before starting the bundles of the next level.
+     */
+    constexpr const char * const AUTO_START_PARALLEL = CELIX_AUTO_START_PARALLEL;
+
 
     /**
      * @brief Celix framework environment property (named "CELIX_BUNDLES_PATH") which specified a `;` separated
@@ -35,11 +35,11 @@ namespace celix {
     class PropertiesIterator {
     public:
         explicit PropertiesIterator(celix_properties_t* props) {
-            iter = hashMapIterator_construct((hash_map_t*)props);
+            iter = celix_propertiesIterator_construct(props);
             next();
         }
         explicit PropertiesIterator(const celix_properties_t* props) {
-            iter = hashMapIterator_construct((hash_map_t*)props);
+            iter = celix_propertiesIterator_construct(props);
             next();
         }
 
@@ -53,7 +53,7 @@ namespace celix {
         }
 
         bool operator==(const celix::PropertiesIterator& rhs) const {
-            bool sameMap = iter.map == rhs.iter.map;
+            bool sameMap = iter.props == rhs.iter.props;
             bool sameIndex = iter.index == rhs.iter.index;
             bool oneIsEnd = end || rhs.end;
             if (oneIsEnd) {
@@ -68,12 +68,11 @@ namespace celix {
         }
 
         void next() {
-            if (hashMapIterator_hasNext(&iter)) {
-                auto* entry = hashMapIterator_nextEntry(&iter);
-                auto *k = hashMapEntry_getKey(entry);
-                auto *v = hashMapEntry_getValue(entry);
-                first = std::string{(const char*)k};
-                second = std::string{(const char*)v};
+            if (celix_propertiesIterator_hasNext(&iter)) {
+                auto *k = celix_propertiesIterator_nextKey(&iter);
+                auto *v = celix_properties_get(iter.props, k, "");
+                first = std::string{k};
+                second = std::string{v};
             } else {
                 moveToEnd();
             }
@@ -88,7 +87,7 @@ namespace celix {
         std::string first{};
         std::string second{};
     private:
-        hash_map_iterator_t iter{nullptr, nullptr, nullptr, 0, 0};
+        celix_properties_iterator_t iter{nullptr, 0};
         bool end{false};
     };
 
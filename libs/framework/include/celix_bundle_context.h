@@ -765,6 +765,11 @@ typedef struct celix_service_use_options {
  * This function will block until the callback is finished. As result it is possible to provide callback data from the
  * stack.
  *
+ * The callback is called on the calling thread. The service tracker used to find the service is cached in the bundle
+ * context and shared between use calls with the same filter options; cached trackers are evicted when idle.
+ * If a wait timeout is configured, the call blocks until a matching service is added to the tracker or the timeout
+ * expires.
+ *
  * @param   ctx The bundle context.
  * @param   opts The required options. Note that the serviceName is required.
  * @return  True if a service was found.
@@ -784,6 +789,9 @@ bool celix_bundleContext_useServiceWithOptions(
  * This function will block until the callback is finished. As result it is possible to provide callback data from the
  * stack.
  *
+ * The callbacks are called on the calling thread, using a cached service tracker (see
+ * celix_bundleContext_useServiceWithOptions).
+ *
  * @param   ctx The bundle context.
  * @param   opts The required options. Note that the serviceName is required.
  * @return  The number of services found and called
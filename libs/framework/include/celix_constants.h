@@ -166,8 +166,8 @@ extern "C" {
  * @brief Celix framework environment property (named "CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE") which configures
  * the static event size queue used by the Celix framework.
  *
- * The Celix framework handle service events in a event thread. This thread uses a static allocated event queue with
- * a fixed size and dynamic event queue if the static event queue is full.
+ * The Celix framework handle service events in a event thread. This thread uses a static allocated lock-free event
+ * queue with a fixed size (rounded up to a power of 2) and dynamic event queue if the static event queue is full.
  * The decrease the memory footprint a smaller static event queue size can be used and to improve performance during
  * heavy load a bigger static event queue size can be used.
  *
@@ -176,6 +176,98 @@ extern "C" {
  */
 #define CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE "CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE"
 
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_NR_OF_EVENT_LOOPS") which configures
+ * the number of event loop threads used by the Celix framework.
+ *
+ * Events are assigned to an event loop based on the bundle id of the event, so that the events for a single bundle
+ * are still handled in order. Events without a bundle (e.g. framework events) are handled by the first event loop.
+ * Every event loop has its own static event queue (see CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE).
+ *
+ * A synchronous call on an event loop thread for a bundle handled by another event loop (e.g. a service registration)
+ * waits on that other event loop. Such a wait is rejected and logged as error if the other event loop is (indirectly)
+ * waiting on the calling event loop, because it would deadlock. Use the async API on event loop threads to prevent this.
+ *
+ * Default is CELIX_FRAMEWORK_DEFAULT_NR_OF_EVENT_LOOPS which is 1, but can be override with a compiler
+ * define (same name).
+ */
+#define CELIX_FRAMEWORK_NR_OF_EVENT_LOOPS "CELIX_FRAMEWORK_NR_OF_EVENT_LOOPS"
+
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_CONTENT_CACHE_DIR") which configures a
+ * persistent, content addressed, cache dir for extracted bundles.
+ *
+ * Default is not set. If set, an installed bundle zip is extracted once to a entry in this dir, keyed by the hash and
+ * modification time of the bundle zip. Unchanged bundles reuse their already extracted entry and pre-serialized
+ * manifest on the next start, also if the framework storage (cache) is cleaned.
+ *
+ * Note that the content cache dir is never cleaned by the framework and that libraries of a bundle are loaded from
+ * the entry. So frameworks in the same process configured with the same content cache dir share the loaded bundle
+ * libraries.
+ */
+#define CELIX_FRAMEWORK_CONTENT_CACHE_DIR "CELIX_FRAMEWORK_CONTENT_CACHE_DIR"
+
+/**
+ * @brief Celix framework environment property (named "CELIX_LOAD_BUNDLES_FROM_ZIP") which configures whether bundles
+ * are loaded directly from their bundle zip, without extracting the bundle zip.
+ *
+ * Default is false. If true (and supported by the platform, currently only Linux), bundle zips containing only a
+ * manifest and the libraries listed in the Private-Library and Export-Library manifest headers are not extracted.
+ * The Bundle-Activator header is not checked, so a bundle zip with an activator library which is not listed in one of
+ * these headers is extracted. The manifest is read directly from the bundle zip and the libraries are loaded from an
+ * in-memory file (memfd). Uncompressed (stored) libraries are copied from a memory mapped bundle zip, compressed
+ * libraries are inflated.
+ *
+ * Bundles loaded from a zip have no entries on disk, so celix_bundle_getEntry will not find any entries for these
+ * bundles. Other bundle zips are extracted as usual.
+ */
+#define CELIX_LOAD_BUNDLES_FROM_ZIP "CELIX_LOAD_BUNDLES_FROM_ZIP"
+
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_TRACE_ENABLED") which configures whether the
+ * framework records a startup and lifecycle trace.
+ *
+ * Default is false. If true, the framework records the duration of bundle installs, bundle library loading, bundle
+ * activator create/start calls and bundle starts, and the time events wait in the event queue. The trace is
+ * accessible through the framework trace service (see celix_framework_trace_service.h) and the shell trace command
+ * and can be exported as Chrome trace-event JSON.
+ */
+#define CELIX_FRAMEWORK_TRACE_ENABLED "CELIX_FRAMEWORK_TRACE_ENABLED"
+
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_TRACE_BUFFER_SIZE") which configures the
+ * number of trace entries kept by the framework (rounded up to a power of 2).
+ *
+ * The trace entries are recorded in a lock-free ring, if the ring is full the oldest entries are overwritten.
+ *
+ * Default is CELIX_FRAMEWORK_DEFAULT_TRACE_BUFFER_SIZE which is 4096, but can be override with a compiler
+ * define (same name).
+ */
+#define CELIX_FRAMEWORK_TRACE_BUFFER_SIZE "CELIX_FRAMEWORK_TRACE_BUFFER_SIZE"
+
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_EVENT_METRICS_ENABLED") which configures
+ * whether the framework keeps event loop metrics.
+ *
+ * Default is false. If true, the framework keeps histograms of the event queue depth, the time events wait in the
+ * event queue and the time it takes to handle events (per event type and per bundle for generic events). The
+ * slowest handled events are kept, so that bundles blocking the event loop can be identified. The metrics are
+ * accessible through the framework metrics service (see celix_framework_metrics_service.h) and the shell metrics
+ * command.
+ */
+#define CELIX_FRAMEWORK_EVENT_METRICS_ENABLED "CELIX_FRAMEWORK_EVENT_METRICS_ENABLED"
+
+/**
+ * @brief Celix framework environment property (named "CELIX_FRAMEWORK_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US") which
+ * configures the handle time (in microseconds) an event needs to exceed to be kept as one of the slowest events.
+ *
+ * Faster events are only added to the histograms, so that recording them stays lock-free.
+ *
+ * Default is CELIX_FRAMEWORK_DEFAULT_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US which is 1000 (1ms), but can be override
+ * with a compiler define (same name).
+ */
+#define CELIX_FRAMEWORK_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US "CELIX_FRAMEWORK_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US"
+
 /**
  * @brief Celix framework environment property (named "CELIX_AUTO_START_0") which specified a (ordered) space
  * separated set of bundles to load and auto start when the Celix framework is started.
@@ -218,6 +310,18 @@ extern "C" {
  */
 #define CELIX_AUTO_START_6 "CELIX_AUTO_START_6"
 
+/**
+ * @brief Celix framework environment property (named "CELIX_AUTO_START_PARALLEL") which configures if the bundles
+ * of a single auto start level (CELIX_AUTO_START_0 - CELIX_AUTO_START_6) are started concurrently.
+ *
+ * Default is false. If true, the bundles of a auto start level are started concurrently and the framework waits
+ * until all bundles of a level are started before starting the bundles of the next level. The start order of bundles
+ * within a level is then undefined.
+ *
+ * Note that the bundles of a auto start level are always installed (extracted and manifest parsed) concurrently.
+ */
+#define CELIX_AUTO_START_PARALLEL "CELIX_AUTO_START_PARALLEL"
+
 
 #ifdef __cplusplus
 }
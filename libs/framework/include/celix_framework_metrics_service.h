@@ -0,0 +1,141 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_FRAMEWORK_METRICS_SERVICE_H_
+#define CELIX_FRAMEWORK_METRICS_SERVICE_H_
+
+#include <stdint.h>
+
+#include "celix_array_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The framework metrics service name.
+ *
+ * The framework metrics service is registered by the framework bundle if event metrics are enabled
+ * (see CELIX_FRAMEWORK_EVENT_METRICS_ENABLED).
+ */
+#define CELIX_FRAMEWORK_METRICS_SERVICE_NAME "celix_framework_metrics_service"
+#define CELIX_FRAMEWORK_METRICS_SERVICE_VERSION "1.0.0"
+
+/**
+ * @brief The number of buckets of a metrics histogram.
+ */
+#define CELIX_FRAMEWORK_METRICS_NR_OF_BUCKETS 32
+
+/**
+ * @brief The (max) number of slowest handled events kept by the framework.
+ */
+#define CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS 10
+
+typedef enum celix_framework_metrics_event_type {
+    CELIX_FRAMEWORK_METRICS_FRAMEWORK_EVENT     = 0,
+    CELIX_FRAMEWORK_METRICS_BUNDLE_EVENT        = 1,
+    CELIX_FRAMEWORK_METRICS_REGISTER_EVENT      = 2,
+    CELIX_FRAMEWORK_METRICS_UNREGISTER_EVENT    = 3,
+    CELIX_FRAMEWORK_METRICS_GENERIC_EVENT       = 4,
+    CELIX_FRAMEWORK_METRICS_NR_OF_EVENT_TYPES   = 5
+} celix_framework_metrics_event_type_e;
+
+/**
+ * @brief A log2 histogram.
+ *
+ * Bucket 0 counts the value 0 and bucket i counts the values in the range [2^(i-1), 2^i). The last bucket also
+ * counts all larger values.
+ */
+typedef struct celix_framework_metrics_histogram {
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+    uint64_t buckets[CELIX_FRAMEWORK_METRICS_NR_OF_BUCKETS];
+} celix_framework_metrics_histogram_t;
+
+/**
+ * @brief The metrics of the generic events fired for a bundle (see celix_framework_fireGenericEvent).
+ */
+typedef struct celix_framework_bundle_event_metrics {
+    long bndId;
+    char bndSymbolicName[64]; //can be truncated
+    celix_framework_metrics_histogram_t handleTimeInUs;
+} celix_framework_bundle_event_metrics_t;
+
+/**
+ * @brief A handled event which blocked the event loop for handleTimeInUs.
+ */
+typedef struct celix_framework_blocking_event {
+    celix_framework_metrics_event_type_e type;
+    long bndId; //the bundle of the event, -1 if the event has no bundle
+    char bndSymbolicName[64]; //can be truncated
+    char eventName[64]; //generic event name or service name, can be truncated or empty
+    uint64_t handleTimeInUs;
+} celix_framework_blocking_event_t;
+
+/**
+ * @brief A snapshot of the framework event loop metrics.
+ */
+typedef struct celix_framework_event_metrics {
+    celix_framework_metrics_histogram_t queueDepth; //nr of pending events when an event is added to the event queue
+    celix_framework_metrics_histogram_t queueLatencyInUs; //time between adding and handling an event
+    celix_framework_metrics_histogram_t handleTimeInUs[CELIX_FRAMEWORK_METRICS_NR_OF_EVENT_TYPES];
+    celix_array_list_t *bundles; //entries are celix_framework_bundle_event_metrics_t*
+    celix_array_list_t *blockingEvents; //entries are celix_framework_blocking_event_t*, ordered from slowest
+} celix_framework_event_metrics_t;
+
+/**
+ * @brief Service to access the event loop metrics of the framework.
+ */
+typedef struct celix_framework_metrics_service {
+    void *handle;
+
+    /**
+     * @brief Creates a snapshot of the event loop metrics. The snapshot should be destroyed with destroyEventMetrics.
+     */
+    celix_framework_event_metrics_t* (*createEventMetrics)(void *handle);
+
+    /**
+     * @brief Destroys a snapshot created with createEventMetrics.
+     */
+    void (*destroyEventMetrics)(void *handle, celix_framework_event_metrics_t *metrics);
+
+    /**
+     * @brief Resets the event loop metrics.
+     */
+    void (*reset)(void *handle);
+} celix_framework_metrics_service_t;
+
+/**
+ * @brief Returns a description of the metrics event type.
+ */
+const char* celix_frameworkMetrics_eventTypeToString(celix_framework_metrics_event_type_e type);
+
+/**
+ * @brief Returns the estimated value for the provided percentile (0.0 - 1.0) of the histogram.
+ *
+ * The estimate is the upper bound of the bucket containing the percentile, limited by the max of the histogram.
+ */
+uint64_t celix_frameworkMetrics_percentile(const celix_framework_metrics_histogram_t *histogram, double percentile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_FRAMEWORK_METRICS_SERVICE_H_ */
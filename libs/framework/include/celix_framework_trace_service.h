@@ -0,0 +1,100 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_FRAMEWORK_TRACE_SERVICE_H_
+#define CELIX_FRAMEWORK_TRACE_SERVICE_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "celix_errno.h"
+#include "celix_array_list.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief The framework trace service name.
+ *
+ * The framework trace service is registered by the framework bundle if tracing is enabled
+ * (see CELIX_FRAMEWORK_TRACE_ENABLED).
+ */
+#define CELIX_FRAMEWORK_TRACE_SERVICE_NAME "celix_framework_trace_service"
+#define CELIX_FRAMEWORK_TRACE_SERVICE_VERSION "1.0.0"
+
+typedef enum celix_framework_trace_event_type {
+    CELIX_FRAMEWORK_TRACE_INSTALL_BUNDLE        = 0, //fw_installBundle2, including the creation of the bundle archive
+    CELIX_FRAMEWORK_TRACE_LOAD_BUNDLE_LIBRARIES = 1, //loading the bundle libraries during resolving
+    CELIX_FRAMEWORK_TRACE_ACTIVATOR_CREATE      = 2, //the bundle activator create call
+    CELIX_FRAMEWORK_TRACE_ACTIVATOR_START       = 3, //the bundle activator start call
+    CELIX_FRAMEWORK_TRACE_START_BUNDLE          = 4, //the complete bundle start, including resolving and activation
+    CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT      = 5  //time an event waited in the event queue before being handled
+} celix_framework_trace_event_type_e;
+
+/**
+ * @brief A single trace entry. Times are in nanoseconds relative to the creation of the framework.
+ */
+typedef struct celix_framework_trace_entry {
+    celix_framework_trace_event_type_e type;
+    long bndId;
+    char bndSymbolicName[64]; //can be truncated, empty for event queue wait entries
+    long threadId;
+    uint64_t startTimeInNs;
+    uint64_t durationInNs;
+} celix_framework_trace_entry_t;
+
+/**
+ * @brief Service to access the startup and lifecycle trace of the framework.
+ *
+ * The trace entries are recorded in a fixed size ring (see CELIX_FRAMEWORK_TRACE_BUFFER_SIZE), so when the ring is
+ * full the oldest entries are overwritten.
+ */
+typedef struct celix_framework_trace_service {
+    void *handle;
+
+    /**
+     * @brief Returns the recorded trace entries in recording order.
+     *
+     * The caller is owner of the returned list and the (malloc'ed) celix_framework_trace_entry_t* entries.
+     */
+    celix_array_list_t* (*getEntries)(void *handle);
+
+    /**
+     * @brief Writes the recorded trace entries as Chrome trace-event JSON, which can be loaded in a trace viewer
+     * (e.g. chrome://tracing or Perfetto).
+     */
+    celix_status_t (*writeChromeTrace)(void *handle, FILE *stream);
+
+    /**
+     * @brief Clears the recorded trace entries.
+     */
+    void (*clear)(void *handle);
+} celix_framework_trace_service_t;
+
+/**
+ * @brief Returns a description of the trace event type.
+ */
+const char* celix_frameworkTrace_eventTypeToString(celix_framework_trace_event_type_e type);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_FRAMEWORK_TRACE_SERVICE_H_ */
@@ -27,6 +27,8 @@
 #ifndef MANIFEST_H_
 #define MANIFEST_H_
 
+#include <stdio.h>
+
 #include "properties.h"
 #include "celix_errno.h"
 #include "framework_exports.h"
@@ -46,6 +48,8 @@ FRAMEWORK_EXPORT celix_status_t manifest_create(manifest_pt *manifest);
 
 FRAMEWORK_EXPORT celix_status_t manifest_createFromFile(const char *filename, manifest_pt *manifest);
 
+FRAMEWORK_EXPORT celix_status_t manifest_createFromStream(FILE *stream, manifest_pt *manifest);
+
 FRAMEWORK_EXPORT celix_status_t manifest_destroy(manifest_pt manifest);
 
 FRAMEWORK_EXPORT void manifest_clear(manifest_pt manifest);
@@ -56,6 +60,8 @@ FRAMEWORK_EXPORT celix_status_t manifest_getEntries(manifest_pt manifest, hash_m
 
 FRAMEWORK_EXPORT celix_status_t manifest_read(manifest_pt manifest, const char *filename);
 
+FRAMEWORK_EXPORT celix_status_t manifest_readFromStream(manifest_pt manifest, FILE *stream);
+
 FRAMEWORK_EXPORT void manifest_write(manifest_pt manifest, const char *filename);
 
 FRAMEWORK_EXPORT const char *manifest_getValue(manifest_pt manifest, const char *name);
@@ -43,6 +43,8 @@ celix_status_t bundle_create(bundle_pt * bundle) {
 	if (*bundle == NULL) {
 		return CELIX_ENOMEM;
 	}
+	celixThreadMutex_create(&(*bundle)->serviceReferencesMutex, NULL);
+	(*bundle)->serviceReferences = celix_longHashMap_create();
 	status = bundleArchive_createSystemBundleArchive(&archive);
 	if (status == CELIX_SUCCESS) {
         module_pt module;
@@ -84,6 +86,8 @@ celix_status_t bundle_createFromArchive(bundle_pt * bundle, framework_pt framewo
 	(*bundle)->state = OSGI_FRAMEWORK_BUNDLE_INSTALLED;
 	(*bundle)->modules = NULL;
 	arrayList_create(&(*bundle)->modules);
+	celixThreadMutex_create(&(*bundle)->serviceReferencesMutex, NULL);
+	(*bundle)->serviceReferences = celix_longHashMap_create();
 	
 	status = bundle_createModule(*bundle, &module);
 	if (status == CELIX_SUCCESS) {
@@ -106,6 +110,13 @@ celix_status_t bundle_destroy(bundle_pt bundle) {
 	arrayListIterator_destroy(iter);
 	arrayList_destroy(bundle->modules);
 
+	if (celix_longHashMap_size(bundle->serviceReferences) > 0) {
+	    fw_log(celix_frameworkLogger_globalLogger(), CELIX_LOG_LEVEL_ERROR, "Unexpected service references left for bundle %s. Nr of references: %zu",
+	           bundle->symbolicName == NULL ? "unknown" : bundle->symbolicName, celix_longHashMap_size(bundle->serviceReferences));
+	}
+	celix_longHashMap_destroy(bundle->serviceReferences);
+	celixThreadMutex_destroy(&bundle->serviceReferencesMutex);
+
 	free(bundle->symbolicName);
 	free(bundle);
 
@@ -627,9 +638,8 @@ void celix_bundle_destroyRegisteredServicesList(celix_array_list_t* list) {
 celix_array_list_t* celix_bundle_listServiceTrackers(const celix_bundle_t *bnd) {
     celix_array_list_t* result = celix_arrayList_create();
     celixThreadMutex_lock(&bnd->context->mutex);
-    hash_map_iterator_t iter = hashMapIterator_construct(bnd->context->serviceTrackers);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_bundle_context_service_tracker_entry_t *trkEntry = hashMapIterator_nextValue(&iter);
+    CELIX_LONG_HASH_MAP_ITERATE(bnd->context->serviceTrackers, iter) {
+        celix_bundle_context_service_tracker_entry_t *trkEntry = iter.value.ptrValue;
         if (trkEntry->tracker != NULL) {
             celix_bundle_service_tracker_list_entry_t *entry = calloc(1, sizeof(*entry));
             entry->filter = celix_utils_strdup(trkEntry->tracker->filter);
@@ -37,6 +37,8 @@ struct bundleArchive {
 	char * location;
 	DIR *archiveRootDir;
 	char * archiveRoot;
+	char * contentCacheDir; //optional, see celix_bundle_revision_options_t
+	bool loadFromZip; //see celix_bundle_revision_options_t
 	linked_list_pt revisions;
 	long refreshCount;
 	time_t lastModified;
@@ -95,6 +97,10 @@ celix_status_t bundleArchive_createSystemBundleArchive(bundle_archive_pt *bundle
 }
 
 celix_status_t bundleArchive_create(const char *archiveRoot, long id, const char * location, const char *inputFile, bundle_archive_pt *bundle_archive) {
+	return bundleArchive_createWithOptions(archiveRoot, NULL, id, location, inputFile, bundle_archive);
+}
+
+celix_status_t bundleArchive_createWithOptions(const char *archiveRoot, const celix_bundle_revision_options_t *opts, long id, const char * location, const char *inputFile, bundle_archive_pt *bundle_archive) {
 	celix_status_t status = CELIX_SUCCESS;
 	char *error = NULL;
 	bundle_archive_pt archive = NULL;
@@ -113,6 +119,8 @@ celix_status_t bundleArchive_create(const char *archiveRoot, long id, const char
 				archive->location = strdup(location);
 				archive->archiveRootDir = NULL;
 				archive->archiveRoot = strdup(archiveRoot);
+				archive->contentCacheDir = opts != NULL && opts->contentCacheDir != NULL ? strdup(opts->contentCacheDir) : NULL;
+				archive->loadFromZip = opts != NULL && opts->loadFromZip;
 				archive->refreshCount = -1;
 				time(&archive->lastModified);
 
@@ -159,6 +167,7 @@ celix_status_t bundleArchive_destroy(bundle_archive_pt archive) {
 		if (archive->location != NULL) {
 			free(archive->location);
 		}
+		free(archive->contentCacheDir);
 
 		free(archive);
 		archive = NULL;
@@ -170,6 +179,10 @@ celix_status_t bundleArchive_destroy(bundle_archive_pt archive) {
 }
 
 celix_status_t bundleArchive_recreate(const char * archiveRoot, bundle_archive_pt *bundle_archive) {
+	return bundleArchive_recreateWithOptions(archiveRoot, NULL, bundle_archive);
+}
+
+celix_status_t bundleArchive_recreateWithOptions(const char * archiveRoot, const celix_bundle_revision_options_t *opts, bundle_archive_pt *bundle_archive) {
 	celix_status_t status = CELIX_SUCCESS;
 
 	bundle_archive_pt archive = NULL;
@@ -181,6 +194,8 @@ celix_status_t bundleArchive_recreate(const char * archiveRoot, bundle_archive_p
 		status = linkedList_create(&archive->revisions);
 		if (status == CELIX_SUCCESS) {
 			archive->archiveRoot = strdup(archiveRoot);
+			archive->contentCacheDir = opts != NULL && opts->contentCacheDir != NULL ? strdup(opts->contentCacheDir) : NULL;
+			archive->loadFromZip = opts != NULL && opts->loadFromZip;
 			archive->archiveRootDir = NULL;
 			archive->id = -1;
 			archive->persistentState = -1;
@@ -597,7 +612,8 @@ static celix_status_t bundleArchive_createRevisionFromLocation(bundle_archive_pt
 		bundle_revision_pt revision = NULL;
 
 		sprintf(root, "%s/version%ld.%ld", archive->archiveRoot, refreshCount, revNr);
-		status = bundleRevision_create(root, location, revNr, inputFile, &revision);
+		celix_bundle_revision_options_t opts = {.contentCacheDir = archive->contentCacheDir, .loadFromZip = archive->loadFromZip};
+		status = bundleRevision_createWithOptions(root, &opts, location, revNr, inputFile, &revision);
 
 		if (status == CELIX_SUCCESS) {
 			*bundle_revision = revision;
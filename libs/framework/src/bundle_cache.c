@@ -60,6 +60,9 @@ celix_status_t bundleCache_create(const char *fwUUID, celix_properties_t *config
 		const char* cacheDir = celix_properties_get(configurationMap, OSGI_FRAMEWORK_FRAMEWORK_STORAGE, ".cache");
 		bool useTmpDir = celix_properties_getAsBool(configurationMap, OSGI_FRAMEWORK_STORAGE_USE_TMP_DIR, false);
 		cache->configurationMap = configurationMap;
+		const char* contentCacheDir = celix_properties_get(configurationMap, CELIX_FRAMEWORK_CONTENT_CACHE_DIR, NULL);
+		cache->contentCacheDir = contentCacheDir != NULL ? strdup(contentCacheDir) : NULL;
+		cache->loadFromZip = celix_properties_getAsBool(configurationMap, CELIX_LOAD_BUNDLES_FROM_ZIP, false);
 		if (cacheDir == NULL || useTmpDir) {
 			//Using /tmp dir for cache, so that multiple frameworks can be launched
 			//instead of cacheDir = ".cache";
@@ -92,6 +95,7 @@ celix_status_t bundleCache_destroy(bundle_cache_pt *cache) {
 		bundleCache_delete(*cache);
 	}
 	free((*cache)->cacheDir);
+	free((*cache)->contentCacheDir);
 	free(*cache);
 	*cache = NULL;
 
@@ -137,7 +141,8 @@ celix_status_t bundleCache_getArchives(bundle_cache_pt cache, array_list_pt *arc
 						&& (strcmp(dent->d_name, "bundle0") != 0)) {
 
 					bundle_archive_pt archive = NULL;
-					status = bundleArchive_recreate(archiveRoot, &archive);
+					celix_bundle_revision_options_t opts = {.contentCacheDir = cache->contentCacheDir, .loadFromZip = cache->loadFromZip};
+					status = bundleArchive_recreateWithOptions(archiveRoot, &opts, &archive);
 					if (status == CELIX_SUCCESS) {
 						arrayList_add(list, archive);
 					}
@@ -187,7 +192,8 @@ celix_status_t bundleCache_createArchive(bundle_cache_pt cache, long id, const c
 
 	if (cache && location) {
 		snprintf(archiveRoot, sizeof(archiveRoot), "%s/bundle%ld",  cache->cacheDir, id);
-		status = bundleArchive_create(archiveRoot, id, location, inputFile, bundle_archive);
+		celix_bundle_revision_options_t opts = {.contentCacheDir = cache->contentCacheDir, .loadFromZip = cache->loadFromZip};
+		status = bundleArchive_createWithOptions(archiveRoot, &opts, id, location, inputFile, bundle_archive);
 	}
 
 	framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Failed to create archive");
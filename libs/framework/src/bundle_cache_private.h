@@ -33,6 +33,8 @@
 struct bundleCache {
 	properties_pt configurationMap;
 	char * cacheDir;
+	char * contentCacheDir; //optional, see CELIX_FRAMEWORK_CONTENT_CACHE_DIR
+	bool loadFromZip; //see CELIX_LOAD_BUNDLES_FROM_ZIP
 	bool deleteOnDestroy;
 };
 
@@ -46,6 +46,7 @@ static void bundleContext_cleanupServiceTrackers(bundle_context_t *ctx);
 static void bundleContext_cleanupServiceTrackerTrackers(bundle_context_t *ctx);
 static void bundleContext_cleanupServiceRegistration(bundle_context_t* ctx);
 static long celix_bundleContext_trackServicesWithOptionsInternal(celix_bundle_context_t *ctx, const celix_service_tracking_options_t *opts, bool async);
+static bool celix_bundleContext_useServiceWithOptionsInternal(celix_bundle_context_t *ctx, const celix_service_use_options_t *opts, bool cacheTracker);
 
 celix_status_t bundleContext_create(framework_pt framework, celix_framework_logger_t*  logger, bundle_pt bundle, bundle_context_pt *bundle_context) {
 	celix_status_t status = CELIX_SUCCESS;
@@ -65,12 +66,18 @@ celix_status_t bundleContext_create(framework_pt framework, celix_framework_logg
             celixThreadMutex_create(&context->mutex, NULL);
 
             context->svcRegistrations = celix_arrayList_create();
-            context->bundleTrackers = hashMap_create(NULL,NULL,NULL,NULL);
-            context->serviceTrackers = hashMap_create(NULL,NULL,NULL,NULL);
-            context->metaTrackers =  hashMap_create(NULL,NULL,NULL,NULL);
-            context->stoppingTrackerEventIds = hashMap_create(NULL,NULL,NULL,NULL);
+            context->bundleTrackers = celix_longHashMap_create();
+            context->serviceTrackers = celix_longHashMap_create();
+            context->metaTrackers = celix_longHashMap_create();
+            context->stoppingTrackerEventIds = celix_longHashMap_create();
             context->nextTrackerId = 1L;
 
+            celixThreadMutex_create(&context->useTrackers.mutex, NULL);
+            celix_string_hash_map_create_options_t useTrackerOpts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+            useTrackerOpts.storeKeysWeakly = true; //note key is owned by the entry
+            context->useTrackers.entries = celix_stringHashMap_createWithOptions(&useTrackerOpts);
+            context->useTrackers.lastEvictCheck = celix_gettime(CLOCK_MONOTONIC);
+
             *bundle_context = context;
 
         }
@@ -85,15 +92,18 @@ celix_status_t bundleContext_destroy(bundle_context_pt context) {
 	celix_status_t status = CELIX_SUCCESS;
 
 	if (context != NULL) {
-	    assert(hashMap_size(context->bundleTrackers) == 0);
-        hashMap_destroy(context->bundleTrackers, false, false);
-        assert(hashMap_size(context->serviceTrackers) == 0);
-        hashMap_destroy(context->serviceTrackers, false, false);
-        assert(hashMap_size(context->metaTrackers) == 0);
-        hashMap_destroy(context->metaTrackers, false, false);
+	    assert(celix_longHashMap_size(context->bundleTrackers) == 0);
+        celix_longHashMap_destroy(context->bundleTrackers);
+        assert(celix_longHashMap_size(context->serviceTrackers) == 0);
+        celix_longHashMap_destroy(context->serviceTrackers);
+        assert(celix_longHashMap_size(context->metaTrackers) == 0);
+        celix_longHashMap_destroy(context->metaTrackers);
         assert(celix_arrayList_size(context->svcRegistrations) == 0);
         celix_arrayList_destroy(context->svcRegistrations);
-        hashMap_destroy(context->stoppingTrackerEventIds, false, false);
+        celix_longHashMap_destroy(context->stoppingTrackerEventIds);
+        assert(celix_stringHashMap_size(context->useTrackers.entries) == 0);
+        celix_stringHashMap_destroy(context->useTrackers.entries);
+        celixThreadMutex_destroy(&context->useTrackers.mutex);
 
 	    celixThreadMutex_destroy(&context->mutex);
 
@@ -116,6 +126,7 @@ celix_status_t bundleContext_destroy(bundle_context_pt context) {
 void celix_bundleContext_cleanup(celix_bundle_context_t *ctx) {
     //NOTE not perfect, because stopping of registrations/tracker when the activator is destroyed can lead to segfault.
     //but at least we can try to warn the bundle implementer that some cleanup is missing.
+    celix_bundleContext_cleanupUseTrackers(ctx);
     bundleContext_cleanupBundleTrackers(ctx);
     bundleContext_cleanupServiceTrackers(ctx);
     bundleContext_cleanupServiceTrackerTrackers(ctx);
@@ -504,7 +515,7 @@ static long celix_bundleContext_registerServiceWithOptionsInternal(bundle_contex
     }
 
     long svcId = -1;
-    if (!async && celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+    if (!async && celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, celix_bundle_getId(ctx->bundle))) {
         /*
          * Note already on event loop, cannot register the service async, because we cannot wait a future event (the
          * service registration) the event loop.
@@ -570,7 +581,7 @@ static void celix_bundleContext_unregisterServiceInternal(celix_bundle_context_t
         if (found >= 0) {
             if (async) {
                 celix_framework_unregisterAsync(ctx->framework, ctx->bundle, found, data, done);
-            } else if (celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+            } else if (celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, celix_bundle_getId(ctx->bundle))) {
                 /*
                  * sync unregistration.
                  * Note already on event loop, cannot unregister the service async, because we cannot wait a future event (the
@@ -659,7 +670,7 @@ static celix_status_t bundleContext_bundleChanged(void *listenerSvc, bundle_even
 
 void celix_bundleContext_trackBundlesWithOptionsCallback(void *data) {
     celix_bundle_context_bundle_tracker_entry_t* entry = data;
-    assert(celix_framework_isCurrentThreadTheEventLoop(entry->ctx->framework));
+    assert(celix_framework_isCurrentThreadTheEventLoopForBnd(entry->ctx->framework, celix_bundle_getId(entry->ctx->bundle)));
     celixThreadMutex_lock(&entry->ctx->mutex);
     bool cancelled = entry->cancelled;
     entry->created = true;
@@ -690,7 +701,7 @@ static long celix_bundleContext_trackBundlesWithOptionsInternal(
 
     celixThreadMutex_lock(&ctx->mutex);
     entry->trackerId = ctx->nextTrackerId++;
-    hashMap_put(ctx->bundleTrackers, (void*)(entry->trackerId), entry);
+    celix_longHashMap_put(ctx->bundleTrackers, entry->trackerId, entry);
     trackerId = entry->trackerId;
     celixThreadMutex_unlock(&ctx->mutex);
 
@@ -776,9 +787,8 @@ static void bundleContext_cleanupBundleTrackers(bundle_context_t *ctx) {
     celix_array_list_t* danglingTrkIds = NULL;
 
     celixThreadMutex_lock(&ctx->mutex);
-    hash_map_iterator_t iter = hashMapIterator_construct(ctx->bundleTrackers);
-    while (hashMapIterator_hasNext(&iter)) {
-        long trkId = (long)hashMapIterator_nextKey(&iter);
+    CELIX_LONG_HASH_MAP_ITERATE(ctx->bundleTrackers, iter) {
+        long trkId = iter.key;
         fw_log(ctx->framework->logger, CELIX_LOG_LEVEL_ERROR, "Dangling bundle tracker with id %li for bundle %s. Add missing 'celix_bundleContext_stopTracker' calls.", trkId, symbolicName);
         if (danglingTrkIds == NULL) {
             danglingTrkIds = celix_arrayList_create();
@@ -805,10 +815,9 @@ static void bundleContext_cleanupServiceTrackers(bundle_context_t *ctx) {
     celix_array_list_t* danglingTrkIds = NULL;
 
     celixThreadMutex_lock(&ctx->mutex);
-    hash_map_iterator_t iter = hashMapIterator_construct(ctx->serviceTrackers);
-    while (hashMapIterator_hasNext(&iter)) {
-        long trkId = (long)hashMapIterator_nextKey(&iter);
-        celix_bundle_context_service_tracker_entry_t* entry = hashMap_get(ctx->serviceTrackers, (void*)trkId);
+    CELIX_LONG_HASH_MAP_ITERATE(ctx->serviceTrackers, iter) {
+        long trkId = iter.key;
+        celix_bundle_context_service_tracker_entry_t* entry = iter.value.ptrValue;
         fw_log(ctx->framework->logger, CELIX_LOG_LEVEL_ERROR, "Dangling service tracker with trkId %li, for bundle %s and with filter %s. Add missing 'celix_bundleContext_stopTracker' calls.", trkId, symbolicName, entry->tracker->filter);
         if (danglingTrkIds == NULL) {
             danglingTrkIds = celix_arrayList_create();
@@ -835,10 +844,9 @@ static void bundleContext_cleanupServiceTrackerTrackers(bundle_context_t *ctx) {
     celix_array_list_t* danglingTrkIds = NULL;
 
     celixThreadMutex_lock(&ctx->mutex);
-    hash_map_iterator_t iter = hashMapIterator_construct(ctx->metaTrackers);
-    while (hashMapIterator_hasNext(&iter)) {
-        long trkId = (long)hashMapIterator_nextKey(&iter);
-        celix_bundle_context_service_tracker_tracker_entry_t *entry = hashMap_get(ctx->metaTrackers, (void*)trkId);
+    CELIX_LONG_HASH_MAP_ITERATE(ctx->metaTrackers, iter) {
+        long trkId = iter.key;
+        celix_bundle_context_service_tracker_tracker_entry_t *entry = iter.value.ptrValue;
         fw_log(ctx->framework->logger, CELIX_LOG_LEVEL_ERROR, "Dangling meta tracker (service tracker tracker) with trkId %li, for bundle %s and for the services %s. Add missing 'celix_bundleContext_stopTracker' calls.", trkId, symbolicName, entry->serviceName);
         if (danglingTrkIds == NULL) {
             danglingTrkIds = celix_arrayList_create();
@@ -888,7 +896,7 @@ static void celix_bundleContext_removeBundleTracker(void *data) {
     celix_bundle_context_bundle_tracker_entry_t *tracker = data;
     fw_removeBundleListener(tracker->ctx->framework, tracker->ctx->bundle, &tracker->listener);
     celixThreadMutex_lock(&tracker->ctx->mutex);
-    hashMap_remove(tracker->ctx->stoppingTrackerEventIds, (void*)tracker->trackerId);
+    celix_longHashMap_remove(tracker->ctx->stoppingTrackerEventIds, tracker->trackerId);
     celixThreadMutex_unlock(&tracker->ctx->mutex);
     free(tracker);
 }
@@ -897,7 +905,7 @@ static void celix_bundleContext_removeServiceTracker(void *data) {
     celix_bundle_context_service_tracker_entry_t *tracker = data;
     celix_serviceTracker_destroy(tracker->tracker);
     celixThreadMutex_lock(&tracker->ctx->mutex);
-    hashMap_remove(tracker->ctx->stoppingTrackerEventIds, (void*)tracker->trackerId);
+    celix_longHashMap_remove(tracker->ctx->stoppingTrackerEventIds, tracker->trackerId);
     celixThreadMutex_unlock(&tracker->ctx->mutex);
     free(tracker);
 }
@@ -906,7 +914,7 @@ static void celix_bundleContext_removeServiceTrackerTracker(void *data) {
     celix_bundle_context_service_tracker_tracker_entry_t *tracker = data;
     celix_framework_unregister(tracker->ctx->framework, tracker->ctx->bundle, tracker->serviceId);
     celixThreadMutex_lock(&tracker->ctx->mutex);
-    hashMap_remove(tracker->ctx->stoppingTrackerEventIds, (void*)tracker->trackerId);
+    celix_longHashMap_remove(tracker->ctx->stoppingTrackerEventIds, tracker->trackerId);
     celixThreadMutex_unlock(&tracker->ctx->mutex);
     free(tracker->serviceName);
     free(tracker);
@@ -925,32 +933,35 @@ static void celix_bundleContext_stopTrackerInternal(bundle_context_t *ctx, long
 
     celixThreadMutex_lock(&ctx->mutex);
 
-    if (hashMap_containsKey(ctx->bundleTrackers, (void *) trackerId)) {
+    if (celix_longHashMap_hasKey(ctx->bundleTrackers, trackerId)) {
         found = true;
-        bundleTracker = hashMap_remove(ctx->bundleTrackers, (void *) trackerId);
+        bundleTracker = celix_longHashMap_get(ctx->bundleTrackers, trackerId);
+        celix_longHashMap_remove(ctx->bundleTrackers, trackerId);
         if (!bundleTracker->created && !async) {
             //note tracker not yet created, so cancel instead of removing
             bundleTracker->cancelled = true;
             cancelled = true;
         }
-    } else if (hashMap_containsKey(ctx->serviceTrackers, (void *) trackerId)) {
+    } else if (celix_longHashMap_hasKey(ctx->serviceTrackers, trackerId)) {
         found = true;
-        serviceTracker = hashMap_remove(ctx->serviceTrackers, (void *) trackerId);
+        serviceTracker = celix_longHashMap_get(ctx->serviceTrackers, trackerId);
+        celix_longHashMap_remove(ctx->serviceTrackers, trackerId);
         if (serviceTracker->tracker == NULL && !async) {
             //note tracker not yet created, so cancel instead of removing
             serviceTracker->cancelled = true;
             cancelled = true;
         }
-    } else if (hashMap_containsKey(ctx->metaTrackers, (void *) trackerId)) {
+    } else if (celix_longHashMap_hasKey(ctx->metaTrackers, trackerId)) {
         found = true;
-        svcTrackerTracker = hashMap_remove(ctx->metaTrackers, (void *) trackerId);
+        svcTrackerTracker = celix_longHashMap_get(ctx->metaTrackers, trackerId);
+        celix_longHashMap_remove(ctx->metaTrackers, trackerId);
         //note because a meta tracker is a service listener hook under waiter, no additional cancel is needed (svc reg will be cancelled)
     }
 
     if (found && cancelled) {
         //nop
         celixThreadMutex_unlock(&ctx->mutex);
-    } else if (found && !async && celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+    } else if (found && !async && celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, celix_bundle_getId(ctx->bundle))) {
         //already on the event loop, stop tracker "traditionally" to keep old behavior
         celixThreadMutex_unlock(&ctx->mutex); //note calling remove/stops/unregister out side of locks
 
@@ -972,7 +983,7 @@ static void celix_bundleContext_stopTrackerInternal(bundle_context_t *ctx, long
     } else if (found && async) {
         //NOTE: for async stopping of tracking we need to ensure we cant wait for the tracker destroy id event.
         long eventId = celix_framework_nextEventId(ctx->framework);
-        hashMap_put(ctx->stoppingTrackerEventIds, (void*)trackerId, (void*)eventId);
+        celix_longHashMap_putLong(ctx->stoppingTrackerEventIds, trackerId, eventId);
 
         if (bundleTracker != NULL) {
             celix_framework_fireGenericEvent(ctx->framework, eventId, celix_bundle_getId(ctx->bundle), "stop tracker", bundleTracker, celix_bundleContext_removeBundleTracker, doneData, doneCallback);
@@ -1024,25 +1035,25 @@ static void celix_bundleContext_waitForTrackerInternal(celix_bundle_context_t* c
 
     if (waitForStart) {
         celixThreadMutex_lock(&ctx->mutex);
-        if (hashMap_containsKey(ctx->bundleTrackers, (void *) trackerId)) {
+        if (celix_longHashMap_hasKey(ctx->bundleTrackers, trackerId)) {
             found = true;
-            celix_bundle_context_bundle_tracker_entry_t* bundleTracker = hashMap_get(ctx->bundleTrackers, (void *) trackerId);
+            celix_bundle_context_bundle_tracker_entry_t* bundleTracker = celix_longHashMap_get(ctx->bundleTrackers, trackerId);
             eventId = bundleTracker->createEventId;
-        } else if (hashMap_containsKey(ctx->serviceTrackers, (void *) trackerId)) {
+        } else if (celix_longHashMap_hasKey(ctx->serviceTrackers, trackerId)) {
             found = true;
-            celix_bundle_context_service_tracker_entry_t* serviceTracker = hashMap_get(ctx->serviceTrackers, (void *) trackerId);
+            celix_bundle_context_service_tracker_entry_t* serviceTracker = celix_longHashMap_get(ctx->serviceTrackers, trackerId);
             eventId = serviceTracker->createEventId;
-        } else if (hashMap_containsKey(ctx->metaTrackers, (void *) trackerId)) {
+        } else if (celix_longHashMap_hasKey(ctx->metaTrackers, trackerId)) {
             found = true;
-            celix_bundle_context_service_tracker_tracker_entry_t* svcTrackerTracker = hashMap_get(ctx->metaTrackers, (void *) trackerId);
+            celix_bundle_context_service_tracker_tracker_entry_t* svcTrackerTracker = celix_longHashMap_get(ctx->metaTrackers, trackerId);
             svcId = svcTrackerTracker->serviceId;
         }
         celixThreadMutex_unlock(&ctx->mutex);
     } else {
         celixThreadMutex_lock(&ctx->mutex);
-        if (hashMap_containsKey(ctx->stoppingTrackerEventIds, (void*)trackerId)) {
+        if (celix_longHashMap_hasKey(ctx->stoppingTrackerEventIds, trackerId)) {
             found = true;
-            eventId = (long)hashMap_get(ctx->stoppingTrackerEventIds, (void*)trackerId);
+            eventId = celix_longHashMap_getLong(ctx->stoppingTrackerEventIds, trackerId, -1);
         }
         celixThreadMutex_unlock(&ctx->mutex);
     }
@@ -1121,7 +1132,8 @@ bool celix_bundleContext_useServiceWithId(
     opts.filter.filter = filter;
     opts.callbackHandle = callbackHandle;
     opts.use = use;
-    return celix_bundleContext_useServiceWithOptions(ctx, &opts);
+    //note not caching the use service tracker, a tracker per service id would only be used for a single service
+    return celix_bundleContext_useServiceWithOptionsInternal(ctx, &opts, false);
 }
 
 bool celix_bundleContext_useService(
@@ -1149,125 +1161,322 @@ size_t celix_bundleContext_useServices(
     return celix_bundleContext_useServicesWithOptions(ctx, &opts);
 }
 
-typedef struct celix_bundle_context_use_service_data {
-    celix_bundle_context_t* ctx;
-    celix_service_use_options_t opts;
-
-    celix_thread_mutex_t mutex; //protects below
-    bool called;
-    size_t count;
-    celix_service_tracker_t * svcTracker;
-} celix_bundle_context_use_service_data_t;
+/**
+ * Creates the key for the use service tracker cache. The key is written in buf if it fits, otherwise it is allocated
+ * and should be freed by the caller.
+ */
+static char* celix_bundleContext_createUseTrackerKey(const celix_service_filter_options_t* filter, char* buf, size_t bufSize) {
+    const char* serviceName = filter->serviceName == NULL ? "" : filter->serviceName;
+    const char* versionRange = filter->versionRange == NULL ? "" : filter->versionRange;
+    const char* additionalFilter = filter->filter == NULL ? "" : filter->filter;
+    const char* serviceLanguage = filter->serviceLanguage == NULL ? "" : filter->serviceLanguage;
+    int ignoreServiceLanguage = filter->ignoreServiceLanguage ? 1 : 0;
+    int len = snprintf(buf, bufSize, "%s\x1f%s\x1f%s\x1f%s\x1f%i", serviceName, versionRange, additionalFilter, serviceLanguage, ignoreServiceLanguage);
+    if (len >= 0 && (size_t)len < bufSize) {
+        return buf;
+    }
+    char* key = NULL;
+    asprintf(&key, "%s\x1f%s\x1f%s\x1f%s\x1f%i", serviceName, versionRange, additionalFilter, serviceLanguage, ignoreServiceLanguage);
+    return key;
+}
+
+typedef struct celix_bundle_context_create_use_tracker_data {
+    celix_bundle_context_use_tracker_entry_t* entry;
+    const celix_service_filter_options_t* filter;
+} celix_bundle_context_create_use_tracker_data_t;
+
+static void celix_bundleContext_destroyUseTrackerOnEventLoop(void *data) {
+    celix_bundle_context_use_tracker_entry_t* entry = data;
+    celix_serviceTracker_destroy(entry->tracker);
+    free(entry->key);
+    free(entry);
+}
+
+/**
+ * Called when a service is removed from a use service tracker. Removes the tracker from the cache, so that cached
+ * trackers do not outlive the services they are created for; the tracker is destroyed when it is no longer in use.
+ */
+static void celix_bundleContext_useTrackerServiceRemoved(void *handle, void *svc __attribute__((unused))) {
+    celix_bundle_context_use_tracker_entry_t* entry = handle;
+    celix_bundle_context_t* ctx = entry->ctx;
+    bool destroy = false;
+    celixThreadMutex_lock(&ctx->useTrackers.mutex);
+    if (entry->key != NULL && !entry->detached && celix_stringHashMap_get(ctx->useTrackers.entries, entry->key) == entry) {
+        celix_stringHashMap_remove(ctx->useTrackers.entries, entry->key);
+        entry->uncached = true;
+        destroy = entry->useCount == 0;
+    }
+    celixThreadMutex_unlock(&ctx->useTrackers.mutex);
+    if (destroy) {
+        //note called by the tracker, so always destroying the tracker using a event
+        celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "destroy use service tracker", entry, celix_bundleContext_destroyUseTrackerOnEventLoop, NULL, NULL);
+    }
+}
 
-static void celix_bundleContext_useServiceWithOptions_1_CreateServiceTracker(void *data) {
-    celix_bundle_context_use_service_data_t* d = data;
-    assert(celix_framework_isCurrentThreadTheEventLoop(d->ctx->framework));
+static void celix_bundleContext_createUseTrackerOnEventLoop(void *data) {
+    celix_bundle_context_create_use_tracker_data_t* d = data;
+    celix_bundle_context_t* ctx = d->entry->ctx;
+    assert(celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, celix_bundle_getId(ctx->bundle)));
 
     celix_service_tracking_options_t trkOpts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
-    trkOpts.filter.serviceName = d->opts.filter.serviceName;
-    trkOpts.filter = d->opts.filter;
-    trkOpts.filter.versionRange = d->opts.filter.versionRange;
-    trkOpts.filter.serviceLanguage = d->opts.filter.serviceLanguage;
-
-    celixThreadMutex_lock(&d->mutex);
-    d->svcTracker = celix_serviceTracker_createWithOptions(d->ctx, &trkOpts);
-    celixThreadMutex_unlock(&d->mutex);
+    trkOpts.filter = *d->filter;
+    trkOpts.callbackHandle = d->entry;
+    trkOpts.remove = celix_bundleContext_useTrackerServiceRemoved;
+    d->entry->tracker = celix_serviceTracker_createWithOptions(ctx, &trkOpts);
 }
 
-static void celix_bundleContext_useServiceWithOptions_2_UseService(void *data) {
-    celix_bundle_context_use_service_data_t* d = data;
-    assert(celix_framework_isCurrentThreadTheEventLoop(d->ctx->framework));
-
-    celixThreadMutex_lock(&d->mutex);
-    celix_service_tracker_t *tracker = d->svcTracker;
-    d->svcTracker = NULL;
-    celixThreadMutex_unlock(&d->mutex);
-
-    bool called = celix_serviceTracker_useHighestRankingService(tracker, d->opts.filter.serviceName, d->opts.callbackHandle, d->opts.use, d->opts.useWithProperties, d->opts.useWithOwner);
-    celix_serviceTracker_destroy(tracker);
+/**
+ * Destroys the tracker of a use service tracker entry and frees the entry.
+ * The entry is freed after the tracker is destroyed, because the entry is the callback handle of the tracker.
+ */
+static void celix_bundleContext_destroyUseTracker(celix_bundle_context_t* ctx, celix_bundle_context_use_tracker_entry_t* entry, bool wait) {
+    if (celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, celix_bundle_getId(ctx->bundle))) {
+        celix_bundleContext_destroyUseTrackerOnEventLoop(entry);
+    } else {
+        long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "destroy use service tracker", entry, celix_bundleContext_destroyUseTrackerOnEventLoop, NULL, NULL);
+        if (wait) {
+            celix_framework_waitForGenericEvent(ctx->framework, eventId);
+        }
+    }
+}
 
-    celixThreadMutex_lock(&d->mutex);
-    d->called = called;
-    celixThreadMutex_unlock(&d->mutex);
+/**
+ * Waits until the events queued in the event loop of the context bundle before this call are handled, so that
+ * (async) service registrations made before the use call or triggered by creating a use service tracker are visible.
+ * Only fires an event if there are pending events (of any bundle) on that event loop and if not called from the event loop.
+ */
+static void celix_bundleContext_flushUseTrackerEvents(celix_bundle_context_t* ctx) {
+    long bndId = celix_bundle_getId(ctx->bundle);
+    if (celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, bndId) || !celix_framework_hasPendingEventsOnLoopOfBnd(ctx->framework, bndId)) {
+        return;
+    }
+    long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, bndId, "flush use service", NULL, NULL, NULL, NULL);
+    celix_framework_waitForGenericEvent(ctx->framework, eventId);
 }
 
-bool celix_bundleContext_useServiceWithOptions(
-        celix_bundle_context_t *ctx,
-        const celix_service_use_options_t *opts) {
-    if (opts == NULL) {
-        return false;
+/**
+ * Creates a use service tracker entry with a tracker for the provided filter options. The tracker is created on the
+ * event loop. Returns NULL if the tracker could not be created.
+ */
+static celix_bundle_context_use_tracker_entry_t* celix_bundleContext_createUseTracker(celix_bundle_context_t* ctx, const celix_service_filter_options_t* filter) {
+    celix_bundle_context_use_tracker_entry_t* entry = calloc(1, sizeof(*entry));
+    entry->ctx = ctx;
+    celix_bundle_context_create_use_tracker_data_t data = {entry, filter};
+    if (celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, celix_bundle_getId(ctx->bundle))) {
+        celix_bundleContext_createUseTrackerOnEventLoop(&data);
+    } else {
+        long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "create use service tracker", &data, celix_bundleContext_createUseTrackerOnEventLoop, NULL, NULL);
+        celix_framework_waitForGenericEvent(ctx->framework, eventId);
     }
+    if (entry->tracker == NULL) {
+        free(entry);
+        entry = NULL;
+    }
+    return entry;
+}
 
-    celix_bundle_context_use_service_data_t data = {0};
-    data.ctx = ctx;
-    data.opts = *opts;
-    celixThreadMutex_create(&data.mutex, NULL);
+/**
+ * Removes the least recently used idle entry from the use service tracker cache if the cache is full.
+ * Should be called with the use trackers mutex locked.
+ * @return The removed entry or NULL.
+ */
+static celix_bundle_context_use_tracker_entry_t* celix_bundleContext_removeLeastRecentlyUsedUseTracker(celix_bundle_context_t* ctx) {
+    if (celix_stringHashMap_size(ctx->useTrackers.entries) <= CELIX_BUNDLE_CONTEXT_USE_TRACKER_MAX_ENTRIES) {
+        return NULL;
+    }
+    celix_bundle_context_use_tracker_entry_t* lru = NULL;
+    CELIX_STRING_HASH_MAP_ITERATE(ctx->useTrackers.entries, iter) {
+        celix_bundle_context_use_tracker_entry_t* visit = iter.value.ptrValue;
+        if (visit->useCount == 0 && (lru == NULL || celix_difftime(&visit->lastUsed, &lru->lastUsed) < 0)) {
+            lru = visit;
+        }
+    }
+    if (lru != NULL) {
+        celix_stringHashMap_remove(ctx->useTrackers.entries, lru->key);
+    }
+    return lru;
+}
 
-    struct timespec startTime = celix_gettime(CLOCK_MONOTONIC);
+/**
+ * Returns a use service tracker for the provided filter options and increases its use count.
+ * If cache is true, the tracker is shared with other use calls with the same filter options and a new tracker is only
+ * created if no tracker is cached yet. Trackers are created on the event loop.
+ */
+static celix_bundle_context_use_tracker_entry_t* celix_bundleContext_acquireUseTracker(celix_bundle_context_t* ctx, const celix_service_filter_options_t* filter, bool cache) {
+    if (!cache) {
+        celix_bundle_context_use_tracker_entry_t* entry = celix_bundleContext_createUseTracker(ctx, filter);
+        if (entry != NULL) {
+            entry->useCount = 1;
+            entry->uncached = true;
+        }
+        return entry;
+    }
 
-    bool useServiceIsDone = false;
-    do {
-        if (celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
-            celix_bundleContext_useServiceWithOptions_1_CreateServiceTracker(&data);
-            celix_bundleContext_useServiceWithOptions_2_UseService(&data);
-        } else {
-            long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "create service tracker", &data, celix_bundleContext_useServiceWithOptions_1_CreateServiceTracker, NULL, NULL);
-            celix_framework_waitForGenericEvent(ctx->framework, eventId);
+    char buf[256];
+    char* key = celix_bundleContext_createUseTrackerKey(filter, buf, sizeof(buf));
+    if (key == NULL) {
+        return NULL;
+    }
 
-            eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "use service", &data, celix_bundleContext_useServiceWithOptions_2_UseService, NULL, NULL);
-            celix_framework_waitForGenericEvent(ctx->framework, eventId);
+    celixThreadMutex_lock(&ctx->useTrackers.mutex);
+    celix_bundle_context_use_tracker_entry_t* entry = celix_stringHashMap_get(ctx->useTrackers.entries, key);
+    if (entry != NULL) {
+        entry->useCount += 1;
+    }
+    celixThreadMutex_unlock(&ctx->useTrackers.mutex);
+
+    if (entry == NULL) {
+        celix_bundle_context_use_tracker_entry_t* created = celix_bundleContext_createUseTracker(ctx, filter);
+        celix_bundle_context_use_tracker_entry_t* evicted = NULL;
+        if (created != NULL) {
+            celixThreadMutex_lock(&ctx->useTrackers.mutex);
+            entry = celix_stringHashMap_get(ctx->useTrackers.entries, key);
+            if (entry == NULL) {
+                entry = created;
+                entry->key = celix_utils_strdup(key);
+                celix_stringHashMap_put(ctx->useTrackers.entries, entry->key, entry);
+                created = NULL;
+                evicted = celix_bundleContext_removeLeastRecentlyUsedUseTracker(ctx);
+            }
+            entry->useCount += 1;
+            celixThreadMutex_unlock(&ctx->useTrackers.mutex);
+        }
+        if (created != NULL) {
+            //another thread cached a tracker for the same filter in the meantime
+            celix_bundleContext_destroyUseTracker(ctx, created, false);
         }
+        if (evicted != NULL) {
+            celix_bundleContext_destroyUseTracker(ctx, evicted, false);
+        }
+    }
 
-        bool timeoutNotUsed = opts->waitTimeoutInSeconds == 0;
-        bool timeoutExpired = celix_elapsedtime(CLOCK_MONOTONIC, startTime) > opts->waitTimeoutInSeconds;
-        celixThreadMutex_lock(&data.mutex);
-        bool called = data.called;
-        celixThreadMutex_unlock(&data.mutex);
+    if (key != buf) {
+        free(key);
+    }
+    return entry;
+}
 
-        useServiceIsDone = timeoutNotUsed || timeoutExpired || called;
-        if (!useServiceIsDone) {
-            usleep(10);
+/**
+ * Decreases the use count of a use service tracker and evicts cached trackers which are idle for longer than
+ * CELIX_BUNDLE_CONTEXT_USE_TRACKER_IDLE_TIMEOUT seconds.
+ * Trackers which track services of a service factory are not cached, so that the service factory services are
+ * released after every use call.
+ */
+static void celix_bundleContext_releaseUseTracker(celix_bundle_context_t* ctx, celix_bundle_context_use_tracker_entry_t* entry) {
+    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+    celix_array_list_t* evicted = NULL;
+    bool tracksFactoryServices = !entry->uncached && celix_serviceTracker_hasFactoryServices(entry->tracker);
+
+    celixThreadMutex_lock(&ctx->useTrackers.mutex);
+    entry->useCount -= 1;
+    entry->lastUsed = now;
+    if (tracksFactoryServices && !entry->detached && !entry->uncached) {
+        //note a cached tracker would keep the services of a service factory, so the services of a service factory
+        //are released after the use call by removing the tracker from the cache.
+        if (celix_stringHashMap_get(ctx->useTrackers.entries, entry->key) == entry) {
+            celix_stringHashMap_remove(ctx->useTrackers.entries, entry->key);
+        }
+        entry->uncached = true;
+    }
+    bool destroyDetached = entry->detached && entry->useCount == 0;
+    bool destroyUncached = entry->uncached && entry->useCount == 0;
+    if (celix_difftime(&ctx->useTrackers.lastEvictCheck, &now) >= CELIX_BUNDLE_CONTEXT_USE_TRACKER_EVICT_INTERVAL) {
+        ctx->useTrackers.lastEvictCheck = now;
+        celix_string_hash_map_iterator_t iter = celix_stringHashMap_begin(ctx->useTrackers.entries);
+        while (!celix_stringHashMapIterator_isEnd(&iter)) {
+            celix_bundle_context_use_tracker_entry_t* visit = iter.value.ptrValue;
+            if (visit->useCount == 0 && celix_difftime(&visit->lastUsed, &now) >= CELIX_BUNDLE_CONTEXT_USE_TRACKER_IDLE_TIMEOUT) {
+                celix_stringHashMapIterator_remove(&iter);
+                if (evicted == NULL) {
+                    evicted = celix_arrayList_create();
+                }
+                celix_arrayList_add(evicted, visit);
+            } else {
+                celix_stringHashMapIterator_next(&iter);
+            }
         }
-    } while (!useServiceIsDone);
+    }
+    celixThreadMutex_unlock(&ctx->useTrackers.mutex);
 
-    celixThreadMutex_lock(&data.mutex);
-    bool called = data.called;
-    celixThreadMutex_unlock(&data.mutex);
-    celixThreadMutex_destroy(&data.mutex);
+    if (destroyDetached) {
+        //note the context is already cleaned up and the event loop can be stopped, so destroying the tracker directly
+        celix_bundleContext_destroyUseTrackerOnEventLoop(entry);
+    } else if (destroyUncached) {
+        celix_bundleContext_destroyUseTracker(ctx, entry, true);
+    }
 
-    return called;
+    if (evicted != NULL) {
+        for (int i = 0; i < celix_arrayList_size(evicted); ++i) {
+            celix_bundleContext_destroyUseTracker(ctx, celix_arrayList_get(evicted, i), false);
+        }
+        celix_arrayList_destroy(evicted);
+    }
 }
 
-static void celix_bundleContext_useServicesWithOptions_1_CreateServiceTracker(void *data) {
-    celix_bundle_context_use_service_data_t* d = data;
-    assert(celix_framework_isCurrentThreadTheEventLoop(d->ctx->framework));
+void celix_bundleContext_cleanupUseTrackers(bundle_context_t* ctx) {
+    celix_array_list_t* entries = celix_arrayList_create();
 
-    celix_service_tracking_options_t trkOpts = CELIX_EMPTY_SERVICE_TRACKING_OPTIONS;
-    trkOpts.filter.serviceName = d->opts.filter.serviceName;
-    trkOpts.filter = d->opts.filter;
-    trkOpts.filter.versionRange = d->opts.filter.versionRange;
-    trkOpts.filter.serviceLanguage = d->opts.filter.serviceLanguage;
+    celixThreadMutex_lock(&ctx->useTrackers.mutex);
+    CELIX_STRING_HASH_MAP_ITERATE(ctx->useTrackers.entries, iter) {
+        celix_bundle_context_use_tracker_entry_t* entry = iter.value.ptrValue;
+        if (entry->useCount > 0) {
+            //note can be in use by the thread stopping the bundle (e.g. a use callback stopping the framework)
+            entry->detached = true;
+        } else {
+            celix_arrayList_add(entries, entry);
+        }
+    }
+    celix_stringHashMap_clear(ctx->useTrackers.entries);
+    celixThreadMutex_unlock(&ctx->useTrackers.mutex);
+
+    for (int i = 0; i < celix_arrayList_size(entries); ++i) {
+        celix_bundleContext_destroyUseTracker(ctx, celix_arrayList_get(entries, i), true);
+    }
+    celix_arrayList_destroy(entries);
 
-    celixThreadMutex_lock(&d->mutex);
-    d->svcTracker = celix_serviceTracker_createWithOptions(d->ctx, &trkOpts);
-    celixThreadMutex_unlock(&d->mutex);
+    long bndId = celix_bundle_getId(ctx->bundle);
+    if (!celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, bndId)) {
+        //note ensure trackers removed from the cache by a service removal are also destroyed
+        celix_framework_waitUntilNoEventsForBnd(ctx->framework, bndId);
+    }
 }
 
-static void celix_bundleContext_useServicesWithOptions_2_UseServices(void *data) {
-    celix_bundle_context_use_service_data_t* d = data;
-    assert(celix_framework_isCurrentThreadTheEventLoop(d->ctx->framework));
+/**
+ * Uses the highest ranking service matching the use options. If cacheTracker is false, the use service tracker is
+ * not cached, which is used for use calls with a filter which is unlikely to be reused (e.g. a service id filter).
+ */
+static bool celix_bundleContext_useServiceWithOptionsInternal(
+        celix_bundle_context_t *ctx,
+        const celix_service_use_options_t *opts,
+        bool cacheTracker) {
+    if (opts == NULL || opts->filter.serviceName == NULL) {
+        return false;
+    }
 
-    celixThreadMutex_lock(&d->mutex);
-    celix_service_tracker_t *tracker = d->svcTracker;
-    d->svcTracker = NULL;
-    celixThreadMutex_unlock(&d->mutex);
+    struct timespec startTime = celix_gettime(CLOCK_MONOTONIC);
+    celix_bundle_context_use_tracker_entry_t* entry = celix_bundleContext_acquireUseTracker(ctx, &opts->filter, cacheTracker);
+    if (entry == NULL) {
+        return false;
+    }
+
+    celix_bundleContext_flushUseTrackerEvents(ctx);
+    bool called = celix_serviceTracker_useHighestRankingService(entry->tracker, opts->filter.serviceName, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
+    while (!called) {
+        double remaining = opts->waitTimeoutInSeconds - celix_elapsedtime(CLOCK_MONOTONIC, startTime);
+        if (remaining <= 0 || !celix_serviceTracker_waitForTrackedServices(entry->tracker, remaining)) {
+            break;
+        }
+        called = celix_serviceTracker_useHighestRankingService(entry->tracker, opts->filter.serviceName, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
+    }
 
-    size_t count = celix_serviceTracker_useServices(tracker, d->opts.filter.serviceName, d->opts.callbackHandle, d->opts.use, d->opts.useWithProperties, d->opts.useWithOwner);
-    celix_serviceTracker_destroy(tracker);
+    celix_bundleContext_releaseUseTracker(ctx, entry);
+    return called;
+}
 
-    celixThreadMutex_lock(&d->mutex);
-    d->count = count;
-    celixThreadMutex_unlock(&d->mutex);
+bool celix_bundleContext_useServiceWithOptions(
+        celix_bundle_context_t *ctx,
+        const celix_service_use_options_t *opts) {
+    return celix_bundleContext_useServiceWithOptionsInternal(ctx, opts, true);
 }
 
 size_t celix_bundleContext_useServicesWithOptions(
@@ -1277,26 +1486,15 @@ size_t celix_bundleContext_useServicesWithOptions(
         return 0;
     }
 
-    celix_bundle_context_use_service_data_t data = {0};
-    data.ctx = ctx;
-    data.opts = *opts;
-
-    if (celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
-        celix_bundleContext_useServicesWithOptions_1_CreateServiceTracker(&data);
-        celix_bundleContext_useServicesWithOptions_2_UseServices(&data);
-    } else {
-        long eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "create service tracker", &data, celix_bundleContext_useServicesWithOptions_1_CreateServiceTracker, NULL, NULL);
-        celix_framework_waitForGenericEvent(ctx->framework, eventId);
-
-        eventId = celix_framework_fireGenericEvent(ctx->framework, -1, celix_bundle_getId(ctx->bundle), "use service", &data, celix_bundleContext_useServicesWithOptions_2_UseServices, NULL, NULL);
-        celix_framework_waitForGenericEvent(ctx->framework, eventId);
+    celix_bundle_context_use_tracker_entry_t* entry = celix_bundleContext_acquireUseTracker(ctx, &opts->filter, true);
+    if (entry == NULL) {
+        return 0;
     }
 
-    celixThreadMutex_lock(&data.mutex);
-    size_t count = data.count;
-    celixThreadMutex_unlock(&data.mutex);
-    celixThreadMutex_destroy(&data.mutex);
+    celix_bundleContext_flushUseTrackerEvents(ctx);
+    size_t count = celix_serviceTracker_useServices(entry->tracker, opts->filter.serviceName, opts->callbackHandle, opts->use, opts->useWithProperties, opts->useWithOwner);
 
+    celix_bundleContext_releaseUseTracker(ctx, entry);
     return count;
 }
 
@@ -1357,7 +1555,7 @@ long celix_bundleContext_trackServicesAsync(
 
 static void celix_bundleContext_createTrackerOnEventLoop(void *data) {
     celix_bundle_context_service_tracker_entry_t* entry = data;
-    assert(celix_framework_isCurrentThreadTheEventLoop(entry->ctx->framework));
+    assert(celix_framework_isCurrentThreadTheEventLoopForBnd(entry->ctx->framework, celix_bundle_getId(entry->ctx->bundle)));
     celixThreadMutex_lock(&entry->ctx->mutex);
     bool cancelled = entry->cancelled;
     celixThreadMutex_unlock(&entry->ctx->mutex);
@@ -1403,7 +1601,7 @@ static long celix_bundleContext_trackServicesWithOptionsInternal(celix_bundle_co
         fw_log(ctx->framework->logger, CELIX_LOG_LEVEL_DEBUG, "Starting a tracker for any services");
     }
 
-    if (!async && celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+    if (!async && celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, celix_bundle_getId(ctx->bundle))) {
         //already in event loop thread. To keep the old behavior just create the tracker traditionally (chained in the current thread).
         celix_service_tracker_t *tracker = celix_serviceTracker_createWithOptions(ctx, opts);
         long trackerId = -1L;
@@ -1416,7 +1614,7 @@ static long celix_bundleContext_trackServicesWithOptionsInternal(celix_bundle_co
             celixThreadMutex_lock(&ctx->mutex);
             entry->trackerId = ctx->nextTrackerId++;
             trackerId = entry->trackerId;
-            hashMap_put(ctx->serviceTrackers, (void *) trackerId, entry);
+            celix_longHashMap_put(ctx->serviceTrackers, trackerId, entry);
             celixThreadMutex_unlock(&ctx->mutex);
         }
         return trackerId;
@@ -1433,7 +1631,7 @@ static long celix_bundleContext_trackServicesWithOptionsInternal(celix_bundle_co
         celixThreadMutex_lock(&ctx->mutex);
         entry->trackerId = ctx->nextTrackerId++;
         long trackerId = entry->trackerId;
-        hashMap_put(ctx->serviceTrackers, (void *)entry->trackerId, entry);
+        celix_longHashMap_put(ctx->serviceTrackers, entry->trackerId, entry);
         celixThreadMutex_unlock(&ctx->mutex);
 
         long id = celix_framework_fireGenericEvent(ctx->framework, entry->createEventId, celix_bundle_getId(ctx->bundle), "create service tracker event", entry, celix_bundleContext_createTrackerOnEventLoop, entry, celix_bundleContext_doneCreatingTrackerOnEventLoop);
@@ -1556,7 +1754,7 @@ long celix_bundleContext_trackServiceTrackersInternal(
     entry->hook.added = bundleContext_callServicedTrackerTrackerAdd;
     entry->hook.removed = bundleContext_callServicedTrackerTrackerRemove;
 
-    if (!async && celix_framework_isCurrentThreadTheEventLoop(ctx->framework)) {
+    if (!async && celix_framework_isCurrentThreadTheEventLoopForBnd(ctx->framework, celix_bundle_getId(ctx->bundle))) {
         //already on event loop, registering the "traditional way" i.e. chaining on the current thread
         service_registration_t* reg = NULL;
         bundleContext_registerService(ctx, OSGI_FRAMEWORK_LISTENER_HOOK_SERVICE_NAME, &entry->hook, NULL, &reg);
@@ -1570,7 +1768,7 @@ long celix_bundleContext_trackServiceTrackersInternal(
 
     if (entry->serviceId >= 0) {
         celixThreadMutex_lock(&ctx->mutex);
-        hashMap_put(ctx->metaTrackers, (void*)entry->trackerId, entry);
+        celix_longHashMap_put(ctx->metaTrackers, entry->trackerId, entry);
         long trkId = entry->trackerId;
         celixThreadMutex_unlock(&ctx->mutex);
         return trkId;
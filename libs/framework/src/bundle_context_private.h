@@ -26,6 +26,8 @@
 #include "celix_bundle_context.h"
 #include "listener_hook_service.h"
 #include "service_tracker.h"
+#include "celix_long_hash_map.h"
+#include "celix_string_hash_map.h"
 
 typedef struct celix_bundle_context_bundle_tracker_entry {
 	celix_bundle_context_t *ctx;
@@ -70,6 +72,31 @@ typedef struct celix_bundle_context_service_tracker_tracker_entry {
     long createEventId;
 } celix_bundle_context_service_tracker_tracker_entry_t;
 
+#ifndef CELIX_BUNDLE_CONTEXT_USE_TRACKER_IDLE_TIMEOUT
+#define CELIX_BUNDLE_CONTEXT_USE_TRACKER_IDLE_TIMEOUT 10 //seconds a cached use service tracker can be unused before it is evicted
+#endif
+
+#ifndef CELIX_BUNDLE_CONTEXT_USE_TRACKER_EVICT_INTERVAL
+#define CELIX_BUNDLE_CONTEXT_USE_TRACKER_EVICT_INTERVAL 1 //minimum seconds between scans for idle cached use service trackers
+#endif
+
+#ifndef CELIX_BUNDLE_CONTEXT_USE_TRACKER_MAX_ENTRIES
+#define CELIX_BUNDLE_CONTEXT_USE_TRACKER_MAX_ENTRIES 32 //max cached use service trackers, above this the least recently used idle tracker is evicted
+#endif
+
+/**
+ * A service tracker shared by the celix_bundleContext_useService* calls with the same filter options.
+ */
+typedef struct celix_bundle_context_use_tracker_entry {
+    celix_bundle_context_t* ctx;
+    char* key; //normalized service filter options, NULL for uncached entries
+    celix_service_tracker_t* tracker;
+    size_t useCount;
+    struct timespec lastUsed;
+    bool detached; //removed from the cache while in use by the bundle context cleanup, destroyed by the last user
+    bool uncached; //not in the cache (anymore), destroyed on the event loop by the last user
+} celix_bundle_context_use_tracker_entry_t;
+
 struct celix_bundle_context {
 	celix_framework_t *framework;
 	celix_bundle_t *bundle;
@@ -78,14 +105,26 @@ struct celix_bundle_context {
 	array_list_t *svcRegistrations; //serviceIds
 	celix_dependency_manager_t *mng;
 	long nextTrackerId;
-	hash_map_t *bundleTrackers; //key = trackerId, value = celix_bundle_context_bundle_tracker_entry_t*
-	hash_map_t *serviceTrackers; //key = trackerId, value = celix_service_tracker_t*
-	hash_map_t *metaTrackers; //key = trackerId, value = celix_bundle_context_service_tracker_tracker_entry_t*
-    hash_map_t *stoppingTrackerEventIds; //key = trackerId, value = eventId for stopping the tracker. Note id are only present if the stop tracking is queued.
+	celix_long_hash_map_t *bundleTrackers; //key = trackerId, value = celix_bundle_context_bundle_tracker_entry_t*
+	celix_long_hash_map_t *serviceTrackers; //key = trackerId, value = celix_service_tracker_t*
+	celix_long_hash_map_t *metaTrackers; //key = trackerId, value = celix_bundle_context_service_tracker_tracker_entry_t*
+    celix_long_hash_map_t *stoppingTrackerEventIds; //key = trackerId, value = eventId for stopping the tracker. Note id are only present if the stop tracking is queued.
+
+    struct {
+        celix_thread_mutex_t mutex; //protects below
+        celix_string_hash_map_t* entries; //key = normalized filter options (not copied), value = celix_bundle_context_use_tracker_entry_t*
+        struct timespec lastEvictCheck;
+    } useTrackers;
 };
 
 
 void celix_bundleContext_cleanup(celix_bundle_context_t *ctx);
 
+/**
+ * Destroys the cached use service trackers of the bundle context, so that services used by use service calls are
+ * released. Should not be called on a Celix event loop thread.
+ */
+void celix_bundleContext_cleanupUseTrackers(celix_bundle_context_t *ctx);
+
 
 #endif /* BUNDLE_CONTEXT_PRIVATE_H_ */
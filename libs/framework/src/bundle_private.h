@@ -22,6 +22,8 @@
 
 #include "bundle.h"
 #include "celix_bundle.h"
+#include "celix_threads.h"
+#include "celix_long_hash_map.h"
 
 
 
@@ -36,6 +38,9 @@ struct celix_bundle {
 	manifest_pt manifest;
 
 	celix_framework_t *framework;
+
+	celix_thread_mutex_t serviceReferencesMutex; //protects serviceReferences
+	celix_long_hash_map_t *serviceReferences; //service references owned by this bundle, key = svc id, managed by the service registry
 };
 
 #endif /* BUNDLE_PRIVATE_H_ */
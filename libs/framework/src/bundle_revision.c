@@ -23,15 +23,242 @@
 #include <archive.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <unistd.h>
+#include <ftw.h>
+#include <inttypes.h>
 
 
 #include "bundle_revision_private.h"
+#include "celix_properties.h"
+#include "celix_constants.h"
+#include "utils.h"
 
 celix_status_t bundleRevision_create(const char *root, const char *location, long revisionNr, const char *inputFile, bundle_revision_pt *bundle_revision) {
+    return bundleRevision_createWithOptions(root, NULL, location, revisionNr, inputFile, bundle_revision);
+}
+
+static celix_status_t bundleRevision_hashFile(const char* file, uint64_t* hashOut) {
+    FILE* f = fopen(file, "rb");
+    if (f == NULL) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+    //FNV-1a 64 bit
+    uint64_t hash = 14695981039346656037ULL;
+    unsigned char buf[16 * 1024];
+    size_t read = fread(buf, 1, sizeof(buf), f);
+    while (read > 0) {
+        for (size_t i = 0; i < read; ++i) {
+            hash ^= buf[i];
+            hash *= 1099511628211ULL;
+        }
+        read = fread(buf, 1, sizeof(buf), f);
+    }
+    celix_status_t status = ferror(f) ? CELIX_FILE_IO_EXCEPTION : CELIX_SUCCESS;
+    fclose(f);
+    *hashOut = hash;
+    return status;
+}
+
+static int bundleRevision_removeFile(const char* path, const struct stat* st __attribute__((unused)), int flag __attribute__((unused)), struct FTW* ftw __attribute__((unused))) {
+    return remove(path);
+}
+
+static celix_status_t bundleRevision_createDirs(const char* dir) {
+    char* path = strdup(dir);
+    celix_status_t status = CELIX_SUCCESS;
+    for (char* p = path + 1; status == CELIX_SUCCESS; ++p) {
+        if (*p == '/' || *p == '\0') {
+            char hold = *p;
+            *p = '\0';
+            if (mkdir(path, S_IRWXU) != 0 && errno != EEXIST) {
+                status = CELIX_FILE_IO_EXCEPTION;
+            }
+            *p = hold;
+            if (hold == '\0') {
+                break;
+            }
+        }
+    }
+    free(path);
+    return status;
+}
+
+/**
+ * Stores the main attributes of the manifest as properties file, so that a next revision for the same content cache
+ * entry does not need to parse the manifest. Manifests with named sections are not stored.
+ */
+static void bundleRevision_storeManifest(manifest_pt manifest, const char* file) {
+    hash_map_pt entries = NULL;
+    manifest_getEntries(manifest, &entries);
+    if (entries == NULL || hashMap_size(entries) == 0) {
+        celix_properties_store(manifest_getMainAttributes(manifest), file, NULL);
+    }
+}
+
+static celix_status_t bundleRevision_loadManifest(const char* entryDir, manifest_pt* manifest) {
+    celix_status_t status = CELIX_SUCCESS;
+    char file[512];
+    snprintf(file, sizeof(file), "%s/manifest.properties", entryDir);
+    celix_properties_t* attributes = access(file, F_OK) == 0 ? celix_properties_load(file) : NULL;
+    if (attributes != NULL) {
+        status = manifest_create(manifest);
+        if (status == CELIX_SUCCESS) {
+            celix_properties_t* mainAttributes = manifest_getMainAttributes(*manifest);
+            const char* key;
+            CELIX_PROPERTIES_FOR_EACH(attributes, key) {
+                celix_properties_set(mainAttributes, key, celix_properties_get(attributes, key, NULL));
+            }
+        }
+        celix_properties_destroy(attributes);
+    } else {
+        snprintf(file, sizeof(file), "%s/content/META-INF/MANIFEST.MF", entryDir);
+        status = manifest_createFromFile(file, manifest);
+    }
+    return status;
+}
+
+/**
+ * Ensures the bundle zip is extracted in a content cache entry (<contentCacheDir>/<hash>-<mtime>) and returns the
+ * content root and manifest of that entry.
+ *
+ * A new entry is extracted to a temporary dir and then renamed, so a existing entry is always complete. If another
+ * thread or process renamed the same entry first, the temporary dir is removed.
+ */
+static celix_status_t bundleRevision_useContentCache(const char* contentCacheDir, const char* bundleZip, char** contentRoot, manifest_pt* manifest) {
+    static long tmpCounter = 0; //NOTE atomic
+
+    struct stat st;
+    uint64_t hash = 0;
+    celix_status_t status = stat(bundleZip, &st) == 0 ? CELIX_SUCCESS : CELIX_FILE_IO_EXCEPTION;
+    status = CELIX_DO_IF(status, bundleRevision_hashFile(bundleZip, &hash));
+    if (status != CELIX_SUCCESS) {
+        return status;
+    }
+
+    char* entryDir = NULL;
+    asprintf(&entryDir, "%s/%016" PRIx64 "-%lld", contentCacheDir, hash, (long long)st.st_mtime);
+    if (access(entryDir, F_OK) == 0) {
+        status = bundleRevision_loadManifest(entryDir, manifest);
+    } else {
+        char* tmpDir = NULL;
+        char path[512];
+        asprintf(&tmpDir, "%s.tmp%i.%li", entryDir, (int)getpid(), __atomic_fetch_add(&tmpCounter, 1, __ATOMIC_RELAXED));
+        status = bundleRevision_createDirs(tmpDir);
+        snprintf(path, sizeof(path), "%s/content", tmpDir);
+        if (status == CELIX_SUCCESS && mkdir(path, S_IRWXU) != 0) {
+            status = CELIX_FILE_IO_EXCEPTION;
+        }
+        status = CELIX_DO_IF(status, extractBundle(bundleZip, path));
+        snprintf(path, sizeof(path), "%s/content/META-INF/MANIFEST.MF", tmpDir);
+        status = CELIX_DO_IF(status, manifest_createFromFile(path, manifest));
+        if (status == CELIX_SUCCESS) {
+            snprintf(path, sizeof(path), "%s/manifest.properties", tmpDir);
+            bundleRevision_storeManifest(*manifest, path);
+            if (rename(tmpDir, entryDir) != 0) {
+                //note entry created concurrently, use that one
+                nftw(tmpDir, bundleRevision_removeFile, 16, FTW_DEPTH | FTW_PHYS);
+                status = access(entryDir, F_OK) == 0 ? CELIX_SUCCESS : CELIX_FILE_IO_EXCEPTION;
+            }
+        } else {
+            nftw(tmpDir, bundleRevision_removeFile, 16, FTW_DEPTH | FTW_PHYS);
+        }
+        free(tmpDir);
+    }
+
+    if (status == CELIX_SUCCESS) {
+        asprintf(contentRoot, "%s/content", entryDir);
+    } else if (*manifest != NULL) {
+        manifest_destroy(*manifest);
+        *manifest = NULL;
+    }
+    free(entryDir);
+    return status;
+}
+
+/**
+ * Returns whether entry is the file name of one of the (comma separated) libraries, using the same library name
+ * to file name mapping as the framework uses to load libraries.
+ */
+static bool bundleRevision_isListedLibrary(const char* libraries, const char* entry) {
+    bool found = false;
+    char* copy = libraries != NULL ? strdup(libraries) : NULL;
+    char* last = NULL;
+    char* token = copy != NULL ? strtok_r(copy, ",", &last) : NULL;
+    while (token != NULL && !found) {
+        char* path = NULL;
+        char* lib = strtok_r(token, ";", &path);
+        if (lib != NULL) {
+            lib = utils_stringTrim(lib);
+            char file[256];
+            if (strncmp("lib", lib, 3) == 0) {
+                snprintf(file, sizeof(file), "%s", lib);
+            } else {
+                snprintf(file, sizeof(file), "lib%s.so", lib);
+            }
+            found = strcmp(file, entry) == 0;
+        }
+        token = strtok_r(NULL, ",", &last);
+    }
+    free(copy);
+    return found;
+}
+
+/**
+ * Tries to read the manifest directly from the bundle zip and checks whether the bundle zip only contains
+ * the manifest and the libraries mentioned in the manifest, so that the bundle can be loaded without extracting it.
+ * On success the manifest is returned, otherwise the bundle zip should be extracted as usual.
+ */
+static bool bundleRevision_loadManifestFromZip(const char* bundleZip, manifest_pt* manifestOut) {
+#ifdef __linux__
+    char* data = NULL;
+    size_t size = 0;
+    manifest_pt manifest = NULL;
+    if (readBundleEntry(bundleZip, "META-INF/MANIFEST.MF", &data, &size) != CELIX_SUCCESS) {
+        return false;
+    }
+    FILE* stream = fmemopen(data, size, "r");
+    celix_status_t status = stream != NULL ? manifest_createFromStream(stream, &manifest) : CELIX_FILE_IO_EXCEPTION;
+    if (stream != NULL) {
+        fclose(stream);
+    }
+    free(data);
+
+    celix_array_list_t* entries = NULL;
+    status = CELIX_DO_IF(status, listBundleEntries(bundleZip, &entries));
+    bool eligible = status == CELIX_SUCCESS;
+    if (eligible) {
+        const char* privateLibraries = manifest_getValue(manifest, OSGI_FRAMEWORK_PRIVATE_LIBRARY);
+        const char* exportLibraries = manifest_getValue(manifest, OSGI_FRAMEWORK_EXPORT_LIBRARY);
+        for (int i = 0; i < celix_arrayList_size(entries); ++i) {
+            char* entry = celix_arrayList_get(entries, i);
+            size_t len = strlen(entry);
+            bool isDir = len > 0 && entry[len - 1] == '/';
+            if (!isDir && strcmp(entry, "META-INF/MANIFEST.MF") != 0 &&
+                    !bundleRevision_isListedLibrary(privateLibraries, entry) &&
+                    !bundleRevision_isListedLibrary(exportLibraries, entry)) {
+                eligible = false;
+            }
+            free(entry);
+        }
+        celix_arrayList_destroy(entries);
+    }
+
+    if (eligible) {
+        *manifestOut = manifest;
+    } else if (manifest != NULL) {
+        manifest_destroy(manifest);
+    }
+    return eligible;
+#else
+    return false;
+#endif
+}
+
+celix_status_t bundleRevision_createWithOptions(const char *root, const celix_bundle_revision_options_t *opts, const char *location, long revisionNr, const char *inputFile, bundle_revision_pt *bundle_revision) {
     celix_status_t status = CELIX_SUCCESS;
 	bundle_revision_pt revision = NULL;
 
-	revision = (bundle_revision_pt) malloc(sizeof(*revision));
+	revision = (bundle_revision_pt) calloc(1, sizeof(*revision));
     if (!revision) {
     	status = CELIX_ENOMEM;
     } else {
@@ -40,26 +267,42 @@ celix_status_t bundleRevision_create(const char *root, const char *location, lon
             free(revision);
             status = CELIX_FILE_IO_EXCEPTION;
         } else {
+            char* contentRoot = NULL;
+            const char* contentCacheDir = opts != NULL ? opts->contentCacheDir : NULL;
             if (inputFile != NULL) {
                 status = extractBundle(inputFile, root);
             } else if (strcmp(location, "inputstream:") != 0) {
             	// If location != inputstream, extract it, else ignore it and assume this is a cache entry.
-                status = extractBundle(location, root);
+                if (opts != NULL && opts->loadFromZip && bundleRevision_loadManifestFromZip(location, &revision->manifest)) {
+                    revision->zipLocation = strdup(location);
+                } else if (contentCacheDir != NULL) {
+                    status = bundleRevision_useContentCache(contentCacheDir, location, &contentRoot, &revision->manifest);
+                } else {
+                    status = extractBundle(location, root);
+                }
             }
 
             status = CELIX_DO_IF(status, arrayList_create(&(revision->libraryHandles)));
             if (status == CELIX_SUCCESS) {
+                revision->libraryFds = celix_arrayList_create();
                 revision->revisionNr = revisionNr;
-                revision->root = strdup(root);
+                revision->root = contentRoot != NULL ? contentRoot : strdup(root);
                 revision->location = strdup(location);
 
                 *bundle_revision = revision;
 
-                char manifest[512];
-                snprintf(manifest, sizeof(manifest), "%s/META-INF/MANIFEST.MF", revision->root);
-				status = manifest_createFromFile(manifest, &revision->manifest);
+                if (revision->manifest == NULL) {
+                    char manifest[512];
+                    snprintf(manifest, sizeof(manifest), "%s/META-INF/MANIFEST.MF", revision->root);
+                    status = manifest_createFromFile(manifest, &revision->manifest);
+                }
             }
             else {
+                free(contentRoot);
+                free(revision->zipLocation);
+                if (revision->manifest != NULL) {
+                    manifest_destroy(revision->manifest);
+                }
             	free(revision);
             }
 
@@ -73,6 +316,11 @@ celix_status_t bundleRevision_create(const char *root, const char *location, lon
 
 celix_status_t bundleRevision_destroy(bundle_revision_pt revision) {
     arrayList_destroy(revision->libraryHandles);
+    for (int i = 0; i < celix_arrayList_size(revision->libraryFds); ++i) {
+        close(celix_arrayList_getInt(revision->libraryFds, i));
+    }
+    celix_arrayList_destroy(revision->libraryFds);
+    free(revision->zipLocation);
     manifest_destroy(revision->manifest);
     free(revision->root);
     free(revision->location);
@@ -144,3 +392,11 @@ celix_status_t bundleRevision_getHandles(bundle_revision_pt revision, array_list
 
     return status;
 }
+
+const char* celix_bundleRevision_getZipLocation(bundle_revision_pt revision) {
+    return revision->zipLocation;
+}
+
+void celix_bundleRevision_addLibraryMemFd(bundle_revision_pt revision, int fd) {
+    celix_arrayList_addInt(revision->libraryFds, fd);
+}
@@ -28,6 +28,7 @@
 #define BUNDLE_REVISION_PRIVATE_H_
 
 #include "bundle_revision.h"
+#include "celix_array_list.h"
 
 struct bundleRevision {
 	long revisionNr;
@@ -36,6 +37,21 @@ struct bundleRevision {
 	manifest_pt manifest;
 
 	array_list_pt libraryHandles;
+
+	char *zipLocation; //set if the revision is loaded from the bundle zip, see celix_bundle_revision_options_t
+	celix_array_list_t *libraryFds; //memory file descriptors of the libraries loaded from the bundle zip
 };
 
+/**
+ * Returns the location of the bundle zip if the content of this revision is not extracted, but loaded directly from
+ * the bundle zip. Returns NULL otherwise.
+ */
+const char* celix_bundleRevision_getZipLocation(bundle_revision_pt revision);
+
+/**
+ * Adds a memory file descriptor of a library loaded from the bundle zip to the revision.
+ * The revision will close the file descriptor when the revision is destroyed.
+ */
+void celix_bundleRevision_addLibraryMemFd(bundle_revision_pt revision, int fd);
+
 #endif /* BUNDLE_REVISION_PRIVATE_H_ */
@@ -0,0 +1,254 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+
+#include "celix_framework_metrics.h"
+#include "celix_threads.h"
+
+struct celix_framework_metrics {
+    celix_framework_metrics_histogram_t queueDepth; //NOTE atomic fields
+    celix_framework_metrics_histogram_t queueLatencyInUs; //NOTE atomic fields
+    celix_framework_metrics_histogram_t handleTimeInUs[CELIX_FRAMEWORK_METRICS_NR_OF_EVENT_TYPES]; //NOTE atomic fields
+
+    celix_thread_mutex_t mutex; //protects below
+    celix_array_list_t* bundles; //entries are celix_framework_bundle_event_metrics_t*
+    celix_framework_blocking_event_t blockingEvents[CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS]; //ordered from slowest
+    int nrOfBlockingEvents;
+    uint64_t minBlockingThresholdInUs; //lower bound of the blocking threshold
+    uint64_t blockingThresholdInUs; //NOTE atomic. Handle time an event needs to exceed to be added to the slowest events.
+};
+
+static int celix_frameworkMetrics_bucket(uint64_t value) {
+    if (value == 0) {
+        return 0;
+    }
+    int bucket = 64 - __builtin_clzll(value);
+    return bucket < CELIX_FRAMEWORK_METRICS_NR_OF_BUCKETS ? bucket : CELIX_FRAMEWORK_METRICS_NR_OF_BUCKETS - 1;
+}
+
+static void celix_frameworkMetrics_addToHistogram(celix_framework_metrics_histogram_t* histogram, uint64_t value) {
+    __atomic_add_fetch(&histogram->count, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&histogram->sum, value, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&histogram->buckets[celix_frameworkMetrics_bucket(value)], 1, __ATOMIC_RELAXED);
+    uint64_t max = __atomic_load_n(&histogram->max, __ATOMIC_RELAXED);
+    while (value > max && !__atomic_compare_exchange_n(&histogram->max, &max, value, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        //note on failure max is updated to the current max
+    }
+}
+
+static void celix_frameworkMetrics_copyHistogram(celix_framework_metrics_histogram_t* dest, celix_framework_metrics_histogram_t* src) {
+    dest->count = __atomic_load_n(&src->count, __ATOMIC_RELAXED);
+    dest->sum = __atomic_load_n(&src->sum, __ATOMIC_RELAXED);
+    dest->max = __atomic_load_n(&src->max, __ATOMIC_RELAXED);
+    for (int i = 0; i < CELIX_FRAMEWORK_METRICS_NR_OF_BUCKETS; ++i) {
+        dest->buckets[i] = __atomic_load_n(&src->buckets[i], __ATOMIC_RELAXED);
+    }
+}
+
+static void celix_frameworkMetrics_resetHistogram(celix_framework_metrics_histogram_t* histogram) {
+    __atomic_store_n(&histogram->count, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&histogram->sum, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&histogram->max, 0, __ATOMIC_RELAXED);
+    for (int i = 0; i < CELIX_FRAMEWORK_METRICS_NR_OF_BUCKETS; ++i) {
+        __atomic_store_n(&histogram->buckets[i], 0, __ATOMIC_RELAXED);
+    }
+}
+
+celix_framework_metrics_t* celix_frameworkMetrics_create(uint64_t minBlockingThresholdInUs) {
+    celix_framework_metrics_t* metrics = calloc(1, sizeof(*metrics));
+    metrics->minBlockingThresholdInUs = minBlockingThresholdInUs;
+    metrics->blockingThresholdInUs = minBlockingThresholdInUs;
+    celixThreadMutex_create(&metrics->mutex, NULL);
+    metrics->bundles = celix_arrayList_create();
+    return metrics;
+}
+
+void celix_frameworkMetrics_destroy(celix_framework_metrics_t* metrics) {
+    if (metrics != NULL) {
+        for (int i = 0; i < celix_arrayList_size(metrics->bundles); ++i) {
+            free(celix_arrayList_get(metrics->bundles, i));
+        }
+        celix_arrayList_destroy(metrics->bundles);
+        celixThreadMutex_destroy(&metrics->mutex);
+        free(metrics);
+    }
+}
+
+void celix_frameworkMetrics_recordQueueDepth(celix_framework_metrics_t* metrics, size_t depth) {
+    celix_frameworkMetrics_addToHistogram(&metrics->queueDepth, depth);
+}
+
+static celix_framework_bundle_event_metrics_t* celix_frameworkMetrics_findOrAddBundle(celix_framework_metrics_t* metrics, const celix_bundle_t* bnd) {
+    long bndId = celix_bundle_getId(bnd);
+    for (int i = 0; i < celix_arrayList_size(metrics->bundles); ++i) {
+        celix_framework_bundle_event_metrics_t* entry = celix_arrayList_get(metrics->bundles, i);
+        if (entry->bndId == bndId) {
+            return entry;
+        }
+    }
+    celix_framework_bundle_event_metrics_t* entry = calloc(1, sizeof(*entry));
+    entry->bndId = bndId;
+    snprintf(entry->bndSymbolicName, sizeof(entry->bndSymbolicName), "%s", celix_bundle_getSymbolicName(bnd));
+    celix_arrayList_add(metrics->bundles, entry);
+    return entry;
+}
+
+/**
+ * Adds the event to the slowest events. Should be called with the mutex locked.
+ */
+static void celix_frameworkMetrics_addBlockingEvent(celix_framework_metrics_t* metrics, celix_framework_metrics_event_type_e type, const celix_bundle_t* bnd, const char* eventName, uint64_t handleTimeInUs) {
+    int index = metrics->nrOfBlockingEvents;
+    while (index > 0 && metrics->blockingEvents[index - 1].handleTimeInUs < handleTimeInUs) {
+        index -= 1;
+    }
+    if (index >= CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS) {
+        return;
+    }
+    int last = metrics->nrOfBlockingEvents < CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS ? metrics->nrOfBlockingEvents : CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS - 1;
+    memmove(&metrics->blockingEvents[index + 1], &metrics->blockingEvents[index], (last - index) * sizeof(metrics->blockingEvents[0]));
+    if (metrics->nrOfBlockingEvents < CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS) {
+        metrics->nrOfBlockingEvents += 1;
+    }
+
+    celix_framework_blocking_event_t* event = &metrics->blockingEvents[index];
+    memset(event, 0, sizeof(*event));
+    event->type = type;
+    event->bndId = bnd != NULL ? celix_bundle_getId(bnd) : -1L;
+    snprintf(event->bndSymbolicName, sizeof(event->bndSymbolicName), "%s", bnd != NULL ? celix_bundle_getSymbolicName(bnd) : "");
+    snprintf(event->eventName, sizeof(event->eventName), "%s", eventName != NULL ? eventName : "");
+    event->handleTimeInUs = handleTimeInUs;
+
+    if (metrics->nrOfBlockingEvents == CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS) {
+        uint64_t threshold = metrics->blockingEvents[CELIX_FRAMEWORK_METRICS_NR_OF_BLOCKING_EVENTS - 1].handleTimeInUs;
+        threshold = threshold > metrics->minBlockingThresholdInUs ? threshold : metrics->minBlockingThresholdInUs;
+        __atomic_store_n(&metrics->blockingThresholdInUs, threshold, __ATOMIC_RELAXED);
+    }
+}
+
+void celix_frameworkMetrics_recordHandledEvent(celix_framework_metrics_t* metrics, celix_framework_metrics_event_type_e type, const celix_bundle_t* bnd, const char* eventName, uint64_t latencyInNs, uint64_t handleTimeInNs) {
+    uint64_t handleTimeInUs = handleTimeInNs / 1000;
+    celix_frameworkMetrics_addToHistogram(&metrics->queueLatencyInUs, latencyInNs / 1000);
+    celix_frameworkMetrics_addToHistogram(&metrics->handleTimeInUs[type], handleTimeInUs);
+
+    bool isGenericBundleEvent = type == CELIX_FRAMEWORK_METRICS_GENERIC_EVENT && bnd != NULL;
+    bool isBlocking = handleTimeInUs > __atomic_load_n(&metrics->blockingThresholdInUs, __ATOMIC_RELAXED);
+    if (isGenericBundleEvent || isBlocking) {
+        celixThreadMutex_lock(&metrics->mutex);
+        if (isGenericBundleEvent) {
+            celix_framework_bundle_event_metrics_t* entry = celix_frameworkMetrics_findOrAddBundle(metrics, bnd);
+            celix_frameworkMetrics_addToHistogram(&entry->handleTimeInUs, handleTimeInUs);
+        }
+        if (isBlocking) {
+            celix_frameworkMetrics_addBlockingEvent(metrics, type, bnd, eventName, handleTimeInUs);
+        }
+        celixThreadMutex_unlock(&metrics->mutex);
+    }
+}
+
+celix_framework_event_metrics_t* celix_frameworkMetrics_createEventMetrics(celix_framework_metrics_t* metrics) {
+    celix_framework_event_metrics_t* result = calloc(1, sizeof(*result));
+    celix_frameworkMetrics_copyHistogram(&result->queueDepth, &metrics->queueDepth);
+    celix_frameworkMetrics_copyHistogram(&result->queueLatencyInUs, &metrics->queueLatencyInUs);
+    for (int i = 0; i < CELIX_FRAMEWORK_METRICS_NR_OF_EVENT_TYPES; ++i) {
+        celix_frameworkMetrics_copyHistogram(&result->handleTimeInUs[i], &metrics->handleTimeInUs[i]);
+    }
+    result->bundles = celix_arrayList_create();
+    result->blockingEvents = celix_arrayList_create();
+
+    celixThreadMutex_lock(&metrics->mutex);
+    for (int i = 0; i < celix_arrayList_size(metrics->bundles); ++i) {
+        celix_framework_bundle_event_metrics_t* entry = malloc(sizeof(*entry));
+        *entry = *(celix_framework_bundle_event_metrics_t*)celix_arrayList_get(metrics->bundles, i);
+        celix_arrayList_add(result->bundles, entry);
+    }
+    for (int i = 0; i < metrics->nrOfBlockingEvents; ++i) {
+        celix_framework_blocking_event_t* event = malloc(sizeof(*event));
+        *event = metrics->blockingEvents[i];
+        celix_arrayList_add(result->blockingEvents, event);
+    }
+    celixThreadMutex_unlock(&metrics->mutex);
+    return result;
+}
+
+void celix_frameworkMetrics_destroyEventMetrics(celix_framework_event_metrics_t* eventMetrics) {
+    if (eventMetrics != NULL) {
+        for (int i = 0; i < celix_arrayList_size(eventMetrics->bundles); ++i) {
+            free(celix_arrayList_get(eventMetrics->bundles, i));
+        }
+        celix_arrayList_destroy(eventMetrics->bundles);
+        for (int i = 0; i < celix_arrayList_size(eventMetrics->blockingEvents); ++i) {
+            free(celix_arrayList_get(eventMetrics->blockingEvents, i));
+        }
+        celix_arrayList_destroy(eventMetrics->blockingEvents);
+        free(eventMetrics);
+    }
+}
+
+void celix_frameworkMetrics_reset(celix_framework_metrics_t* metrics) {
+    celix_frameworkMetrics_resetHistogram(&metrics->queueDepth);
+    celix_frameworkMetrics_resetHistogram(&metrics->queueLatencyInUs);
+    for (int i = 0; i < CELIX_FRAMEWORK_METRICS_NR_OF_EVENT_TYPES; ++i) {
+        celix_frameworkMetrics_resetHistogram(&metrics->handleTimeInUs[i]);
+    }
+    celixThreadMutex_lock(&metrics->mutex);
+    for (int i = 0; i < celix_arrayList_size(metrics->bundles); ++i) {
+        free(celix_arrayList_get(metrics->bundles, i));
+    }
+    celix_arrayList_clear(metrics->bundles);
+    metrics->nrOfBlockingEvents = 0;
+    __atomic_store_n(&metrics->blockingThresholdInUs, metrics->minBlockingThresholdInUs, __ATOMIC_RELAXED);
+    celixThreadMutex_unlock(&metrics->mutex);
+}
+
+const char* celix_frameworkMetrics_eventTypeToString(celix_framework_metrics_event_type_e type) {
+    switch (type) {
+        case CELIX_FRAMEWORK_METRICS_FRAMEWORK_EVENT:
+            return "framework event";
+        case CELIX_FRAMEWORK_METRICS_BUNDLE_EVENT:
+            return "bundle event";
+        case CELIX_FRAMEWORK_METRICS_REGISTER_EVENT:
+            return "register service event";
+        case CELIX_FRAMEWORK_METRICS_UNREGISTER_EVENT:
+            return "unregister service event";
+        case CELIX_FRAMEWORK_METRICS_GENERIC_EVENT:
+            return "generic event";
+        default:
+            return "unknown";
+    }
+}
+
+uint64_t celix_frameworkMetrics_percentile(const celix_framework_metrics_histogram_t *histogram, double percentile) {
+    if (histogram->count == 0) {
+        return 0;
+    }
+    uint64_t target = (uint64_t)(percentile * (double)histogram->count + 0.5);
+    target = target == 0 ? 1 : target;
+    uint64_t cumulative = 0;
+    for (int i = 0; i < CELIX_FRAMEWORK_METRICS_NR_OF_BUCKETS; ++i) {
+        cumulative += histogram->buckets[i];
+        if (cumulative >= target) {
+            uint64_t upper = i == 0 ? 0 : (1ULL << i) - 1;
+            return upper < histogram->max ? upper : histogram->max;
+        }
+    }
+    return histogram->max;
+}
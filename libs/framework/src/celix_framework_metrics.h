@@ -0,0 +1,89 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_FRAMEWORK_METRICS_H_
+#define CELIX_FRAMEWORK_METRICS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "celix_bundle.h"
+#include "celix_framework_metrics_service.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Event loop metrics of the framework.
+ *
+ * The histograms are updated with atomic operations, so recording is lock-free for all but the generic event per
+ * bundle metrics and the (rare) update of the slowest events.
+ */
+typedef struct celix_framework_metrics celix_framework_metrics_t;
+
+#ifndef CELIX_FRAMEWORK_DEFAULT_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US
+#define CELIX_FRAMEWORK_DEFAULT_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US 1000
+#endif
+
+/**
+ * @brief Creates the event loop metrics.
+ *
+ * @param minBlockingThresholdInUs The handle time an event needs to exceed to be added to the slowest events, also
+ * after a reset. Events below this threshold do not lock the metrics mutex.
+ */
+celix_framework_metrics_t* celix_frameworkMetrics_create(uint64_t minBlockingThresholdInUs);
+
+void celix_frameworkMetrics_destroy(celix_framework_metrics_t* metrics);
+
+/**
+ * @brief Records the number of pending events when an event is added to the event queue.
+ */
+void celix_frameworkMetrics_recordQueueDepth(celix_framework_metrics_t* metrics, size_t depth);
+
+/**
+ * @brief Records a handled event.
+ *
+ * @param bnd The (optional) bundle of the event.
+ * @param eventName The (optional) generic event name or service name of the event.
+ * @param latencyInNs The time between adding and handling the event.
+ * @param handleTimeInNs The time it took to handle the event.
+ */
+void celix_frameworkMetrics_recordHandledEvent(celix_framework_metrics_t* metrics, celix_framework_metrics_event_type_e type, const celix_bundle_t* bnd, const char* eventName, uint64_t latencyInNs, uint64_t handleTimeInNs);
+
+/**
+ * @see celix_framework_metrics_service_t.createEventMetrics
+ */
+celix_framework_event_metrics_t* celix_frameworkMetrics_createEventMetrics(celix_framework_metrics_t* metrics);
+
+/**
+ * @see celix_framework_metrics_service_t.destroyEventMetrics
+ */
+void celix_frameworkMetrics_destroyEventMetrics(celix_framework_event_metrics_t* eventMetrics);
+
+/**
+ * @see celix_framework_metrics_service_t.reset
+ */
+void celix_frameworkMetrics_reset(celix_framework_metrics_t* metrics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_FRAMEWORK_METRICS_H_ */
@@ -0,0 +1,189 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#else
+#include <pthread.h>
+#endif
+
+#include "celix_framework_trace.h"
+#include "celix_utils.h"
+
+typedef struct celix_framework_trace_slot {
+    size_t seq; //NOTE atomic. 2*pos+1 while the entry for position pos is written, 2*pos+2 when written.
+    celix_framework_trace_entry_t entry;
+} celix_framework_trace_slot_t;
+
+struct celix_framework_trace {
+    uint64_t startTimeInNs; //monotonic time of the creation of the trace
+    size_t cap; //power of 2
+    size_t writePos; //NOTE atomic. Next position to be claimed by a writer.
+    size_t clearPos; //NOTE atomic. Positions before the clear position are ignored by readers.
+    celix_framework_trace_slot_t* slots;
+};
+
+celix_framework_trace_t* celix_frameworkTrace_create(size_t capacity) {
+    celix_framework_trace_t* trace = calloc(1, sizeof(*trace));
+    trace->startTimeInNs = celix_frameworkTrace_now();
+    trace->cap = 2;
+    while (trace->cap < capacity) {
+        trace->cap *= 2;
+    }
+    trace->slots = calloc(trace->cap, sizeof(*trace->slots));
+    return trace;
+}
+
+void celix_frameworkTrace_destroy(celix_framework_trace_t* trace) {
+    if (trace != NULL) {
+        free(trace->slots);
+        free(trace);
+    }
+}
+
+uint64_t celix_frameworkTrace_now() {
+    struct timespec now = celix_gettime(CLOCK_MONOTONIC);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+static long celix_frameworkTrace_threadId() {
+#ifdef __linux__
+    return (long)syscall(SYS_gettid);
+#else
+    return (long)(uintptr_t)pthread_self();
+#endif
+}
+
+void celix_frameworkTrace_record(celix_framework_trace_t* trace, celix_framework_trace_event_type_e type, long bndId, const char* bndSymbolicName, uint64_t startTimeInNs) {
+    uint64_t end = celix_frameworkTrace_now();
+    size_t pos = __atomic_fetch_add(&trace->writePos, 1, __ATOMIC_RELAXED);
+    celix_framework_trace_slot_t* slot = &trace->slots[pos & (trace->cap - 1)];
+    __atomic_store_n(&slot->seq, 2 * pos + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    slot->entry.type = type;
+    slot->entry.bndId = bndId;
+    if (bndSymbolicName != NULL) {
+        strncpy(slot->entry.bndSymbolicName, bndSymbolicName, sizeof(slot->entry.bndSymbolicName) - 1);
+        slot->entry.bndSymbolicName[sizeof(slot->entry.bndSymbolicName) - 1] = '\0';
+    } else {
+        slot->entry.bndSymbolicName[0] = '\0';
+    }
+    slot->entry.threadId = celix_frameworkTrace_threadId();
+    slot->entry.startTimeInNs = startTimeInNs;
+    slot->entry.durationInNs = end > startTimeInNs ? end - startTimeInNs : 0;
+    __atomic_store_n(&slot->seq, 2 * pos + 2, __ATOMIC_RELEASE);
+}
+
+celix_array_list_t* celix_frameworkTrace_getEntries(celix_framework_trace_t* trace) {
+    celix_array_list_t* entries = celix_arrayList_create();
+    size_t end = __atomic_load_n(&trace->writePos, __ATOMIC_ACQUIRE);
+    size_t begin = __atomic_load_n(&trace->clearPos, __ATOMIC_ACQUIRE);
+    if (end - begin > trace->cap) {
+        begin = end - trace->cap;
+    }
+    for (size_t pos = begin; pos < end; ++pos) {
+        celix_framework_trace_slot_t* slot = &trace->slots[pos & (trace->cap - 1)];
+        size_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        if (seq != 2 * pos + 2) {
+            //note entry still being written or already overwritten
+            continue;
+        }
+        celix_framework_trace_entry_t* entry = malloc(sizeof(*entry));
+        *entry = slot->entry;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&slot->seq, __ATOMIC_RELAXED) == seq) {
+            //note entries are recorded in monotonic time, but returned relative to the creation of the trace
+            entry->startTimeInNs = entry->startTimeInNs > trace->startTimeInNs ? entry->startTimeInNs - trace->startTimeInNs : 0;
+            celix_arrayList_add(entries, entry);
+        } else {
+            free(entry);
+        }
+    }
+    return entries;
+}
+
+static void celix_frameworkTrace_writeJsonString(FILE* stream, const char* str) {
+    fputc('"', stream);
+    for (const char* c = str; *c != '\0'; ++c) {
+        if (*c == '"' || *c == '\\') {
+            fprintf(stream, "\\%c", *c);
+        } else if ((unsigned char)*c < 0x20) {
+            fprintf(stream, "\\u%04x", (unsigned int)(unsigned char)*c);
+        } else {
+            fputc(*c, stream);
+        }
+    }
+    fputc('"', stream);
+}
+
+celix_status_t celix_frameworkTrace_writeChromeTrace(celix_framework_trace_t* trace, FILE* stream) {
+    celix_array_list_t* entries = celix_frameworkTrace_getEntries(trace);
+    int pid = (int)getpid();
+    fprintf(stream, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    for (int i = 0; i < celix_arrayList_size(entries); ++i) {
+        celix_framework_trace_entry_t* entry = celix_arrayList_get(entries, i);
+        char name[128];
+        if (entry->bndSymbolicName[0] != '\0') {
+            snprintf(name, sizeof(name), "%s %s", celix_frameworkTrace_eventTypeToString(entry->type), entry->bndSymbolicName);
+        } else {
+            snprintf(name, sizeof(name), "%s", celix_frameworkTrace_eventTypeToString(entry->type));
+        }
+        fprintf(stream, "%s\n{\"name\":", i == 0 ? "" : ",");
+        celix_frameworkTrace_writeJsonString(stream, name);
+        fprintf(stream, ",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%i,\"tid\":%li,\"args\":{\"bndId\":%li}}",
+                entry->type == CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT ? "event" : "bundle",
+                (double)entry->startTimeInNs / 1000.0,
+                (double)entry->durationInNs / 1000.0,
+                pid,
+                entry->threadId,
+                entry->bndId);
+        free(entry);
+    }
+    fprintf(stream, "\n]}\n");
+    celix_arrayList_destroy(entries);
+    return ferror(stream) ? CELIX_FILE_IO_EXCEPTION : CELIX_SUCCESS;
+}
+
+void celix_frameworkTrace_clear(celix_framework_trace_t* trace) {
+    size_t end = __atomic_load_n(&trace->writePos, __ATOMIC_ACQUIRE);
+    __atomic_store_n(&trace->clearPos, end, __ATOMIC_RELEASE);
+}
+
+const char* celix_frameworkTrace_eventTypeToString(celix_framework_trace_event_type_e type) {
+    switch (type) {
+        case CELIX_FRAMEWORK_TRACE_INSTALL_BUNDLE:
+            return "install bundle";
+        case CELIX_FRAMEWORK_TRACE_LOAD_BUNDLE_LIBRARIES:
+            return "load bundle libraries";
+        case CELIX_FRAMEWORK_TRACE_ACTIVATOR_CREATE:
+            return "activator create";
+        case CELIX_FRAMEWORK_TRACE_ACTIVATOR_START:
+            return "activator start";
+        case CELIX_FRAMEWORK_TRACE_START_BUNDLE:
+            return "start bundle";
+        case CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT:
+            return "event queue wait";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_FRAMEWORK_TRACE_H_
+#define CELIX_FRAMEWORK_TRACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "celix_framework_trace_service.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CELIX_FRAMEWORK_DEFAULT_TRACE_BUFFER_SIZE
+#define CELIX_FRAMEWORK_DEFAULT_TRACE_BUFFER_SIZE 4096
+#endif
+
+/**
+ * @brief Lock-free trace ring used to record the framework startup and lifecycle trace.
+ *
+ * Writers claim a slot with an atomic increment and never block. A slot is guarded by a sequence number, so that
+ * readers can detect (and skip) slots which are being (over)written.
+ */
+typedef struct celix_framework_trace celix_framework_trace_t;
+
+/**
+ * @brief Creates a trace ring with at least the provided capacity (rounded up to a power of 2).
+ */
+celix_framework_trace_t* celix_frameworkTrace_create(size_t capacity);
+
+void celix_frameworkTrace_destroy(celix_framework_trace_t* trace);
+
+/**
+ * @brief Returns the current monotonic time in nanoseconds, the time base used for recording trace entries.
+ */
+uint64_t celix_frameworkTrace_now();
+
+/**
+ * @brief Records an entry which started at startTimeInNs (see celix_frameworkTrace_now) and ends now.
+ *
+ * @param bndSymbolicName The (optional) bundle symbolic name.
+ */
+void celix_frameworkTrace_record(celix_framework_trace_t* trace, celix_framework_trace_event_type_e type, long bndId, const char* bndSymbolicName, uint64_t startTimeInNs);
+
+/**
+ * @see celix_framework_trace_service_t.getEntries
+ */
+celix_array_list_t* celix_frameworkTrace_getEntries(celix_framework_trace_t* trace);
+
+/**
+ * @see celix_framework_trace_service_t.writeChromeTrace
+ */
+celix_status_t celix_frameworkTrace_writeChromeTrace(celix_framework_trace_t* trace, FILE* stream);
+
+/**
+ * @see celix_framework_trace_service_t.clear
+ */
+void celix_frameworkTrace_clear(celix_framework_trace_t* trace);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_FRAMEWORK_TRACE_H_ */
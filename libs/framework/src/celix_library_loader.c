@@ -19,15 +19,25 @@
 
 #include "celix_constants.h"
 #include "celix_library_loader.h"
+#include "archive.h"
 #include <dlfcn.h>
+#include <stdio.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
-celix_library_handle_t* celix_libloader_open(celix_bundle_context_t *ctx, const char *libPath) {
+static bool celix_libloader_useNoDelete(celix_bundle_context_t *ctx) {
 #if defined(DEBUG) && !defined(ANDROID)
     bool def = true;
 #else
     bool def = false;
 #endif
-    bool noDelete = celix_bundleContext_getPropertyAsBool(ctx, CELIX_LOAD_BUNDLES_WITH_NODELETE, def);
+    return celix_bundleContext_getPropertyAsBool(ctx, CELIX_LOAD_BUNDLES_WITH_NODELETE, def);
+}
+
+celix_library_handle_t* celix_libloader_open(celix_bundle_context_t *ctx, const char *libPath) {
+    bool noDelete = celix_libloader_useNoDelete(ctx);
     if (noDelete) {
         return dlopen(libPath, RTLD_LAZY|RTLD_LOCAL|RTLD_NODELETE);
     } else {
@@ -35,6 +45,29 @@ celix_library_handle_t* celix_libloader_open(celix_bundle_context_t *ctx, const
     }
 }
 
+celix_library_handle_t* celix_libloader_openFromZip(celix_bundle_context_t *ctx, const char *zipPath, const char *entryName, int *memFd) {
+    *memFd = -1;
+#ifdef __linux__
+    int fd = memfd_create(entryName, MFD_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    celix_library_handle_t* handle = NULL;
+    if (writeBundleEntry(zipPath, entryName, fd) == CELIX_SUCCESS) {
+        char path[64];
+        snprintf(path, sizeof(path), "/proc/self/fd/%i", fd);
+        handle = celix_libloader_open(ctx, path);
+    }
+    if (handle == NULL) {
+        close(fd);
+    } else if (!celix_libloader_useNoDelete(ctx)) {
+        *memFd = fd;
+    }
+    return handle;
+#else
+    return NULL;
+#endif
+}
 
 void celix_libloader_close(celix_library_handle_t *handle) {
     dlclose(handle);
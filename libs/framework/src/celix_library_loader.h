@@ -25,6 +25,18 @@
 typedef void celix_library_handle_t;
 
 celix_library_handle_t* celix_libloader_open(celix_bundle_context_t *ctx, const char *libPath);
+
+/**
+ * Opens a library entry of a bundle zip without extracting it, by copying the library to a memory file (memfd) and
+ * opening the memory file using its /proc/self/fd path. Only supported on Linux.
+ *
+ * The memory file descriptor must stay open as long as the library is loaded, because the loaded library is known by
+ * its /proc/self/fd path. If the library is loaded with RTLD_NODELETE (see CELIX_LOAD_BUNDLES_WITH_NODELETE) the
+ * library is never unloaded and the memory file descriptor is kept open; memFd is then set to -1.
+ *
+ * @param[out] memFd The memory file descriptor which should be closed after the library is closed, or -1.
+ */
+celix_library_handle_t* celix_libloader_openFromZip(celix_bundle_context_t *ctx, const char *zipPath, const char *entryName, int *memFd);
 void celix_libloader_close(celix_library_handle_t *handle);
 void* celix_libloader_getSymbol(celix_library_handle_t *handle, const char *name);
 const char* celix_libloader_getLastError();
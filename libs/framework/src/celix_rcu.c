@@ -0,0 +1,108 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <sched.h>
+
+#include "celix_rcu.h"
+#include "celix_threads.h"
+
+#define CELIX_RCU_NR_OF_READER_SLOTS 64
+#define CELIX_RCU_CACHE_LINE_SIZE 64
+
+/**
+ * Reader slot with a reader counter per epoch index. Padded to a cache line, so that readers using different slots
+ * do not share a cache line.
+ */
+typedef struct celix_rcu_reader_slot {
+    long counts[2]; //NOTE atomic
+    char padding[CELIX_RCU_CACHE_LINE_SIZE - 2 * sizeof(long)];
+} celix_rcu_reader_slot_t;
+
+struct celix_rcu {
+    celix_rcu_reader_slot_t slots[CELIX_RCU_NR_OF_READER_SLOTS];
+    int index; //NOTE atomic. The epoch index (0 or 1) used by new readers.
+    celix_thread_mutex_t syncMutex; //serializes celix_rcu_synchronize calls
+};
+
+static int celix_rcu_nextThreadSlot = 0; //NOTE atomic
+static __thread int celix_rcu_threadSlot = -1;
+
+static inline int celix_rcu_slotForCurrentThread() {
+    if (celix_rcu_threadSlot < 0) {
+        celix_rcu_threadSlot = __atomic_fetch_add(&celix_rcu_nextThreadSlot, 1, __ATOMIC_RELAXED) % CELIX_RCU_NR_OF_READER_SLOTS;
+    }
+    return celix_rcu_threadSlot;
+}
+
+celix_rcu_t* celix_rcu_create() {
+    celix_rcu_t* rcu = NULL;
+    if (posix_memalign((void**)&rcu, CELIX_RCU_CACHE_LINE_SIZE, sizeof(*rcu)) != 0) {
+        return NULL;
+    }
+    for (int i = 0; i < CELIX_RCU_NR_OF_READER_SLOTS; ++i) {
+        rcu->slots[i].counts[0] = 0;
+        rcu->slots[i].counts[1] = 0;
+    }
+    rcu->index = 0;
+    celixThreadMutex_create(&rcu->syncMutex, NULL);
+    return rcu;
+}
+
+void celix_rcu_destroy(celix_rcu_t* rcu) {
+    if (rcu != NULL) {
+        celixThreadMutex_destroy(&rcu->syncMutex);
+        free(rcu);
+    }
+}
+
+int celix_rcu_readLock(celix_rcu_t* rcu) {
+    int slot = celix_rcu_slotForCurrentThread();
+    int idx = __atomic_load_n(&rcu->index, __ATOMIC_SEQ_CST);
+    __atomic_fetch_add(&rcu->slots[slot].counts[idx], 1, __ATOMIC_SEQ_CST);
+    return slot * 2 + idx;
+}
+
+void celix_rcu_readUnlock(celix_rcu_t* rcu, int token) {
+    __atomic_fetch_sub(&rcu->slots[token / 2].counts[token % 2], 1, __ATOMIC_RELEASE);
+}
+
+static void celix_rcu_waitForReaders(celix_rcu_t* rcu, int idx) {
+    for (int i = 0; i < CELIX_RCU_NR_OF_READER_SLOTS; ++i) {
+        while (__atomic_load_n(&rcu->slots[i].counts[idx], __ATOMIC_SEQ_CST) != 0) {
+            sched_yield();
+        }
+    }
+}
+
+void celix_rcu_synchronize(celix_rcu_t* rcu) {
+    celixThreadMutex_lock(&rcu->syncMutex);
+    int idx = __atomic_load_n(&rcu->index, __ATOMIC_SEQ_CST);
+
+    //Readers which read the epoch index just before a previous flip can still be counted for the other index.
+    //New readers use the current index, so waiting for the other index will not starve.
+    celix_rcu_waitForReaders(rcu, 1 - idx);
+
+    //Flip the index, so that new readers are counted for the other index, and wait for the readers of this index.
+    //Readers which increase the count of this index after the flip have read the index before the flip, but will
+    //read the published data after their increment and thus see the new version.
+    __atomic_store_n(&rcu->index, 1 - idx, __ATOMIC_SEQ_CST);
+    celix_rcu_waitForReaders(rcu, idx);
+    celixThreadMutex_unlock(&rcu->syncMutex);
+}
@@ -0,0 +1,66 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_RCU_H_
+#define CELIX_RCU_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A read-copy-update domain, used to protect data which is read lock-free and replaced by writers.
+ *
+ * Readers mark a read section with celix_rcu_readLock/celix_rcu_readUnlock. A reader only updates the counter of
+ * its own reader slot (a cache line per slot, threads are spread over the slots), so readers do not block and do not
+ * contend with each other.
+ * A writer publishes a new version of the data and calls celix_rcu_synchronize before freeing the old version;
+ * celix_rcu_synchronize waits until all read sections which could still use the old version are ended.
+ *
+ * A read section should be short and must not call celix_rcu_synchronize (of the same domain).
+ */
+typedef struct celix_rcu celix_rcu_t;
+
+celix_rcu_t* celix_rcu_create();
+
+void celix_rcu_destroy(celix_rcu_t* rcu);
+
+/**
+ * @brief Starts a read section.
+ * @return The token to provide to celix_rcu_readUnlock.
+ */
+int celix_rcu_readLock(celix_rcu_t* rcu);
+
+/**
+ * @brief Ends a read section.
+ */
+void celix_rcu_readUnlock(celix_rcu_t* rcu, int token);
+
+/**
+ * @brief Waits until all read sections started before this call are ended.
+ *
+ * Should be called after publishing a new version of the protected data and before freeing the old version.
+ */
+void celix_rcu_synchronize(celix_rcu_t* rcu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_RCU_H_ */
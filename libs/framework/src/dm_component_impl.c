@@ -28,6 +28,7 @@
 #include "celix_filter.h"
 #include "dm_component_impl.h"
 #include "celix_framework.h"
+#include "framework_private.h"
 
 struct celix_dm_component_struct {
     char uuid[DM_COMPONENT_MAX_ID_LENGTH];
@@ -57,6 +58,19 @@ struct celix_dm_component_struct {
     size_t nrOfTimesResumed;
 
     bool isEnabled;
+
+    /**
+     * Whether a batched handle change event is scheduled on the event loop.
+     * Service dependency events for a component are batched, so that the resume and state transition are only
+     * performed once for all events handled in the same event loop iteration.
+     */
+    bool changePending;
+
+    /**
+     * Whether the component is suspended for a batch of service dependency events. The component will be resumed
+     * in the batched handle change event.
+     */
+    bool suspended;
 };
 
 typedef struct dm_interface_struct {
@@ -72,6 +86,7 @@ static bool celix_dmComponent_areAllRequiredServiceDependenciesResolved(celix_dm
 static bool celix_dmComponent_performTransition(celix_dm_component_t *component, celix_dm_component_state_t oldState, celix_dm_component_state_t newState);
 static celix_status_t celix_dmComponent_calculateNewState(celix_dm_component_t *component, celix_dm_component_state_t currentState, celix_dm_component_state_t *newState);
 static celix_status_t celix_dmComponent_handleChange(celix_dm_component_t *component);
+static void celix_dmComponent_scheduleHandleChange(celix_dm_component_t *component);
 static celix_status_t celix_dmComponent_handleAdd(celix_dm_component_t *component, const celix_dm_event_t* event);
 static celix_status_t celix_dmComponent_handleRemove(celix_dm_component_t *component, const celix_dm_event_t* event);
 static celix_status_t celix_dmComponent_handleSet(celix_dm_component_t *component, const celix_dm_event_t* event);
@@ -131,6 +146,8 @@ celix_dm_component_t* celix_dmComponent_createWithUUID(bundle_context_t *context
     component->removedDependencies = celix_arrayList_create();
     celixThreadMutex_create(&component->mutex, NULL);
     component->isEnabled = false;
+    component->changePending = false;
+    component->suspended = false;
     return component;
 }
 
@@ -153,7 +170,7 @@ void celix_dmComponent_destroy(celix_dm_component_t *component) {
     if (component != NULL) {
         celix_dmComponent_destroyAsync(component, NULL, NULL);
 
-        if (celix_framework_isCurrentThreadTheEventLoop(celix_bundleContext_getFramework(component->context))) {
+        if (celix_framework_isCurrentThreadTheEventLoopForBnd(celix_bundleContext_getFramework(component->context), celix_bundleContext_getBundleId(component->context))) {
             celix_bundleContext_log(component->context, CELIX_LOG_LEVEL_ERROR,
                    "Cannot synchronized destroy dm component on Celix event thread. Use celix_dmComponent_destroyAsync instead!");
         } else {
@@ -344,6 +361,7 @@ static celix_status_t celix_dmComponent_disable(celix_dm_component_t *component)
  */
 static void celix_dmComponent_disableDirectly(celix_dm_component_t *component) {
     component->isEnabled = false;
+    component->suspended = false;
     component->state = DM_CMP_STATE_INACTIVE;
     celix_dmComponent_unregisterServices(component, false);
     celix_dmComponent_disableDependencies(component);
@@ -389,6 +407,7 @@ static bool celix_dmComponent_isDisabled(celix_dm_component_t *component) {
     celixThreadMutex_lock(&component->mutex);
     isStopped =
             !component->isEnabled &&
+            !component->changePending &&
             component->state == DM_CMP_STATE_INACTIVE &&
             celix_dmComponent_areAllDependenciesDisabled(component);
     celixThreadMutex_unlock(&component->mutex);
@@ -516,7 +535,13 @@ celix_status_t celix_private_dmComponent_handleEvent(celix_dm_component_t *compo
 
 static celix_status_t celix_dmComponent_suspend(celix_dm_component_t *component, celix_dm_service_dependency_t *dependency) {
 	celix_status_t status = CELIX_SUCCESS;
+	celixThreadMutex_lock(&component->mutex);
+	bool alreadySuspended = component->suspended;
 	if (component->callbackStop != NULL) {
+	    component->suspended = true;
+	}
+	celixThreadMutex_unlock(&component->mutex);
+	if (component->callbackStop != NULL && !alreadySuspended) {
         celix_bundleContext_log(component->context, CELIX_LOG_LEVEL_TRACE,
                "Suspending component %s (uuid=%s)",
                component->name,
@@ -587,22 +612,23 @@ static celix_status_t celix_dmComponent_handleEvent(celix_dm_component_t *compon
                             event->dep->serviceName);
 
     bool eventHandled = false;
+    //note the resume of a suspended component and the state change are batched; they are handled once for all
+    //service dependency events of the component in the current event loop iteration.
     if (event->eventType == CELIX_DM_EVENT_SVC_ADD || (event->eventType == CELIX_DM_EVENT_SVC_SET && event->svc != NULL)) {
-        //note adding service or setting new service, so cmp will not be stopped in handleChange -> use suspend / resume now
+        //note adding service or setting new service, so cmp will not be stopped in handleChange -> use suspend now
         eventHandled = true;
         bool needSuspend = celix_dmComponent_needsSuspend(component, event);
         if (needSuspend) {
             celix_dmComponent_suspend(component, event->dep);
         }
         setAddOrRemFp(event->dep, event->svc, event->props);
-        if (needSuspend) {
-            celix_dmComponent_resume(component, event->dep);
-        }
+        celix_dmComponent_scheduleHandleChange(component);
     };
 
-    celix_dmComponent_handleChange(component);
-
     if (!eventHandled /*remove or set null*/) {
+        //note removing svc or set svc to null can stop the component, this is handled directly
+        celix_dmComponent_handleChange(component);
+
         //removing svc or set svc to null -> if still active check if suspend is needed before invoking
         bool needSuspend = celix_dmComponent_needsSuspend(component, event);
         if (needSuspend) {
@@ -610,7 +636,7 @@ static celix_status_t celix_dmComponent_handleEvent(celix_dm_component_t *compon
         }
         setAddOrRemFp(event->dep, event->svc, event->props);
         if (needSuspend) {
-            celix_dmComponent_resume(component, event->dep);
+            celix_dmComponent_scheduleHandleChange(component);
         }
     }
 
@@ -657,7 +683,7 @@ static celix_status_t celix_dmComponent_disableDependencies(celix_dm_component_t
  */
 static void celix_dmComponent_handleChangeOnEventThread(void *data) {
     celix_dm_component_t* component = data;
-    assert(celix_framework_isCurrentThreadTheEventLoop(celix_bundleContext_getFramework(component->context)));
+    assert(celix_framework_isCurrentThreadTheEventLoopForBnd(celix_bundleContext_getFramework(component->context), celix_bundleContext_getBundleId(component->context)));
 
     celixThreadMutex_lock(&component->mutex);
     celix_dm_component_state_t oldState;
@@ -680,9 +706,50 @@ static void celix_dmComponent_handleChangeOnEventThread(void *data) {
     celixThreadMutex_unlock(&component->mutex);
 }
 
+/**
+ * Resume a suspended component (if needed) and calculate and handle state change for a batch of service dependency
+ * events.
+ */
+static void celix_dmComponent_handleBatchedChangeOnEventThread(void *data) {
+    celix_dm_component_t* component = data;
+    celixThreadMutex_lock(&component->mutex);
+    component->changePending = false;
+    bool resume = component->suspended;
+    component->suspended = false;
+    celixThreadMutex_unlock(&component->mutex);
+
+    if (resume) {
+        celix_dmComponent_resume(component, NULL);
+    }
+    celix_dmComponent_handleChangeOnEventThread(component);
+}
+
+/**
+ * Schedule a batched state change at the end of the current event loop batch, if not already scheduled.
+ */
+static void celix_dmComponent_scheduleHandleChange(celix_dm_component_t *component) {
+    celixThreadMutex_lock(&component->mutex);
+    bool schedule = !component->changePending;
+    component->changePending = true;
+    celixThreadMutex_unlock(&component->mutex);
+    celix_framework_t* fw = celix_bundleContext_getFramework(component->context);
+    if (schedule && !celix_framework_scheduleEndOfEventBatchCallback(fw, celix_bundleContext_getBundleId(component->context), component, celix_dmComponent_handleBatchedChangeOnEventThread)) {
+        //note not called on the event loop thread, fallback to a separate event
+        celix_framework_fireGenericEvent(
+                fw,
+                -1,
+                celix_bundleContext_getBundleId(component->context),
+                "dm component handle batched change",
+                component,
+                celix_dmComponent_handleBatchedChangeOnEventThread,
+                NULL,
+                NULL);
+    }
+}
+
 static celix_status_t celix_dmComponent_handleChange(celix_dm_component_t *component) {
     celix_framework_t* fw = celix_bundleContext_getFramework(component->context);
-    if (celix_framework_isCurrentThreadTheEventLoop(fw)) {
+    if (celix_framework_isCurrentThreadTheEventLoopForBnd(fw, celix_bundleContext_getBundleId(component->context))) {
         celix_dmComponent_handleChangeOnEventThread(component);
     } else {
         celix_framework_fireGenericEvent(
@@ -782,7 +849,10 @@ static bool celix_dmComponent_performTransition(celix_dm_component_t *component,
         }
     } else if (currentState == DM_CMP_STATE_TRACKING_OPTIONAL && desiredState == DM_CMP_STATE_INSTANTIATED_AND_WAITING_FOR_REQUIRED) {
         celix_dmComponent_unregisterServices(component, false);
-        if (component->callbackStop) {
+        if (component->suspended) {
+            //note component is already stopped for a batch of service dependency events
+            component->suspended = false;
+        } else if (component->callbackStop) {
         	status = component->callbackStop(component->implementation);
         }
     } else if (currentState == DM_CMP_STATE_INSTANTIATED_AND_WAITING_FOR_REQUIRED && desiredState == DM_CMP_STATE_WAITING_FOR_REQUIRED) {
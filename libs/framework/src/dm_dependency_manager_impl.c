@@ -29,6 +29,7 @@
 #include "celix_dependency_manager.h"
 #include "celix_bundle.h"
 #include "celix_framework.h"
+#include "framework_private.h"
 
 celix_dependency_manager_t* celix_private_dependencyManager_create(celix_bundle_context_t *context) {
 	celix_dependency_manager_t *manager = calloc(1, sizeof(*manager));
@@ -252,7 +253,7 @@ size_t celix_dependencyManager_nrOfComponents(celix_dependency_manager_t *mng) {
 
 void celix_dependencyManager_wait(celix_dependency_manager_t *mng) {
     celix_framework_t *fw = celix_bundleContext_getFramework(mng->ctx);
-    if (!celix_framework_isCurrentThreadTheEventLoop(fw)) {
+    if (!celix_framework_isCurrentThreadTheEventLoopForBnd(fw, celix_bundleContext_getBundleId(mng->ctx))) {
         celix_bundleContext_waitForEvents(mng->ctx);
     } else {
         celix_bundleContext_log(mng->ctx, CELIX_LOG_LEVEL_WARNING,
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <inttypes.h>
 #include <unistd.h>
 #include "celixbool.h"
 #include <uuid/uuid.h>
@@ -39,6 +40,7 @@
 #include "bundle_context_private.h"
 #include "service_tracker.h"
 #include "celix_library_loader.h"
+#include "bundle_revision_private.h"
 #include "celix_log_constants.h"
 
 typedef celix_status_t (*create_function_fp)(bundle_context_t *context, void **userData);
@@ -155,7 +157,7 @@ celix_status_t fw_populateDependentGraph(framework_pt framework, bundle_pt expor
 
 void fw_fireBundleEvent(framework_pt framework, bundle_event_type_e, celix_framework_bundle_entry_t* entry);
 void fw_fireFrameworkEvent(framework_pt framework, framework_event_type_e eventType, celix_status_t errorCode);
-static void *fw_eventDispatcher(void *fw);
+static void *fw_eventDispatcher(void *data);
 
 celix_status_t fw_invokeBundleListener(framework_pt framework, bundle_listener_pt listener, bundle_event_pt event, bundle_pt bundle);
 celix_status_t fw_invokeFrameworkListener(framework_pt framework, framework_listener_pt listener, framework_event_pt event, bundle_pt bundle);
@@ -171,7 +173,9 @@ static celix_status_t frameworkActivator_destroy(void * userData, bundle_context
 static void framework_autoStartConfiguredBundles(celix_framework_t *fw);
 static void framework_autoInstallConfiguredBundlesForList(celix_framework_t *fw, const char *autoStart, celix_array_list_t *installedBundles);
 static void framework_autoStartConfiguredBundlesForList(celix_framework_t* fw, const celix_array_list_t *installedBundles);
-static void celix_framework_addToEventQueue(celix_framework_t *fw, const celix_framework_event_t* event);
+static void framework_autoStartConfiguredBundlesForListConcurrently(celix_framework_t* fw, const celix_array_list_t *installedBundles);
+static char* resolveBundleLocation(celix_framework_t *fw, const char *bndLoc, const char *p);
+static void celix_framework_addToEventQueue(celix_framework_t *fw, celix_framework_event_t* event);
 
 struct fw_bundleListener {
 	bundle_pt bundle;
@@ -224,26 +228,66 @@ struct fw_frameworkListener {
 typedef struct fw_frameworkListener * fw_framework_listener_pt;
 
 
+/**
+ * Returns the trace start time, or 0 if tracing is not enabled.
+ */
+static inline uint64_t fw_traceStart(celix_framework_t* fw) {
+    return fw->tracing.trace != NULL ? celix_frameworkTrace_now() : 0;
+}
+
+static inline void fw_traceRecord(celix_framework_t* fw, celix_framework_trace_event_type_e type, const celix_bundle_t* bnd, uint64_t startTime) {
+    if (fw->tracing.trace != NULL) {
+        celix_frameworkTrace_record(fw->tracing.trace, type, celix_bundle_getId(bnd), celix_bundle_getSymbolicName(bnd), startTime);
+    }
+}
+
 celix_status_t framework_create(framework_pt *out, celix_properties_t* config) {
     celix_framework_t* framework = calloc(1, sizeof(*framework));
 
     celixThreadCondition_init(&framework->shutdown.cond, NULL);
     celixThreadMutex_create(&framework->shutdown.mutex, NULL);
-    celixThreadMutex_create(&framework->dispatcher.mutex, NULL);
     celixThreadMutex_create(&framework->frameworkListenersLock, NULL);
     celixThreadMutex_create(&framework->bundleListenerLock, NULL);
     celixThreadMutex_create(&framework->installedBundles.mutex, NULL);
-    celixThreadCondition_init(&framework->dispatcher.cond, NULL);
-    framework->dispatcher.active = true;
+    celixThreadMutex_create(&framework->resolverMutex, NULL);
     framework->nextBundleId = CELIX_FRAMEWORK_BUNDLE_ID + 1;
-    framework->installRequestMap = hashMap_create(utils_stringHash, utils_stringHash, utils_stringEquals, utils_stringEquals);
     framework->installedBundles.entries = celix_arrayList_create();
     framework->configurationMap = config;
     framework->bundleListeners = celix_arrayList_create();
     framework->frameworkListeners = celix_arrayList_create();
-    framework->dispatcher.eventQueueCap = (int)celix_properties_getAsLong(config, CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE, CELIX_FRAMEWORK_DEFAULT_STATIC_EVENT_QUEUE_SIZE);
-    framework->dispatcher.eventQueue = malloc(sizeof(celix_framework_event_t) * framework->dispatcher.eventQueueCap);
-    framework->dispatcher.dynamicEventQueue = celix_arrayList_create();
+    long eventQueueSize = celix_properties_getAsLong(config, CELIX_FRAMEWORK_STATIC_EVENT_QUEUE_SIZE, CELIX_FRAMEWORK_DEFAULT_STATIC_EVENT_QUEUE_SIZE);
+    long nrOfEventLoops = celix_properties_getAsLong(config, CELIX_FRAMEWORK_NR_OF_EVENT_LOOPS, CELIX_FRAMEWORK_DEFAULT_NR_OF_EVENT_LOOPS);
+    framework->dispatcher.nrOfLoops = nrOfEventLoops > 0 ? (int)nrOfEventLoops : 1;
+    framework->dispatcher.loops = calloc(framework->dispatcher.nrOfLoops, sizeof(celix_framework_event_loop_t));
+    celixThreadMutex_create(&framework->dispatcher.waitMutex, NULL);
+    for (int i = 0; i < framework->dispatcher.nrOfLoops; ++i) {
+        celix_framework_event_loop_t* loop = &framework->dispatcher.loops[i];
+        loop->fw = framework;
+        celixThreadMutex_create(&loop->mutex, NULL);
+        celixThreadCondition_init(&loop->cond, NULL);
+        loop->active = true;
+        loop->ringCap = 2;
+        while (loop->ringCap < eventQueueSize) {
+            loop->ringCap *= 2;
+        }
+        loop->ring = malloc(sizeof(celix_framework_event_slot_t) * loop->ringCap);
+        for (size_t k = 0; k < loop->ringCap; ++k) {
+            loop->ring[k].seq = k;
+        }
+        loop->endOfBatchCallbacks = celix_deque_create(sizeof(celix_framework_end_of_batch_callback_t));
+    }
+
+    framework->tracing.svcId = -1L;
+    if (celix_properties_getAsBool(config, CELIX_FRAMEWORK_TRACE_ENABLED, false)) {
+        long traceSize = celix_properties_getAsLong(config, CELIX_FRAMEWORK_TRACE_BUFFER_SIZE, CELIX_FRAMEWORK_DEFAULT_TRACE_BUFFER_SIZE);
+        framework->tracing.trace = celix_frameworkTrace_create(traceSize > 0 ? (size_t)traceSize : CELIX_FRAMEWORK_DEFAULT_TRACE_BUFFER_SIZE);
+    }
+
+    framework->metrics.svcId = -1L;
+    if (celix_properties_getAsBool(config, CELIX_FRAMEWORK_EVENT_METRICS_ENABLED, false)) {
+        long threshold = celix_properties_getAsLong(config, CELIX_FRAMEWORK_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US, CELIX_FRAMEWORK_DEFAULT_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US);
+        framework->metrics.metrics = celix_frameworkMetrics_create(threshold >= 0 ? (uint64_t)threshold : CELIX_FRAMEWORK_DEFAULT_EVENT_METRICS_BLOCKING_THRESHOLD_IN_US);
+    }
 
     //create and store framework uuid
     char uuid[37];
@@ -326,10 +370,11 @@ celix_status_t framework_destroy(framework_pt framework) {
         if (count > 0) {
             const char *bndName = celix_bundle_getSymbolicName(bnd);
             fw_log(framework->logger, CELIX_LOG_LEVEL_FATAL, "Cannot destroy framework. The use count of bundle %s (bnd id %li) is not 0, but %u.", bndName, entry->bndId, count);
-            celixThreadMutex_lock(&framework->dispatcher.mutex);
-            int nrOfRequests = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
-            celixThreadMutex_unlock(&framework->dispatcher.mutex);
-            fw_log(framework->logger, CELIX_LOG_LEVEL_WARNING, "nr of request left: %i (should be 0).", nrOfRequests);
+            size_t nrOfRequests = 0;
+            for (int k = 0; k < framework->dispatcher.nrOfLoops; ++k) {
+                nrOfRequests += __atomic_load_n(&framework->dispatcher.loops[k].pendingEvents, __ATOMIC_ACQUIRE);
+            }
+            fw_log(framework->logger, CELIX_LOG_LEVEL_WARNING, "nr of request left: %zu (should be 0).", nrOfRequests);
         }
         fw_bundleEntry_destroy(entry, true);
 
@@ -364,14 +409,13 @@ celix_status_t framework_destroy(framework_pt framework) {
     celixThreadMutex_unlock(&framework->installedBundles.mutex);
     celix_arrayList_destroy(framework->installedBundles.entries);
     celixThreadMutex_destroy(&framework->installedBundles.mutex);
+    celixThreadMutex_destroy(&framework->resolverMutex);
 
     //teardown framework bundle lifecycle handling
     celixThreadMutex_destroy(&framework->bundleLifecycleHandling.mutex);
     assert(celix_arrayList_size(framework->bundleLifecycleHandling.bundleLifecycleHandlers) == 0);
     celix_arrayList_destroy(framework->bundleLifecycleHandling.bundleLifecycleHandlers);
 
-    hashMap_destroy(framework->installRequestMap, false, false);
-
     if (framework->bundleListeners) {
         arrayList_destroy(framework->bundleListeners);
     }
@@ -379,15 +423,26 @@ celix_status_t framework_destroy(framework_pt framework) {
         arrayList_destroy(framework->frameworkListeners);
     }
 
-    assert(celix_arrayList_size(framework->dispatcher.dynamicEventQueue) == 0);
-    celix_arrayList_destroy(framework->dispatcher.dynamicEventQueue);
+    for (int i = 0; i < framework->dispatcher.nrOfLoops; ++i) {
+        celix_framework_event_loop_t* loop = &framework->dispatcher.loops[i];
+        assert(loop->overflowSize == 0);
+        free(loop->overflowFirst); //note at most one (empty) segment left
+        free(loop->ring);
+        assert(celix_deque_isEmpty(loop->endOfBatchCallbacks));
+        celix_deque_destroy(loop->endOfBatchCallbacks);
+        celixThreadCondition_destroy(&loop->cond);
+        celixThreadMutex_destroy(&loop->mutex);
+    }
+    free(framework->dispatcher.loops);
+    celixThreadMutex_destroy(&framework->dispatcher.waitMutex);
+
+    celix_frameworkTrace_destroy(framework->tracing.trace);
+    celix_frameworkMetrics_destroy(framework->metrics.metrics);
 
 	bundleCache_destroy(&framework->cache);
 
-	celixThreadCondition_destroy(&framework->dispatcher.cond);
     celixThreadMutex_destroy(&framework->frameworkListenersLock);
 	celixThreadMutex_destroy(&framework->bundleListenerLock);
-	celixThreadMutex_destroy(&framework->dispatcher.mutex);
 	celixThreadMutex_destroy(&framework->shutdown.mutex);
 	celixThreadCondition_destroy(&framework->shutdown.cond);
 
@@ -395,16 +450,18 @@ celix_status_t framework_destroy(framework_pt framework) {
 
     properties_destroy(framework->configurationMap);
 
-    free(framework->dispatcher.eventQueue);
     free(framework);
 
 	return status;
 }
 
 celix_status_t fw_init(framework_pt framework) {
-    celixThreadMutex_lock(&framework->dispatcher.mutex);
-    framework->dispatcher.active = true;
-    celixThreadMutex_unlock(&framework->dispatcher.mutex);
+    for (int i = 0; i < framework->dispatcher.nrOfLoops; ++i) {
+        celix_framework_event_loop_t* loop = &framework->dispatcher.loops[i];
+        celixThreadMutex_lock(&loop->mutex);
+        loop->active = true;
+        celixThreadMutex_unlock(&loop->mutex);
+    }
 
     celixThreadMutex_lock(&framework->shutdown.mutex);
     framework->shutdown.done = false;
@@ -413,8 +470,17 @@ celix_status_t fw_init(framework_pt framework) {
     celixThreadMutex_unlock(&framework->shutdown.mutex);
 
 
-	celixThread_create(&framework->dispatcher.thread, NULL, fw_eventDispatcher, framework);
-	celixThread_setName(&framework->dispatcher.thread, "CelixEvent");
+    for (int i = 0; i < framework->dispatcher.nrOfLoops; ++i) {
+        celix_framework_event_loop_t* loop = &framework->dispatcher.loops[i];
+        celixThread_create(&loop->thread, NULL, fw_eventDispatcher, loop);
+        if (i == 0) {
+            celixThread_setName(&loop->thread, "CelixEvent");
+        } else {
+            char name[16];
+            snprintf(name, sizeof(name), "CelixEvent%i", i);
+            celixThread_setName(&loop->thread, name);
+        }
+    }
 
     bool cleanCache = celix_properties_getAsBool(framework->configurationMap, OSGI_FRAMEWORK_FRAMEWORK_STORAGE_CLEAN_NAME, OSGI_FRAMEWORK_FRAMEWORK_STORAGE_CLEAN_DEFAULT);
     if (cleanCache) {
@@ -524,62 +590,215 @@ celix_status_t framework_start(framework_pt framework) {
 	return status;
 }
 
+/**
+ * @brief A pool of worker threads which concurrently run a fixed number of tasks.
+ * Tasks are picked up by the workers in task index order.
+ */
+typedef struct celix_framework_task_pool {
+    size_t nrOfTasks;
+    size_t nextTask; //NOTE atomic
+    void* data;
+    void (*run)(void* data, size_t taskIndex);
+} celix_framework_task_pool_t;
+
+static void* framework_taskPoolWorker(void* data) {
+    celix_framework_task_pool_t* pool = data;
+    size_t task = __atomic_fetch_add(&pool->nextTask, 1, __ATOMIC_RELAXED);
+    while (task < pool->nrOfTasks) {
+        pool->run(pool->data, task);
+        task = __atomic_fetch_add(&pool->nextTask, 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Runs all the tasks of the pool and returns when all tasks are done.
+ * The calling thread also acts as a worker, so at most (nr of online cpus - 1) additional threads are created.
+ */
+static void framework_runTaskPool(celix_framework_task_pool_t* pool) {
+    long nrOfCpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t nrOfThreads = nrOfCpus > 1 ? (size_t)nrOfCpus - 1 : 0;
+    if (pool->nrOfTasks < nrOfThreads + 1) {
+        nrOfThreads = pool->nrOfTasks > 0 ? pool->nrOfTasks - 1 : 0;
+    }
+    celix_thread_t* threads = nrOfThreads > 0 ? calloc(nrOfThreads, sizeof(*threads)) : NULL;
+    size_t started = 0;
+    for (size_t i = 0; threads != NULL && i < nrOfThreads; ++i) {
+        if (celixThread_create(&threads[i], NULL, framework_taskPoolWorker, pool) != CELIX_SUCCESS) {
+            break;
+        }
+        started += 1;
+    }
+    framework_taskPoolWorker(pool);
+    for (size_t i = 0; i < started; ++i) {
+        celixThread_join(threads[i], NULL);
+    }
+    free(threads);
+}
+
+/**
+ * @brief A bundle to be auto installed. The bundle archive is created (bundle extracted and manifest parsed) by a
+ * worker of the task pool.
+ */
+typedef struct celix_framework_auto_install_entry {
+    char* location; //the configured location
+    char* resolvedLocation;
+    long bndId;
+    bundle_archive_pt archive; //NULL if the bundle was already installed or if creating the archive failed
+    celix_status_t status;
+} celix_framework_auto_install_entry_t;
+
+typedef struct celix_framework_auto_install_data {
+    celix_framework_t* fw;
+    celix_framework_auto_install_entry_t* entries;
+} celix_framework_auto_install_data_t;
+
+typedef struct celix_framework_auto_start_data {
+    celix_framework_t* fw;
+    const celix_array_list_t* bundles;
+} celix_framework_auto_start_data_t;
+
 static void framework_autoStartConfiguredBundles(celix_framework_t* fw) {
     bundle_context_t *fwCtx = framework_getContext(fw);
     const char* cosgiKeys[] = {"cosgi.auto.start.0","cosgi.auto.start.1","cosgi.auto.start.2","cosgi.auto.start.3","cosgi.auto.start.4","cosgi.auto.start.5","cosgi.auto.start.6"};
     const char* celixKeys[] = {CELIX_AUTO_START_0, CELIX_AUTO_START_1, CELIX_AUTO_START_2, CELIX_AUTO_START_3, CELIX_AUTO_START_4, CELIX_AUTO_START_5, CELIX_AUTO_START_6};
-    celix_array_list_t *installedBundles = celix_arrayList_create();
-    size_t len = 7;
+    celix_array_list_t* installedBundles[sizeof(celixKeys) / sizeof(celixKeys[0])]; //per auto start level
+    size_t len = sizeof(celixKeys) / sizeof(celixKeys[0]);
     for (int i = 0; i < len; ++i) {
+        installedBundles[i] = celix_arrayList_create();
         const char *autoStart = celix_bundleContext_getProperty(fwCtx, celixKeys[i], NULL);
         if (autoStart == NULL) {
             autoStart = celix_bundleContext_getProperty(fwCtx, cosgiKeys[i], NULL);
         }
         if (autoStart != NULL) {
-            framework_autoInstallConfiguredBundlesForList(fw, autoStart, installedBundles);
+            framework_autoInstallConfiguredBundlesForList(fw, autoStart, installedBundles[i]);
         }
     }
-    framework_autoStartConfiguredBundlesForList(fw, installedBundles);
-    celix_arrayList_destroy(installedBundles);
+
+    bool parallel = celix_bundleContext_getPropertyAsBool(fwCtx, CELIX_AUTO_START_PARALLEL, false);
+    for (int i = 0; i < len; ++i) {
+        if (parallel) {
+            framework_autoStartConfiguredBundlesForListConcurrently(fw, installedBundles[i]);
+        } else {
+            framework_autoStartConfiguredBundlesForList(fw, installedBundles[i]);
+        }
+        celix_arrayList_destroy(installedBundles[i]);
+    }
 }
 
+static void framework_autoInstallCreateArchive(void* data, size_t taskIndex) {
+    celix_framework_auto_install_data_t* installData = data;
+    celix_framework_auto_install_entry_t* entry = &installData->entries[taskIndex];
+    if (entry->bndId >= 0) {
+        entry->status = bundleCache_createArchive(installData->fw->cache, entry->bndId, entry->resolvedLocation, NULL, &entry->archive);
+        if (entry->status != CELIX_SUCCESS) {
+            bundleArchive_destroy(entry->archive);
+            entry->archive = NULL;
+        }
+    }
+}
 
 static void framework_autoInstallConfiguredBundlesForList(celix_framework_t* fw, const char *autoStartIn, celix_array_list_t *installedBundles) {
     bundle_context_t *fwCtx = framework_getContext(fw);
     char delims[] = " ";
     char *save_ptr = NULL;
     char *autoStart = celix_utils_strdup(autoStartIn);
+    const char *paths = NULL;
+    fw_getProperty(fw, CELIX_BUNDLES_PATH_NAME, CELIX_BUNDLES_PATH_DEFAULT, &paths);
+
+    size_t nrOfEntries = 0;
+    size_t cap = 8;
+    celix_framework_auto_install_entry_t* entries = calloc(cap, sizeof(*entries));
+
+    //first resolve the locations and assign bundle ids in the configured order
+    char *location = autoStart == NULL ? NULL : strtok_r(autoStart, delims, &save_ptr);
+    while (location != NULL) {
+        if (nrOfEntries == cap) {
+            cap *= 2;
+            entries = realloc(entries, cap * sizeof(*entries));
+        }
+        celix_framework_auto_install_entry_t* entry = &entries[nrOfEntries++];
+        memset(entry, 0, sizeof(*entry));
+        entry->location = location;
+        entry->resolvedLocation = resolveBundleLocation(fw, location, paths);
+        entry->bndId = -1L;
+        entry->status = CELIX_SUCCESS;
+        bool duplicate = false;
+        for (size_t i = 0; entry->resolvedLocation != NULL && i + 1 < nrOfEntries; ++i) {
+            if (entries[i].resolvedLocation != NULL && strcmp(entries[i].resolvedLocation, entry->resolvedLocation) == 0) {
+                duplicate = true;
+                break;
+            }
+        }
+        if (entry->resolvedLocation != NULL && !duplicate && framework_getBundle(fw, entry->resolvedLocation) == NULL) {
+            entry->bndId = framework_getNextBundleId(fw);
+        }
+        location = strtok_r(NULL, delims, &save_ptr);
+    }
 
-    if (autoStart != NULL) {
-        char *location = strtok_r(autoStart, delims, &save_ptr);
-        while (location != NULL) {
-            //first install
-            bundle_t *bnd = NULL;
-            celix_status_t  rc = bundleContext_installBundle(fwCtx, location, &bnd);
-            if (rc == CELIX_SUCCESS) {
-                celix_arrayList_add(installedBundles, bnd);
+    //extract the bundles and parse their manifests concurrently
+    celix_framework_auto_install_data_t installData = {.fw = fw, .entries = entries};
+    celix_framework_task_pool_t pool = {.nrOfTasks = nrOfEntries, .nextTask = 0, .data = &installData, .run = framework_autoInstallCreateArchive};
+    framework_runTaskPool(&pool);
+
+    //lastly create the bundles in the configured order
+    for (size_t i = 0; i < nrOfEntries; ++i) {
+        celix_framework_auto_install_entry_t* entry = &entries[i];
+        bundle_t *bnd = NULL;
+        celix_status_t rc = entry->status;
+        if (rc == CELIX_SUCCESS && entry->archive != NULL) {
+            if (framework_getBundle(fw, entry->resolvedLocation) != NULL) {
+                //installed in the meantime
+                bundleArchive_closeAndDelete(entry->archive);
+                bundleArchive_destroy(entry->archive);
+                rc = bundleContext_installBundle(fwCtx, entry->location, &bnd);
             } else {
-                printf("Could not install bundle '%s'\n", location);
+                rc = fw_installBundle2(fw, &bnd, entry->bndId, entry->location, NULL, entry->archive);
             }
-            location = strtok_r(NULL, delims, &save_ptr);
+        } else if (rc == CELIX_SUCCESS) {
+            //already installed, duplicate entry or location not found
+            rc = bundleContext_installBundle(fwCtx, entry->location, &bnd);
+        }
+        if (rc == CELIX_SUCCESS && celix_arrayList_indexOf(installedBundles, (celix_array_list_entry_t){.voidPtrVal = bnd}) < 0) {
+            celix_arrayList_add(installedBundles, bnd);
+        } else if (rc != CELIX_SUCCESS) {
+            printf("Could not install bundle '%s'\n", entry->location);
         }
+        free(entry->resolvedLocation);
     }
+
+    free(entries);
     free(autoStart);
 }
 
+static void framework_autoStartConfiguredBundle(celix_framework_t* fw, bundle_t* bnd) {
+    long bndId = -1;
+    bundle_getBundleId(bnd, &bndId);
+    bool started = celix_framework_startBundle(fw, bndId);
+    if (!started) {
+        fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Could not start bundle %s (bnd id = %li)\n", bnd->symbolicName, bndId);
+    }
+}
+
 static void framework_autoStartConfiguredBundlesForList(celix_framework_t* fw, const celix_array_list_t *installedBundles) {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
     for (int i = 0; i < celix_arrayList_size(installedBundles); ++i) {
-        long bndId = -1;
-        bundle_t *bnd = celix_arrayList_get(installedBundles, i);
-        bundle_getBundleId(bnd, &bndId);
-        bool started = celix_framework_startBundle(fw, bndId);
-        if (!started) {
-            fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Could not start bundle %s (bnd id = %li)\n", bnd->symbolicName, bndId);
-        }
+        framework_autoStartConfiguredBundle(fw, celix_arrayList_get(installedBundles, i));
     }
 }
 
+static void framework_autoStartBundleTask(void* data, size_t taskIndex) {
+    celix_framework_auto_start_data_t* startData = data;
+    framework_autoStartConfiguredBundle(startData->fw, celix_arrayList_get(startData->bundles, (int)taskIndex));
+}
+
+static void framework_autoStartConfiguredBundlesForListConcurrently(celix_framework_t* fw, const celix_array_list_t *installedBundles) {
+    assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
+    celix_framework_auto_start_data_t startData = {.fw = fw, .bundles = installedBundles};
+    celix_framework_task_pool_t pool = {.nrOfTasks = (size_t)celix_arrayList_size(installedBundles), .nextTask = 0, .data = &startData, .run = framework_autoStartBundleTask};
+    framework_runTaskPool(&pool); //note returns when all bundles of the list are started; a barrier between levels
+}
+
 celix_status_t framework_stop(framework_pt framework) {
     bool stopped = celix_framework_stopBundle(framework, CELIX_FRAMEWORK_BUNDLE_ID);
     return stopped ? CELIX_SUCCESS : CELIX_ILLEGAL_STATE;
@@ -648,6 +867,7 @@ static char* resolveBundleLocation(celix_framework_t *fw, const char *bndLoc, co
 celix_status_t fw_installBundle2(framework_pt framework, bundle_pt * bundle, long id, const char *bndLoc, const char *inputFile, bundle_archive_pt archive) {
     celix_status_t status = CELIX_SUCCESS;
     bundle_state_e state = OSGI_FRAMEWORK_BUNDLE_UNKNOWN;
+    uint64_t traceStart = fw_traceStart(framework);
 
     const char *paths = NULL;
     fw_getProperty(framework, CELIX_BUNDLES_PATH_NAME, CELIX_BUNDLES_PATH_DEFAULT, &paths);
@@ -703,6 +923,7 @@ celix_status_t fw_installBundle2(framework_pt framework, bundle_pt * bundle, lon
             celixThreadMutex_lock(&framework->installedBundles.mutex);
             celix_arrayList_add(framework->installedBundles.entries, bEntry);
             celixThreadMutex_unlock(&framework->installedBundles.mutex);
+            fw_traceRecord(framework, CELIX_FRAMEWORK_TRACE_INSTALL_BUNDLE, *bundle, traceStart);
             fw_fireBundleEvent(framework, OSGI_FRAMEWORK_BUNDLE_EVENT_INSTALLED, bEntry);
             celix_framework_bundleEntry_decreaseUseCount(bEntry);
         } else {
@@ -1262,7 +1483,9 @@ static celix_status_t framework_markBundleResolved(framework_pt framework, modul
             bool isSystemBundle = false;
             bundle_isSystemBundle(bundle, &isSystemBundle);
             if (!isSystemBundle) {
+                uint64_t traceStart = fw_traceStart(framework);
                 status = CELIX_DO_IF(status, framework_loadBundleLibraries(framework, bundle));
+                fw_traceRecord(framework, CELIX_FRAMEWORK_TRACE_LOAD_BUNDLE_LIBRARIES, bundle, traceStart);
             }
 
             status = CELIX_DO_IF(status, bundle_setState(bundle, OSGI_FRAMEWORK_BUNDLE_RESOLVED));
@@ -1389,12 +1612,15 @@ static void* framework_shutdown(void *framework) {
         celix_framework_bundleEntry_decreaseUseCount(fwEntry);
     }
 
-    //join dispatcher thread
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    fw->dispatcher.active = false;
-    celixThreadCondition_broadcast(&fw->dispatcher.cond);
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
-    celixThread_join(fw->dispatcher.thread, NULL);
+    //join dispatcher threads
+    for (int i = 0; i < fw->dispatcher.nrOfLoops; ++i) {
+        celix_framework_event_loop_t* loop = &fw->dispatcher.loops[i];
+        celixThreadMutex_lock(&loop->mutex);
+        loop->active = false;
+        celixThreadCondition_broadcast(&loop->cond);
+        celixThreadMutex_unlock(&loop->mutex);
+        celixThread_join(loop->thread, NULL);
+    }
     fw_log(fw->logger, CELIX_LOG_LEVEL_TRACE, "Joined event loop thread for framework %s", celix_framework_getUUID(framework));
 
 
@@ -1459,55 +1685,148 @@ void fw_fireFrameworkEvent(framework_pt framework, framework_event_type_e eventT
     celix_framework_addToEventQueue(framework, &event);
 }
 
-static void celix_framework_addToEventQueue(celix_framework_t *fw, const celix_framework_event_t* event) {
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    //try to add to static queue
-    if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) { //always to dynamic queue if not empty (to ensure order)
-        celix_framework_event_t *e = malloc(sizeof(*e));
-        *e = *event; //shallow copy
-        celix_arrayList_add(fw->dispatcher.dynamicEventQueue, e);
-        if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) % 100 == 0) {
-            fw_log(fw->logger, CELIX_LOG_LEVEL_WARNING, "dynamic event queue size is %i. Is there a bundle blocking on the event loop thread?", celix_arrayList_size(fw->dispatcher.dynamicEventQueue));
-        }
-    } else if (fw->dispatcher.eventQueueSize < fw->dispatcher.eventQueueCap) {
-        size_t index = (fw->dispatcher.eventQueueFirstEntry + fw->dispatcher.eventQueueSize) %
-                       fw->dispatcher.eventQueueCap;
-        fw->dispatcher.eventQueue[index] = *event; //shallow copy
-        fw->dispatcher.eventQueueSize += 1;
-    } else {
-        //static queue is full, dynamics queue is empty. Add first entry to dynamic queue
-        fw_log(fw->logger, CELIX_LOG_LEVEL_WARNING,
-               "Static event queue for celix framework is full, falling back to dynamic allocated events. Increase static event queue size, current size is %i", fw->dispatcher.eventQueueCap);
-        celix_framework_event_t *e = malloc(sizeof(*e));
-        *e = *event; //shallow copy
-        celix_arrayList_add(fw->dispatcher.dynamicEventQueue, e);
+/**
+ * Tries to add the event to the lock-free event ring. Returns false if the ring is full.
+ */
+static bool fw_tryAddToEventRing(celix_framework_event_loop_t* loop, const celix_framework_event_t* event) {
+    size_t mask = loop->ringCap - 1;
+    size_t pos = __atomic_load_n(&loop->ringTail, __ATOMIC_RELAXED);
+    for (;;) {
+        celix_framework_event_slot_t* slot = &loop->ring[pos & mask];
+        size_t seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&loop->ringTail, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                slot->event = *event; //shallow copy
+                __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+                return true;
+            }
+            //note on failure pos is updated to the current tail
+        } else if (diff < 0) {
+            //slot still in use by the event loop, ring is full
+            return false;
+        } else {
+            pos = __atomic_load_n(&loop->ringTail, __ATOMIC_RELAXED);
+        }
     }
-    celixThreadCondition_broadcast(&fw->dispatcher.cond);
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
 }
 
-static void fw_handleEventRequest(celix_framework_t *framework, celix_framework_event_t* event) {
-    if (event->type == CELIX_BUNDLE_EVENT_TYPE) {
-        celix_array_list_t *localListeners = celix_arrayList_create();
-        celixThreadMutex_lock(&framework->bundleListenerLock);
-        for (int i = 0; i < celix_arrayList_size(framework->bundleListeners); ++i) {
-            fw_bundle_listener_pt listener = arrayList_get(framework->bundleListeners, i);
-            fw_bundleListener_increaseUseCount(listener);
-            celix_arrayList_add(localListeners, listener);
+/**
+ * Adds the event to the overflow segments. Should be called with the dispatcher mutex locked.
+ */
+static void fw_addToEventOverflow(celix_framework_event_loop_t* loop, const celix_framework_event_t* event) {
+    size_t size = __atomic_load_n(&loop->overflowSize, __ATOMIC_RELAXED);
+    if (size == 0) {
+        fw_log(loop->fw->logger, CELIX_LOG_LEVEL_WARNING,
+               "Static event queue for celix framework is full, falling back to dynamic allocated events. Increase static event queue size, current size is %zu", loop->ringCap);
+    } else if (size % 100 == 0) {
+        uint64_t handlingStart = __atomic_load_n(&loop->handlingStartInNs, __ATOMIC_ACQUIRE);
+        if (handlingStart != 0) {
+            long bndId = __atomic_load_n(&loop->handlingBndId, __ATOMIC_RELAXED);
+            uint64_t now = celix_frameworkTrace_now();
+            uint64_t blockedInMs = now > handlingStart ? (now - handlingStart) / 1000000 : 0;
+            fw_log(loop->fw->logger, CELIX_LOG_LEVEL_WARNING,
+                   "dynamic event queue size is %zu. Event loop thread is blocked by an event for bundle %li for %" PRIu64 " ms.",
+                   size, bndId, blockedInMs);
+        } else {
+            fw_log(loop->fw->logger, CELIX_LOG_LEVEL_WARNING, "dynamic event queue size is %zu. Is there a bundle blocking on the event loop thread?", size);
         }
-        celixThreadMutex_unlock(&framework->bundleListenerLock);
-        for (int i = 0; i < celix_arrayList_size(localListeners); ++i) {
-            fw_bundle_listener_pt listener = arrayList_get(localListeners, i);
+    }
+
+    celix_framework_event_segment_t* last = loop->overflowLast;
+    if (last == NULL || last->writeIndex == CELIX_FRAMEWORK_EVENT_SEGMENT_SIZE) {
+        celix_framework_event_segment_t* segment = malloc(sizeof(*segment));
+        segment->next = NULL;
+        segment->readIndex = 0;
+        segment->writeIndex = 0;
+        if (last == NULL) {
+            loop->overflowFirst = segment;
+        } else {
+            last->next = segment;
+        }
+        loop->overflowLast = segment;
+        last = segment;
+    }
+    last->events[last->writeIndex++] = *event; //shallow copy
+    __atomic_store_n(&loop->overflowSize, size + 1, __ATOMIC_RELEASE);
+}
+
+/**
+ * Returns the event loop for the provided bundle id. Events without a bundle are handled by the first event loop.
+ */
+static celix_framework_event_loop_t* fw_eventLoopForBndId(celix_framework_t* fw, long bndId) {
+    int index = bndId >= 0 ? (int)(bndId % fw->dispatcher.nrOfLoops) : 0;
+    return &fw->dispatcher.loops[index];
+}
+
+static void celix_framework_addToEventQueue(celix_framework_t *fw, celix_framework_event_t* event) {
+    if (fw->tracing.trace != NULL || fw->metrics.metrics != NULL) {
+        event->enqueueTimeInNs = celix_frameworkTrace_now();
+    }
+    //note events for the same bundle are always added to the same event loop, to ensure order per bundle.
+    celix_framework_event_loop_t* loop = fw_eventLoopForBndId(fw, event->bndEntry != NULL ? event->bndEntry->bndId : -1);
+    size_t pending = __atomic_add_fetch(&loop->pendingEvents, 1, __ATOMIC_ACQ_REL);
+    if (fw->metrics.metrics != NULL) {
+        celix_frameworkMetrics_recordQueueDepth(fw->metrics.metrics, pending - 1);
+    }
+
+    //note if the overflow is in use, new events go to the overflow to ensure order
+    bool added = __atomic_load_n(&loop->overflowSize, __ATOMIC_ACQUIRE) == 0 && fw_tryAddToEventRing(loop, event);
+    if (!added) {
+        celixThreadMutex_lock(&loop->mutex);
+        fw_addToEventOverflow(loop, event);
+        celixThreadCondition_broadcast(&loop->cond);
+        celixThreadMutex_unlock(&loop->mutex);
+        return;
+    }
+
+    //only wake up the event loop thread if it is waiting for events
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&loop->sleeping, __ATOMIC_RELAXED)) {
+        celixThreadMutex_lock(&loop->mutex);
+        celixThreadCondition_broadcast(&loop->cond);
+        celixThreadMutex_unlock(&loop->mutex);
+    }
+}
+
+/**
+ * Creates a snapshot of the current bundle listeners, with an increased use count for every listener.
+ * The snapshot is initialized in the provided storage, so that it normally does not allocate.
+ */
+static celix_array_list_t* fw_createBundleListenersSnapshot(celix_framework_t *framework, celix_array_list_storage_t* storage) {
+    celix_array_list_t *localListeners = celix_arrayList_init(storage);
+    celixThreadMutex_lock(&framework->bundleListenerLock);
+    for (int i = 0; i < celix_arrayList_size(framework->bundleListeners); ++i) {
+        fw_bundle_listener_pt listener = arrayList_get(framework->bundleListeners, i);
+        fw_bundleListener_increaseUseCount(listener);
+        celix_arrayList_add(localListeners, listener);
+    }
+    celixThreadMutex_unlock(&framework->bundleListenerLock);
+    return localListeners;
+}
+
+static void fw_destroyBundleListenersSnapshot(celix_array_list_t* localListeners) {
+    for (int i = 0; i < celix_arrayList_size(localListeners); ++i) {
+        fw_bundle_listener_pt listener = arrayList_get(localListeners, i);
+        fw_bundleListener_decreaseUseCount(listener);
+    }
+    celix_arrayList_destroy(localListeners);
+}
+
+/**
+ * Handles a single event. For bundle events the provided bundle listeners snapshot is used.
+ */
+static void fw_handleEventRequest(celix_framework_t *framework, celix_framework_event_t* event, celix_array_list_t* bundleListeners) {
+    if (event->type == CELIX_BUNDLE_EVENT_TYPE) {
+        for (int i = 0; i < celix_arrayList_size(bundleListeners); ++i) {
+            fw_bundle_listener_pt listener = arrayList_get(bundleListeners, i);
 
             bundle_event_t bEvent;
             memset(&bEvent, 0, sizeof(bEvent));
             bEvent.bnd = event->bndEntry->bnd;
             bEvent.type = event->bundleEvent;
             fw_invokeBundleListener(framework, listener->listener, &bEvent, listener->bundle);
-
-            fw_bundleListener_decreaseUseCount(listener);
         }
-        celix_arrayList_destroy(localListeners);
     } else if (event->type == CELIX_FRAMEWORK_EVENT_TYPE) {
         celixThreadMutex_lock(&framework->frameworkListenersLock);
         for (int i = 0; i < celix_arrayList_size(framework->frameworkListeners); ++i) {
@@ -1550,82 +1869,228 @@ static void fw_handleEventRequest(celix_framework_t *framework, celix_framework_
     }
 }
 
-static inline celix_framework_event_t* fw_topEventFromQueue(celix_framework_t* fw) {
-    celix_framework_event_t* e = NULL;
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    if (fw->dispatcher.eventQueueSize > 0) {
-        e = &fw->dispatcher.eventQueue[fw->dispatcher.eventQueueFirstEntry];
-    } else if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) {
-        e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, 0);
+static inline bool fw_isEventInRingHead(celix_framework_event_loop_t* loop) {
+    celix_framework_event_slot_t* slot = &loop->ring[loop->ringHead & (loop->ringCap - 1)];
+    return __atomic_load_n(&slot->seq, __ATOMIC_SEQ_CST) == loop->ringHead + 1;
+}
+
+/**
+ * Fetches up to CELIX_FRAMEWORK_EVENT_BATCH_SIZE events from the queue. Should only be called from the event loop thread.
+ * A batch contains either ring or overflow events. The events stay in the queue until fw_releaseEventBatch is called,
+ * but are ignored by the waitFor functions when marked as handled.
+ *
+ * @return The number of fetched events.
+ */
+static size_t fw_fetchEventBatch(celix_framework_event_loop_t* loop, celix_framework_event_t** batch, bool* fromOverflow) {
+    size_t count = 0;
+    *fromOverflow = false;
+    while (count < CELIX_FRAMEWORK_EVENT_BATCH_SIZE) {
+        size_t pos = loop->ringHead + count;
+        celix_framework_event_slot_t* slot = &loop->ring[pos & (loop->ringCap - 1)];
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != pos + 1) {
+            break;
+        }
+        batch[count++] = &slot->event;
+    }
+    if (count == 0 && __atomic_load_n(&loop->overflowSize, __ATOMIC_ACQUIRE) > 0) {
+        //note ring is drained, so the overflow events are next in line.
+        celixThreadMutex_lock(&loop->mutex);
+        for (celix_framework_event_segment_t* segment = loop->overflowFirst; segment != NULL && count < CELIX_FRAMEWORK_EVENT_BATCH_SIZE; segment = segment->next) {
+            for (size_t i = segment->readIndex; i < segment->writeIndex && count < CELIX_FRAMEWORK_EVENT_BATCH_SIZE; ++i) {
+                batch[count++] = &segment->events[i];
+            }
+        }
+        celixThreadMutex_unlock(&loop->mutex);
+        *fromOverflow = true;
+    }
+    return count;
+}
+
+/**
+ * Removes the handled batch events from the queue and signals the waiters.
+ */
+static void fw_releaseEventBatch(celix_framework_event_loop_t* loop, size_t count, bool fromOverflow) {
+    celixThreadMutex_lock(&loop->mutex);
+    if (fromOverflow) {
+        size_t remaining = count;
+        while (remaining > 0) {
+            celix_framework_event_segment_t* segment = loop->overflowFirst;
+            size_t n = segment->writeIndex - segment->readIndex;
+            n = n < remaining ? n : remaining;
+            segment->readIndex += n;
+            remaining -= n;
+            if (segment->readIndex == segment->writeIndex) {
+                if (segment == loop->overflowLast) {
+                    //keep the last segment for reuse
+                    segment->readIndex = 0;
+                    segment->writeIndex = 0;
+                } else {
+                    loop->overflowFirst = segment->next;
+                    free(segment);
+                }
+            }
+        }
+        __atomic_store_n(&loop->overflowSize, loop->overflowSize - count, __ATOMIC_RELEASE);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            size_t pos = loop->ringHead + i;
+            celix_framework_event_slot_t* slot = &loop->ring[pos & (loop->ringCap - 1)];
+            __atomic_store_n(&slot->seq, pos + loop->ringCap, __ATOMIC_RELEASE);
+        }
+        loop->ringHead += count;
     }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
-    return e;
+    celixThreadCondition_broadcast(&loop->cond);
+    celixThreadMutex_unlock(&loop->mutex);
 }
 
-static inline bool fw_removeTopEventFromQueue(celix_framework_t* fw) {
-    bool dynamicallyAllocated = false;
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    if (fw->dispatcher.eventQueueSize > 0) {
-        fw->dispatcher.eventQueueFirstEntry = (fw->dispatcher.eventQueueFirstEntry+1) % fw->dispatcher.eventQueueCap;
-        fw->dispatcher.eventQueueSize -= 1;
-    } else if (celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) {
-        celix_arrayList_removeAt(fw->dispatcher.dynamicEventQueue, 0);
-        dynamicallyAllocated = true;
+/**
+ * Waits on the dispatcher cond until an event is added, the dispatcher is stopped or a timeout of 1 second.
+ */
+static void fw_waitForEvents(celix_framework_event_loop_t* loop) {
+    celixThreadMutex_lock(&loop->mutex);
+    __atomic_store_n(&loop->sleeping, true, __ATOMIC_SEQ_CST);
+    //note recheck after sleeping is set, so that producers either see sleeping or their event is seen here.
+    bool empty = !fw_isEventInRingHead(loop) && __atomic_load_n(&loop->overflowSize, __ATOMIC_ACQUIRE) == 0;
+    if (empty && loop->active) {
+        celixThreadCondition_timedwaitRelative(&loop->cond, &loop->mutex, 1, 0);
     }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
-    return dynamicallyAllocated;
+    __atomic_store_n(&loop->sleeping, false, __ATOMIC_RELAXED);
+    celixThreadMutex_unlock(&loop->mutex);
 }
 
+/**
+ * Marks the event as handled, so that it is ignored by the waitFor functions, and wakes up waiting threads if needed.
+ */
+static void fw_markEventHandled(celix_framework_event_loop_t* loop, celix_framework_event_t* event) {
+    __atomic_store_n(&event->handled, true, __ATOMIC_SEQ_CST);
+    __atomic_sub_fetch(&loop->pendingEvents, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&loop->nrOfWaiters, __ATOMIC_SEQ_CST) > 0) {
+        celixThreadMutex_lock(&loop->mutex);
+        celixThreadCondition_broadcast(&loop->cond);
+        celixThreadMutex_unlock(&loop->mutex);
+    }
+}
 
-static inline void fw_handleEvents(celix_framework_t* framework) {
-    celixThreadMutex_lock(&framework->dispatcher.mutex);
-    int size = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
-    if (size == 0) {
-        celixThreadCondition_timedwaitRelative(&framework->dispatcher.cond, &framework->dispatcher.mutex, 1, 0);
+static celix_framework_metrics_event_type_e fw_metricsEventType(celix_framework_event_type_e type) {
+    switch (type) {
+        case CELIX_BUNDLE_EVENT_TYPE:
+            return CELIX_FRAMEWORK_METRICS_BUNDLE_EVENT;
+        case CELIX_REGISTER_SERVICE_EVENT:
+            return CELIX_FRAMEWORK_METRICS_REGISTER_EVENT;
+        case CELIX_UNREGISTER_SERVICE_EVENT:
+            return CELIX_FRAMEWORK_METRICS_UNREGISTER_EVENT;
+        case CELIX_GENERIC_EVENT:
+            return CELIX_FRAMEWORK_METRICS_GENERIC_EVENT;
+        default:
+            return CELIX_FRAMEWORK_METRICS_FRAMEWORK_EVENT;
     }
-    size = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
-    celixThreadMutex_unlock(&framework->dispatcher.mutex);
+}
 
-    while (size > 0) {
-        celix_framework_event_t* topEvent = fw_topEventFromQueue(framework);
-        fw_handleEventRequest(framework, topEvent);
-        bool dynamiclyAllocatedEvent = fw_removeTopEventFromQueue(framework);
+/**
+ * Handles the event request and records the queue latency and handle time of the event.
+ * The event in progress is registered on the event loop, so that a blocking bundle can be reported.
+ */
+static void fw_handleEventRequestWithMetrics(celix_framework_event_loop_t* loop, celix_framework_event_t* event, celix_array_list_t* bundleListeners) {
+    uint64_t start = celix_frameworkTrace_now();
+    __atomic_store_n(&loop->handlingBndId, event->bndEntry != NULL ? event->bndEntry->bndId : -1L, __ATOMIC_RELAXED);
+    __atomic_store_n(&loop->handlingStartInNs, start, __ATOMIC_RELEASE);
+
+    fw_handleEventRequest(loop->fw, event, bundleListeners);
 
-        if (topEvent->bndEntry != NULL) {
-            celix_framework_bundleEntry_decreaseUseCount(topEvent->bndEntry);
+    uint64_t end = celix_frameworkTrace_now();
+    __atomic_store_n(&loop->handlingStartInNs, 0, __ATOMIC_RELEASE);
+
+    const char* eventName = event->type == CELIX_GENERIC_EVENT ? event->genericEventName : event->serviceName;
+    uint64_t latency = start > event->enqueueTimeInNs ? start - event->enqueueTimeInNs : 0;
+    celix_frameworkMetrics_recordHandledEvent(loop->fw->metrics.metrics, fw_metricsEventType(event->type),
+                                              event->bndEntry != NULL ? event->bndEntry->bnd : NULL, eventName,
+                                              latency, end - start);
+}
+
+/**
+ * Marks the event as handled and releases the event resources, except the queue slot.
+ */
+static void fw_finalizeEvent(celix_framework_event_loop_t* loop, celix_framework_event_t* event) {
+    //note marking the event handled first, so that the waitFor functions do not access a released bundle entry
+    fw_markEventHandled(loop, event);
+    if (event->bndEntry != NULL) {
+        celix_framework_bundleEntry_decreaseUseCount(event->bndEntry);
+    }
+    free(event->serviceName);
+}
+
+static inline void fw_handleEvents(celix_framework_event_loop_t* loop) {
+    celix_framework_event_t* batch[CELIX_FRAMEWORK_EVENT_BATCH_SIZE];
+    bool fromOverflow;
+    size_t count = fw_fetchEventBatch(loop, batch, &fromOverflow);
+    if (count == 0) {
+        fw_waitForEvents(loop);
+        count = fw_fetchEventBatch(loop, batch, &fromOverflow);
+    }
+
+    while (count > 0) {
+        celix_array_list_storage_t bundleListenersStorage;
+        celix_array_list_t* bundleListeners = NULL; //note shared by consecutive bundle events
+        size_t firstNotFinalized = 0;
+        for (size_t i = 0; i < count; ++i) {
+            celix_framework_event_t* event = batch[i];
+            if (event->type == CELIX_BUNDLE_EVENT_TYPE && bundleListeners == NULL) {
+                bundleListeners = fw_createBundleListenersSnapshot(loop->fw, &bundleListenersStorage);
+            } else if (event->type != CELIX_BUNDLE_EVENT_TYPE && bundleListeners != NULL) {
+                fw_destroyBundleListenersSnapshot(bundleListeners);
+                bundleListeners = NULL;
+            }
+            if (loop->fw->tracing.trace != NULL) {
+                long bndId = event->bndEntry != NULL ? event->bndEntry->bndId : -1L;
+                celix_frameworkTrace_record(loop->fw->tracing.trace, CELIX_FRAMEWORK_TRACE_EVENT_QUEUE_WAIT, bndId, NULL, event->enqueueTimeInNs);
+            }
+            if (loop->fw->metrics.metrics != NULL) {
+                fw_handleEventRequestWithMetrics(loop, event, bundleListeners);
+            } else {
+                fw_handleEventRequest(loop->fw, event, bundleListeners);
+            }
+            __atomic_store_n(&event->processed, true, __ATOMIC_SEQ_CST);
+            if (celix_deque_isEmpty(loop->endOfBatchCallbacks)) {
+                //note no pending end of batch callbacks, so the effect of the event is complete
+                fw_finalizeEvent(loop, event);
+                firstNotFinalized = i + 1;
+            }
+        }
+        if (bundleListeners != NULL) {
+            fw_destroyBundleListenersSnapshot(bundleListeners);
         }
-        free(topEvent->serviceName);
-        if (dynamiclyAllocatedEvent) {
-            free(topEvent);
+        //note end of batch callbacks are called before the events processed after the callbacks were scheduled are
+        //marked handled, so that waiters see their effect
+        celix_framework_end_of_batch_callback_t entry;
+        while (celix_deque_popFront(loop->endOfBatchCallbacks, &entry)) {
+            entry.callback(entry.data);
         }
+        for (size_t i = firstNotFinalized; i < count; ++i) {
+            fw_finalizeEvent(loop, batch[i]);
+        }
+        fw_releaseEventBatch(loop, count, fromOverflow);
 
-        celixThreadMutex_lock(&framework->dispatcher.mutex);
-        size = framework->dispatcher.eventQueueSize + celix_arrayList_size(framework->dispatcher.dynamicEventQueue);
-        celixThreadCondition_broadcast(&framework->dispatcher.cond);
-        celixThreadMutex_unlock(&framework->dispatcher.mutex);
+        count = fw_fetchEventBatch(loop, batch, &fromOverflow);
     }
 }
 
-static void *fw_eventDispatcher(void *fw) {
-    framework_pt framework = (framework_pt) fw;
+static void *fw_eventDispatcher(void *data) {
+    celix_framework_event_loop_t* loop = data;
 
-    celixThreadMutex_lock(&framework->dispatcher.mutex);
-    bool active = framework->dispatcher.active;
-    celixThreadMutex_unlock(&framework->dispatcher.mutex);
+    celixThreadMutex_lock(&loop->mutex);
+    bool active = loop->active;
+    celixThreadMutex_unlock(&loop->mutex);
 
     while (active) {
-        fw_handleEvents(framework);
-        celixThreadMutex_lock(&framework->dispatcher.mutex);
-        active = framework->dispatcher.active;
-        celixThreadMutex_unlock(&framework->dispatcher.mutex);
+        fw_handleEvents(loop);
+        celixThreadMutex_lock(&loop->mutex);
+        active = loop->active;
+        celixThreadMutex_unlock(&loop->mutex);
     }
 
     //not active any more, last run for possible request left overs
-    celixThreadMutex_lock(&framework->dispatcher.mutex);
-    bool needLastRun = framework->dispatcher.eventQueueSize > 0 || celix_arrayList_size(framework->dispatcher.dynamicEventQueue) > 0;
-    celixThreadMutex_unlock(&framework->dispatcher.mutex);
-    if (needLastRun) {
-        fw_handleEvents(framework);
+    if (__atomic_load_n(&loop->pendingEvents, __ATOMIC_ACQUIRE) > 0) {
+        fw_handleEvents(loop);
     }
 
     celixThread_exit(NULL);
@@ -1655,8 +2120,59 @@ celix_status_t fw_invokeFrameworkListener(framework_pt framework, framework_list
     return ret;
 }
 
+static celix_array_list_t* frameworkActivator_getTraceEntries(void* handle) {
+    return celix_frameworkTrace_getEntries(handle);
+}
+
+static celix_status_t frameworkActivator_writeChromeTrace(void* handle, FILE* stream) {
+    return celix_frameworkTrace_writeChromeTrace(handle, stream);
+}
+
+static void frameworkActivator_clearTrace(void* handle) {
+    celix_frameworkTrace_clear(handle);
+}
+
+static celix_framework_event_metrics_t* frameworkActivator_createEventMetrics(void* handle) {
+    return celix_frameworkMetrics_createEventMetrics(handle);
+}
+
+static void frameworkActivator_destroyEventMetrics(void* handle __attribute__((unused)), celix_framework_event_metrics_t* metrics) {
+    celix_frameworkMetrics_destroyEventMetrics(metrics);
+}
+
+static void frameworkActivator_resetMetrics(void* handle) {
+    celix_frameworkMetrics_reset(handle);
+}
+
 static celix_status_t frameworkActivator_start(void * userData, bundle_context_t *context) {
-    // nothing to do
+    framework_pt framework = NULL;
+    if (bundleContext_getFramework(context, &framework) != CELIX_SUCCESS) {
+        return CELIX_SUCCESS;
+    }
+    if (framework->metrics.metrics != NULL) {
+        framework->metrics.svc.handle = framework->metrics.metrics;
+        framework->metrics.svc.createEventMetrics = frameworkActivator_createEventMetrics;
+        framework->metrics.svc.destroyEventMetrics = frameworkActivator_destroyEventMetrics;
+        framework->metrics.svc.reset = frameworkActivator_resetMetrics;
+
+        celix_service_registration_options_t opts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
+        opts.svc = &framework->metrics.svc;
+        opts.serviceName = CELIX_FRAMEWORK_METRICS_SERVICE_NAME;
+        opts.serviceVersion = CELIX_FRAMEWORK_METRICS_SERVICE_VERSION;
+        framework->metrics.svcId = celix_bundleContext_registerServiceWithOptionsAsync(context, &opts);
+    }
+    if (framework->tracing.trace != NULL) {
+        framework->tracing.svc.handle = framework->tracing.trace;
+        framework->tracing.svc.getEntries = frameworkActivator_getTraceEntries;
+        framework->tracing.svc.writeChromeTrace = frameworkActivator_writeChromeTrace;
+        framework->tracing.svc.clear = frameworkActivator_clearTrace;
+
+        celix_service_registration_options_t opts = CELIX_EMPTY_SERVICE_REGISTRATION_OPTIONS;
+        opts.svc = &framework->tracing.svc;
+        opts.serviceName = CELIX_FRAMEWORK_TRACE_SERVICE_NAME;
+        opts.serviceVersion = CELIX_FRAMEWORK_TRACE_SERVICE_VERSION;
+        framework->tracing.svcId = celix_bundleContext_registerServiceWithOptionsAsync(context, &opts);
+    }
     return CELIX_SUCCESS;
 }
 
@@ -1665,6 +2181,14 @@ static celix_status_t frameworkActivator_stop(void * userData, bundle_context_t
     framework_pt framework;
 
     if (bundleContext_getFramework(context, &framework) == CELIX_SUCCESS) {
+        if (framework->tracing.svcId >= 0) {
+            celix_bundleContext_unregisterServiceAsync(context, framework->tracing.svcId, NULL, NULL);
+            framework->tracing.svcId = -1L;
+        }
+        if (framework->metrics.svcId >= 0) {
+            celix_bundleContext_unregisterServiceAsync(context, framework->metrics.svcId, NULL, NULL);
+            framework->metrics.svcId = -1L;
+        }
 
         fw_log(framework->logger, CELIX_LOG_LEVEL_TRACE, "Start shutdown thread for framework %s", celix_framework_getUUID(framework));
 
@@ -1794,22 +2318,28 @@ static celix_status_t framework_loadLibrary(framework_pt framework, const char *
         char * library_extension = ".dll";
 #endif
 
+    char libraryName[128];
     char libraryPath[256];
-    long refreshCount = 0;
-    const char *archiveRoot = NULL;
-    long revisionNumber = 0;
+    const char *root = NULL;
+    const char *zipLocation = NULL;
+    bundle_revision_pt revision = NULL;
 
-    status = CELIX_DO_IF(status, bundleArchive_getRefreshCount(archive, &refreshCount));
-    status = CELIX_DO_IF(status, bundleArchive_getArchiveRoot(archive, &archiveRoot));
-    status = CELIX_DO_IF(status, bundleArchive_getCurrentRevisionNumber(archive, &revisionNumber));
+    //note the revision root is normally <archive root>/version<refresh count>.<revision nr>, but can also be a
+    //content cache entry. If the revision is loaded from the bundle zip, the library is loaded from the zip.
+    status = CELIX_DO_IF(status, bundleArchive_getCurrentRevision(archive, &revision));
+    status = CELIX_DO_IF(status, bundleRevision_getRoot(revision, &root));
+    if (status == CELIX_SUCCESS) {
+        zipLocation = celix_bundleRevision_getZipLocation(revision);
+    }
 
     memset(libraryPath, 0, 256);
     int written = 0;
     if (strncmp("lib", library, 3) == 0) {
-        written = snprintf(libraryPath, 256, "%s/version%ld.%ld/%s", archiveRoot, refreshCount, revisionNumber, library);
+        written = snprintf(libraryName, 128, "%s", library);
     } else {
-        written = snprintf(libraryPath, 256, "%s/version%ld.%ld/%s%s%s", archiveRoot, refreshCount, revisionNumber, library_prefix, library, library_extension);
+        written = snprintf(libraryName, 128, "%s%s%s", library_prefix, library, library_extension);
     }
+    written = written < 128 ? snprintf(libraryPath, 256, "%s/%s", zipLocation != NULL ? zipLocation : root, libraryName) : 256;
 
     if (written >= 256) {
         error = "library path is too long";
@@ -1817,15 +2347,21 @@ static celix_status_t framework_loadLibrary(framework_pt framework, const char *
     } else {
         celix_bundle_context_t *fwCtx = NULL;
         bundle_getContext(framework->bundle, &fwCtx);
-        *handle = celix_libloader_open(fwCtx, libraryPath);
+        if (zipLocation != NULL) {
+            int memFd = -1;
+            *handle = celix_libloader_openFromZip(fwCtx, zipLocation, libraryName, &memFd);
+            if (memFd >= 0) {
+                celix_bundleRevision_addLibraryMemFd(revision, memFd);
+            }
+        } else {
+            *handle = celix_libloader_open(fwCtx, libraryPath);
+        }
         if (*handle == NULL) {
             error = celix_libloader_getLastError();
             status =  CELIX_BUNDLE_EXCEPTION;
         } else {
-            bundle_revision_pt revision = NULL;
             array_list_pt handles = NULL;
 
-            status = CELIX_DO_IF(status, bundleArchive_getCurrentRevision(archive, &revision));
             status = CELIX_DO_IF(status, bundleRevision_getHandles(revision, &handles));
 
             if(handles != NULL){
@@ -1974,35 +2510,173 @@ void celix_framework_unregisterAsync(celix_framework_t* fw, celix_bundle_t* bnd,
     celix_framework_addToEventQueue(fw, &event);
 }
 
+/**
+ * Returns the first queued or in progress (not yet handled) event for which the match function returns true, NULL if not found.
+ * Should be called with the event loop mutex locked; this ensures that ring slots are not released and
+ * overflow segments are not changed during the search.
+ */
+static celix_framework_event_t* fw_findEventInQueue(celix_framework_event_loop_t* loop, bool (*match)(const celix_framework_event_t* e, long id), long id) {
+    size_t tail = __atomic_load_n(&loop->ringTail, __ATOMIC_ACQUIRE);
+    for (size_t pos = loop->ringHead; pos != tail; ++pos) {
+        celix_framework_event_slot_t* slot = &loop->ring[pos & (loop->ringCap - 1)];
+        //note skipping slots claimed by a producer, but not yet published
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == pos + 1 && !__atomic_load_n(&slot->event.handled, __ATOMIC_SEQ_CST) && match(&slot->event, id)) {
+            return &slot->event;
+        }
+    }
+    for (celix_framework_event_segment_t* segment = loop->overflowFirst; segment != NULL; segment = segment->next) {
+        for (size_t i = segment->readIndex; i < segment->writeIndex; ++i) {
+            if (!__atomic_load_n(&segment->events[i].handled, __ATOMIC_SEQ_CST) && match(&segment->events[i], id)) {
+                return &segment->events[i];
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Returns the event loop of the current thread or NULL if the current thread is not a event loop thread.
+ */
+static celix_framework_event_loop_t* fw_currentEventLoop(celix_framework_t* fw) {
+    celix_thread_t self = celixThread_self();
+    for (int i = 0; i < fw->dispatcher.nrOfLoops; ++i) {
+        if (celixThread_equals(self, fw->dispatcher.loops[i].thread)) {
+            return &fw->dispatcher.loops[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Registers that the current event loop thread is going to wait on another event loop.
+ * Returns false if the other event loop is (indirectly) waiting on the current event loop, waiting would then deadlock.
+ */
+static bool fw_startWaitingForEventLoop(celix_framework_event_loop_t* current, celix_framework_event_loop_t* loop) {
+    celix_framework_t* fw = current->fw;
+    bool cycle = false;
+    celixThreadMutex_lock(&fw->dispatcher.waitMutex);
+    for (celix_framework_event_loop_t* l = loop; l != NULL && !cycle; l = l->waitingForLoop) {
+        cycle = l == current;
+    }
+    if (!cycle) {
+        current->waitingForLoop = loop;
+    }
+    celixThreadMutex_unlock(&fw->dispatcher.waitMutex);
+    return !cycle;
+}
+
+static void fw_stopWaitingForEventLoop(celix_framework_event_loop_t* current) {
+    celixThreadMutex_lock(&current->fw->dispatcher.waitMutex);
+    current->waitingForLoop = NULL;
+    celixThreadMutex_unlock(&current->fw->dispatcher.waitMutex);
+}
+
+/**
+ * Waits until there is no queued or in progress event in the event loop for which the match function returns true.
+ *
+ * Waiting for events on the own event loop is not allowed and is logged and asserted.
+ * An event loop thread can wait for events on another event loop, but a wait which would close a cycle of event loops
+ * waiting on each other (e.g. event loop A waits on B while B waits on A) is rejected and logged, because it would
+ * deadlock.
+ */
+static void fw_waitWhileEventInLoop(celix_framework_event_loop_t* loop, bool (*match)(const celix_framework_event_t* e, long id), long id) {
+    celix_framework_event_loop_t* current = fw_currentEventLoop(loop->fw);
+    if (current == loop) {
+        fw_log(loop->fw->logger, CELIX_LOG_LEVEL_ERROR, "Cannot wait for events on the own Celix event loop thread.");
+        assert(current != loop);
+        return;
+    } else if (current != NULL && !fw_startWaitingForEventLoop(current, loop)) {
+        int loopIndex = (int)(loop - loop->fw->dispatcher.loops);
+        int currentIndex = (int)(current - loop->fw->dispatcher.loops);
+        fw_log(loop->fw->logger, CELIX_LOG_LEVEL_ERROR,
+               "Cannot wait on Celix event loop %i from event loop %i, because event loop %i is (indirectly) waiting on event loop %i. Waiting would deadlock.",
+               loopIndex, currentIndex, loopIndex, currentIndex);
+        return;
+    }
+
+    __atomic_add_fetch(&loop->nrOfWaiters, 1, __ATOMIC_SEQ_CST);
+    celixThreadMutex_lock(&loop->mutex);
+    while (fw_findEventInQueue(loop, match, id) != NULL) {
+        celixThreadCondition_timedwaitRelative(&loop->cond, &loop->mutex, 5, 0);
+    }
+    celixThreadMutex_unlock(&loop->mutex);
+    __atomic_sub_fetch(&loop->nrOfWaiters, 1, __ATOMIC_SEQ_CST);
+
+    if (current != NULL) {
+        fw_stopWaitingForEventLoop(current);
+    }
+}
+
+/**
+ * Waits until there is no queued or in progress event in any of the event loops for which the match function returns true.
+ *
+ * When called from an event loop thread, the own event loop is not waited on; callers only wait for events of bundles
+ * handled by another event loop (see celix_framework_isCurrentThreadTheEventLoopForBnd). A matching event on the
+ * own event loop is a misuse, which is logged and asserted.
+ */
+static void fw_waitWhileEventInQueue(celix_framework_t* fw, bool (*match)(const celix_framework_event_t* e, long id), long id) {
+    celix_framework_event_loop_t* current = fw_currentEventLoop(fw);
+    if (current != NULL) {
+        celixThreadMutex_lock(&current->mutex);
+        bool found = fw_findEventInQueue(current, match, id) != NULL;
+        celixThreadMutex_unlock(&current->mutex);
+        if (found) {
+            fw_log(fw->logger, CELIX_LOG_LEVEL_ERROR, "Cannot wait for events on the own Celix event loop thread.");
+            assert(!found);
+        }
+    }
+    for (int i = 0; i < fw->dispatcher.nrOfLoops; ++i) {
+        celix_framework_event_loop_t* loop = &fw->dispatcher.loops[i];
+        if (loop != current) {
+            fw_waitWhileEventInLoop(loop, match, id);
+        }
+    }
+}
+
+static bool fw_isRegisterEventForSvcId(const celix_framework_event_t* e, long svcId) {
+    return e->type == CELIX_REGISTER_SERVICE_EVENT && e->registerServiceId == svcId;
+}
+
+static bool fw_isNotProcessedRegisterEventForSvcId(const celix_framework_event_t* e, long svcId) {
+    return fw_isRegisterEventForSvcId(e, svcId) && !__atomic_load_n(&e->processed, __ATOMIC_SEQ_CST);
+}
+
+static bool fw_isUnregisterEventForSvcId(const celix_framework_event_t* e, long svcId) {
+    return e->type == CELIX_UNREGISTER_SERVICE_EVENT && e->unregisterServiceId == svcId;
+}
+
+static bool fw_isRegistrationEventForBndId(const celix_framework_event_t* e, long bndId) {
+    return (e->type == CELIX_REGISTER_SERVICE_EVENT || e->type == CELIX_UNREGISTER_SERVICE_EVENT) && e->bndEntry->bndId == bndId;
+}
+
+static bool fw_isEventForBndId(const celix_framework_event_t* e, long bndId) {
+    return e->bndEntry != NULL && e->bndEntry->bndId == bndId;
+}
+
+static bool fw_isGenericEventForEventId(const celix_framework_event_t* e, long eventId) {
+    return e->type == CELIX_GENERIC_EVENT && e->genericEventId == eventId;
+}
+
 /**
  * Checks if there is a pending service registration in the event queue and canels this.
+ * Registration events which are already processed, but not yet marked as handled, are not cancelled.
  *
  * This can be needed when a service is regsitered async and still on the event queue when an sync unregistration
  * is made.
  * @returns true if a service registration is cancelled.
  */
 static bool celix_framework_cancelServiceRegistrationIfPending(celix_framework_t* fw, celix_bundle_t* bnd, long serviceId) {
-    bool cancelled = false;
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    for (int i = 0; i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-        celix_framework_event_t *event = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-        if (event->type == CELIX_REGISTER_SERVICE_EVENT && event->registerServiceId == serviceId) {
+    celix_framework_event_t* event = NULL;
+    for (int i = 0; event == NULL && i < fw->dispatcher.nrOfLoops; ++i) {
+        celix_framework_event_loop_t* loop = &fw->dispatcher.loops[i];
+        celixThreadMutex_lock(&loop->mutex);
+        event = fw_findEventInQueue(loop, fw_isNotProcessedRegisterEventForSvcId, serviceId);
+        if (event != NULL) {
             event->cancelled = true;
-            cancelled = true;
-            break;
         }
+        celixThreadMutex_unlock(&loop->mutex);
     }
-    for (size_t i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-        size_t index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-        celix_framework_event_t *event = &fw->dispatcher.eventQueue[index];
-        if (event->type == CELIX_REGISTER_SERVICE_EVENT && event->registerServiceId == serviceId) {
-            event->cancelled = true;
-            cancelled = true;
-            break;
-        }
-    }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
-    return cancelled;
+    return event != NULL;
 }
 
 void celix_framework_unregister(celix_framework_t* fw, celix_bundle_t* bnd, long serviceId) {
@@ -2012,97 +2686,32 @@ void celix_framework_unregister(celix_framework_t* fw, celix_bundle_t* bnd, long
 }
 
 void celix_framework_waitForAsyncRegistration(framework_t *fw, long svcId) {
-    assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool registrationsInProgress = true;
-    while (registrationsInProgress) {
-        registrationsInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if (e->type == CELIX_REGISTER_SERVICE_EVENT && e->registerServiceId == svcId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; !registrationsInProgress && i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if (e->type == CELIX_REGISTER_SERVICE_EVENT && e->registerServiceId == svcId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        if (registrationsInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
-
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    fw_waitWhileEventInQueue(fw, fw_isRegisterEventForSvcId, svcId);
 }
 
 void celix_framework_waitForAsyncUnregistration(framework_t *fw, long svcId) {
-    assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool registrationsInProgress = true;
-    while (registrationsInProgress) {
-        registrationsInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if (e->type == CELIX_UNREGISTER_SERVICE_EVENT && e->unregisterServiceId == svcId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; !registrationsInProgress && i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if (e->type == CELIX_UNREGISTER_SERVICE_EVENT && e->unregisterServiceId == svcId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        if (registrationsInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
-
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    fw_waitWhileEventInQueue(fw, fw_isUnregisterEventForSvcId, svcId);
 }
 
 void celix_framework_waitForAsyncRegistrations(framework_t *fw, long bndId) {
-    assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
+    fw_waitWhileEventInLoop(fw_eventLoopForBndId(fw, bndId), fw_isRegistrationEventForBndId, bndId);
+}
 
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool registrationsInProgress = true;
-    while (registrationsInProgress) {
-        registrationsInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if ((e->type == CELIX_REGISTER_SERVICE_EVENT || e->type == CELIX_UNREGISTER_SERVICE_EVENT) && e->bndEntry->bndId == bndId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; i < !registrationsInProgress && celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if ((e->type == CELIX_REGISTER_SERVICE_EVENT || e->type == CELIX_UNREGISTER_SERVICE_EVENT) && e->bndEntry->bndId == bndId) {
-                registrationsInProgress = true;
-                break;
-            }
-        }
-        if (registrationsInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
+bool celix_framework_isCurrentThreadTheEventLoop(framework_t* fw) {
+    return fw_currentEventLoop(fw) != NULL;
+}
 
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+bool celix_framework_isCurrentThreadTheEventLoopForBnd(celix_framework_t* fw, long bndId) {
+    return celixThread_equals(celixThread_self(), fw_eventLoopForBndId(fw, bndId)->thread);
 }
 
-bool celix_framework_isCurrentThreadTheEventLoop(framework_t* fw) {
-    return celixThread_equals(celixThread_self(), fw->dispatcher.thread);
+bool celix_framework_scheduleEndOfEventBatchCallback(celix_framework_t* fw, long bndId, void* data, void (*callback)(void* data)) {
+    celix_framework_event_loop_t* loop = fw_eventLoopForBndId(fw, bndId);
+    if (!celixThread_equals(celixThread_self(), loop->thread)) {
+        return false;
+    }
+    celix_framework_end_of_batch_callback_t entry = {data, callback};
+    return celix_deque_pushBack(loop->endOfBatchCallbacks, &entry) == CELIX_SUCCESS;
 }
 
 const char* celix_framework_getUUID(const celix_framework_t *fw) {
@@ -2163,7 +2772,7 @@ bool celix_framework_isBundleActive(celix_framework_t *fw, long bndId) {
 }
 
 static void celix_framework_waitForBundleEvents(celix_framework_t *fw, long bndId) {
-    if (bndId >= 0 && !celix_framework_isCurrentThreadTheEventLoop(fw)) {
+    if (bndId >= 0 && !celix_framework_isCurrentThreadTheEventLoopForBnd(fw, bndId)) {
         celix_framework_waitUntilNoEventsForBnd(fw, bndId);
     }
 }
@@ -2432,6 +3041,7 @@ celix_status_t celix_framework_startBundleEntry(celix_framework_t* framework, ce
     linked_list_pt wires = NULL;
     celix_bundle_context_t* context = NULL;
     celix_bundle_activator_t* activator = NULL;
+    uint64_t traceStart = fw_traceStart(framework);
 
     celix_bundle_state_e state = celix_bundle_getState(bndEntry->bnd);
 
@@ -2457,16 +3067,19 @@ celix_status_t celix_framework_startBundleEntry(celix_framework_t* framework, ce
         case OSGI_FRAMEWORK_BUNDLE_INSTALLED:
             bundle_getCurrentModule(bndEntry->bnd, &module);
             module_getSymbolicName(module, &name);
+            celixThreadMutex_lock(&framework->resolverMutex);
             if (!module_isResolved(module)) {
                 wires = resolver_resolve(module);
                 if (wires == NULL) {
+                    celixThreadMutex_unlock(&framework->resolverMutex);
                     celix_framework_bundleEntry_decreaseUseCount(bndEntry);
                     return CELIX_BUNDLE_EXCEPTION;
                 }
                 status = framework_markResolvedModules(framework, wires);
-                if (status != CELIX_SUCCESS) {
-                    break;
-                }
+            }
+            celixThreadMutex_unlock(&framework->resolverMutex);
+            if (status != CELIX_SUCCESS) {
+                break;
             }
             /* no break */
         case OSGI_FRAMEWORK_BUNDLE_RESOLVED:
@@ -2514,7 +3127,9 @@ celix_status_t celix_framework_startBundleEntry(celix_framework_t* framework, ce
 
                     if (status == CELIX_SUCCESS) {
                         if (create != NULL) {
+                            uint64_t createStart = fw_traceStart(framework);
                             status = CELIX_DO_IF(status, create(context, &userData));
+                            fw_traceRecord(framework, CELIX_FRAMEWORK_TRACE_ACTIVATOR_CREATE, bndEntry->bnd, createStart);
                             if (status == CELIX_SUCCESS) {
                                 activator->userData = userData;
                             }
@@ -2522,7 +3137,9 @@ celix_status_t celix_framework_startBundleEntry(celix_framework_t* framework, ce
                     }
                     if (status == CELIX_SUCCESS) {
                         if (start != NULL) {
+                            uint64_t startStart = fw_traceStart(framework);
                             status = CELIX_DO_IF(status, start(userData, context));
+                            fw_traceRecord(framework, CELIX_FRAMEWORK_TRACE_ACTIVATOR_START, bndEntry->bnd, startStart);
                         }
                     }
 
@@ -2558,6 +3175,8 @@ celix_status_t celix_framework_startBundleEntry(celix_framework_t* framework, ce
         } else {
             fw_logCode(framework->logger, CELIX_LOG_LEVEL_ERROR, status, "Could not start bundle: %s [%ld]", symbolicName, id);
         }
+    } else if (state != OSGI_FRAMEWORK_BUNDLE_ACTIVE) {
+        fw_traceRecord(framework, CELIX_FRAMEWORK_TRACE_START_BUNDLE, bndEntry->bnd, traceStart);
     }
 
     return status;
@@ -2566,40 +3185,32 @@ celix_status_t celix_framework_startBundleEntry(celix_framework_t* framework, ce
 void celix_framework_waitForEmptyEventQueue(celix_framework_t *fw) {
     assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
 
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    while (fw->dispatcher.eventQueueSize > 0 || celix_arrayList_size(fw->dispatcher.dynamicEventQueue) > 0) {
-        celixThreadCondition_wait(&fw->dispatcher.cond, &fw->dispatcher.mutex);
+    //note events handled by one event loop can add events to another event loop, so repeat until all loops were empty
+    bool waited = true;
+    while (waited) {
+        waited = false;
+        for (int i = 0; i < fw->dispatcher.nrOfLoops; ++i) {
+            celix_framework_event_loop_t* loop = &fw->dispatcher.loops[i];
+            __atomic_add_fetch(&loop->nrOfWaiters, 1, __ATOMIC_SEQ_CST);
+            celixThreadMutex_lock(&loop->mutex);
+            while (__atomic_load_n(&loop->pendingEvents, __ATOMIC_SEQ_CST) > 0) {
+                waited = true;
+                celixThreadCondition_wait(&loop->cond, &loop->mutex);
+            }
+            celixThreadMutex_unlock(&loop->mutex);
+            __atomic_sub_fetch(&loop->nrOfWaiters, 1, __ATOMIC_SEQ_CST);
+        }
+        waited = waited && fw->dispatcher.nrOfLoops > 1;
     }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
 }
 
 void celix_framework_waitUntilNoEventsForBnd(celix_framework_t* fw, long bndId) {
-    assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
+    fw_waitWhileEventInLoop(fw_eventLoopForBndId(fw, bndId), fw_isEventForBndId, bndId);
+}
 
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool eventInProgress = true;
-    while (eventInProgress) {
-        eventInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if (e->bndEntry != NULL && e->bndEntry->bndId == bndId) {
-                eventInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; !eventInProgress && i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if (e->bndEntry != NULL && e->bndEntry->bndId == bndId) {
-                eventInProgress = true;
-                break;
-            }
-        }
-        if (eventInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+bool celix_framework_hasPendingEventsOnLoopOfBnd(celix_framework_t* fw, long bndId) {
+    celix_framework_event_loop_t* loop = fw_eventLoopForBndId(fw, bndId);
+    return __atomic_load_n(&loop->pendingEvents, __ATOMIC_SEQ_CST) > 0;
 }
 
 
@@ -2641,32 +3252,7 @@ long celix_framework_nextEventId(framework_t *fw) {
 }
 
 void celix_framework_waitForGenericEvent(framework_t *fw, long eventId) {
-    assert(!celix_framework_isCurrentThreadTheEventLoop(fw));
-
-    celixThreadMutex_lock(&fw->dispatcher.mutex);
-    bool eventInProgress = true;
-    while (eventInProgress) {
-        eventInProgress = false;
-        for (int i = 0; i < fw->dispatcher.eventQueueSize; ++i) {
-            int index = (fw->dispatcher.eventQueueFirstEntry + i) % fw->dispatcher.eventQueueCap;
-            celix_framework_event_t* e = &fw->dispatcher.eventQueue[index];
-            if (e->type == CELIX_GENERIC_EVENT && e->genericEventId == eventId) {
-                eventInProgress = true;
-                break;
-            }
-        }
-        for (int i = 0; !eventInProgress && i < celix_arrayList_size(fw->dispatcher.dynamicEventQueue); ++i) {
-            celix_framework_event_t* e = celix_arrayList_get(fw->dispatcher.dynamicEventQueue, i);
-            if (e->type == CELIX_GENERIC_EVENT && e->genericEventId == eventId) {
-                eventInProgress = true;
-                break;
-            }
-        }
-        if (eventInProgress) {
-            celixThreadCondition_timedwaitRelative(&fw->dispatcher.cond, &fw->dispatcher.mutex, 5, 0);
-        }
-    }
-    celixThreadMutex_unlock(&fw->dispatcher.mutex);
+    fw_waitWhileEventInQueue(fw, fw_isGenericEventForEventId, eventId);
 }
 
 void celix_framework_waitForStop(celix_framework_t *framework) {
@@ -40,11 +40,22 @@
 
 #include "celix_threads.h"
 #include "service_registry.h"
+#include "celix_framework_trace.h"
+#include "celix_framework_metrics.h"
+#include "celix_deque.h"
 
 #ifndef CELIX_FRAMEWORK_DEFAULT_STATIC_EVENT_QUEUE_SIZE
 #define CELIX_FRAMEWORK_DEFAULT_STATIC_EVENT_QUEUE_SIZE 1024
 #endif
 
+#ifndef CELIX_FRAMEWORK_DEFAULT_NR_OF_EVENT_LOOPS
+#define CELIX_FRAMEWORK_DEFAULT_NR_OF_EVENT_LOOPS 1
+#endif
+
+#ifndef CELIX_FRAMEWORK_EVENT_BATCH_SIZE
+#define CELIX_FRAMEWORK_EVENT_BATCH_SIZE 64 //max nr of events the event loop thread drains from the queue in one go
+#endif
+
 typedef struct celix_framework_bundle_entry {
     celix_bundle_t *bnd;
     long bndId;
@@ -79,6 +90,9 @@ struct celix_framework_event {
     //for bundle event
     bundle_event_type_e bundleEvent;
 
+    bool handled; //NOTE atomic. Set by the event loop thread when the event is handled, but not yet removed from the queue
+    bool processed; //NOTE atomic. Set by the event loop thread directly after the event is processed, can be before handled is set
+
     //for register event
     long registerServiceId;
     bool cancelled;
@@ -98,11 +112,70 @@ struct celix_framework_event {
     void *genericProcessData;
     void (*genericProcess)(void*);
 
+    uint64_t enqueueTimeInNs; //only set if tracing or event metrics are enabled
+
 
 };
 
 typedef struct celix_framework_event celix_framework_event_t;
 
+/**
+ * @brief Slot of the lock-free event ring.
+ *
+ * The sequence number is used to hand over a slot between the producers and the consumer (Vyukov style):
+ * seq == pos -> slot is free for the producer claiming position pos,
+ * seq == pos + 1 -> slot contains a published event for position pos.
+ */
+typedef struct celix_framework_event_slot {
+    size_t seq; //NOTE atomic
+    celix_framework_event_t event;
+} celix_framework_event_slot_t;
+
+#define CELIX_FRAMEWORK_EVENT_SEGMENT_SIZE 128
+
+/**
+ * @brief Segment of the overflow event queue, used when the event ring is full.
+ */
+typedef struct celix_framework_event_segment {
+    struct celix_framework_event_segment* next;
+    size_t readIndex;
+    size_t writeIndex;
+    celix_framework_event_t events[CELIX_FRAMEWORK_EVENT_SEGMENT_SIZE];
+} celix_framework_event_segment_t;
+
+/**
+ * @brief Callback called by an event loop thread after handling a batch of events.
+ */
+typedef struct celix_framework_end_of_batch_callback {
+    void* data;
+    void (*callback)(void* data);
+} celix_framework_end_of_batch_callback_t;
+
+/**
+ * @brief An event loop thread with its own event queue.
+ */
+typedef struct celix_framework_event_loop {
+    celix_framework_t* fw;
+    celix_thread_cond_t cond;
+    celix_thread_t thread;
+    celix_thread_mutex_t mutex; //protects active, ringHead, the overflow segments and the release of ring slots
+    bool active;
+    celix_framework_event_slot_t* ring; //bounded multi-producer, single-consumer ring, producers do not lock
+    size_t ringCap; //power of 2
+    size_t ringHead; //position of the first event in the ring. Only updated by the event loop thread.
+    size_t ringTail; //NOTE atomic. Next position to be claimed by a producer.
+    celix_framework_event_segment_t* overflowFirst; //used when the ring is full
+    celix_framework_event_segment_t* overflowLast;
+    size_t overflowSize; //NOTE atomic, only updated with the mutex locked
+    size_t pendingEvents; //NOTE atomic. Number of queued or in progress events
+    size_t nrOfWaiters; //NOTE atomic. Number of threads waiting on the cond for handled events
+    bool sleeping; //NOTE atomic. True if the event loop thread is (about to be) waiting on the cond
+    uint64_t handlingStartInNs; //NOTE atomic. Start time of the event in progress, 0 if idle. Only set if event metrics are enabled
+    long handlingBndId; //NOTE atomic. Bundle id of the event in progress. Only set if event metrics are enabled
+    celix_deque_t* endOfBatchCallbacks; //entries are celix_framework_end_of_batch_callback_t. Only used by the event loop thread.
+    struct celix_framework_event_loop* waitingForLoop; //the event loop this event loop thread is waiting on, NULL if not waiting. Protected by the dispatcher waitMutex
+} celix_framework_event_loop_t;
+
 enum celix_bundle_lifecycle_command {
     CELIX_BUNDLE_LIFECYCLE_START,
     CELIX_BUNDLE_LIFECYCLE_STOP,
@@ -121,7 +194,6 @@ typedef struct celix_framework_bundle_lifecycle_handler {
 struct celix_framework {
     celix_bundle_t *bundle;
     long bundleId; //the bundle id of the framework (normally 0)
-    hash_map_pt installRequestMap;
 
     array_list_pt frameworkListeners;
     celix_thread_mutex_t frameworkListenersLock;
@@ -148,20 +220,16 @@ struct celix_framework {
         celix_thread_mutex_t mutex;
     } installedBundles;
 
+    celix_thread_mutex_t resolverMutex; //protects resolving and marking modules resolved, needed when bundles are started concurrently
+
 
     properties_pt configurationMap;
 
 
     struct {
-        celix_thread_cond_t cond;
-        celix_thread_t thread;
-        celix_thread_mutex_t mutex; //protects below
-        bool active;
-        celix_framework_event_t* eventQueue; //ring buffer
-        int eventQueueCap;
-        int eventQueueSize;
-        int eventQueueFirstEntry;
-        celix_array_list_t *dynamicEventQueue; //entry = celix_framework_event_t*. Used when the eventQueue is full
+        celix_framework_event_loop_t* loops; //events are assigned to a loop based on the bundle id
+        int nrOfLoops;
+        celix_thread_mutex_t waitMutex; //protects the waitingForLoop field of the event loops
     } dispatcher;
 
     celix_framework_logger_t* logger;
@@ -172,6 +240,18 @@ struct celix_framework {
         celix_thread_mutex_t mutex; //protects below
         celix_array_list_t* bundleLifecycleHandlers; //entry = celix_framework_bundle_lifecycle_handler_t*
     } bundleLifecycleHandling;
+
+    struct {
+        celix_framework_trace_t* trace; //NULL if tracing is not enabled, see CELIX_FRAMEWORK_TRACE_ENABLED
+        celix_framework_trace_service_t svc;
+        long svcId;
+    } tracing;
+
+    struct {
+        celix_framework_metrics_t* metrics; //NULL if event metrics are not enabled, see CELIX_FRAMEWORK_EVENT_METRICS_ENABLED
+        celix_framework_metrics_service_t svc;
+        long svcId;
+    } metrics;
 };
 
 FRAMEWORK_EXPORT celix_status_t fw_getProperty(framework_pt framework, const char* name, const char* defaultValue, const char** value);
@@ -285,6 +365,34 @@ void celix_framework_waitForAsyncUnregistration(celix_framework_t *fw, long svcI
  */
 bool celix_framework_isCurrentThreadTheEventLoop(celix_framework_t* fw);
 
+/**
+ * Returns whether the current thread is the Celix framework event loop thread which handles the events of the
+ * provided bundle.
+ *
+ * With multiple event loops, being on an event loop thread is not enough to handle work of a bundle directly;
+ * work for a bundle handled by another event loop must go through that event loop to keep the per bundle event order.
+ */
+bool celix_framework_isCurrentThreadTheEventLoopForBnd(celix_framework_t* fw, long bndId);
+
+/**
+ * @brief Schedule a callback which will be called by the event loop thread of the provided bundle after the current
+ * batch of events is handled, but before the events processed since the callback was scheduled are marked as handled.
+ *
+ * This can be used to coalesce work triggered by multiple events of a single batch, while callers waiting on one of
+ * the events (e.g. a synchronous service registration) still observe the result of the callback.
+ *
+ * @return True if the callback is scheduled, false if the current thread is not the event loop thread of the
+ * provided bundle.
+ */
+bool celix_framework_scheduleEndOfEventBatchCallback(celix_framework_t* fw, long bndId, void* data, void (*callback)(void* data));
+
+/**
+ * Returns whether the event loop handling the events of the provided bundle has queued or in progress events.
+ * Note that this is a check for the whole event loop, the pending events can also be events of other bundles handled
+ * by the same event loop.
+ */
+bool celix_framework_hasPendingEventsOnLoopOfBnd(celix_framework_t* fw, long bndId);
+
 /**
  * Increase the use count of a bundle and ensure that a bundle cannot be uninstalled.
  */
@@ -91,10 +91,38 @@ celix_status_t manifest_getEntries(manifest_pt manifest, hash_map_pt *map) {
 	return CELIX_SUCCESS;
 }
 
+celix_status_t manifest_createFromStream(FILE *stream, manifest_pt *manifest) {
+	celix_status_t status;
+
+	status = manifest_create(manifest);
+
+	if (status == CELIX_SUCCESS) {
+		manifest_readFromStream(*manifest, stream);
+	}
+
+	framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Cannot create manifest from stream");
+
+	return status;
+}
+
 celix_status_t manifest_read(manifest_pt manifest, const char *filename) {
     celix_status_t status = CELIX_SUCCESS;
 
 	FILE *file = fopen ( filename, "r" );
+	if (file != NULL) {
+		status = manifest_readFromStream(manifest, file);
+		fclose(file);
+	} else {
+		status = CELIX_FILE_IO_EXCEPTION;
+		framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Cannot open manifest '%s'", filename);
+	}
+
+	return status;
+}
+
+celix_status_t manifest_readFromStream(manifest_pt manifest, FILE *file) {
+    celix_status_t status = CELIX_SUCCESS;
+
 	if (file != NULL) {
 		char lbuf[512];
 		char name[512];
@@ -112,7 +140,7 @@ celix_status_t manifest_read(manifest_pt manifest, const char *filename) {
 
 			if (lbuf[--len] != '\n') {
 				status = CELIX_FILE_IO_EXCEPTION;
-				framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Manifest '%s' line too long", filename);
+				framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Manifest line too long");
 				break;
 			}
 			if (len > 0 && lbuf[len - 1] == '\r') {
@@ -133,7 +161,7 @@ celix_status_t manifest_read(manifest_pt manifest, const char *filename) {
 					name[len - 6] = '\0';
 				} else {
 					status = CELIX_FILE_IO_EXCEPTION;
-					framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Manifest '%s' invalid format", filename);
+					framework_logIfError(celix_frameworkLogger_globalLogger(), status, NULL, "Manifest invalid format");
 					break;
 				}
 
@@ -173,7 +201,6 @@ celix_status_t manifest_read(manifest_pt manifest, const char *filename) {
 			name[0] = '\0';
 			skipEmptyLines = true;
 		}
-		fclose(file);
 	} else {
 		status = CELIX_FILE_IO_EXCEPTION;
 	}
@@ -40,6 +40,10 @@
 #include <utime.h>
 #endif
 #include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include "unzip.h"
 #include "archive.h"
@@ -380,3 +384,129 @@ celix_status_t extractBundle(const char* bundleName, const char* revisionRoot) {
 
     return status;
 }
+
+celix_status_t listBundleEntries(const char *bundleName, celix_array_list_t **entries) {
+    unzFile uf = unzOpen64(bundleName);
+    if (uf == NULL) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+
+    celix_status_t status = CELIX_SUCCESS;
+    celix_array_list_t *result = celix_arrayList_create();
+    int err = unzGoToFirstFile(uf);
+    while (err == UNZ_OK) {
+        char name[MAXFILENAME];
+        unz_file_info64 info;
+        err = unzGetCurrentFileInfo64(uf, &info, name, sizeof(name), NULL, 0, NULL, 0);
+        if (err == UNZ_OK) {
+            celix_arrayList_add(result, strdup(name));
+            err = unzGoToNextFile(uf);
+        }
+    }
+    if (err != UNZ_END_OF_LIST_OF_FILE) {
+        status = CELIX_FILE_IO_EXCEPTION;
+        for (int i = 0; i < celix_arrayList_size(result); ++i) {
+            free(celix_arrayList_get(result, i));
+        }
+        celix_arrayList_destroy(result);
+    } else {
+        *entries = result;
+    }
+    unzClose(uf);
+    return status;
+}
+
+celix_status_t readBundleEntry(const char *bundleName, const char *entryName, char **data, size_t *size) {
+    unzFile uf = unzOpen64(bundleName);
+    if (uf == NULL) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+
+    celix_status_t status = CELIX_FILE_IO_EXCEPTION;
+    unz_file_info64 info;
+    if (unzLocateFile(uf, entryName, CASESENSITIVITY) == UNZ_OK &&
+            unzGetCurrentFileInfo64(uf, &info, NULL, 0, NULL, 0, NULL, 0) == UNZ_OK &&
+            unzOpenCurrentFile(uf) == UNZ_OK) {
+        char *buf = malloc(info.uncompressed_size + 1);
+        size_t read = 0;
+        int rc = 1;
+        while (buf != NULL && read < info.uncompressed_size && rc > 0) {
+            rc = unzReadCurrentFile(uf, buf + read, (unsigned)(info.uncompressed_size - read));
+            read += rc > 0 ? (size_t)rc : 0;
+        }
+        if (unzCloseCurrentFile(uf) == UNZ_OK && buf != NULL && read == info.uncompressed_size) {
+            buf[read] = '\0';
+            *data = buf;
+            *size = read;
+            status = CELIX_SUCCESS;
+        } else {
+            free(buf);
+        }
+    }
+    unzClose(uf);
+    return status;
+}
+
+static celix_status_t writeAll(int fd, const char *buf, size_t size) {
+    while (size > 0) {
+        ssize_t written = write(fd, buf, size);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        } else if (written <= 0) {
+            return CELIX_FILE_IO_EXCEPTION;
+        }
+        buf += written;
+        size -= (size_t)written;
+    }
+    return CELIX_SUCCESS;
+}
+
+celix_status_t writeBundleEntry(const char *bundleName, const char *entryName, int fd) {
+#ifdef _WIN32
+    return CELIX_FILE_IO_EXCEPTION;
+#else
+    unzFile uf = unzOpen64(bundleName);
+    if (uf == NULL) {
+        return CELIX_FILE_IO_EXCEPTION;
+    }
+
+    celix_status_t status = CELIX_FILE_IO_EXCEPTION;
+    unz_file_info64 info;
+    if (unzLocateFile(uf, entryName, CASESENSITIVITY) == UNZ_OK &&
+            unzGetCurrentFileInfo64(uf, &info, NULL, 0, NULL, 0, NULL, 0) == UNZ_OK &&
+            unzOpenCurrentFile(uf) == UNZ_OK) {
+        if (info.compression_method == 0) {
+            //stored, write directly from a memory map of the zip
+            ZPOS64_T offset = unzGetCurrentFileZStreamPos64(uf);
+            int zipFd = open(bundleName, O_RDONLY);
+            struct stat st;
+            if (zipFd >= 0 && fstat(zipFd, &st) == 0 && offset + info.uncompressed_size <= (ZPOS64_T)st.st_size) {
+                void *base = st.st_size > 0 ? mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, zipFd, 0) : MAP_FAILED;
+                if (base != MAP_FAILED) {
+                    status = writeAll(fd, (const char *)base + offset, info.uncompressed_size);
+                    munmap(base, (size_t)st.st_size);
+                }
+            }
+            if (zipFd >= 0) {
+                close(zipFd);
+            }
+        } else {
+            char buf[WRITEBUFFERSIZE];
+            int rc = unzReadCurrentFile(uf, buf, sizeof(buf));
+            status = CELIX_SUCCESS;
+            while (rc > 0 && status == CELIX_SUCCESS) {
+                status = writeAll(fd, buf, (size_t)rc);
+                rc = unzReadCurrentFile(uf, buf, sizeof(buf));
+            }
+            if (rc < 0) {
+                status = CELIX_FILE_IO_EXCEPTION;
+            }
+        }
+        if (unzCloseCurrentFile(uf) != UNZ_OK) {
+            status = CELIX_FILE_IO_EXCEPTION;
+        }
+    }
+    unzClose(uf);
+    return status;
+#endif
+}
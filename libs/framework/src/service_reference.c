@@ -52,10 +52,12 @@ celix_status_t serviceReference_create(registry_callback_t callback, bundle_pt r
         ref->service = NULL;
         serviceRegistration_getBundle(registration, &ref->registrationBundle);
 		celixThreadRwlock_create(&ref->lock, NULL);
+		celixThreadMutex_create(&ref->usageMutex, NULL);
 		ref->refCount = 1;
         ref->usageCount = 0;
 
         serviceRegistration_retain(ref->registration);
+        serviceRegistration_addReference(ref->registration, ref);
 	}
 
 	if (status == CELIX_SUCCESS) {
@@ -68,26 +70,25 @@ celix_status_t serviceReference_create(registry_callback_t callback, bundle_pt r
 }
 
 celix_status_t serviceReference_retain(service_reference_pt ref) {
-    celixThreadRwlock_writeLock(&ref->lock);
-    ref->refCount += 1;
-    celixThreadRwlock_unlock(&ref->lock);
+    __atomic_add_fetch(&ref->refCount, 1, __ATOMIC_RELAXED);
     return CELIX_SUCCESS;
 }
 
 celix_status_t serviceReference_release(service_reference_pt ref, bool *out) {
     bool destroyed = false;
-    celixThreadRwlock_writeLock(&ref->lock);
-    assert(ref->refCount > 0);
-    ref->refCount -= 1;
-    if (ref->refCount == 0) {
-        if (ref->registration != NULL) {
-            serviceRegistration_release(ref->registration);
-        }
+    size_t count = __atomic_sub_fetch(&ref->refCount, 1, __ATOMIC_ACQ_REL);
+    assert(count != (size_t)-1);
+    if (count == 0) {
+        celixThreadRwlock_writeLock(&ref->lock);
+        service_registration_pt reg = ref->registration;
+        __atomic_store_n(&ref->registration, NULL, __ATOMIC_RELEASE);
         celixThreadRwlock_unlock(&ref->lock);
+        if (reg != NULL) {
+            serviceRegistration_removeReference(reg, ref);
+            serviceRegistration_release(reg);
+        }
         serviceReference_destroy(ref);
         destroyed = true;
-    } else {
-        celixThreadRwlock_unlock(&ref->lock);
     }
 
     if (out) {
@@ -97,12 +98,7 @@ celix_status_t serviceReference_release(service_reference_pt ref, bool *out) {
 }
 
 celix_status_t serviceReference_increaseUsage(service_reference_pt ref, size_t *out) {
-    //fw_log(logger, CELIX_LOG_LEVEL_DEBUG, "Destroying service reference %p\n", ref);
-    size_t local = 0;
-    celixThreadRwlock_writeLock(&ref->lock);
-    ref->usageCount += 1;
-    local = ref->usageCount;
-    celixThreadRwlock_unlock(&ref->lock);
+    size_t local = __atomic_add_fetch(&ref->usageCount, 1, __ATOMIC_ACQ_REL);
     if (out) {
         *out = local;
     }
@@ -111,16 +107,16 @@ celix_status_t serviceReference_increaseUsage(service_reference_pt ref, size_t *
 
 celix_status_t serviceReference_decreaseUsage(service_reference_pt ref, size_t *out) {
     celix_status_t status = CELIX_SUCCESS;
-    size_t localCount = 0;
-    celixThreadRwlock_writeLock(&ref->lock);
-    if (ref->usageCount == 0) {
+    size_t localCount = __atomic_load_n(&ref->usageCount, __ATOMIC_ACQUIRE);
+    while (localCount > 0 && !__atomic_compare_exchange_n(&ref->usageCount, &localCount, localCount - 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        //retry with updated count
+    }
+    if (localCount == 0) {
         serviceReference_logWarningUsageCountBelowZero(ref);
         status = CELIX_BUNDLE_EXCEPTION;
     } else {
-        ref->usageCount -= 1;
+        localCount -= 1;
     }
-    localCount = ref->usageCount;
-    celixThreadRwlock_unlock(&ref->lock);
 
     if (out) {
         *out = localCount;
@@ -128,49 +124,140 @@ celix_status_t serviceReference_decreaseUsage(service_reference_pt ref, size_t *
     return status;
 }
 
-static void serviceReference_logWarningUsageCountBelowZero(service_reference_pt ref __attribute__((unused))) {
-    fw_log(celix_frameworkLogger_globalLogger(), CELIX_LOG_LEVEL_WARNING, "Cannot decrease service usage count below 0\n");
+/**
+ * Increases the usage count if the usage count is > 0. Returns false if the usage count is 0.
+ */
+static bool serviceReference_tryIncreaseUsage(service_reference_pt ref) {
+    size_t count = __atomic_load_n(&ref->usageCount, __ATOMIC_ACQUIRE);
+    while (count > 0) {
+        if (__atomic_compare_exchange_n(&ref->usageCount, &count, count + 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            return true;
+        }
+    }
+    return false;
 }
 
+/**
+ * Decreases the usage count if the usage count is > 1. Returns false if the usage count is 1 or 0.
+ */
+static bool serviceReference_tryDecreaseUsage(service_reference_pt ref, size_t *updatedCount) {
+    size_t count = __atomic_load_n(&ref->usageCount, __ATOMIC_ACQUIRE);
+    while (count > 1) {
+        if (__atomic_compare_exchange_n(&ref->usageCount, &count, count - 1, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            *updatedCount = count - 1;
+            return true;
+        }
+    }
+    return false;
+}
 
-celix_status_t serviceReference_getUsageCount(service_reference_pt ref, size_t *count) {
-    celix_status_t status = CELIX_SUCCESS;
+/**
+ * Returns the (retained) registration of the service reference or NULL if the reference is invalid.
+ */
+static service_registration_pt serviceReference_retainRegistration(service_reference_pt ref) {
     celixThreadRwlock_readLock(&ref->lock);
-    *count = ref->usageCount;
+    service_registration_pt reg = ref->registration;
+    if (reg != NULL) {
+        serviceRegistration_retain(reg);
+    }
     celixThreadRwlock_unlock(&ref->lock);
+    return reg;
+}
+
+celix_status_t serviceReference_getServiceAndIncreaseUsage(service_reference_pt ref, bundle_pt bundle, const void **service) {
+    if (__atomic_load_n(&ref->registration, __ATOMIC_ACQUIRE) == NULL) {
+        *service = NULL;
+        return CELIX_SUCCESS;
+    }
+
+    if (serviceReference_tryIncreaseUsage(ref)) {
+        //service already in use, note the service is stored before the usage count became > 0
+        *service = __atomic_load_n(&ref->service, __ATOMIC_ACQUIRE);
+        return CELIX_SUCCESS;
+    }
+
+    //first usage
+    const void* svc = NULL;
+    service_registration_pt reg = serviceReference_retainRegistration(ref);
+    celixThreadMutex_lock(&ref->usageMutex);
+    if (reg != NULL && serviceRegistration_isValid(reg)) {
+        if (!serviceReference_tryIncreaseUsage(ref)) {
+            serviceRegistration_getService(reg, bundle, &svc);
+            __atomic_store_n(&ref->service, svc, __ATOMIC_RELEASE);
+            __atomic_store_n(&ref->usageCount, 1, __ATOMIC_RELEASE);
+        } else {
+            svc = __atomic_load_n(&ref->service, __ATOMIC_ACQUIRE);
+        }
+    }
+    celixThreadMutex_unlock(&ref->usageMutex);
+    if (reg != NULL) {
+        serviceRegistration_release(reg);
+    }
+    *service = svc;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t serviceReference_decreaseUsageAndUngetService(service_reference_pt ref, bundle_pt bundle, size_t *out) {
+    size_t count = 0;
+    if (serviceReference_tryDecreaseUsage(ref, &count)) {
+        if (out) {
+            *out = count;
+        }
+        return CELIX_SUCCESS;
+    }
+
+    //(possible) last usage
+    service_registration_pt reg = serviceReference_retainRegistration(ref);
+    celixThreadMutex_lock(&ref->usageMutex);
+    celix_status_t status = serviceReference_decreaseUsage(ref, &count);
+    if (status == CELIX_SUCCESS && count == 0) {
+        const void* svc = __atomic_load_n(&ref->service, __ATOMIC_ACQUIRE);
+        if (reg != NULL) {
+            serviceRegistration_ungetService(reg, bundle, &svc);
+        }
+    }
+    celixThreadMutex_unlock(&ref->usageMutex);
+    if (reg != NULL) {
+        serviceRegistration_release(reg);
+    }
+    if (out) {
+        *out = count;
+    }
     return status;
 }
 
+static void serviceReference_logWarningUsageCountBelowZero(service_reference_pt ref __attribute__((unused))) {
+    fw_log(celix_frameworkLogger_globalLogger(), CELIX_LOG_LEVEL_WARNING, "Cannot decrease service usage count below 0\n");
+}
+
+
+celix_status_t serviceReference_getUsageCount(service_reference_pt ref, size_t *count) {
+    *count = __atomic_load_n(&ref->usageCount, __ATOMIC_ACQUIRE);
+    return CELIX_SUCCESS;
+}
+
 celix_status_t serviceReference_getReferenceCount(service_reference_pt ref, size_t *count) {
-    celix_status_t status = CELIX_SUCCESS;
-    celixThreadRwlock_readLock(&ref->lock);
-    *count = ref->refCount;
-    celixThreadRwlock_unlock(&ref->lock);
-    return status;
+    *count = __atomic_load_n(&ref->refCount, __ATOMIC_ACQUIRE);
+    return CELIX_SUCCESS;
 }
 
 celix_status_t serviceReference_getService(service_reference_pt ref, void **service) {
-    celix_status_t status = CELIX_SUCCESS;
-    celixThreadRwlock_readLock(&ref->lock);
     /*NOTE the service argument should be 'const void**'
       To ensure backwards compatibility a cast is made instead.
     */
-    *service = (const void**) ref->service;
-    celixThreadRwlock_unlock(&ref->lock);
-    return status;
+    *service = (const void**) __atomic_load_n(&ref->service, __ATOMIC_ACQUIRE);
+    return CELIX_SUCCESS;
 }
 
 celix_status_t serviceReference_setService(service_reference_pt ref, const void *service) {
-    celix_status_t status = CELIX_SUCCESS;
-    celixThreadRwlock_writeLock(&ref->lock);
-    ref->service = service;
-    celixThreadRwlock_unlock(&ref->lock);
-    return status;
+    __atomic_store_n(&ref->service, service, __ATOMIC_RELEASE);
+    return CELIX_SUCCESS;
 }
 
 static void serviceReference_destroy(service_reference_pt ref) {
 	assert(ref->refCount == 0);
     celixThreadRwlock_destroy(&ref->lock);
+    celixThreadMutex_destroy(&ref->usageMutex);
 	ref->registration = NULL;
 	free(ref);
 }
@@ -233,6 +320,17 @@ serviceReference_getPropertyWithDefault(service_reference_pt ref, const char *ke
     return status;
 }
 
+static long serviceReference_getPropertyAsLong(service_reference_pt ref, const char *key, long defaultValue) {
+    long result = defaultValue;
+    properties_pt props = NULL;
+    celixThreadRwlock_readLock(&ref->lock);
+    if (ref->registration != NULL && serviceRegistration_getProperties(ref->registration, &props) == CELIX_SUCCESS) {
+        result = celix_properties_getAsLong(props, key, defaultValue);
+    }
+    celixThreadRwlock_unlock(&ref->lock);
+    return result;
+}
+
 celix_status_t serviceReference_getProperty(service_reference_pt ref, const char* key, const char** value) {
     return serviceReference_getPropertyWithDefault(ref, key, NULL, value);
 }
@@ -243,17 +341,15 @@ FRAMEWORK_EXPORT celix_status_t serviceReference_getPropertyKeys(service_referen
 
     celixThreadRwlock_readLock(&ref->lock);
     serviceRegistration_getProperties(ref->registration, &props);
-    hash_map_iterator_pt it;
     int i = 0;
-    int vsize = hashMap_size(props);
+    int vsize = celix_properties_size(props);
     *size = (unsigned int)vsize;
     *keys = malloc(vsize * sizeof(**keys));
-    it = hashMapIterator_create(props);
-    while (hashMapIterator_hasNext(it)) {
-        (*keys)[i] = hashMapIterator_nextKey(it);
+    const char *key;
+    CELIX_PROPERTIES_FOR_EACH(props, key) {
+        (*keys)[i] = (char*)key;
         i++;
     }
-    hashMapIterator_destroy(it);
     celixThreadRwlock_unlock(&ref->lock);
     return status;
 }
@@ -264,7 +360,7 @@ celix_status_t serviceReference_invalidate(service_reference_pt ref) {
     service_registration_pt reg = NULL;
     celixThreadRwlock_writeLock(&ref->lock);
     reg = ref->registration;
-    ref->registration = NULL;
+    __atomic_store_n(&ref->registration, NULL, __ATOMIC_RELEASE);
     celixThreadRwlock_unlock(&ref->lock);
 
     if (reg != NULL) {
@@ -323,14 +419,8 @@ celix_status_t serviceReference_compareTo(service_reference_pt reference, servic
 	other_id = atol(other_id_str);
 
 
-	long rank, other_rank;
-	const char *rank_str;
-    const char* other_rank_str;
-	serviceReference_getProperty(reference, OSGI_FRAMEWORK_SERVICE_RANKING, &rank_str);
-	serviceReference_getProperty(compareTo, OSGI_FRAMEWORK_SERVICE_RANKING, &other_rank_str);
-
-	rank = rank_str == NULL ? 0 : atol(rank_str);
-	other_rank = other_rank_str == NULL ? 0 : atol(other_rank_str);
+	long rank = serviceReference_getPropertyAsLong(reference, OSGI_FRAMEWORK_SERVICE_RANKING, 0);
+	long other_rank = serviceReference_getPropertyAsLong(compareTo, OSGI_FRAMEWORK_SERVICE_RANKING, 0);
 
     *compare = celix_utils_compareServiceIdsAndRanking(id, rank, other_id, other_rank);
 
@@ -34,14 +34,15 @@
 struct serviceReference {
     registry_callback_t callback;
 	bundle_pt referenceOwner;
-	struct serviceRegistration * registration;
+	struct serviceRegistration * registration; //protected by lock, NOTE can be atomically read without lock
     bundle_pt registrationBundle;
-    const void* service;
+    const void* service; //NOTE atomic
 
-	size_t refCount;
-    size_t usageCount;
+	size_t refCount; //NOTE atomic
+    size_t usageCount; //NOTE atomic
 
     celix_thread_rwlock_t lock;
+    celix_thread_mutex_t usageMutex; //serializes the first and last usage of the service (get/unget service)
 };
 
 celix_status_t serviceReference_create(registry_callback_t callback, bundle_pt referenceOwner, service_registration_pt registration, service_reference_pt *reference);
@@ -52,6 +53,21 @@ celix_status_t serviceReference_release(service_reference_pt ref, bool *destroye
 celix_status_t serviceReference_increaseUsage(service_reference_pt ref, size_t *updatedCount);
 celix_status_t serviceReference_decreaseUsage(service_reference_pt ref, size_t *updatedCount);
 
+/**
+ * Increases the usage count of the service reference and returns the service.
+ * For the first usage the service is retrieved from the service registration (which can be a service factory).
+ * If the service usage is already > 0, no locks are taken.
+ * If the service reference is invalid, the service will be NULL and the usage count will not be increased.
+ */
+celix_status_t serviceReference_getServiceAndIncreaseUsage(service_reference_pt ref, bundle_pt bundle, const void **service);
+
+/**
+ * Decreases the usage count of the service reference and, for the last usage, ungets the service
+ * from the service registration.
+ * If the service usage is > 1, no locks are taken.
+ */
+celix_status_t serviceReference_decreaseUsageAndUngetService(service_reference_pt ref, bundle_pt bundle, size_t *updatedCount);
+
 celix_status_t serviceReference_invalidate(service_reference_pt reference);
 celix_status_t serviceReference_isValid(service_reference_pt reference, bool *result);
 
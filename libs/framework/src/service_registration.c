@@ -23,6 +23,7 @@
 #include <assert.h>
 
 #include "service_registration_private.h"
+#include "service_reference_private.h"
 #include "celix_constants.h"
 
 static celix_status_t serviceRegistration_initializeProperties(service_registration_pt registration, properties_pt properties);
@@ -65,6 +66,7 @@ static celix_status_t serviceRegistration_createInternal(registry_callback_t cal
 		}
 
 		reg->isUnregistering = false;
+		reg->references = celix_arrayList_create();
 		celixThreadRwlock_create(&reg->lock, NULL);
 
 		celixThreadRwlock_writeLock(&reg->lock);
@@ -83,19 +85,14 @@ static celix_status_t serviceRegistration_createInternal(registry_callback_t cal
 }
 
 void serviceRegistration_retain(service_registration_pt registration) {
-	celixThreadRwlock_writeLock(&registration->lock);
-	registration->refCount += 1;
-    celixThreadRwlock_unlock(&registration->lock);
+    __atomic_add_fetch(&registration->refCount, 1, __ATOMIC_RELAXED);
 }
 
 void serviceRegistration_release(service_registration_pt registration) {
-    celixThreadRwlock_writeLock(&registration->lock);
-    assert(registration->refCount > 0);
-	registration->refCount -= 1;
-	if (registration->refCount == 0) {
+    size_t count = __atomic_sub_fetch(&registration->refCount, 1, __ATOMIC_ACQ_REL);
+    assert(count != (size_t)-1);
+	if (count == 0) {
 		serviceRegistration_destroy(registration);
-	} else {
-        celixThreadRwlock_unlock(&registration->lock);
 	}
 }
 
@@ -107,7 +104,7 @@ static celix_status_t serviceRegistration_destroy(service_registration_pt regist
     registration->callback.unregister = NULL;
 
 	properties_destroy(registration->properties);
-	celixThreadRwlock_unlock(&registration->lock);
+	celix_arrayList_destroy(registration->references);
     celixThreadRwlock_destroy(&registration->lock);
 	free(registration);
 
@@ -140,6 +137,41 @@ void serviceRegistration_invalidate(service_registration_pt registration) {
     celixThreadRwlock_unlock(&registration->lock);
 }
 
+void serviceRegistration_addReference(service_registration_pt registration, service_reference_pt reference) {
+    celixThreadRwlock_writeLock(&registration->lock);
+    celix_arrayList_add(registration->references, reference);
+    celixThreadRwlock_unlock(&registration->lock);
+}
+
+void serviceRegistration_removeReference(service_registration_pt registration, service_reference_pt reference) {
+    celixThreadRwlock_writeLock(&registration->lock);
+    celix_arrayList_remove(registration->references, reference);
+    celixThreadRwlock_unlock(&registration->lock);
+}
+
+void serviceRegistration_invalidateReferences(service_registration_pt registration) {
+    //note a reference in the list can be concurrently destroyed, but it will not be freed before it is removed
+    //from the list, which requires the registration lock.
+    celixThreadRwlock_writeLock(&registration->lock);
+    for (int i = 0; i < celix_arrayList_size(registration->references); ++i) {
+        service_reference_pt ref = celix_arrayList_get(registration->references, i);
+        serviceReference_invalidate(ref);
+    }
+    celix_arrayList_clear(registration->references);
+    celixThreadRwlock_unlock(&registration->lock);
+}
+
+void serviceRegistration_getReferenceOwners(service_registration_pt registration, celix_array_list_t *owners) {
+    celixThreadRwlock_readLock(&registration->lock);
+    for (int i = 0; i < celix_arrayList_size(registration->references); ++i) {
+        service_reference_pt ref = celix_arrayList_get(registration->references, i);
+        bundle_pt owner = NULL;
+        serviceReference_getOwner(ref, &owner);
+        celix_arrayList_add(owners, owner);
+    }
+    celixThreadRwlock_unlock(&registration->lock);
+}
+
 bool serviceRegistration_isValid(service_registration_pt registration) {
     bool isValid;
     if (registration != NULL) {
@@ -232,6 +264,13 @@ celix_status_t serviceRegistration_setProperties(service_registration_pt registr
     celix_status_t status;
 
     celixThreadRwlock_writeLock(&registration->lock);
+    if (properties == NULL) {
+        properties = properties_create();
+    }
+    if (registration->properties != NULL) {
+        //note like the service id, the objectClass cannot be changed after registration (the service registry indexes registrations on it)
+        properties_set(properties, OSGI_FRAMEWORK_OBJECTCLASS, properties_get(registration->properties, OSGI_FRAMEWORK_OBJECTCLASS));
+    }
     status = serviceRegistration_initializeProperties(registration, properties);
     celixThreadRwlock_unlock(&registration->lock);
 
@@ -48,7 +48,9 @@ struct serviceRegistration {
 	struct service *services;
 	int nrOfServices;
 
-	size_t refCount; //protected by mutex
+	size_t refCount; //NOTE atomic
+
+	celix_array_list_t *references; //service references for this registration, protected by lock
 
 	celix_thread_rwlock_t lock;
 };
@@ -62,6 +64,20 @@ void serviceRegistration_release(service_registration_pt registration);
 bool serviceRegistration_isValid(service_registration_pt registration);
 void serviceRegistration_invalidate(service_registration_pt registration);
 
+void serviceRegistration_addReference(service_registration_pt registration, service_reference_pt reference);
+void serviceRegistration_removeReference(service_registration_pt registration, service_reference_pt reference);
+
+/**
+ * Invalidates all service references for this registration.
+ * Note that the registration itself should still be retained by the caller.
+ */
+void serviceRegistration_invalidateReferences(service_registration_pt registration);
+
+/**
+ * Adds the owners of the service references for this registration to the provided list.
+ */
+void serviceRegistration_getReferenceOwners(service_registration_pt registration, celix_array_list_t *owners);
+
 celix_status_t serviceRegistration_getService(service_registration_pt registration, bundle_pt bundle, const void **service);
 celix_status_t serviceRegistration_ungetService(service_registration_pt registration, bundle_pt bundle, const void **service);
 
@@ -21,6 +21,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <assert.h>
+#include <limits.h>
 #include <celix_api.h>
 
 #include "service_registry_private.h"
@@ -29,6 +30,8 @@
 #include "celix_constants.h"
 #include "service_reference_private.h"
 #include "framework_private.h"
+#include "bundle_private.h"
+#include "utils.h"
 
 static celix_status_t serviceRegistry_registerServiceInternal(service_registry_pt registry, bundle_pt bundle, const char* serviceName, const void * serviceObject, properties_pt dictionary, long reservedId, enum celix_service_type svcType, service_registration_pt *registration);
 static celix_status_t serviceRegistry_addHooks(service_registry_pt registry, const char* serviceName, const void *serviceObject, service_registration_pt registration);
@@ -52,6 +55,23 @@ static void celix_increasePendingRegisteredEvent(celix_service_registry_t *regis
 static void celix_decreasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId);
 static void celix_waitForPendingRegisteredEvents(celix_service_registry_t *registry, long svcId);
 
+static const char* celix_serviceRegistry_findServiceNameInFilter(const celix_filter_t *filter);
+static void celix_serviceRegistry_addToServiceNameIndex(celix_service_registry_t *registry, service_registration_t *registration);
+static void celix_serviceRegistry_removeFromServiceNameIndex(celix_service_registry_t *registry, service_registration_t *registration);
+static void celix_serviceRegistry_addServiceListenerToIndex(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry);
+static void celix_serviceRegistry_removeServiceListenerFromIndex(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry);
+
+typedef void (*celix_service_registry_snapshot_visitor_fp)(void *data, const celix_service_registry_snapshot_entry_t *entry);
+
+static celix_service_registry_snapshot_t* celix_serviceRegistry_createSnapshot(size_t nrOfIdSegments, size_t nrOfNameSegments, size_t otherObjectClassSize);
+static void celix_serviceRegistry_destroySnapshots(celix_service_registry_t *registry);
+static void celix_serviceRegistry_addToSnapshot(celix_service_registry_t *registry, celix_bundle_t *bnd, service_registration_t *registration);
+static void celix_serviceRegistry_removeFromSnapshot(celix_service_registry_t *registry, service_registration_t *registration);
+static celix_service_registry_snapshot_t* celix_serviceRegistry_readLockSnapshot(celix_service_registry_t *registry, int *token);
+static void celix_serviceRegistry_readUnlockSnapshot(celix_service_registry_t *registry, int token);
+static const celix_service_registry_snapshot_entry_t* celix_serviceRegistry_findSnapshotEntry(const celix_service_registry_snapshot_t *snapshot, long svcId);
+static void celix_serviceRegistry_visitSnapshotEntries(const celix_service_registry_snapshot_t *snapshot, const char *serviceName, bool includeOtherObjectClass, celix_service_registry_snapshot_visitor_fp visitor, void *data);
+
 celix_status_t serviceRegistry_create(framework_pt framework, service_registry_pt *out) {
 	celix_status_t status;
 
@@ -65,16 +85,23 @@ celix_status_t serviceRegistry_create(framework_pt framework, service_registry_p
         reg->callback.unregister = (void *) serviceRegistry_unregisterService;
 
 		reg->serviceRegistrations = hashMap_create(NULL, NULL, NULL, NULL);
+		reg->serviceRegistrationsByName = celix_stringHashMap_create();
+		reg->serviceRegistrationsWithOtherObjectClass = celix_arrayList_create();
 		reg->framework = framework;
         reg->nextServiceId = 1L;
-        reg->serviceReferences = hashMap_create(NULL, NULL, NULL, NULL);
 
 		reg->listenerHooks = celix_arrayList_create();
 		reg->serviceListeners = celix_arrayList_create();
+		reg->serviceListenersByName = celix_stringHashMap_create();
+		reg->serviceListenersForAllNames = celix_arrayList_create();
 
 		celixThreadMutex_create(&reg->pendingRegisterEvents.mutex, NULL);
 		celixThreadCondition_init(&reg->pendingRegisterEvents.cond, NULL);
-		reg->pendingRegisterEvents.map = hashMap_create(NULL, NULL, NULL, NULL);
+		reg->pendingRegisterEvents.map = celix_longHashMap_create();
+
+		reg->rcu = celix_rcu_create();
+		reg->snapshot = celix_serviceRegistry_createSnapshot(0, 0, 0);
+		reg->retired = celix_arrayList_create();
 
 		status = celixThreadRwlock_create(&reg->lock, NULL);
 	}
@@ -98,10 +125,13 @@ celix_status_t serviceRegistry_destroy(service_registry_pt registry) {
     }
     for (int i = 0; i < size; ++i) {
         celix_service_registry_service_listener_entry_t *entry = celix_arrayList_get(registry->serviceListeners, i);
+        celix_serviceRegistry_removeServiceListenerFromIndex(registry, entry);
         celix_decreaseCountServiceListener(entry);
         celix_waitAndDestroyServiceListener(entry);
     }
     arrayList_destroy(registry->serviceListeners);
+    celix_stringHashMap_destroy(registry->serviceListenersByName);
+    celix_arrayList_destroy(registry->serviceListenersForAllNames);
 
     //destroy service registration map
     size = hashMap_size(registry->serviceRegistrations);
@@ -124,12 +154,19 @@ celix_status_t serviceRegistry_destroy(service_registry_pt registry) {
     assert(size == 0);
     hashMap_destroy(registry->serviceRegistrations, false, false);
 
-    //destroy service references (double) map);
-    size = hashMap_size(registry->serviceReferences);
-    if (size > 0) {
-        fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Unexpected service references left in the service registry! Nr of references: %i", size);
+    //destroy service name index, note index lists should already be removed with the last unregistration
+    CELIX_STRING_HASH_MAP_ITERATE(registry->serviceRegistrationsByName, nameIter) {
+        celix_array_list_t *registrations = nameIter.value.ptrValue;
+        celix_arrayList_destroy(registrations);
     }
-    hashMap_destroy(registry->serviceReferences, false, false);
+    celix_stringHashMap_destroy(registry->serviceRegistrationsByName);
+    celix_arrayList_destroy(registry->serviceRegistrationsWithOtherObjectClass);
+
+    //note service references are owned by bundles and checked when a bundle is destroyed
+
+    assert(registry->snapshot->size == 0);
+    celix_serviceRegistry_destroySnapshots(registry);
+    celix_rcu_destroy(registry->rcu);
 
     //destroy listener hooks
     size = celix_arrayList_size(registry->listenerHooks);
@@ -139,11 +176,11 @@ celix_status_t serviceRegistry_destroy(service_registry_pt registry) {
     }
     celix_arrayList_destroy(registry->listenerHooks);
 
-    size = hashMap_size(registry->pendingRegisterEvents.map);
+    size = (int)celix_longHashMap_size(registry->pendingRegisterEvents.map);
     assert(size == 0);
     celixThreadMutex_destroy(&registry->pendingRegisterEvents.mutex);
     celixThreadCondition_destroy(&registry->pendingRegisterEvents.cond);
-    hashMap_destroy(registry->pendingRegisterEvents.map, false, false);
+    celix_longHashMap_destroy(registry->pendingRegisterEvents.map);
 
     free(registry);
 
@@ -212,6 +249,8 @@ static celix_status_t serviceRegistry_registerServiceInternal(service_registry_p
         hashMap_put(registry->serviceRegistrations, bundle, regs);
     }
 	arrayList_add(regs, *registration);
+	celix_serviceRegistry_addToServiceNameIndex(registry, *registration);
+	celix_serviceRegistry_addToSnapshot(registry, bundle, *registration);
 
     //update pending register event
     celix_increasePendingRegisteredEvent(registry, svcId);
@@ -253,6 +292,8 @@ celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, b
             hashMap_remove(registry->serviceRegistrations, bundle);
         }
 	}
+	celix_serviceRegistry_removeFromServiceNameIndex(registry, registration);
+	celix_serviceRegistry_removeFromSnapshot(registry, registration);
 	celixThreadRwlock_unlock(&registry->lock);
 
 
@@ -261,19 +302,8 @@ celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, b
 
     celix_serviceRegistry_serviceChanged(registry, OSGI_FRAMEWORK_SERVICE_EVENT_UNREGISTERING, registration);
 
-    celixThreadRwlock_readLock(&registry->lock);
     //invalidate service references
-    hash_map_iterator_pt iter = hashMapIterator_create(registry->serviceReferences);
-    while (hashMapIterator_hasNext(iter)) {
-        hash_map_pt refsMap = hashMapIterator_nextValue(iter);
-        service_reference_pt ref = refsMap != NULL ?
-                                   hashMap_get(refsMap, (void*)registration->serviceId) : NULL;
-        if (ref != NULL) {
-            serviceReference_invalidate(ref);
-        }
-    }
-    hashMapIterator_destroy(iter);
-	celixThreadRwlock_unlock(&registry->lock);
+    serviceRegistration_invalidateReferences(registration);
 
 	serviceRegistration_invalidate(registration);
     serviceRegistration_release(registration);
@@ -283,31 +313,21 @@ celix_status_t serviceRegistry_unregisterService(service_registry_pt registry, b
 
 celix_status_t serviceRegistry_getServiceReference(service_registry_pt registry, bundle_pt owner,
                                                    service_registration_pt registration, service_reference_pt *out) {
-	celix_status_t status = CELIX_SUCCESS;
-
-	if (celixThreadRwlock_writeLock(&registry->lock) == CELIX_SUCCESS) {
-	    status = serviceRegistry_getServiceReference_internal(registry, owner, registration, out);
-	    celixThreadRwlock_unlock(&registry->lock);
-	}
-
+	celixThreadMutex_lock(&owner->serviceReferencesMutex);
+	celix_status_t status = serviceRegistry_getServiceReference_internal(registry, owner, registration, out);
+	celixThreadMutex_unlock(&owner->serviceReferencesMutex);
 	return status;
 }
 
 static celix_status_t serviceRegistry_getServiceReference_internal(service_registry_pt registry, bundle_pt owner,
                                                    service_registration_pt registration, service_reference_pt *out) {
-	//only call after locked registry RWlock
+	//only call after locked owner serviceReferencesMutex
 	celix_status_t status = CELIX_SUCCESS;
 	bundle_pt bundle = NULL;
     service_reference_pt ref = NULL;
-    hash_map_pt references = NULL;
-
-    references = hashMap_get(registry->serviceReferences, owner);
-    if (references == NULL) {
-        references = hashMap_create(NULL, NULL, NULL, NULL);
-        hashMap_put(registry->serviceReferences, owner, references);
-	}
+    celix_long_hash_map_t* references = owner->serviceReferences;
 
-    ref = hashMap_get(references, (void*)registration->serviceId);
+    ref = celix_longHashMap_get(references, registration->serviceId);
 
     if (ref == NULL) {
         status = serviceRegistration_getBundle(registration, &bundle);
@@ -315,7 +335,7 @@ static celix_status_t serviceRegistry_getServiceReference_internal(service_regis
             status = serviceReference_create(registry->callback, owner, registration, &ref);
         }
         if (status == CELIX_SUCCESS) {
-            hashMap_put(references, (void*)registration->serviceId, ref);
+            celix_longHashMap_put(references, registration->serviceId, ref);
         }
     } else {
         serviceReference_retain(ref);
@@ -331,56 +351,74 @@ static celix_status_t serviceRegistry_getServiceReference_internal(service_regis
 	return status;
 }
 
+typedef struct serviceRegistry_matching_registrations_data {
+    const char *serviceName;
+    filter_pt filter;
+    array_list_pt matchingRegistrations;
+    celix_status_t status;
+} serviceRegistry_matching_registrations_data_t;
+
+static void serviceRegistry_addMatchingRegistration(void *handle, const celix_service_registry_snapshot_entry_t *entry) {
+    //only call in a snapshot read section
+    serviceRegistry_matching_registrations_data_t *data = handle;
+    if (data->status != CELIX_SUCCESS) {
+        return;
+    }
+    service_registration_pt registration = entry->registration;
+    properties_pt props = NULL;
+    bool matchResult;
+
+    data->status = serviceRegistration_getProperties(registration, &props);
+    if (data->status == CELIX_SUCCESS) {
+        bool matched = false;
+        matchResult = false;
+        if (data->filter != NULL) {
+            filter_match(data->filter, props, &matchResult);
+        }
+        if ((data->serviceName == NULL) && ((data->filter == NULL) || matchResult)) {
+            matched = true;
+        } else if (data->serviceName != NULL) {
+            if ((strcmp(entry->serviceName, data->serviceName) == 0) && ((data->filter == NULL) || matchResult)) {
+                matched = true;
+            }
+        }
+        if (matched) {
+            if (serviceRegistration_isValid(registration)) {
+                serviceRegistration_retain(registration);
+                arrayList_add(data->matchingRegistrations, registration);
+            }
+        }
+    }
+}
+
 celix_status_t serviceRegistry_getServiceReferences(service_registry_pt registry, bundle_pt owner, const char *serviceName, filter_pt filter, array_list_pt *out) {
 	celix_status_t status;
-	hash_map_iterator_pt iterator;
     array_list_pt references = NULL;
 	array_list_pt matchingRegistrations = NULL;
-    bool matchResult;
 
     status = arrayList_create(&references);
     status = CELIX_DO_IF(status, arrayList_create(&matchingRegistrations));
 
-    celixThreadRwlock_readLock(&registry->lock);
-	iterator = hashMapIterator_create(registry->serviceRegistrations);
-	while (status == CELIX_SUCCESS && hashMapIterator_hasNext(iterator)) {
-		array_list_pt regs = (array_list_pt) hashMapIterator_nextValue(iterator);
-		unsigned int regIdx;
-		for (regIdx = 0; (regs != NULL) && regIdx < arrayList_size(regs); regIdx++) {
-			service_registration_pt registration = (service_registration_pt) arrayList_get(regs, regIdx);
-			properties_pt props = NULL;
-
-			status = serviceRegistration_getProperties(registration, &props);
-			if (status == CELIX_SUCCESS) {
-				bool matched = false;
-				matchResult = false;
-				if (filter != NULL) {
-					filter_match(filter, props, &matchResult);
-				}
-				if ((serviceName == NULL) && ((filter == NULL) || matchResult)) {
-					matched = true;
-				} else if (serviceName != NULL) {
-					const char *className = NULL;
-					matchResult = false;
-					serviceRegistration_getServiceName(registration, &className);
-					if (filter != NULL) {
-						filter_match(filter, props, &matchResult);
-					}
-					if ((strcmp(className, serviceName) == 0) && ((filter == NULL) || matchResult)) {
-						matched = true;
-					}
-				}
-				if (matched) {
-					if (serviceRegistration_isValid(registration)) {
-                        serviceRegistration_retain(registration);
-                        arrayList_add(matchingRegistrations, registration);
-					}
-				}
-			}
-		}
-	}
-    celixThreadRwlock_unlock(&registry->lock);
-	hashMapIterator_destroy(iterator);
+    const char *filterSvcName = celix_serviceRegistry_findServiceNameInFilter(filter);
+
+    if (status == CELIX_SUCCESS) {
+        serviceRegistry_matching_registrations_data_t data;
+        data.serviceName = serviceName;
+        data.filter = filter;
+        data.matchingRegistrations = matchingRegistrations;
+        data.status = CELIX_SUCCESS;
+
+        int token;
+        celix_service_registry_snapshot_t* snapshot = celix_serviceRegistry_readLockSnapshot(registry, &token);
+        if (serviceName != NULL) {
+            celix_serviceRegistry_visitSnapshotEntries(snapshot, serviceName, false, serviceRegistry_addMatchingRegistration, &data);
+        } else {
+            //note if filterSvcName is NULL, all entries are visited
+            celix_serviceRegistry_visitSnapshotEntries(snapshot, filterSvcName, true, serviceRegistry_addMatchingRegistration, &data);
+        }
+        celix_serviceRegistry_readUnlockSnapshot(registry, token);
+        status = data.status;
+    }
 
     if (status == CELIX_SUCCESS) {
         unsigned int i;
@@ -418,7 +456,6 @@ celix_status_t serviceRegistry_retainServiceReference(service_registry_pt regist
     celix_status_t status = CELIX_SUCCESS;
     bundle_pt refBundle = NULL;
     
-    celixThreadRwlock_writeLock(&registry->lock);
     serviceReference_getOwner(reference, &refBundle);
     if (refBundle == bundle) {
         serviceReference_retain(reference);
@@ -426,7 +463,6 @@ celix_status_t serviceRegistry_retainServiceReference(service_registry_pt regist
         status = CELIX_ILLEGAL_ARGUMENT;
         fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "cannot retain a service reference from an other bundle (in ref %p) (provided %p).", refBundle, bundle);
     }
-    celixThreadRwlock_unlock(&registry->lock);
 
     return status;
 }
@@ -437,7 +473,7 @@ celix_status_t serviceRegistry_ungetServiceReference(service_registry_pt registr
     bool destroyed = false;
     size_t count = 0;
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadMutex_lock(&bundle->serviceReferencesMutex);
     serviceReference_getUsageCount(reference, &count);
     serviceReference_release(reference, &destroyed);
     if (destroyed) {
@@ -446,40 +482,25 @@ celix_status_t serviceRegistry_ungetServiceReference(service_registry_pt registr
             serviceRegistry_logWarningServiceReferenceUsageCount(registry, bundle, reference, count, 0);
         }
 
-        hash_map_pt refsMap = hashMap_get(registry->serviceReferences, bundle);
-
-        unsigned long refId = 0UL;
+        long refId = 0L;
         service_reference_pt ref = NULL;
 
-        if (refsMap != NULL) {
-            hash_map_iterator_t iter = hashMapIterator_construct(refsMap);
-            while (hashMapIterator_hasNext(&iter)) {
-                hash_map_entry_pt entry = hashMapIterator_nextEntry(&iter);
-                refId = (unsigned long) hashMapEntry_getKey(entry); //note could be invalid e.g. freed
-                ref = hashMapEntry_getValue(entry);
-
-                if (ref == reference) {
-                    break;
-                } else {
-                    ref = NULL;
-                    refId = 0UL;
-                }
+        CELIX_LONG_HASH_MAP_ITERATE(bundle->serviceReferences, iter) {
+            if (iter.value.ptrValue == reference) {
+                refId = iter.key; //note the registration of the reference could already be invalid e.g. freed
+                ref = reference;
+                break;
             }
         }
 
         if (ref != NULL) {
-            hashMap_remove(refsMap, (void*)refId);
-            int size = hashMap_size(refsMap);
-            if (size == 0) {
-                hashMap_destroy(refsMap, false, false);
-                hashMap_remove(registry->serviceReferences, bundle);
-            }
+            celix_longHashMap_remove(bundle->serviceReferences, refId);
         } else {
             fw_log(registry->framework->logger, CELIX_LOG_LEVEL_FATAL, "Cannot find reference %p in serviceReferences map",
                    reference);
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadMutex_unlock(&bundle->serviceReferencesMutex);
 
     return status;
 }
@@ -517,13 +538,12 @@ static void serviceRegistry_logWarningServiceReferenceUsageCount(service_registr
 celix_status_t serviceRegistry_clearReferencesFor(service_registry_pt registry, bundle_pt bundle) {
     celix_status_t status = CELIX_SUCCESS;
 
-    celixThreadRwlock_writeLock(&registry->lock);
+    celixThreadMutex_lock(&bundle->serviceReferencesMutex);
 
-    hash_map_pt refsMap = hashMap_remove(registry->serviceReferences, bundle);
+    celix_long_hash_map_t* refsMap = bundle->serviceReferences;
     if (refsMap != NULL) {
-        hash_map_iterator_pt iter = hashMapIterator_create(refsMap);
-        while (hashMapIterator_hasNext(iter)) {
-            service_reference_pt ref = hashMapIterator_nextValue(iter);
+        CELIX_LONG_HASH_MAP_ITERATE(refsMap, iter) {
+            service_reference_pt ref = iter.value.ptrValue;
             size_t refCount;
             size_t usageCount;
 
@@ -540,11 +560,10 @@ celix_status_t serviceRegistry_clearReferencesFor(service_registry_pt registry,
                 serviceReference_release(ref, &destroyed);
             }
         }
-        hashMapIterator_destroy(iter);
-        hashMap_destroy(refsMap, false, false);
+        celix_longHashMap_clear(refsMap);
     }
 
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadMutex_unlock(&bundle->serviceReferencesMutex);
 
     return status;
 }
@@ -555,84 +574,26 @@ celix_status_t serviceRegistry_getServicesInUse(service_registry_pt registry, bu
     array_list_pt result = NULL;
     arrayList_create(&result);
 
-    //LOCK
-    celixThreadRwlock_readLock(&registry->lock);
-
-    hash_map_pt refsMap = hashMap_get(registry->serviceReferences, bundle);
-
-    if(refsMap) {
-        hash_map_iterator_pt iter = hashMapIterator_create(refsMap);
-        while (hashMapIterator_hasNext(iter)) {
-            service_reference_pt ref = hashMapIterator_nextValue(iter);
-            arrayList_add(result, ref);
-        }
-        hashMapIterator_destroy(iter);
+    celixThreadMutex_lock(&bundle->serviceReferencesMutex);
+    CELIX_LONG_HASH_MAP_ITERATE(bundle->serviceReferences, iter) {
+        service_reference_pt ref = iter.value.ptrValue;
+        arrayList_add(result, ref);
     }
-
-    //UNLOCK
-    celixThreadRwlock_unlock(&registry->lock);
+    celixThreadMutex_unlock(&bundle->serviceReferencesMutex);
 
     *out = result;
 
 	return CELIX_SUCCESS;
 }
 
-celix_status_t serviceRegistry_getService(service_registry_pt registry, bundle_pt bundle, service_reference_pt reference, const void **out) {
-	celix_status_t status = CELIX_SUCCESS;
-	service_registration_pt registration = NULL;
-    size_t count = 0;
-    const void *service = NULL;
-    bool valid = false;
-
-
-    celixThreadRwlock_readLock(&registry->lock);
-    serviceReference_getServiceRegistration(reference, &registration);
-    valid = serviceRegistration_isValid(registration);
-    if (valid) {
-        serviceRegistration_retain(registration);
-        serviceReference_increaseUsage(reference, &count);
-        if (count == 1) {
-            serviceRegistration_getService(registration, bundle, &service);
-            serviceReference_setService(reference, service);
-        }
-    }
-    celixThreadRwlock_unlock(&registry->lock);
-    if(!valid) {
-        *out = NULL;
-        return status;
-    }
-
-    serviceRegistration_release(registration);
-
-    /* NOTE the out argument of sr_getService should be 'const void**'
-       To ensure backwards compatibility a cast is made instead.
-    */
-    serviceReference_getService(reference, (void **)out);
-
-	return status;
+celix_status_t serviceRegistry_getService(service_registry_pt registry __attribute__((unused)), bundle_pt bundle, service_reference_pt reference, const void **out) {
+    //note no registry lock needed, the usage count is managed by the service reference itself
+    return serviceReference_getServiceAndIncreaseUsage(reference, bundle, out);
 }
 
-celix_status_t serviceRegistry_ungetService(service_registry_pt registry, bundle_pt bundle, service_reference_pt reference, bool *result) {
-    service_registration_pt reg = NULL;
-    const void *service = NULL;
+celix_status_t serviceRegistry_ungetService(service_registry_pt registry __attribute__((unused)), bundle_pt bundle, service_reference_pt reference, bool *result __attribute__((unused))) {
     size_t count = 0;
-
-    celixThreadRwlock_readLock(&registry->lock);
-    celixThreadRwlock_unlock(&registry->lock);
-
-    celix_status_t status = serviceReference_decreaseUsage(reference, &count);
-    if (count == 0) {
-        /*NOTE the argument service of sr_getService should be 'const void**'
-          To ensure backwards compatibility a cast is made instead.
-          */
-        serviceReference_getService(reference, (void**)&service);
-        serviceReference_getServiceRegistration(reference, &reg);
-        if (reg != NULL) {
-            serviceRegistration_ungetService(reg, bundle, &service);
-        }
-    }
-
-	return status;
+    return serviceReference_decreaseUsageAndUngetService(reference, bundle, &count);
 }
 
 static celix_status_t serviceRegistry_addHooks(service_registry_pt registry, const char* serviceName, const void* serviceObject __attribute__((unused)), service_registration_pt registration) {
@@ -791,22 +752,10 @@ size_t serviceRegistry_nrOfHooks(service_registry_pt registry) {
 static celix_status_t serviceRegistry_getUsingBundles(service_registry_pt registry, service_registration_pt registration, array_list_pt *out) {
     celix_status_t status;
     array_list_pt bundles = NULL;
-    hash_map_iterator_pt iter;
 
     status = arrayList_create(&bundles);
     if (status == CELIX_SUCCESS) {
-        celixThreadRwlock_readLock(&registry->lock);
-        iter = hashMapIterator_create(registry->serviceReferences);
-        while (hashMapIterator_hasNext(iter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
-            bundle_pt registrationUser = hashMapEntry_getKey(entry);
-            hash_map_pt regMap = hashMapEntry_getValue(entry);
-            if (hashMap_containsKey(regMap, (void*)registration->serviceId)) {
-                arrayList_add(bundles, registrationUser);
-            }
-        }
-        hashMapIterator_destroy(iter);
-        celixThreadRwlock_unlock(&registry->lock);
+        serviceRegistration_getReferenceOwners(registration, bundles);
     }
 
     if (status == CELIX_SUCCESS) {
@@ -919,6 +868,7 @@ static inline void celix_waitAndDestroyServiceListener(celix_service_registry_se
     //destroy
     celixThreadMutex_destroy(&entry->mutex);
     celixThreadCondition_destroy(&entry->cond);
+    celix_compiledFilter_destroy(entry->compiledFilter);
     celix_filter_destroy(entry->filter);
     free(entry);
 }
@@ -984,6 +934,52 @@ static int celix_serviceRegistry_compareRegistrations(const void *a, const void
     return celix_utils_compareServiceIdsAndRanking(servIdA, servRankingA, servIdB, servRankingB);
 }
 
+static void celix_serviceRegistry_addFilterMatchingRegistrations(celix_array_list_t *regs, const celix_filter_t *filter, celix_array_list_t *matchedRegistrations) {
+    //only call after locked registry RWlock
+    for (int i = 0; regs != NULL && i < celix_arrayList_size(regs); ++i) {
+        service_registration_t *reg = celix_arrayList_get(regs, i);
+        celix_properties_t* svcProps = NULL;
+        serviceRegistration_getProperties(reg, &svcProps);
+        if (svcProps != NULL && celix_filter_match(filter, svcProps)) {
+            celix_arrayList_add(matchedRegistrations, reg);
+        }
+    }
+}
+
+typedef struct celix_service_registry_filter_matching_data {
+    const celix_filter_t *filter;
+    celix_array_list_t *matchedRegistrations;
+} celix_service_registry_filter_matching_data_t;
+
+static void celix_serviceRegistry_addFilterMatchingSnapshotEntry(void *handle, const celix_service_registry_snapshot_entry_t *entry) {
+    //only call in a snapshot read section
+    celix_service_registry_filter_matching_data_t *data = handle;
+    celix_properties_t* svcProps = NULL;
+    serviceRegistration_getProperties(entry->registration, &svcProps);
+    if (svcProps != NULL && celix_filter_match(data->filter, svcProps)) {
+        celix_arrayList_add(data->matchedRegistrations, entry->registration);
+    }
+}
+
+/**
+ * Adds all registrations matching the filter to the matchedRegistrations list.
+ * If the filter requires a specific objectClass, only the registrations from the service name index are matched.
+ */
+static void celix_serviceRegistry_findMatchingRegistrations(celix_service_registry_t *registry, const celix_filter_t *filter, celix_array_list_t *matchedRegistrations) {
+    //only call after locked registry RWlock
+    const char *svcName = celix_serviceRegistry_findServiceNameInFilter(filter);
+    if (svcName != NULL) {
+        celix_serviceRegistry_addFilterMatchingRegistrations(celix_stringHashMap_get(registry->serviceRegistrationsByName, svcName), filter, matchedRegistrations);
+        celix_serviceRegistry_addFilterMatchingRegistrations(registry->serviceRegistrationsWithOtherObjectClass, filter, matchedRegistrations);
+    } else {
+        hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
+        while (hashMapIterator_hasNext(&iter)) {
+            celix_array_list_t *regs = hashMapIterator_nextValue(&iter);
+            celix_serviceRegistry_addFilterMatchingRegistrations(regs, filter, matchedRegistrations);
+        }
+    }
+}
+
 celix_array_list_t* celix_serviceRegisrty_findServices(
         celix_service_registry_t* registry,
         const char* filterStr) {
@@ -996,22 +992,15 @@ celix_array_list_t* celix_serviceRegisrty_findServices(
     }
 
     celix_array_list_t *result = celix_arrayList_create();
-    celix_array_list_t* matchedRegistrations = celix_arrayList_create();
+    celix_array_list_storage_t matchedRegistrationsStorage;
+    celix_array_list_t* matchedRegistrations = celix_arrayList_init(&matchedRegistrationsStorage);
 
-    celixThreadRwlock_readLock(&registry->lock);
+    int token;
+    celix_service_registry_snapshot_t* snapshot = celix_serviceRegistry_readLockSnapshot(registry, &token);
 
-    hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_array_list_t *regs = hashMapIterator_nextValue(&iter);
-        for (int i = 0; i < celix_arrayList_size(regs); ++i) {
-            service_registration_t *reg = celix_arrayList_get(regs, i);
-            celix_properties_t* svcProps = NULL;
-            serviceRegistration_getProperties(reg, &svcProps);
-            if (svcProps != NULL && celix_filter_match(filter, svcProps)) {
-                celix_arrayList_add(matchedRegistrations, reg);
-            }
-        }
-    }
+    celix_service_registry_filter_matching_data_t data = {filter, matchedRegistrations};
+    const char *svcName = celix_serviceRegistry_findServiceNameInFilter(filter); //note if NULL, all entries are visited
+    celix_serviceRegistry_visitSnapshotEntries(snapshot, svcName, true, celix_serviceRegistry_addFilterMatchingSnapshotEntry, &data);
 
     //sort matched registration and add the svc id to the result list.
     if (celix_arrayList_size(matchedRegistrations) > 1) {
@@ -1021,7 +1010,7 @@ celix_array_list_t* celix_serviceRegisrty_findServices(
         service_registration_t* reg = celix_arrayList_get(matchedRegistrations, i);
         celix_arrayList_addLong(result, serviceRegistration_getServiceId(reg));
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celix_serviceRegistry_readUnlockSnapshot(registry, token);
 
     celix_filter_destroy(filter);
     celix_arrayList_destroy(matchedRegistrations);
@@ -1054,32 +1043,24 @@ bool celix_serviceRegistry_getServiceInfo(
         bool *outIsFactory) {
     bool found = false;
 
-    celixThreadRwlock_readLock(&registry->lock);
-    celix_bundle_t *bundle = framework_getBundleById(registry->framework, bndId);
-    celix_array_list_t *registrations = bundle != NULL ? hashMap_get(registry->serviceRegistrations, bundle) : NULL;
-    if (registrations != NULL) {
-        for (int i = 0; i < celix_arrayList_size(registrations); ++i) {
-            service_registration_t *reg = celix_arrayList_get(registrations, i);
-            if (svcId == serviceRegistration_getServiceId(reg)) {
-                found = true;
-                if (outServiceName != NULL) {
-                    const char *s = NULL;
-                    serviceRegistration_getServiceName(reg, &s);
-                    *outServiceName = celix_utils_strdup(s);
-                }
-                if (outServiceProperties != NULL) {
-                    celix_properties_t *p = NULL;
-                    serviceRegistration_getProperties(reg, &p);
-                    *outServiceProperties = celix_properties_copy(p);
-                }
-                if (outIsFactory != NULL) {
-                    *outIsFactory = serviceRegistration_isFactoryService(reg);
-                }
-                break;
-            }
+    int token;
+    celix_service_registry_snapshot_t* snapshot = celix_serviceRegistry_readLockSnapshot(registry, &token);
+    const celix_service_registry_snapshot_entry_t* entry = celix_serviceRegistry_findSnapshotEntry(snapshot, svcId);
+    if (entry != NULL && entry->bndId == bndId) {
+        found = true;
+        if (outServiceName != NULL) {
+            *outServiceName = celix_utils_strdup(entry->serviceName);
+        }
+        if (outServiceProperties != NULL) {
+            celix_properties_t *p = NULL;
+            serviceRegistration_getProperties(entry->registration, &p);
+            *outServiceProperties = celix_properties_copy(p);
+        }
+        if (outIsFactory != NULL) {
+            *outIsFactory = serviceRegistration_isFactoryService(entry->registration);
         }
     }
-    celixThreadRwlock_unlock(&registry->lock);
+    celix_serviceRegistry_readUnlockSnapshot(registry, token);
 
     return found;
 }
@@ -1098,36 +1079,35 @@ celix_status_t celix_serviceRegistry_addServiceListener(celix_service_registry_t
     celix_service_registry_service_listener_entry_t *entry = calloc(1, sizeof(*entry));
     entry->bundle = bundle;
     entry->filter = filter;
+    entry->compiledFilter = celix_filter_compile(filter);
     entry->listener = listener;
     entry->useCount = 1; //new entry -> count on 1
     celixThreadMutex_create(&entry->mutex, NULL);
     celixThreadCondition_init(&entry->cond, NULL);
 
-    celix_array_list_t *references =  celix_arrayList_create();
+    celix_array_list_storage_t referencesStorage;
+    celix_array_list_t *references =  celix_arrayList_init(&referencesStorage);
 
     celixThreadRwlock_writeLock(&registry->lock);
     celix_arrayList_add(registry->serviceListeners, entry); //use count 1
+    celix_serviceRegistry_addServiceListenerToIndex(registry, entry);
 
     //find already registered services
-    hash_map_iterator_t iter = hashMapIterator_construct(registry->serviceRegistrations);
-    while (hashMapIterator_hasNext(&iter)) {
-        celix_array_list_t *regs = (array_list_pt) hashMapIterator_nextValue(&iter);
-        for (int regIdx = 0; (regs != NULL) && regIdx < celix_arrayList_size(regs); ++regIdx) {
-            service_registration_pt registration = celix_arrayList_get(regs, regIdx);
-            properties_pt props = NULL;
-            serviceRegistration_getProperties(registration, &props);
-            if (celix_filter_match(filter, props)) {
-                serviceRegistration_retain(registration);
-                long svcId = serviceRegistration_getServiceId(registration);
-                service_reference_pt ref = NULL;
-                serviceRegistry_getServiceReference_internal(registry, bundle, registration, &ref);
-                celix_arrayList_add(references, ref);
-                //update pending register event count
-                celix_increasePendingRegisteredEvent(registry, svcId);
-            }
-        }
+    celix_array_list_storage_t matchedRegistrationsStorage;
+    celix_array_list_t *matchedRegistrations = celix_arrayList_init(&matchedRegistrationsStorage);
+    celix_serviceRegistry_findMatchingRegistrations(registry, filter, matchedRegistrations);
+    for (int i = 0; i < celix_arrayList_size(matchedRegistrations); ++i) {
+        service_registration_pt registration = celix_arrayList_get(matchedRegistrations, i);
+        serviceRegistration_retain(registration);
+        long svcId = serviceRegistration_getServiceId(registration);
+        service_reference_pt ref = NULL;
+        serviceRegistry_getServiceReference_internal(registry, bundle, registration, &ref);
+        celix_arrayList_add(references, ref);
+        //update pending register event count
+        celix_increasePendingRegisteredEvent(registry, svcId);
     }
     celixThreadRwlock_unlock(&registry->lock);
+    celix_arrayList_destroy(matchedRegistrations);
 
     //NOTE there is a race condition with serviceRegistry_registerServiceInternal, as result
     //a REGISTERED event can be triggered twice instead of once. The service tracker can deal with this.
@@ -1167,6 +1147,7 @@ celix_status_t celix_serviceRegistry_removeServiceListener(celix_service_registr
         if (visit->listener == listener) {
             entry = visit;
             celix_arrayList_removeAt(registry->serviceListeners, i);
+            celix_serviceRegistry_removeServiceListenerFromIndex(registry, entry);
             break;
         }
     }
@@ -1182,38 +1163,34 @@ celix_status_t celix_serviceRegistry_removeServiceListener(celix_service_registr
     return CELIX_SUCCESS;
 }
 
+static void celix_serviceRegistry_retainMatchingServiceListeners(celix_array_list_t *listeners, celix_properties_t *props, celix_array_list_t *matchedEntries) {
+    //only call after locked registry RWlock
+    for (int i = 0; listeners != NULL && i < celix_arrayList_size(listeners); ++i) {
+        celix_service_registry_service_listener_entry_t *entry = celix_arrayList_get(listeners, i);
+        if (celix_compiledFilter_match(entry->compiledFilter, props)) {
+            celix_increaseCountServiceListener(entry); //ensure that use count > 0, so that the listener cannot be destroyed until all pending event are handled.
+            celix_arrayList_add(matchedEntries, entry);
+        }
+    }
+}
+
 static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *registry, celix_service_event_type_t eventType, service_registration_pt registration) {
     celix_service_registry_service_listener_entry_t *entry;
 
-    celix_array_list_t* retainedEntries = celix_arrayList_create();
-    celix_array_list_t* matchedEntries = celix_arrayList_create();
+    celix_array_list_storage_t matchedEntriesStorage;
+    celix_array_list_t* matchedEntries = celix_arrayList_init(&matchedEntriesStorage);
+    celix_properties_t *props = NULL;
+    serviceRegistration_getProperties(registration, &props);
+    const char *objectClass = celix_properties_get(props, OSGI_FRAMEWORK_OBJECTCLASS, NULL);
 
+    //note only the service listeners for the objectClass of the service and the listeners for all services can match
     celixThreadRwlock_readLock(&registry->lock);
-    for (int i = 0; i < celix_arrayList_size(registry->serviceListeners); ++i) {
-        entry = celix_arrayList_get(registry->serviceListeners, i);
-        celix_arrayList_add(retainedEntries, entry);
-        celix_increaseCountServiceListener(entry); //ensure that use count > 0, so that the listener cannot be destroyed until all pending event are handled.
+    if (objectClass != NULL) {
+        celix_serviceRegistry_retainMatchingServiceListeners(celix_stringHashMap_get(registry->serviceListenersByName, objectClass), props, matchedEntries);
     }
+    celix_serviceRegistry_retainMatchingServiceListeners(registry->serviceListenersForAllNames, props, matchedEntries);
     celixThreadRwlock_unlock(&registry->lock);
 
-    for (int i = 0; i < celix_arrayList_size(retainedEntries); ++i) {
-        entry = celix_arrayList_get(retainedEntries, i);
-        int matched = 0;
-        celix_properties_t *props = NULL;
-        bool matchResult = false;
-        serviceRegistration_getProperties(registration, &props);
-        if (entry->filter != NULL) {
-            filter_match(entry->filter, props, &matchResult);
-        }
-        matched = (entry->filter == NULL) || matchResult;
-        if (matched) {
-            celix_arrayList_add(matchedEntries, entry);
-        } else {
-            celix_decreaseCountServiceListener(entry); //Not a match -> release entry
-        }
-    }
-    celix_arrayList_destroy(retainedEntries);
-
     /*
      * TODO FIXME, A deadlock can happen when (e.g.) a service is deregistered, triggering this fw_serviceChanged and
      * one of the matching service listener callbacks tries to remove an other matched service listener.
@@ -1240,32 +1217,32 @@ static void celix_serviceRegistry_serviceChanged(celix_service_registry_t *regis
 
 static void celix_increasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId) {
     celixThreadMutex_lock(&registry->pendingRegisterEvents.mutex);
-    long count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
+    long count = celix_longHashMap_getLong(registry->pendingRegisterEvents.map, svcId, 0);
     count += 1;
-    hashMap_put(registry->pendingRegisterEvents.map, (void*)svcId, (void*)count);
+    celix_longHashMap_putLong(registry->pendingRegisterEvents.map, svcId, count);
     celixThreadMutex_unlock(&registry->pendingRegisterEvents.mutex);
 }
 
 static void celix_decreasePendingRegisteredEvent(celix_service_registry_t *registry, long svcId) {
     celixThreadMutex_lock(&registry->pendingRegisterEvents.mutex);
-    long count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
+    long count = celix_longHashMap_getLong(registry->pendingRegisterEvents.map, svcId, 0);
     assert(count >= 1);
     count -= 1;
     if (count > 0) {
-        hashMap_put(registry->pendingRegisterEvents.map, (void *)svcId, (void *)count);
+        celix_longHashMap_putLong(registry->pendingRegisterEvents.map, svcId, count);
     } else {
-        hashMap_remove(registry->pendingRegisterEvents.map, (void*)svcId);
+        celix_longHashMap_remove(registry->pendingRegisterEvents.map, svcId);
     }
-    celixThreadCondition_signal(&registry->pendingRegisterEvents.cond);
+    celixThreadCondition_broadcast(&registry->pendingRegisterEvents.cond); //note can be multiple waiters, when using multiple event loops
     celixThreadMutex_unlock(&registry->pendingRegisterEvents.mutex);
 }
 
 static void celix_waitForPendingRegisteredEvents(celix_service_registry_t *registry, long svcId) {
     celixThreadMutex_lock(&registry->pendingRegisterEvents.mutex);
-    long count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
+    long count = celix_longHashMap_getLong(registry->pendingRegisterEvents.map, svcId, 0);
     while (count > 0) {
         celixThreadCondition_wait(&registry->pendingRegisterEvents.cond, &registry->pendingRegisterEvents.mutex);
-        count = (long)hashMap_get(registry->pendingRegisterEvents.map, (void*)svcId);
+        count = celix_longHashMap_getLong(registry->pendingRegisterEvents.map, svcId, 0);
     }
     celixThreadMutex_unlock(&registry->pendingRegisterEvents.mutex);
 }
@@ -1278,19 +1255,10 @@ long celix_serviceRegistry_nextSvcId(celix_service_registry_t* registry) {
 bool celix_serviceRegistry_isServiceRegistered(celix_service_registry_t* reg, long serviceId) {
     bool isRegistered = false;
     if (serviceId >= 0) {
-        celixThreadRwlock_readLock(&reg->lock);
-        hash_map_iterator_t iter = hashMapIterator_construct(reg->serviceRegistrations);
-        while (!isRegistered && hashMapIterator_hasNext(&iter)) {
-            celix_array_list_t *regs = hashMapIterator_nextValue(&iter);
-            for (int i = 0; i < celix_arrayList_size(regs); ++i) {
-                service_registration_t* r = celix_arrayList_get(regs, i);
-                if (serviceId == serviceRegistration_getServiceId(r)) {
-                    isRegistered = true;
-                    break;
-                }
-            }
-        }
-        celixThreadRwlock_unlock(&reg->lock);
+        int token;
+        celix_service_registry_snapshot_t* snapshot = celix_serviceRegistry_readLockSnapshot(reg, &token);
+        isRegistered = celix_serviceRegistry_findSnapshotEntry(snapshot, serviceId) != NULL;
+        celix_serviceRegistry_readUnlockSnapshot(reg, token);
     }
     return isRegistered;
 }
@@ -1316,3 +1284,414 @@ void celix_serviceRegistry_unregisterService(celix_service_registry_t* registry,
         fw_log(registry->framework->logger, CELIX_LOG_LEVEL_ERROR, "Cannot unregister service for service id %li. This id is not present or owned by the provided bundle (bnd id %li)", serviceId, celix_bundle_getId(bnd));
     }
 }
+
+static const char* celix_serviceRegistry_findServiceNameInFilter(const celix_filter_t *filter) {
+    //note only a objectClass equal operand which is not part of a OR or NOT operand restricts the matching services.
+    const char *result = NULL;
+    if (filter != NULL && filter->operand == CELIX_FILTER_OPERAND_AND) {
+        for (int i = 0; i < celix_arrayList_size(filter->children); ++i) {
+            result = celix_serviceRegistry_findServiceNameInFilter(celix_arrayList_get(filter->children, i));
+            if (result != NULL) {
+                break;
+            }
+        }
+    } else if (filter != NULL && filter->operand == CELIX_FILTER_OPERAND_EQUAL && strcmp(filter->attribute, OSGI_FRAMEWORK_OBJECTCLASS) == 0) {
+        result = filter->value;
+    }
+    return result;
+}
+
+/**
+ * Adds the registration to the service name index.
+ * The index is keyed on the service name of the registration. Registrations which have a objectClass property
+ * different from their service name are also kept in a separate list, so that they can still be found using
+ * a objectClass filter attribute.
+ */
+static void celix_serviceRegistry_addToServiceNameIndex(celix_service_registry_t *registry, service_registration_t *registration) {
+    //only call after locked registry RWlock (write)
+    const char *svcName = NULL;
+    celix_properties_t *props = NULL;
+    serviceRegistration_getServiceName(registration, &svcName);
+    serviceRegistration_getProperties(registration, &props);
+
+    celix_array_list_t *regs = celix_stringHashMap_get(registry->serviceRegistrationsByName, svcName);
+    if (regs == NULL) {
+        regs = celix_arrayList_create();
+        celix_stringHashMap_put(registry->serviceRegistrationsByName, svcName, regs);
+    }
+    celix_arrayList_add(regs, registration);
+
+    const char *objectClass = celix_properties_get(props, OSGI_FRAMEWORK_OBJECTCLASS, NULL);
+    if (objectClass != NULL && strcmp(objectClass, svcName) != 0) {
+        celix_arrayList_add(registry->serviceRegistrationsWithOtherObjectClass, registration);
+    }
+}
+
+static void celix_serviceRegistry_removeFromServiceNameIndex(celix_service_registry_t *registry, service_registration_t *registration) {
+    //only call after locked registry RWlock (write)
+    const char *svcName = NULL;
+    serviceRegistration_getServiceName(registration, &svcName);
+    celix_array_list_t *regs = celix_stringHashMap_get(registry->serviceRegistrationsByName, svcName);
+    if (regs != NULL) {
+        celix_arrayList_remove(regs, registration);
+        if (celix_arrayList_size(regs) == 0) {
+            celix_stringHashMap_remove(registry->serviceRegistrationsByName, svcName);
+            celix_arrayList_destroy(regs);
+        }
+    }
+    celix_arrayList_remove(registry->serviceRegistrationsWithOtherObjectClass, registration);
+}
+
+static void celix_serviceRegistry_addServiceListenerToIndex(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry) {
+    //only call after locked registry RWlock (write)
+    const char *svcName = celix_serviceRegistry_findServiceNameInFilter(entry->filter);
+    if (svcName != NULL) {
+        celix_array_list_t *listeners = celix_stringHashMap_get(registry->serviceListenersByName, svcName);
+        if (listeners == NULL) {
+            listeners = celix_arrayList_create();
+            celix_stringHashMap_put(registry->serviceListenersByName, svcName, listeners);
+        }
+        celix_arrayList_add(listeners, entry);
+    } else {
+        celix_arrayList_add(registry->serviceListenersForAllNames, entry);
+    }
+}
+
+static void celix_serviceRegistry_removeServiceListenerFromIndex(celix_service_registry_t *registry, celix_service_registry_service_listener_entry_t *entry) {
+    //only call after locked registry RWlock (write)
+    const char *svcName = celix_serviceRegistry_findServiceNameInFilter(entry->filter);
+    if (svcName != NULL) {
+        celix_array_list_t *listeners = celix_stringHashMap_get(registry->serviceListenersByName, svcName);
+        if (listeners != NULL) {
+            celix_arrayList_remove(listeners, entry);
+            if (celix_arrayList_size(listeners) == 0) {
+                celix_stringHashMap_remove(registry->serviceListenersByName, svcName);
+                celix_arrayList_destroy(listeners);
+            }
+        }
+    } else {
+        celix_arrayList_remove(registry->serviceListenersForAllNames, entry);
+    }
+}
+
+#define CELIX_SERVICE_REGISTRY_SEGMENT_CAPACITY 128
+#define CELIX_SERVICE_REGISTRY_MAX_RETIRED 64
+
+/**
+ * Describes the change of a snapshot index: the replaced segment (if any) and the new segments.
+ */
+typedef struct celix_service_registry_index_change {
+    size_t segmentIndex;
+    size_t nrOfReplaced; //0 or 1
+    size_t nrOfNew; //0, 1 or 2
+    celix_service_registry_snapshot_segment_t* newSegments[2];
+} celix_service_registry_index_change_t;
+
+static celix_service_registry_snapshot_t* celix_serviceRegistry_createSnapshot(size_t nrOfIdSegments, size_t nrOfNameSegments, size_t otherObjectClassSize) {
+    //note snapshot, segment pointers and other object class entries are allocated at once
+    celix_service_registry_snapshot_t* snapshot = malloc(sizeof(*snapshot) +
+            (nrOfIdSegments + nrOfNameSegments) * sizeof(celix_service_registry_snapshot_segment_t*) +
+            otherObjectClassSize * sizeof(celix_service_registry_snapshot_entry_t));
+    snapshot->size = 0;
+    snapshot->byId.nrOfSegments = nrOfIdSegments;
+    snapshot->byId.segments = (celix_service_registry_snapshot_segment_t**)(snapshot + 1);
+    snapshot->byName.nrOfSegments = nrOfNameSegments;
+    snapshot->byName.segments = snapshot->byId.segments + nrOfIdSegments;
+    snapshot->otherObjectClassSize = otherObjectClassSize;
+    snapshot->otherObjectClass = (celix_service_registry_snapshot_entry_t*)(snapshot->byName.segments + nrOfNameSegments);
+    return snapshot;
+}
+
+static celix_service_registry_snapshot_segment_t* celix_serviceRegistry_createSegment(size_t size) {
+    celix_service_registry_snapshot_segment_t* segment = malloc(sizeof(*segment) + size * sizeof(celix_service_registry_snapshot_entry_t));
+    segment->size = size;
+    return segment;
+}
+
+static void celix_serviceRegistry_destroySnapshots(celix_service_registry_t *registry) {
+    celix_rcu_synchronize(registry->rcu);
+    for (int i = 0; i < celix_arrayList_size(registry->retired); ++i) {
+        free(celix_arrayList_get(registry->retired, i));
+    }
+    celix_arrayList_destroy(registry->retired);
+    celix_service_registry_snapshot_t* snapshot = registry->snapshot;
+    for (size_t i = 0; i < snapshot->byId.nrOfSegments; ++i) {
+        free(snapshot->byId.segments[i]);
+    }
+    for (size_t i = 0; i < snapshot->byName.nrOfSegments; ++i) {
+        free(snapshot->byName.segments[i]);
+    }
+    free(snapshot);
+}
+
+static int celix_serviceRegistry_compareSnapshotEntry(bool onName, const celix_service_registry_snapshot_entry_t* entry, const char* serviceName, long svcId) {
+    int cmp = onName ? strcmp(entry->serviceName, serviceName) : 0;
+    if (cmp == 0) {
+        cmp = entry->svcId < svcId ? -1 : (entry->svcId > svcId ? 1 : 0);
+    }
+    return cmp;
+}
+
+/**
+ * Finds the position of the first entry in the index which is not less than the provided service name and
+ * service id. Returns false if there is no such entry.
+ */
+static bool celix_serviceRegistry_lowerBound(const celix_service_registry_snapshot_index_t* index, bool onName, const char* serviceName, long svcId, size_t* segmentIndex, size_t* pos) {
+    //find the first segment with a last entry not less than the key
+    size_t low = 0;
+    size_t high = index->nrOfSegments;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        const celix_service_registry_snapshot_segment_t* segment = index->segments[mid];
+        if (celix_serviceRegistry_compareSnapshotEntry(onName, &segment->entries[segment->size - 1], serviceName, svcId) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (low == index->nrOfSegments) {
+        return false;
+    }
+    *segmentIndex = low;
+
+    const celix_service_registry_snapshot_segment_t* segment = index->segments[low];
+    low = 0;
+    high = segment->size;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (celix_serviceRegistry_compareSnapshotEntry(onName, &segment->entries[mid], serviceName, svcId) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *pos = low;
+    return true;
+}
+
+static celix_service_registry_index_change_t celix_serviceRegistry_insertInIndex(const celix_service_registry_snapshot_index_t* index, bool onName, const celix_service_registry_snapshot_entry_t* entry) {
+    celix_service_registry_index_change_t change;
+    memset(&change, 0, sizeof(change));
+    if (index->nrOfSegments == 0) {
+        change.nrOfNew = 1;
+        change.newSegments[0] = celix_serviceRegistry_createSegment(1);
+        change.newSegments[0]->entries[0] = *entry;
+        return change;
+    }
+
+    size_t pos;
+    if (!celix_serviceRegistry_lowerBound(index, onName, entry->serviceName, entry->svcId, &change.segmentIndex, &pos)) {
+        //append to the last segment
+        change.segmentIndex = index->nrOfSegments - 1;
+        pos = index->segments[change.segmentIndex]->size;
+    }
+    const celix_service_registry_snapshot_segment_t* old = index->segments[change.segmentIndex];
+    change.nrOfReplaced = 1;
+
+    size_t size = old->size + 1;
+    celix_service_registry_snapshot_entry_t* entries = malloc(size * sizeof(*entries));
+    memcpy(entries, old->entries, pos * sizeof(*entries));
+    entries[pos] = *entry;
+    memcpy(entries + pos + 1, old->entries + pos, (old->size - pos) * sizeof(*entries));
+
+    if (size <= CELIX_SERVICE_REGISTRY_SEGMENT_CAPACITY) {
+        change.nrOfNew = 1;
+        change.newSegments[0] = celix_serviceRegistry_createSegment(size);
+        memcpy(change.newSegments[0]->entries, entries, size * sizeof(*entries));
+    } else {
+        //split the segment
+        size_t firstSize = size / 2;
+        change.nrOfNew = 2;
+        change.newSegments[0] = celix_serviceRegistry_createSegment(firstSize);
+        memcpy(change.newSegments[0]->entries, entries, firstSize * sizeof(*entries));
+        change.newSegments[1] = celix_serviceRegistry_createSegment(size - firstSize);
+        memcpy(change.newSegments[1]->entries, entries + firstSize, (size - firstSize) * sizeof(*entries));
+    }
+    free(entries);
+    return change;
+}
+
+static celix_service_registry_index_change_t celix_serviceRegistry_removeFromIndex(const celix_service_registry_snapshot_index_t* index, bool onName, const celix_service_registry_snapshot_entry_t* entry) {
+    celix_service_registry_index_change_t change;
+    memset(&change, 0, sizeof(change));
+    size_t pos;
+    if (!celix_serviceRegistry_lowerBound(index, onName, entry->serviceName, entry->svcId, &change.segmentIndex, &pos)) {
+        return change;
+    }
+    const celix_service_registry_snapshot_segment_t* old = index->segments[change.segmentIndex];
+    if (old->entries[pos].registration != entry->registration) {
+        return change;
+    }
+    change.nrOfReplaced = 1;
+    if (old->size > 1) {
+        change.nrOfNew = 1;
+        change.newSegments[0] = celix_serviceRegistry_createSegment(old->size - 1);
+        memcpy(change.newSegments[0]->entries, old->entries, pos * sizeof(*entry));
+        memcpy(change.newSegments[0]->entries + pos, old->entries + pos + 1, (old->size - pos - 1) * sizeof(*entry));
+    }
+    return change;
+}
+
+static size_t celix_serviceRegistry_nrOfSegmentsAfterChange(const celix_service_registry_snapshot_index_t* index, const celix_service_registry_index_change_t* change) {
+    return index->nrOfSegments - change->nrOfReplaced + change->nrOfNew;
+}
+
+static void celix_serviceRegistry_applyIndexChange(celix_service_registry_t *registry, const celix_service_registry_snapshot_index_t* old, const celix_service_registry_index_change_t* change, celix_service_registry_snapshot_index_t* index) {
+    //only call after locked registry RWlock (write)
+    size_t i = 0;
+    for (; i < change->segmentIndex; ++i) {
+        index->segments[i] = old->segments[i];
+    }
+    for (size_t k = 0; k < change->nrOfNew; ++k) {
+        index->segments[i++] = change->newSegments[k];
+    }
+    for (size_t k = change->segmentIndex + change->nrOfReplaced; k < old->nrOfSegments; ++k) {
+        index->segments[i++] = old->segments[k];
+    }
+    if (change->nrOfReplaced > 0) {
+        celix_arrayList_add(registry->retired, old->segments[change->segmentIndex]);
+    }
+}
+
+/**
+ * Publishes a new snapshot and retires the old snapshot. Retired snapshots and segments are freed after a rcu
+ * synchronize; this is done in batches, unless forceSynchronize is true.
+ */
+static void celix_serviceRegistry_publishSnapshot(celix_service_registry_t *registry, celix_service_registry_snapshot_t *snapshot, bool forceSynchronize) {
+    //only call after locked registry RWlock (write)
+    celix_arrayList_add(registry->retired, registry->snapshot);
+    __atomic_store_n(&registry->snapshot, snapshot, __ATOMIC_SEQ_CST);
+    if (forceSynchronize || celix_arrayList_size(registry->retired) >= CELIX_SERVICE_REGISTRY_MAX_RETIRED) {
+        celix_rcu_synchronize(registry->rcu);
+        for (int i = 0; i < celix_arrayList_size(registry->retired); ++i) {
+            free(celix_arrayList_get(registry->retired, i));
+        }
+        celix_arrayList_clear(registry->retired);
+    }
+}
+
+static void celix_serviceRegistry_updateSnapshot(celix_service_registry_t *registry, const celix_service_registry_snapshot_entry_t* entry, bool add, bool otherObjectClass) {
+    //only call after locked registry RWlock (write)
+    celix_service_registry_snapshot_t* old = registry->snapshot;
+    celix_service_registry_index_change_t idChange = add ?
+            celix_serviceRegistry_insertInIndex(&old->byId, false, entry) :
+            celix_serviceRegistry_removeFromIndex(&old->byId, false, entry);
+    if (idChange.nrOfReplaced == 0 && idChange.nrOfNew == 0) {
+        return; //not found
+    }
+    celix_service_registry_index_change_t nameChange = add ?
+            celix_serviceRegistry_insertInIndex(&old->byName, true, entry) :
+            celix_serviceRegistry_removeFromIndex(&old->byName, true, entry);
+
+    size_t otherSize = old->otherObjectClassSize;
+    if (otherObjectClass) {
+        otherSize = add ? otherSize + 1 : otherSize - 1;
+    }
+    celix_service_registry_snapshot_t* snapshot = celix_serviceRegistry_createSnapshot(
+            celix_serviceRegistry_nrOfSegmentsAfterChange(&old->byId, &idChange),
+            celix_serviceRegistry_nrOfSegmentsAfterChange(&old->byName, &nameChange),
+            otherSize);
+    snapshot->size = add ? old->size + 1 : old->size - 1;
+    celix_serviceRegistry_applyIndexChange(registry, &old->byId, &idChange, &snapshot->byId);
+    celix_serviceRegistry_applyIndexChange(registry, &old->byName, &nameChange, &snapshot->byName);
+    size_t count = 0;
+    for (size_t i = 0; i < old->otherObjectClassSize; ++i) {
+        if (old->otherObjectClass[i].registration != entry->registration) {
+            snapshot->otherObjectClass[count++] = old->otherObjectClass[i];
+        }
+    }
+    if (add && otherObjectClass) {
+        snapshot->otherObjectClass[count] = *entry;
+    }
+
+    //note for a removal the rcu synchronize is forced, because the registration is released after unregistering
+    celix_serviceRegistry_publishSnapshot(registry, snapshot, !add);
+}
+
+static bool celix_serviceRegistry_hasOtherObjectClass(service_registration_t *registration, const char* serviceName) {
+    celix_properties_t *props = NULL;
+    serviceRegistration_getProperties(registration, &props);
+    const char *objectClass = celix_properties_get(props, OSGI_FRAMEWORK_OBJECTCLASS, NULL);
+    return objectClass != NULL && strcmp(objectClass, serviceName) != 0;
+}
+
+static void celix_serviceRegistry_addToSnapshot(celix_service_registry_t *registry, celix_bundle_t *bnd, service_registration_t *registration) {
+    //only call after locked registry RWlock (write)
+    celix_service_registry_snapshot_entry_t entry;
+    entry.svcId = serviceRegistration_getServiceId(registration);
+    entry.bndId = celix_bundle_getId(bnd);
+    entry.serviceName = NULL;
+    entry.registration = registration;
+    serviceRegistration_getServiceName(registration, &entry.serviceName);
+    celix_serviceRegistry_updateSnapshot(registry, &entry, true, celix_serviceRegistry_hasOtherObjectClass(registration, entry.serviceName));
+}
+
+static void celix_serviceRegistry_removeFromSnapshot(celix_service_registry_t *registry, service_registration_t *registration) {
+    //only call after locked registry RWlock (write)
+    const celix_service_registry_snapshot_entry_t* found = celix_serviceRegistry_findSnapshotEntry(registry->snapshot, serviceRegistration_getServiceId(registration));
+    if (found != NULL && found->registration == registration) {
+        celix_service_registry_snapshot_entry_t entry = *found;
+        bool otherObjectClass = false;
+        for (size_t i = 0; i < registry->snapshot->otherObjectClassSize; ++i) {
+            if (registry->snapshot->otherObjectClass[i].registration == registration) {
+                otherObjectClass = true;
+                break;
+            }
+        }
+        celix_serviceRegistry_updateSnapshot(registry, &entry, false, otherObjectClass);
+    }
+}
+
+static celix_service_registry_snapshot_t* celix_serviceRegistry_readLockSnapshot(celix_service_registry_t *registry, int *token) {
+    *token = celix_rcu_readLock(registry->rcu);
+    return __atomic_load_n(&registry->snapshot, __ATOMIC_SEQ_CST);
+}
+
+static void celix_serviceRegistry_readUnlockSnapshot(celix_service_registry_t *registry, int token) {
+    celix_rcu_readUnlock(registry->rcu, token);
+}
+
+static const celix_service_registry_snapshot_entry_t* celix_serviceRegistry_findSnapshotEntry(const celix_service_registry_snapshot_t *snapshot, long svcId) {
+    size_t segmentIndex;
+    size_t pos;
+    if (celix_serviceRegistry_lowerBound(&snapshot->byId, false, NULL, svcId, &segmentIndex, &pos)) {
+        const celix_service_registry_snapshot_entry_t* entry = &snapshot->byId.segments[segmentIndex]->entries[pos];
+        return entry->svcId == svcId ? entry : NULL;
+    }
+    return NULL;
+}
+
+/**
+ * Visits the snapshot entries for the provided service name, including the entries with a different objectClass
+ * property if includeOtherObjectClass is true. If serviceName is NULL, all entries are visited.
+ */
+static void celix_serviceRegistry_visitSnapshotEntries(const celix_service_registry_snapshot_t *snapshot, const char *serviceName, bool includeOtherObjectClass, celix_service_registry_snapshot_visitor_fp visitor, void *data) {
+    if (serviceName == NULL) {
+        for (size_t i = 0; i < snapshot->byId.nrOfSegments; ++i) {
+            const celix_service_registry_snapshot_segment_t* segment = snapshot->byId.segments[i];
+            for (size_t k = 0; k < segment->size; ++k) {
+                visitor(data, &segment->entries[k]);
+            }
+        }
+        return;
+    }
+
+    size_t segmentIndex;
+    size_t pos;
+    if (celix_serviceRegistry_lowerBound(&snapshot->byName, true, serviceName, LONG_MIN, &segmentIndex, &pos)) {
+        for (; segmentIndex < snapshot->byName.nrOfSegments; ++segmentIndex, pos = 0) {
+            const celix_service_registry_snapshot_segment_t* segment = snapshot->byName.segments[segmentIndex];
+            for (; pos < segment->size && strcmp(segment->entries[pos].serviceName, serviceName) == 0; ++pos) {
+                visitor(data, &segment->entries[pos]);
+            }
+            if (pos < segment->size) {
+                break;
+            }
+        }
+    }
+    if (includeOtherObjectClass) {
+        for (size_t i = 0; i < snapshot->otherObjectClassSize; ++i) {
+            visitor(data, &snapshot->otherObjectClass[i]);
+        }
+    }
+}
@@ -31,6 +31,9 @@
 #include "service_registry.h"
 #include "listener_hook_service.h"
 #include "service_reference.h"
+#include "celix_long_hash_map.h"
+#include "celix_string_hash_map.h"
+#include "celix_rcu.h"
 
 #define CELIX_SERVICE_REGISTRY_STATIC_EVENT_QUEUE_SIZE  64
 
@@ -53,19 +56,69 @@ typedef struct celix_service_registry_event {
     void (*unregisterCallback)(void *data);
 } celix_service_registry_event_t;
 
+/**
+ * @brief Entry of a service registry snapshot. The service name is owned by the registration.
+ */
+typedef struct celix_service_registry_snapshot_entry {
+    long svcId;
+    long bndId;
+    const char* serviceName;
+    service_registration_t* registration;
+} celix_service_registry_snapshot_entry_t;
+
+/**
+ * @brief Immutable segment of sorted snapshot entries. Segments are shared between snapshots.
+ */
+typedef struct celix_service_registry_snapshot_segment {
+    size_t size;
+    celix_service_registry_snapshot_entry_t entries[];
+} celix_service_registry_snapshot_segment_t;
+
+/**
+ * @brief Immutable sorted index of snapshot entries, divided in segments.
+ *
+ * Adding or removing an entry copies the segment pointers and only the changed segment, so the cost of a
+ * (un)registration does not grow linear with the number of registered services.
+ */
+typedef struct celix_service_registry_snapshot_index {
+    size_t nrOfSegments;
+    celix_service_registry_snapshot_segment_t** segments;
+} celix_service_registry_snapshot_index_t;
+
+/**
+ * @brief Immutable snapshot of the registered services, used for lock-free service lookups.
+ *
+ * A new snapshot is published for every (un)registration. Readers use the snapshot in a rcu read section and
+ * the registrations in the snapshot stay valid until the read section is ended.
+ */
+typedef struct celix_service_registry_snapshot {
+    size_t size;
+    celix_service_registry_snapshot_index_t byId; //sorted on service id
+    celix_service_registry_snapshot_index_t byName; //sorted on service name and service id
+    size_t otherObjectClassSize;
+    celix_service_registry_snapshot_entry_t* otherObjectClass; //registrations with a objectClass property which differs from the service name
+} celix_service_registry_snapshot_t;
+
 struct celix_serviceRegistry {
 	framework_pt framework;
 	registry_callback_t callback;
 
+    celix_rcu_t* rcu;
+    celix_service_registry_snapshot_t* snapshot; //NOTE atomic. Replaced by writers with the write lock, read in a rcu read section.
+    celix_array_list_t* retired; //replaced snapshots and segments, freed after a rcu synchronize
+
     celix_thread_rwlock_t lock; //protect below
 
 	hash_map_t *serviceRegistrations; //key = bundle (reg owner), value = list ( registration )
-	hash_map_t *serviceReferences; //key = bundle, value = map (key = serviceId, value = reference)
+	celix_string_hash_map_t *serviceRegistrationsByName; //key = service name, value = list ( registration )
+	celix_array_list_t *serviceRegistrationsWithOtherObjectClass; //registrations with a objectClass property which differs from the service name
 
 	long nextServiceId;
 
 	celix_array_list_t *listenerHooks; //celix_service_registry_listener_hook_entry_t*
 	celix_array_list_t *serviceListeners; //celix_service_registry_service_listener_entry_t*
+	celix_string_hash_map_t *serviceListenersByName; //key = service name (objectClass) from the listener filter, value = list (celix_service_registry_service_listener_entry_t*)
+	celix_array_list_t *serviceListenersForAllNames; //celix_service_registry_service_listener_entry_t* for listeners without a (single) objectClass in the filter
 
 	/**
 	 * The pending register events are introduced to ensure UNREGISTERING events are always
@@ -79,7 +132,7 @@ struct celix_serviceRegistry {
 	struct {
 	    celix_thread_mutex_t mutex;
 	    celix_thread_cond_t cond;
-	    hash_map_t *map; //key = svc id, value = long (nr of pending register events)
+	    celix_long_hash_map_t *map; //key = svc id, value = long (nr of pending register events)
 	} pendingRegisterEvents;
 };
 
@@ -94,6 +147,7 @@ typedef struct celix_service_registry_listener_hook_entry {
 typedef struct celix_service_registry_service_listener_entry {
     celix_bundle_t *bundle;
     celix_filter_t *filter;
+    celix_compiled_filter_t *compiledFilter; //compiled version of filter, used for matching service events
     celix_service_listener_t *listener;
     celix_thread_mutex_t mutex; //protects below
     celix_thread_cond_t cond;
@@ -52,6 +52,8 @@ static inline celix_tracked_entry_t* tracked_create(service_reference_pt ref, vo
     tracked->properties = props;
     tracked->serviceOwner = bnd;
     tracked->serviceName = celix_properties_get(props, OSGI_FRAMEWORK_OBJECTCLASS, "Error");
+    tracked->serviceId = celix_properties_getAsLong(props, OSGI_FRAMEWORK_SERVICE_ID, -1L);
+    tracked->serviceRanking = celix_properties_getAsLong(props, OSGI_FRAMEWORK_SERVICE_RANKING, 0L);
 
     tracked->useCount = 1;
     celixThreadMutex_create(&tracked->mutex, NULL);
@@ -86,6 +88,61 @@ static inline void tracked_waitAndDestroy(celix_tracked_entry_t *tracked) {
     free(tracked);
 }
 
+/**
+ * Returns whether tracked entry a is ordered before b, i.e. a has a higher ranking or the same ranking and a lower
+ * service id.
+ */
+static inline bool tracked_isOrderedBefore(const celix_tracked_entry_t *a, const celix_tracked_entry_t *b) {
+    return a->serviceRanking > b->serviceRanking || (a->serviceRanking == b->serviceRanking && a->serviceId < b->serviceId);
+}
+
+static void serviceTracker_releaseSnapshot(celix_tracked_snapshot_t *snapshot) {
+    if (__atomic_sub_fetch(&snapshot->refCount, 1, __ATOMIC_ACQ_REL) == 0) {
+        for (size_t i = 0; i < snapshot->size; ++i) {
+            tracked_release(snapshot->entries[i]);
+        }
+        free(snapshot);
+    }
+}
+
+/**
+ * Drops the snapshot of the tracked entries. Should be called with the tracker mutex locked after trackedServices is
+ * updated.
+ */
+static void serviceTracker_invalidateSnapshotLocked(service_tracker_t *tracker) {
+    if (tracker->snapshot != NULL) {
+        serviceTracker_releaseSnapshot(tracker->snapshot);
+        tracker->snapshot = NULL;
+    }
+}
+
+/**
+ * Adds the tracked entry to trackedServices, keeping the ranking order. Should be called with the tracker mutex locked.
+ */
+static void serviceTracker_addTrackedLocked(service_tracker_t *tracker, celix_tracked_entry_t *tracked) {
+    int low = 0;
+    int high = celix_arrayList_size(tracker->trackedServices);
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        celix_tracked_entry_t *visit = celix_arrayList_get(tracker->trackedServices, mid);
+        if (tracked_isOrderedBefore(visit, tracked)) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    arrayList_addIndex(tracker->trackedServices, (unsigned int)low, tracked);
+    serviceTracker_invalidateSnapshotLocked(tracker);
+}
+
+/**
+ * Removes the tracked entry at the provided index from trackedServices. Should be called with the tracker mutex locked.
+ */
+static void serviceTracker_removeTrackedAtLocked(service_tracker_t *tracker, int index) {
+    celix_arrayList_removeAt(tracker->trackedServices, index);
+    serviceTracker_invalidateSnapshotLocked(tracker);
+}
+
 celix_status_t serviceTracker_create(bundle_context_pt context, const char * service, service_tracker_customizer_pt customizer, service_tracker_pt *tracker) {
 	celix_status_t status = CELIX_SUCCESS;
 
@@ -143,6 +200,9 @@ celix_status_t serviceTracker_createWithFilter(bundle_context_pt context, const
 }
 
 celix_status_t serviceTracker_destroy(service_tracker_pt tracker) {
+    if (tracker->snapshot != NULL) {
+        serviceTracker_releaseSnapshot(tracker->snapshot);
+    }
     free(tracker->serviceName);
 	free(tracker->filter);
     celixThreadMutex_destroy(&tracker->closeSync.mutex);
@@ -230,8 +290,9 @@ celix_status_t serviceTracker_close(service_tracker_t* tracker) {
             celix_tracked_entry_t *tracked = NULL;
             nrOfTrackedEntries = celix_arrayList_size(tracker->trackedServices);
             if (nrOfTrackedEntries > 0) {
-                tracked = celix_arrayList_get(tracker->trackedServices, 0);
-                celix_arrayList_removeAt(tracker->trackedServices, 0);
+                //note removing the lowest ranking entry first, so that the highest ranking service only changes once
+                tracked = celix_arrayList_get(tracker->trackedServices, nrOfTrackedEntries - 1);
+                serviceTracker_removeTrackedAtLocked(tracker, nrOfTrackedEntries - 1);
                 celix_arrayList_add(tracker->untrackingServices, tracked);
             }
             celixThreadMutex_unlock(&tracker->mutex);
@@ -432,9 +493,11 @@ static celix_status_t serviceTracker_track(service_tracker_t* tracker, service_r
             }
 
             celix_tracked_entry_t *tracked = tracked_create(reference, service, props, bnd); //use count 1
+            tracked->isFactoryService = serviceRegistration_isFactoryService(reg);
 
             celixThreadMutex_lock(&tracker->mutex);
-            arrayList_add(tracker->trackedServices, tracked);
+            serviceTracker_addTrackedLocked(tracker, tracked);
+            celixThreadCondition_broadcast(&tracker->cond); //wake up celix_serviceTracker_waitForTrackedServices calls
             celixThreadMutex_unlock(&tracker->mutex);
 
             celix_serviceTracker_useHighestRankingService(tracker, tracked->serviceName, tracker, NULL, NULL, serviceTracker_checkAndInvokeSetService);
@@ -542,7 +605,7 @@ static celix_status_t serviceTracker_untrack(service_tracker_t* tracker, service
         if (equals) {
             remove = tracked;
             //remove from trackedServices to prevent getting this service, but don't destroy yet, can be in use
-            celix_arrayList_removeAt(tracker->trackedServices, i);
+            serviceTracker_removeTrackedAtLocked(tracker, i);
             celix_arrayList_add(tracker->untrackingServices, remove);
             break;
         }
@@ -709,6 +772,35 @@ void celix_serviceTracker_destroy(celix_service_tracker_t *tracker) {
     }
 }
 
+bool celix_serviceTracker_waitForTrackedServices(celix_service_tracker_t *tracker, double timeoutInSeconds) {
+    struct timespec start = celix_gettime(CLOCK_MONOTONIC);
+    celixThreadMutex_lock(&tracker->mutex);
+    bool found = celix_arrayList_size(tracker->trackedServices) > 0;
+    while (!found) {
+        double remaining = timeoutInSeconds - celix_elapsedtime(CLOCK_MONOTONIC, start);
+        if (remaining <= 0) {
+            break;
+        }
+        long seconds = (long)remaining;
+        long nanoseconds = (long)((remaining - (double)seconds) * 1000000000.0);
+        celixThreadCondition_timedwaitRelative(&tracker->cond, &tracker->mutex, seconds, nanoseconds);
+        found = celix_arrayList_size(tracker->trackedServices) > 0;
+    }
+    celixThreadMutex_unlock(&tracker->mutex);
+    return found;
+}
+
+bool celix_serviceTracker_hasFactoryServices(celix_service_tracker_t *tracker) {
+    bool found = false;
+    celixThreadMutex_lock(&tracker->mutex);
+    for (int i = 0; !found && i < celix_arrayList_size(tracker->trackedServices); ++i) {
+        celix_tracked_entry_t* tracked = celix_arrayList_get(tracker->trackedServices, i);
+        found = tracked->isFactoryService;
+    }
+    celixThreadMutex_unlock(&tracker->mutex);
+    return found;
+}
+
 bool celix_serviceTracker_useHighestRankingService(service_tracker_t *tracker,
                                                             const char *serviceName /*sanity*/,
                                                             void *callbackHandle,
@@ -716,23 +808,18 @@ bool celix_serviceTracker_useHighestRankingService(service_tracker_t *tracker,
                                                             void (*useWithProperties)(void *handle, void *svc, const celix_properties_t *props),
                                                             void (*useWithOwner)(void *handle, void *svc, const celix_properties_t *props, const celix_bundle_t *owner)) {
     bool called = false;
-    celix_tracked_entry_t *tracked = NULL;
     celix_tracked_entry_t *highest = NULL;
-    long highestRank = 0;
-    unsigned int i;
 
     //first lock tracker and get highest tracked entry
     celixThreadMutex_lock(&tracker->mutex);
-    unsigned int size = arrayList_size(tracker->trackedServices);
-
-    for (i = 0; i < size; i++) {
-        tracked = (celix_tracked_entry_t *) arrayList_get(tracker->trackedServices, i);
+    int size = celix_arrayList_size(tracker->trackedServices);
+    for (int i = 0; i < size; i++) {
+        //note trackedServices is ordered by ranking, so the first entry with a matching service name is the highest
+        //ranking service. For trackers of a single service name this is the first entry.
+        celix_tracked_entry_t *tracked = celix_arrayList_get(tracker->trackedServices, i);
         if (serviceName != NULL && tracked->serviceName != NULL && strncmp(tracked->serviceName, serviceName, 10*1024) == 0) {
-            const char *val = properties_getWithDefault(tracked->properties, OSGI_FRAMEWORK_SERVICE_RANKING, "0");
-            long rank = strtol(val, NULL, 10);
-            if (highest == NULL || rank > highestRank) {
-                highest = tracked;
-            }
+            highest = tracked;
+            break;
         }
     }
     if (highest != NULL) {
@@ -767,24 +854,29 @@ size_t celix_serviceTracker_useServices(
         void (*use)(void *handle, void *svc),
         void (*useWithProperties)(void *handle, void *svc, const celix_properties_t *props),
         void (*useWithOwner)(void *handle, void *svc, const celix_properties_t *props, const celix_bundle_t *owner)) {
-    size_t count = 0;
-    //first lock tracker, get tracked entries and increase use count
+    //first lock tracker and get (or create) the snapshot of the tracked entries
     celixThreadMutex_lock(&tracker->mutex);
-    int size = celix_arrayList_size(tracker->trackedServices);
-    count = (size_t)size;
-    celix_tracked_entry_t *entries[size];
-    for (int i = 0; i < size; i++) {
-        celix_tracked_entry_t *tracked = (celix_tracked_entry_t *) arrayList_get(tracker->trackedServices, i);
-        tracked_retain(tracked);
-        entries[i] = tracked;
+    celix_tracked_snapshot_t *snapshot = tracker->snapshot;
+    if (snapshot == NULL) {
+        int size = celix_arrayList_size(tracker->trackedServices);
+        snapshot = malloc(sizeof(*snapshot) + (size_t)size * sizeof(snapshot->entries[0]));
+        snapshot->refCount = 1; //note owned by the tracker
+        snapshot->size = (size_t)size;
+        for (int i = 0; i < size; i++) {
+            celix_tracked_entry_t *tracked = celix_arrayList_get(tracker->trackedServices, i);
+            tracked_retain(tracked);
+            snapshot->entries[i] = tracked;
+        }
+        tracker->snapshot = snapshot;
     }
+    __atomic_add_fetch(&snapshot->refCount, 1, __ATOMIC_ACQ_REL);
     //unlock tracker so that the tracked entry can be removed from the trackedServices list if unregistered.
     celixThreadMutex_unlock(&tracker->mutex);
 
-    //then use entries and decrease use count
-    for (int i = 0; i < size; i++) {
-        celix_tracked_entry_t *entry = entries[i];
-        //got service, call, decrease use count an signal useCond after.
+    //then use entries and release the snapshot, the entries of the snapshot are retained till the snapshot is released
+    size_t count = snapshot->size;
+    for (size_t i = 0; i < count; i++) {
+        celix_tracked_entry_t *entry = snapshot->entries[i];
         if (use != NULL) {
             use(callbackHandle, entry->service);
         }
@@ -794,8 +886,7 @@ size_t celix_serviceTracker_useServices(
         if (useWithOwner != NULL) {
             useWithOwner(callbackHandle, entry->service, entry->properties, entry->serviceOwner);
         }
-
-        tracked_release(entry);
     }
+    serviceTracker_releaseSnapshot(snapshot);
     return count;
 }
\ No newline at end of file
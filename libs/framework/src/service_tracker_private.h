@@ -65,7 +65,8 @@ struct celix_serviceTracker {
 
     celix_thread_mutex_t mutex; //projects below
     celix_thread_cond_t  cond;
-    celix_array_list_t *trackedServices;
+    celix_array_list_t *trackedServices; //ordered by ranking (desc) and service id (asc), first entry is the highest ranking service
+    struct celix_tracked_snapshot *snapshot; //read-mostly copy of trackedServices used by celix_serviceTracker_useServices, NULL if outdated
     celix_array_list_t *untrackingServices;
     enum celix_service_tracker_state state;
     long currentHighestServiceId;
@@ -77,11 +78,35 @@ typedef struct celix_tracked_entry {
 	const char *serviceName;
 	properties_t *properties;
 	bundle_t *serviceOwner;
+	long serviceId;
+	long serviceRanking;
+	bool isFactoryService;
 
     celix_thread_mutex_t mutex; //protects useCount
 	celix_thread_cond_t useCond;
     size_t useCount;
 } celix_tracked_entry_t;
 
+/**
+ * Immutable snapshot of the tracked entries. The snapshot retains its entries, so that the entries can be used
+ * without holding the tracker mutex.
+ */
+typedef struct celix_tracked_snapshot {
+    size_t refCount; //NOTE atomic
+    size_t size;
+    celix_tracked_entry_t* entries[];
+} celix_tracked_snapshot_t;
+
+/**
+ * Waits until the tracker tracks at least one service or the timeout expires.
+ * Services added to the tracker wake up the waiter through the tracker condition, so no polling is needed.
+ * @return true if the tracker tracks at least one service.
+ */
+bool celix_serviceTracker_waitForTrackedServices(celix_service_tracker_t *tracker, double timeoutInSeconds);
+
+/**
+ * Returns whether the tracker tracks at least one service provided by a service factory.
+ */
+bool celix_serviceTracker_hasFactoryServices(celix_service_tracker_t *tracker);
 
 #endif /* SERVICE_TRACKER_PRIVATE_H_ */
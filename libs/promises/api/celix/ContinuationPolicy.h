@@ -0,0 +1,49 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+
+#pragma once
+
+namespace celix {
+
+    /**
+     * @brief Policy for executing the continuations (map, then, onSuccess, etc) of a promise when it is resolved.
+     */
+    enum class ContinuationPolicy {
+        /**
+         * @brief Continuations are executed as tasks on the executor of the promise.
+         */
+        EXECUTOR,
+
+        /**
+         * @brief Continuations are executed inline on the thread resolving the promise, or on the thread adding the
+         * continuation if the promise is already resolved.
+         *
+         * This avoids a executor task (and context switch) per stage and is intended for cheap, non-blocking
+         * continuations. If more than MAX_INLINE_CONTINUATION_DEPTH continuations are nested on a thread, the
+         * continuation is executed on the executor to avoid a stack overflow.
+         */
+        INLINE
+    };
+
+    /**
+     * @brief The max number of continuations executed nested inline on a single thread.
+     */
+    constexpr int MAX_INLINE_CONTINUATION_DEPTH = 32;
+}
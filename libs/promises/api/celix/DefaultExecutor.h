@@ -27,8 +27,10 @@
 namespace celix {
 
     /**
-     * Simple default executor which uses std::async to run tasks.
+     * Simple executor which uses std::async to run tasks.
      * Does not support priority argument.
+     *
+     * Note that celix::PromiseFactory uses the celix::WorkStealingExecutor by default.
      */
     class DefaultExecutor : public celix::IExecutor {
     public:
@@ -64,6 +64,11 @@ namespace celix {
             std::unique_lock lock{mutex};
             cond.wait_for(lock, time);
         }
+
+        void waitUntilDone() {
+            std::unique_lock lock{mutex};
+            cond.wait(lock, [this]{ return done; });
+        }
     private:
         const std::chrono::duration<double, std::milli> delayInMs;
         mutable std::mutex mutex{}; //protects below
@@ -106,11 +111,17 @@ namespace celix {
         }
 
         void wait() override {
-            bool done = false;
-            while (!done) {
-                std::lock_guard<std::mutex> lck{mutex};
-                removeCompletedFutures();
-                done = futures.empty();
+            while (true) {
+                std::shared_ptr<DefaultDelayedScheduledFuture> scheduledFuture{};
+                {
+                    std::lock_guard<std::mutex> lck{mutex};
+                    removeCompletedFutures();
+                    if (futures.empty()) {
+                        break;
+                    }
+                    scheduledFuture = futures.begin()->first;
+                }
+                scheduledFuture->waitUntilDone();
             }
         }
     private:
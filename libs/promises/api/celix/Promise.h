@@ -23,6 +23,8 @@
 
 namespace celix {
 
+    class PromiseFactory;
+
     /**
      * A Promise of a value.
      * <p>
@@ -400,6 +402,7 @@ namespace celix {
         const std::shared_ptr<celix::impl::SharedPromiseState<T>> state;
 
         friend class Promise<void>;
+        friend class PromiseFactory;
     };
 
     template<>
@@ -616,7 +619,7 @@ inline void celix::Promise<void>::wait() const {
 template<typename T>
 template<typename U>
 inline celix::Promise<U> celix::Promise<T>::then(std::function<celix::Promise<U>(celix::Promise<T>)> success, std::function<void(celix::Promise<T>)> failure) {
-    auto p = celix::impl::SharedPromiseState<U>::create(state->getExecutor(), state->getScheduledExecutor(), state->getPriority());
+    auto p = celix::impl::SharedPromiseState<U>::create(state->getExecutor(), state->getScheduledExecutor(), state->getPriority(), state->getContinuationPolicy());
 
     auto chain = [s = state, p, success = std::move(success), failure = std::move(failure)]() {
         //chain is called when s is resolved
@@ -641,7 +644,7 @@ inline celix::Promise<U> celix::Promise<T>::then(std::function<celix::Promise<U>
 
 template<typename U>
 inline celix::Promise<U> celix::Promise<void>::then(std::function<celix::Promise<U>(celix::Promise<void>)> success, std::function<void(celix::Promise<void>)> failure) {
-    auto p = celix::impl::SharedPromiseState<U>::create(state->getExecutor(), state->getScheduledExecutor(), state->getPriority());
+    auto p = celix::impl::SharedPromiseState<U>::create(state->getExecutor(), state->getScheduledExecutor(), state->getPriority(), state->getContinuationPolicy());
 
     auto chain = [s = state, p, success = std::move(success), failure = std::move(failure)]() {
         //chain is called when s is resolved
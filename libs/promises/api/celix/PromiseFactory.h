@@ -19,10 +19,14 @@
 
 #pragma once
 
+#include "celix/ContinuationPolicy.h"
 #include "celix/Deferred.h"
 #include "celix/IExecutor.h"
 #include "celix/DefaultExecutor.h"
+#include "celix/WorkStealingExecutor.h"
 #include "celix/DefaultScheduledExecutor.h"
+#include "celix/TimerWheelScheduledExecutor.h"
+#include "celix/impl/PromiseAggregates.h"
 
 namespace celix {
 
@@ -31,9 +35,19 @@ namespace celix {
     class PromiseFactory {
     public:
         PromiseFactory();
+        /**
+         * @brief Create a PromiseFactory using the provided executors.
+         *
+         * If no scheduled executor is provided, a celix::TimerWheelScheduledExecutor is created which executes the
+         * expired tasks on the provided executor.
+         *
+         * The continuation policy is used for the promises created by this factory and the promises chained on them,
+         * see celix::ContinuationPolicy.
+         */
         explicit PromiseFactory(
                 std::shared_ptr<celix::IExecutor> _executor,
-                std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor = std::make_shared<celix::DefaultScheduledExecutor>());
+                std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor = {},
+                celix::ContinuationPolicy _continuationPolicy = celix::ContinuationPolicy::EXECUTOR);
 
         ~PromiseFactory() noexcept;
 
@@ -45,6 +59,13 @@ namespace celix {
         template<typename T>
         [[nodiscard]] celix::Deferred<T> deferred(int priority = 0) const;
 
+        /**
+         * @brief Create a deferred using the provided continuation policy instead of the continuation policy of
+         * the factory.
+         */
+        template<typename T>
+        [[nodiscard]] celix::Deferred<T> deferred(int priority, celix::ContinuationPolicy policy) const;
+
         template<typename T>
         [[nodiscard]] celix::Promise<T> deferredTask(std::function<void(celix::Deferred<T>)> task, int priority = 0) const;
 
@@ -64,8 +85,54 @@ namespace celix {
 
         [[nodiscard]] celix::Promise<void> resolvedWithPrio(int priority) const;
 
+        /**
+         * @brief Returns a promise which is resolved with the values of the provided promises, in the same order,
+         * when all provided promises are resolved.
+         *
+         * If one or more of the provided promises failed, the returned promise fails with the first observed failure.
+         * The provided promises are aggregated using a single shared state, so no intermediate promises are created.
+         * Note that the values of the provided promises are moved (if possible) to the returned promise.
+         */
+        template<typename T>
+        [[nodiscard]] celix::Promise<std::vector<T>> all(const std::vector<celix::Promise<T>>& promises, int priority = 0) const;
+
+        /**
+         * @brief Returns a promise which is resolved with the value of the first successfully resolved provided promise.
+         *
+         * If all provided promises failed, the returned promise fails with the failure of the last failed promise.
+         * If no promises are provided, the returned promise fails with a celix::PromiseInvocationException.
+         */
+        template<typename T>
+        [[nodiscard]] celix::Promise<T> any(const std::vector<celix::Promise<T>>& promises, int priority = 0) const;
+
+        /**
+         * @brief Returns a promise which is resolved with the value or failure of the first resolved provided promise.
+         *
+         * If no promises are provided, the returned promise fails with a celix::PromiseInvocationException.
+         */
+        template<typename T>
+        [[nodiscard]] celix::Promise<T> race(const std::vector<celix::Promise<T>>& promises, int priority = 0) const;
+
+        /**
+         * @brief Streams the values of the provided promises, in resolve order, to the consumer in batches of
+         * batchSize values.
+         *
+         * The consumer is called every time batchSize promises are successfully resolved and once more for the
+         * remaining values when all promises are resolved. Consumer calls are serialized.
+         * The returned promise is resolved after the last consumer call, or fails with the first observed failure
+         * (of a provided promise or the consumer) when all promises are resolved.
+         */
+        template<typename T>
+        [[nodiscard]] celix::Promise<void> collectBatch(
+                const std::vector<celix::Promise<T>>& promises,
+                std::size_t batchSize,
+                std::function<void(std::vector<T>)> consumer,
+                int priority = 0) const;
+
         [[nodiscard]] std::shared_ptr<celix::IExecutor> getExecutor() const;
 
+        [[nodiscard]] celix::ContinuationPolicy getContinuationPolicy() const;
+
         //TODO
         //[[nodiscard]] std::shared_ptr<celix::IScheduledExecutor> getScheduledExecutor() const;
 
@@ -74,8 +141,12 @@ namespace celix {
          */
          void wait();
     private:
+        template<typename T>
+        static std::vector<std::shared_ptr<celix::impl::SharedPromiseState<T>>> statesOf(const std::vector<celix::Promise<T>>& promises);
+
         std::shared_ptr<celix::IExecutor> executor;
         std::shared_ptr<celix::IScheduledExecutor> scheduledExecutor;
+        celix::ContinuationPolicy continuationPolicy{celix::ContinuationPolicy::EXECUTOR};
     };
 
 }
@@ -85,15 +156,17 @@ namespace celix {
 *********************************************************************************/
 
 inline celix::PromiseFactory::PromiseFactory() :
-        executor{std::make_shared<celix::DefaultExecutor>()},
-        scheduledExecutor{std::make_shared<celix::DefaultScheduledExecutor>()} {}
+        executor{std::make_shared<celix::WorkStealingExecutor>()},
+        scheduledExecutor{std::make_shared<celix::TimerWheelScheduledExecutor>(executor)} {}
 
 
 inline celix::PromiseFactory::PromiseFactory(
         std::shared_ptr<celix::IExecutor> _executor,
-        std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor) :
+        std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor,
+        celix::ContinuationPolicy _continuationPolicy) :
         executor{std::move(_executor)},
-        scheduledExecutor{std::move(_scheduledExecutor)} {}
+        scheduledExecutor{_scheduledExecutor ? std::move(_scheduledExecutor) : std::make_shared<celix::TimerWheelScheduledExecutor>(executor)},
+        continuationPolicy{_continuationPolicy} {}
 
 inline celix::PromiseFactory::~PromiseFactory() noexcept {
     //ensure that the executors tasks are empty before allowing the to be deallocated.
@@ -102,7 +175,12 @@ inline celix::PromiseFactory::~PromiseFactory() noexcept {
 
 template<typename T>
 celix::Deferred<T> celix::PromiseFactory::deferred(int priority) const {
-    return celix::Deferred<T>{celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority)};
+    return deferred<T>(priority, continuationPolicy);
+}
+
+template<typename T>
+celix::Deferred<T> celix::PromiseFactory::deferred(int priority, celix::ContinuationPolicy policy) const {
+    return celix::Deferred<T>{celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, policy)};
 }
 
 template<typename T>
@@ -116,14 +194,14 @@ template<typename T>
 
 template<typename T>
 celix::Promise<T> celix::PromiseFactory::failed(const std::exception &e, int priority) const {
-    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
     p->fail(e);
     return celix::Promise<T>{p};
 }
 
 template<typename T>
 celix::Promise<T> celix::PromiseFactory::failed(std::exception_ptr ptr, int priority) const {
-    auto p = celix::impl::SharedPromiseState<T>::create(executor, priority);
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
     p->fail(ptr);
     return celix::Promise<T>{p};
 }
@@ -135,7 +213,7 @@ celix::Promise<T> celix::PromiseFactory::resolved(T &&value) const {
 
 template<typename T>
 celix::Promise<T> celix::PromiseFactory::resolvedWithPrio(T &&value, int priority) const {
-    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
     p->resolve(std::forward<T>(value));
     return celix::Promise<T>{p};
 }
@@ -145,15 +223,67 @@ inline celix::Promise<void> celix::PromiseFactory::resolved() const {
 }
 
 inline celix::Promise<void> celix::PromiseFactory::resolvedWithPrio(int priority) const {
-    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority, continuationPolicy);
     p->resolve();
     return celix::Promise<void>{p};
 }
 
+template<typename T>
+std::vector<std::shared_ptr<celix::impl::SharedPromiseState<T>>> celix::PromiseFactory::statesOf(const std::vector<celix::Promise<T>>& promises) {
+    std::vector<std::shared_ptr<celix::impl::SharedPromiseState<T>>> states{};
+    states.reserve(promises.size());
+    for (const auto& promise : promises) {
+        states.emplace_back(promise.state);
+    }
+    return states;
+}
+
+template<typename T>
+celix::Promise<std::vector<T>> celix::PromiseFactory::all(const std::vector<celix::Promise<T>>& promises, int priority) const {
+    auto p = celix::impl::SharedPromiseState<std::vector<T>>::create(executor, scheduledExecutor, priority, continuationPolicy);
+    celix::impl::AllAggregate<T>::aggregate(statesOf(promises), p);
+    return celix::Promise<std::vector<T>>{p};
+}
+
+template<typename T>
+celix::Promise<T> celix::PromiseFactory::any(const std::vector<celix::Promise<T>>& promises, int priority) const {
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
+    celix::impl::FirstAggregate<T>::aggregate(statesOf(promises), true, p);
+    return celix::Promise<T>{p};
+}
+
+template<typename T>
+celix::Promise<T> celix::PromiseFactory::race(const std::vector<celix::Promise<T>>& promises, int priority) const {
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
+    celix::impl::FirstAggregate<T>::aggregate(statesOf(promises), false, p);
+    return celix::Promise<T>{p};
+}
+
+template<typename T>
+celix::Promise<void> celix::PromiseFactory::collectBatch(
+        const std::vector<celix::Promise<T>>& promises,
+        std::size_t batchSize,
+        std::function<void(std::vector<T>)> consumer,
+        int priority) const {
+    if (!consumer) {
+        throw celix::PromiseInvocationException{"provided consumer is not valid"};
+    }
+    if (batchSize == 0) {
+        throw celix::PromiseInvocationException{"provided batch size is not valid"};
+    }
+    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority, continuationPolicy);
+    celix::impl::BatchAggregate<T>::aggregate(statesOf(promises), batchSize, std::move(consumer), p);
+    return celix::Promise<void>{p};
+}
+
 inline std::shared_ptr<celix::IExecutor> celix::PromiseFactory::getExecutor() const {
     return executor;
 }
 
+inline celix::ContinuationPolicy celix::PromiseFactory::getContinuationPolicy() const {
+    return continuationPolicy;
+}
+
 inline void celix::PromiseFactory::wait() {
     scheduledExecutor->wait();
     executor->wait();
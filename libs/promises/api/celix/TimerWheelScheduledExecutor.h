@@ -0,0 +1,346 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "celix/IScheduledExecutor.h"
+
+namespace celix {
+
+    /**
+     * @brief Scheduled executor which uses a single thread and a hashed timer wheel to keep track of the delayed tasks.
+     *
+     * Scheduling and cancelling a task are O(1). Expired tasks are executed on the provided executor, using the
+     * priority of the scheduled task. If the executor rejects an expired task, the task is executed on the timer thread.
+     *
+     * Tasks are never executed before their delay is expired, but can be executed up to a tick later.
+     * Delayed tasks which are not expired when the scheduled executor is destroyed are cancelled.
+     */
+    class TimerWheelScheduledExecutor : public celix::IScheduledExecutor {
+    private:
+        struct State;
+    public:
+        static constexpr std::size_t DEFAULT_NR_OF_SLOTS = 512;
+
+        explicit TimerWheelScheduledExecutor(
+                std::shared_ptr<celix::IExecutor> executor,
+                std::chrono::milliseconds tick = std::chrono::milliseconds{1},
+                std::size_t nrOfSlots = DEFAULT_NR_OF_SLOTS) :
+                state{std::make_shared<State>(std::move(executor), tick, nrOfSlots)},
+                thread{&TimerWheelScheduledExecutor::run, state} {}
+
+        ~TimerWheelScheduledExecutor() noexcept override {
+            {
+                std::lock_guard lck{state->mutex};
+                state->stopped = true;
+                state->cond.notify_all();
+            }
+            if (thread.get_id() == std::this_thread::get_id()) {
+                //note last reference released in a task executed on the timer thread
+                thread.detach();
+            } else {
+                thread.join();
+            }
+        }
+
+        TimerWheelScheduledExecutor(const TimerWheelScheduledExecutor&) = delete;
+        TimerWheelScheduledExecutor& operator=(const TimerWheelScheduledExecutor&) = delete;
+        TimerWheelScheduledExecutor(TimerWheelScheduledExecutor&&) = delete;
+        TimerWheelScheduledExecutor& operator=(TimerWheelScheduledExecutor&&) = delete;
+
+        void wait() override {
+            std::unique_lock lck{state->mutex};
+            state->idleCond.wait(lck, [this]{ return state->pending == 0; });
+        }
+
+        /**
+         * @brief Returns the number of scheduled tasks which are not yet expired or cancelled.
+         */
+        [[nodiscard]] std::size_t getNrOfScheduledTasks() const {
+            std::lock_guard lck{state->mutex};
+            return state->nrOfTimers;
+        }
+    private:
+        class Timer : public celix::IScheduledFuture {
+        public:
+            Timer(std::weak_ptr<State> _state, int _priority, std::function<void()> _task) :
+                    state{std::move(_state)}, priority{_priority}, task{std::move(_task)} {}
+
+            ~Timer() noexcept override = default;
+
+            Timer(const Timer&) = delete;
+            Timer& operator=(const Timer&) = delete;
+            Timer(Timer&&) = delete;
+            Timer& operator=(Timer&&) = delete;
+
+            bool isCancelled() const override {
+                return cancelled.load();
+            }
+
+            bool isDone() const override {
+                return done.load();
+            }
+
+            void cancel() override {
+                auto s = state.lock();
+                if (s) {
+                    s->cancel(this);
+                }
+            }
+        private:
+            friend class TimerWheelScheduledExecutor;
+            friend struct State;
+
+            const std::weak_ptr<State> state;
+            const int priority;
+            std::atomic<bool> cancelled{false};
+            std::atomic<bool> done{false};
+
+            //note below fields are protected by the state mutex
+            std::function<void()> task;
+            std::shared_ptr<Timer> self{}; //keeps the timer alive while it is in the wheel
+            Timer* prev{nullptr};
+            Timer* next{nullptr};
+            std::size_t slot{0};
+            std::size_t rounds{0};
+        };
+
+        struct State {
+            State(std::shared_ptr<celix::IExecutor> _executor, std::chrono::milliseconds _tick, std::size_t nrOfSlots) :
+                    executor{std::move(_executor)},
+                    tick{_tick.count() > 0 ? _tick : std::chrono::milliseconds{1}},
+                    slots(nrOfSlots > 0 ? nrOfSlots : DEFAULT_NR_OF_SLOTS, nullptr) {}
+
+            /**
+             * @brief Returns the number of fully elapsed ticks at the provided time.
+             */
+            std::uint64_t elapsedTicks(std::chrono::steady_clock::time_point time) const {
+                return (std::uint64_t)((time - startTime) / tick);
+            }
+
+            /**
+             * @brief Returns the first tick at which the provided delay from now is expired.
+             */
+            std::uint64_t expireTick(std::chrono::duration<double, std::milli> delay) const {
+                std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - startTime;
+                if (delay.count() > 0) {
+                    elapsed += delay;
+                }
+                return (std::uint64_t)std::ceil(elapsed / tick);
+            }
+
+            void link(Timer* timer) {
+                timer->prev = nullptr;
+                timer->next = slots[timer->slot];
+                if (timer->next != nullptr) {
+                    timer->next->prev = timer;
+                }
+                slots[timer->slot] = timer;
+                nrOfTimers += 1;
+            }
+
+            void unlink(Timer* timer) {
+                if (timer->prev != nullptr) {
+                    timer->prev->next = timer->next;
+                } else {
+                    slots[timer->slot] = timer->next;
+                }
+                if (timer->next != nullptr) {
+                    timer->next->prev = timer->prev;
+                }
+                timer->prev = nullptr;
+                timer->next = nullptr;
+                nrOfTimers -= 1;
+            }
+
+            /**
+             * @brief Marks a scheduled task as done. Should be called with the mutex locked.
+             */
+            void markDone() {
+                if (--pending == 0) {
+                    idleCond.notify_all();
+                }
+            }
+
+            void cancel(Timer* timer) {
+                std::shared_ptr<Timer> released{}; //note released after the mutex is unlocked
+                std::function<void()> task{};
+                std::lock_guard lck{mutex};
+                if (timer->self) {
+                    timer->cancelled.store(true);
+                    timer->done.store(true);
+                    unlink(timer);
+                    task = std::move(timer->task);
+                    released = std::move(timer->self);
+                    markDone();
+                }
+            }
+
+            const std::shared_ptr<celix::IExecutor> executor;
+            const std::chrono::milliseconds tick;
+            const std::chrono::steady_clock::time_point startTime{std::chrono::steady_clock::now()};
+
+            mutable std::mutex mutex{}; //protects below and the wheel fields of the timers
+            std::condition_variable cond{}; //signals new earlier timers or stop
+            std::condition_variable idleCond{}; //signals no pending tasks
+            std::vector<Timer*> slots; //intrusive doubly linked list of timers per slot
+            std::uint64_t currentTick{0}; //last processed tick
+            std::uint64_t wakeupTick{UINT64_MAX}; //tick the timer thread will wakeup, UINT64_MAX if waiting for timers
+            std::size_t nrOfTimers{0};
+            std::size_t pending{0}; //scheduled or executing tasks
+            bool stopped{false};
+        };
+
+        std::shared_ptr<celix::IScheduledFuture> scheduleInMilli(int priority, std::chrono::duration<double, std::milli> delay, std::function<void()> task) override {
+            auto timer = std::make_shared<Timer>(state, priority, std::move(task));
+            std::unique_lock lck{state->mutex};
+            if (state->stopped) {
+                throw celix::RejectedExecutionException{};
+            }
+            state->pending += 1;
+            std::uint64_t target = state->expireTick(delay);
+            if (target <= state->currentTick) {
+                target = state->currentTick + 1;
+            }
+            timer->slot = target % state->slots.size();
+            timer->rounds = (target - state->currentTick - 1) / state->slots.size();
+            timer->self = timer;
+            state->link(timer.get());
+            if (target < state->wakeupTick) {
+                state->cond.notify_one();
+            }
+            return timer;
+        }
+
+        static void dispatch(const std::shared_ptr<State>& state, std::shared_ptr<Timer> timer, std::function<void()> task) {
+            auto runTask = [state, timer, task = std::move(task)]() {
+                try {
+                    task();
+                } catch (...) {
+                    //ignore, no way to report the exception
+                }
+                timer->done.store(true);
+                std::lock_guard lck{state->mutex};
+                state->markDone();
+            };
+            int priority = timer->priority;
+            try {
+                state->executor->execute(priority, runTask);
+            } catch (celix::RejectedExecutionException&) {
+                runTask();
+            }
+        }
+
+        /**
+         * @brief Moves the timers of the current tick slot which have no rounds left to the expired list.
+         * Should be called with the state mutex locked.
+         */
+        static void expireCurrentSlot(State& state, std::vector<std::pair<std::shared_ptr<Timer>, std::function<void()>>>& expired) {
+            Timer* timer = state.slots[state.currentTick % state.slots.size()];
+            while (timer != nullptr) {
+                Timer* next = timer->next;
+                if (timer->rounds == 0) {
+                    state.unlink(timer);
+                    expired.emplace_back(std::move(timer->self), std::move(timer->task));
+                } else {
+                    timer->rounds -= 1;
+                }
+                timer = next;
+            }
+        }
+
+        /**
+         * @brief Returns the next tick with a non-empty slot, or UINT64_MAX if there are no timers.
+         * Should be called with the state mutex locked.
+         */
+        static std::uint64_t nextNonEmptyTick(const State& state) {
+            if (state.nrOfTimers == 0) {
+                return UINT64_MAX;
+            }
+            for (std::size_t i = 1; i <= state.slots.size(); ++i) {
+                if (state.slots[(state.currentTick + i) % state.slots.size()] != nullptr) {
+                    return state.currentTick + i;
+                }
+            }
+            return UINT64_MAX;
+        }
+
+        static void run(std::shared_ptr<State> state) {
+            std::vector<std::pair<std::shared_ptr<Timer>, std::function<void()>>> expired{};
+            std::unique_lock lck{state->mutex};
+            while (!state->stopped) {
+                std::uint64_t nowTick = state->elapsedTicks(std::chrono::steady_clock::now());
+                while (state->currentTick < nowTick && state->nrOfTimers > 0) {
+                    state->currentTick += 1;
+                    expireCurrentSlot(*state, expired);
+                }
+                if (state->nrOfTimers == 0 && state->currentTick < nowTick) {
+                    state->currentTick = nowTick; //note no timers, skip the idle ticks
+                }
+
+                if (!expired.empty()) {
+                    lck.unlock();
+                    for (auto& entry : expired) {
+                        dispatch(state, std::move(entry.first), std::move(entry.second));
+                    }
+                    expired.clear();
+                    lck.lock();
+                    continue;
+                }
+
+                state->wakeupTick = nextNonEmptyTick(*state);
+                if (state->wakeupTick == UINT64_MAX) {
+                    state->cond.wait(lck);
+                } else {
+                    state->cond.wait_until(lck, state->startTime + state->wakeupTick * state->tick);
+                }
+                state->wakeupTick = UINT64_MAX;
+            }
+
+            //cancel the timers left
+            for (auto& slot : state->slots) {
+                while (slot != nullptr) {
+                    Timer* timer = slot;
+                    state->unlink(timer);
+                    timer->cancelled.store(true);
+                    timer->done.store(true);
+                    timer->task = nullptr;
+                    expired.emplace_back(std::move(timer->self), nullptr);
+                    state->markDone();
+                }
+            }
+            lck.unlock();
+            expired.clear();
+        }
+
+        const std::shared_ptr<State> state;
+        std::thread thread;
+    };
+}
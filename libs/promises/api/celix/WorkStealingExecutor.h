@@ -0,0 +1,271 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "celix/IExecutor.h"
+
+namespace celix {
+
+    /**
+     * @brief Fixed-size thread pool executor with a task deque per worker thread and work stealing.
+     *
+     * Tasks executed from a worker thread (e.g. promise chains) are added to the deque of that worker, other tasks
+     * are distributed round-robin over the workers. A worker takes the newest task from its own deque and, if its own
+     * deque is empty, steals the oldest task from the deque of another worker.
+     *
+     * Tasks with a higher priority value are taken before tasks with a lower priority value from the same worker deque.
+     * Exceptions thrown by tasks are ignored.
+     *
+     * Note that wait() must not be called from a task executed by the same executor.
+     */
+    class WorkStealingExecutor : public celix::IExecutor {
+    public:
+        explicit WorkStealingExecutor(std::size_t nrOfThreads = defaultNrOfThreads()) : state{std::make_shared<State>(std::max(nrOfThreads, std::size_t{1}))} {
+            threads.reserve(state->workers.size());
+            for (std::size_t i = 0; i < state->workers.size(); ++i) {
+                threads.emplace_back(&WorkStealingExecutor::run, state, i);
+            }
+        }
+
+        ~WorkStealingExecutor() noexcept override {
+            {
+                std::lock_guard lck{state->mutex};
+                state->stopped.store(true);
+                state->cond.notify_all();
+            }
+            bool calledFromWorker = std::any_of(threads.begin(), threads.end(), [](const std::thread& thread) {
+                return thread.get_id() == std::this_thread::get_id();
+            });
+            for (auto& thread : threads) {
+                if (calledFromWorker) {
+                    //note last reference released in a task. The other workers cannot be joined, because they only
+                    //stop after the pending tasks - including the task calling this destructor - are done.
+                    //The workers keep the state alive until they are stopped.
+                    thread.detach();
+                } else {
+                    thread.join();
+                }
+            }
+        }
+
+        WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+        WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+        WorkStealingExecutor(WorkStealingExecutor&&) = delete;
+        WorkStealingExecutor& operator=(WorkStealingExecutor&&) = delete;
+
+        /**
+         * @brief Returns the number of worker threads used when no number of threads is provided: the number of
+         * hardware threads, with a minimum of 2 so that a task waiting on another task does not block the executor.
+         */
+        static std::size_t defaultNrOfThreads() {
+            return std::max(std::size_t{std::thread::hardware_concurrency()}, std::size_t{2});
+        }
+
+        using celix::IExecutor::execute;
+
+        void execute(int priority, std::function<void()> task) override {
+            const CurrentWorker& current = currentWorker();
+            std::size_t index = current.state == state.get() ?
+                    current.index :
+                    state->nextWorker.fetch_add(1, std::memory_order_relaxed) % state->workers.size();
+            state->pending.fetch_add(1);
+            if (state->stopped.load() && current.state != state.get()) {
+                //note tasks from workers are still accepted, so that running promise chains can complete
+                markDone(*state);
+                throw celix::RejectedExecutionException{};
+            }
+            //note queued is increased before the task is published, so that a worker taking the task cannot decrease it first
+            state->queued.fetch_add(1);
+            try {
+                state->workers[index].push(priority, std::move(task));
+            } catch (...) {
+                state->queued.fetch_sub(1);
+                markDone(*state);
+                throw;
+            }
+            if (state->nrOfSleepingWorkers.load() > 0) {
+                std::lock_guard lck{state->mutex};
+                state->cond.notify_one();
+            }
+        }
+
+        void wait() override {
+            std::unique_lock lck{state->mutex};
+            state->idleCond.wait(lck, [this]{ return state->pending.load() == 0; });
+        }
+
+        /**
+         * @brief Returns the number of worker threads.
+         */
+        [[nodiscard]] std::size_t getNrOfThreads() const {
+            return state->workers.size();
+        }
+
+        /**
+         * @brief Returns the number of tasks which are queued, but not yet started.
+         */
+        [[nodiscard]] std::size_t getQueueDepth() const {
+            return state->queued.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the number of tasks a worker took from the deque of another worker.
+         */
+        [[nodiscard]] std::size_t getStealCount() const {
+            return state->stealCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Returns the number of executed tasks.
+         */
+        [[nodiscard]] std::size_t getExecutedCount() const {
+            return state->executedCount.load(std::memory_order_relaxed);
+        }
+    private:
+        struct Lane {
+            int priority;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        class Worker {
+        public:
+            void push(int priority, std::function<void()> task) {
+                std::lock_guard lck{mutex};
+                auto it = std::find_if(lanes.begin(), lanes.end(), [priority](const Lane& lane) { return lane.priority <= priority; });
+                if (it == lanes.end() || it->priority != priority) {
+                    it = lanes.insert(it, Lane{priority, {}});
+                }
+                it->tasks.emplace_back(std::move(task));
+            }
+
+            bool pop(std::function<void()>& task, bool steal) {
+                std::lock_guard lck{mutex};
+                for (auto& lane : lanes) {
+                    if (!lane.tasks.empty()) {
+                        if (steal) {
+                            task = std::move(lane.tasks.front());
+                            lane.tasks.pop_front();
+                        } else {
+                            task = std::move(lane.tasks.back());
+                            lane.tasks.pop_back();
+                        }
+                        return true;
+                    }
+                }
+                return false;
+            }
+        private:
+            std::mutex mutex{}; //protects lanes
+            std::vector<Lane> lanes{}; //sorted on descending priority
+        };
+
+        struct State {
+            explicit State(std::size_t nrOfWorkers) : workers(nrOfWorkers) {}
+
+            std::vector<Worker> workers;
+            std::atomic<std::size_t> nextWorker{0};
+            std::atomic<std::size_t> queued{0};
+            std::atomic<std::size_t> pending{0}; //queued or running tasks
+            std::atomic<std::size_t> nrOfSleepingWorkers{0};
+            std::atomic<std::size_t> stealCount{0};
+            std::atomic<std::size_t> executedCount{0};
+
+            std::atomic<bool> stopped{false};
+
+            std::mutex mutex{}; //used for the condition variables
+            std::condition_variable cond{}; //signals queued tasks or stop
+            std::condition_variable idleCond{}; //signals no pending tasks
+        };
+
+        struct CurrentWorker {
+            const State* state;
+            std::size_t index;
+        };
+
+        static CurrentWorker& currentWorker() {
+            static thread_local CurrentWorker current{nullptr, 0};
+            return current;
+        }
+
+        static bool take(State& state, std::size_t index, std::function<void()>& task) {
+            if (state.workers[index].pop(task, false)) {
+                return true;
+            }
+            for (std::size_t i = 1; i < state.workers.size(); ++i) {
+                if (state.workers[(index + i) % state.workers.size()].pop(task, true)) {
+                    state.stealCount.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        static void markDone(State& state) {
+            if (state.pending.fetch_sub(1) == 1) {
+                std::lock_guard lck{state.mutex};
+                state.idleCond.notify_all();
+                if (state.stopped.load()) {
+                    state.cond.notify_all();
+                }
+            }
+        }
+
+        static void run(std::shared_ptr<State> state, std::size_t index) {
+            currentWorker() = CurrentWorker{state.get(), index};
+            while (true) {
+                std::function<void()> task{};
+                if (take(*state, index, task)) {
+                    state->queued.fetch_sub(1, std::memory_order_relaxed);
+                    try {
+                        task();
+                    } catch (...) {
+                        //ignore, no way to report the exception
+                    }
+                    task = nullptr; //note release captured state before the task is marked done
+                    state->executedCount.fetch_add(1, std::memory_order_relaxed);
+                    markDone(*state);
+                    continue;
+                }
+
+                std::unique_lock lck{state->mutex};
+                if (state->stopped && state->pending.load() == 0) {
+                    break;
+                }
+                state->nrOfSleepingWorkers.fetch_add(1);
+                state->cond.wait(lck, [&state]{ return state->queued.load() > 0 || (state->stopped && state->pending.load() == 0); });
+                state->nrOfSleepingWorkers.fetch_sub(1);
+            }
+            currentWorker() = CurrentWorker{nullptr, 0};
+        }
+
+        const std::shared_ptr<State> state;
+        std::vector<std::thread> threads{};
+    };
+}
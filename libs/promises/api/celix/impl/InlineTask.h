@@ -0,0 +1,141 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace celix::impl {
+
+    /**
+     * @brief Move-only void() callable with inline storage for small functors.
+     *
+     * Functors up to INLINE_SIZE bytes (e.g. a promise continuation capturing two promise states and two
+     * std::function objects) are stored inline, larger functors are allocated on the heap.
+     */
+    class InlineTask {
+    public:
+        static constexpr std::size_t INLINE_SIZE = 16 * sizeof(void*);
+
+        InlineTask() noexcept = default;
+
+        template<typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, InlineTask>>>
+        InlineTask(F&& f) { // NOLINT(google-explicit-constructor)
+            using Functor = std::decay_t<F>;
+            if constexpr (isStoredInline<Functor>()) {
+                new (storage) Functor(std::forward<F>(f));
+                ops = &InlineOps<Functor>::ops;
+            } else {
+                new (storage) Functor*{new Functor(std::forward<F>(f))};
+                ops = &HeapOps<Functor>::ops;
+            }
+        }
+
+        InlineTask(InlineTask&& other) noexcept {
+            moveFrom(other);
+        }
+
+        InlineTask& operator=(InlineTask&& other) noexcept {
+            if (this != &other) {
+                reset();
+                moveFrom(other);
+            }
+            return *this;
+        }
+
+        InlineTask(const InlineTask&) = delete;
+        InlineTask& operator=(const InlineTask&) = delete;
+
+        ~InlineTask() noexcept {
+            reset();
+        }
+
+        explicit operator bool() const noexcept {
+            return ops != nullptr;
+        }
+
+        void operator()() {
+            ops->invoke(storage);
+        }
+
+        void reset() noexcept {
+            if (ops != nullptr) {
+                ops->destroy(storage);
+                ops = nullptr;
+            }
+        }
+
+        /**
+         * @brief Returns whether a functor of type F is stored inline (without heap allocation).
+         */
+        template<typename F>
+        static constexpr bool isStoredInline() {
+            return sizeof(F) <= INLINE_SIZE && alignof(F) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<F>;
+        }
+    private:
+        struct Ops {
+            void (*invoke)(void* storage);
+            void (*moveTo)(void* from, void* to) noexcept;
+            void (*destroy)(void* storage) noexcept;
+        };
+
+        template<typename F>
+        struct InlineOps {
+            static void invoke(void* storage) {
+                (*static_cast<F*>(storage))();
+            }
+            static void moveTo(void* from, void* to) noexcept {
+                new (to) F(std::move(*static_cast<F*>(from)));
+                static_cast<F*>(from)->~F();
+            }
+            static void destroy(void* storage) noexcept {
+                static_cast<F*>(storage)->~F();
+            }
+            static constexpr Ops ops{&invoke, &moveTo, &destroy};
+        };
+
+        template<typename F>
+        struct HeapOps {
+            static void invoke(void* storage) {
+                (**static_cast<F**>(storage))();
+            }
+            static void moveTo(void* from, void* to) noexcept {
+                new (to) F*{*static_cast<F**>(from)};
+            }
+            static void destroy(void* storage) noexcept {
+                delete *static_cast<F**>(storage);
+            }
+            static constexpr Ops ops{&invoke, &moveTo, &destroy};
+        };
+
+        void moveFrom(InlineTask& other) noexcept {
+            if (other.ops != nullptr) {
+                other.ops->moveTo(other.storage, storage);
+                ops = other.ops;
+                other.ops = nullptr;
+            }
+        }
+
+        alignas(std::max_align_t) unsigned char storage[INLINE_SIZE]{};
+        const Ops* ops{nullptr};
+    };
+}
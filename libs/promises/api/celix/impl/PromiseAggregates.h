@@ -0,0 +1,233 @@
+/**
+ *Licensed to the Apache Software Foundation (ASF) under one
+ *or more contributor license agreements.  See the NOTICE file
+ *distributed with this work for additional information
+ *regarding copyright ownership.  The ASF licenses this file
+ *to you under the Apache License, Version 2.0 (the
+ *"License"); you may not use this file except in compliance
+ *with the License.  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *Unless required by applicable law or agreed to in writing,
+ *software distributed under the License is distributed on an
+ *"AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ *specific language governing permissions and limitations
+ *under the License.
+ */
+
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "celix/impl/SharedPromiseState.h"
+
+namespace celix::impl {
+
+    /**
+     * @brief Aggregation state of PromiseFactory::all, shared by the continuations of all aggregated promises.
+     *
+     * Every continuation writes the value of its promise to its own (preallocated) slot and decrements the
+     * countdown. The continuation which decrements the countdown to zero resolves the result promise.
+     */
+    template<typename T>
+    class AllAggregate {
+    public:
+        AllAggregate(std::size_t nrOfPromises, std::shared_ptr<SharedPromiseState<std::vector<T>>> _result) :
+                remaining{nrOfPromises}, values(nrOfPromises), result{std::move(_result)} {}
+
+        static void aggregate(const std::vector<std::shared_ptr<SharedPromiseState<T>>>& states, std::shared_ptr<SharedPromiseState<std::vector<T>>> result) {
+            if (states.empty()) {
+                result->resolve(std::vector<T>{});
+                return;
+            }
+            auto aggregate = std::make_shared<AllAggregate<T>>(states.size(), std::move(result));
+            for (std::size_t i = 0; i < states.size(); ++i) {
+                states[i]->addChain([aggregate, s = states[i], i] {
+                    aggregate->add(*s, i);
+                });
+            }
+        }
+    private:
+        void add(SharedPromiseState<T>& state, std::size_t index) {
+            try {
+                if (state.isSuccessfullyResolved()) {
+                    values[index].emplace(state.moveOrGetValue());
+                } else {
+                    setFailure(state.getFailure());
+                }
+            } catch (...) {
+                setFailure(std::current_exception());
+            }
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                complete();
+            }
+        }
+
+        void setFailure(std::exception_ptr e) {
+            if (!hasFailure.exchange(true)) {
+                failure = std::move(e);
+            }
+        }
+
+        void complete() {
+            if (hasFailure.load()) {
+                result->tryFail(failure);
+                return;
+            }
+            try {
+                std::vector<T> resultValues{};
+                resultValues.reserve(values.size());
+                for (auto& value : values) {
+                    resultValues.emplace_back(std::move(*value));
+                }
+                result->tryResolve(std::move(resultValues));
+            } catch (...) {
+                result->tryFail(std::current_exception());
+            }
+        }
+
+        std::atomic<std::size_t> remaining;
+        std::vector<std::optional<T>> values; //note every slot is written by the continuation of a single promise
+        std::atomic<bool> hasFailure{false};
+        std::exception_ptr failure{}; //written by the continuation which set hasFailure
+        const std::shared_ptr<SharedPromiseState<std::vector<T>>> result;
+    };
+
+    /**
+     * @brief Aggregation state of PromiseFactory::any and PromiseFactory::race, shared by the continuations of all
+     * aggregated promises.
+     *
+     * The first continuation which claims the aggregate resolves the result promise. For any only successfully
+     * resolved promises claim the aggregate and the result promise fails if all promises failed.
+     */
+    template<typename T>
+    class FirstAggregate {
+    public:
+        FirstAggregate(std::size_t nrOfPromises, bool _onlySuccess, std::shared_ptr<SharedPromiseState<T>> _result) :
+                remaining{nrOfPromises}, onlySuccess{_onlySuccess}, result{std::move(_result)} {}
+
+        static void aggregate(const std::vector<std::shared_ptr<SharedPromiseState<T>>>& states, bool onlySuccess, std::shared_ptr<SharedPromiseState<T>> result) {
+            if (states.empty()) {
+                try {
+                    throw celix::PromiseInvocationException{"No promises provided"};
+                } catch (...) {
+                    result->fail(std::current_exception());
+                }
+                return;
+            }
+            auto aggregate = std::make_shared<FirstAggregate<T>>(states.size(), onlySuccess, std::move(result));
+            for (const auto& state : states) {
+                state->addChain([aggregate, s = state] {
+                    aggregate->add(*s);
+                });
+            }
+        }
+    private:
+        void add(SharedPromiseState<T>& state) {
+            bool success = state.isSuccessfullyResolved();
+            if ((success || !onlySuccess) && !claimed.exchange(true)) {
+                try {
+                    if (success) {
+                        result->tryResolve(state.moveOrGetValue());
+                    } else {
+                        result->tryFail(state.getFailure());
+                    }
+                } catch (...) {
+                    result->tryFail(std::current_exception());
+                }
+            }
+            //note a claim is always done before the countdown, so the last continuation knows whether the aggregate is claimed
+            if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1 && !claimed.exchange(true)) {
+                result->tryFail(state.getFailure());
+            }
+        }
+
+        std::atomic<std::size_t> remaining;
+        std::atomic<bool> claimed{false};
+        const bool onlySuccess;
+        const std::shared_ptr<SharedPromiseState<T>> result;
+    };
+
+    /**
+     * @brief Aggregation state of PromiseFactory::collectBatch, shared by the continuations of all aggregated promises.
+     *
+     * Values are collected in a batch and the consumer is called, with the mutex locked, every time the batch is full.
+     * The last continuation calls the consumer with the remaining values and resolves the result promise.
+     */
+    template<typename T>
+    class BatchAggregate {
+    public:
+        BatchAggregate(std::size_t nrOfPromises, std::size_t _batchSize, std::function<void(std::vector<T>)> _consumer, std::shared_ptr<SharedPromiseState<void>> _result) :
+                batchSize{_batchSize}, consumer{std::move(_consumer)}, result{std::move(_result)}, remaining{nrOfPromises} {
+            batch.reserve(batchSize);
+        }
+
+        static void aggregate(const std::vector<std::shared_ptr<SharedPromiseState<T>>>& states, std::size_t batchSize, std::function<void(std::vector<T>)> consumer, std::shared_ptr<SharedPromiseState<void>> result) {
+            if (states.empty()) {
+                result->resolve();
+                return;
+            }
+            auto aggregate = std::make_shared<BatchAggregate<T>>(states.size(), batchSize, std::move(consumer), std::move(result));
+            for (const auto& state : states) {
+                state->addChain([aggregate, s = state] {
+                    aggregate->add(*s);
+                });
+            }
+        }
+    private:
+        void add(SharedPromiseState<T>& state) {
+            std::unique_lock lck{mutex};
+            try {
+                if (state.isSuccessfullyResolved()) {
+                    batch.emplace_back(state.moveOrGetValue());
+                } else if (!failure) {
+                    failure = state.getFailure();
+                }
+            } catch (...) {
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+            remaining -= 1;
+            if (batch.size() >= batchSize || (remaining == 0 && !batch.empty())) {
+                std::vector<T> full{};
+                full.reserve(remaining == 0 ? 0 : batchSize);
+                full.swap(batch);
+                try {
+                    consumer(std::move(full));
+                } catch (...) {
+                    if (!failure) {
+                        failure = std::current_exception();
+                    }
+                }
+            }
+            if (remaining == 0) {
+                std::exception_ptr e = failure;
+                lck.unlock();
+                if (e) {
+                    result->tryFail(e);
+                } else {
+                    result->tryResolve();
+                }
+            }
+        }
+
+        const std::size_t batchSize;
+        const std::function<void(std::vector<T>)> consumer;
+        const std::shared_ptr<SharedPromiseState<void>> result;
+
+        std::mutex mutex{}; //protects below and serializes the consumer calls
+        std::size_t remaining;
+        std::vector<T> batch{};
+        std::exception_ptr failure{};
+    };
+}
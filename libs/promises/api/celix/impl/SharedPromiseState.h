@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <type_traits>
 #include <functional>
 #include <chrono>
@@ -29,20 +30,61 @@
 #include <thread>
 #include <optional>
 
+#include "celix/ContinuationPolicy.h"
 #include "celix/IExecutor.h"
 #include "celix/IScheduledExecutor.h"
 
 #include "celix/PromiseInvocationException.h"
 #include "celix/PromiseTimeoutException.h"
+#include "celix/impl/InlineTask.h"
 
 namespace celix::impl {
 
+    /**
+     * @brief Bits of the lock-free chain state of a SharedPromiseState.
+     *
+     * The first continuation of a promise state is stored inline and registered and dispatched without locking,
+     * additional continuations are added to the chain vector with the mutex locked.
+     */
+    constexpr int CHAIN_DONE = 0x1; //promise is resolved
+    constexpr int CHAIN_FIRST_CLAIMED = 0x2; //first continuation slot is claimed by a thread adding a continuation
+    constexpr int CHAIN_FIRST_SET = 0x4; //first continuation is stored
+
+    /**
+     * @brief Returns the number of continuations currently executed inline on the calling thread.
+     */
+    inline int& inlineContinuationDepth() {
+        static thread_local int depth = 0;
+        return depth;
+    }
+
+    /**
+     * @brief Executes a continuation inline on the calling thread, keeping track of the inline continuation depth.
+     *
+     * As with a continuation executed on an executor, exceptions thrown by the continuation are ignored.
+     */
+    template<typename F>
+    void executeInlineContinuation(F& task) {
+        int& depth = inlineContinuationDepth();
+        depth += 1;
+        try {
+            task();
+        } catch (...) {
+            //ignore, no way to report the exception
+        }
+        depth -= 1;
+    }
+
     template<typename T>
     class SharedPromiseState {
         // Pointers make using promises properly unnecessarily complicated.
         static_assert(!std::is_pointer_v<T>, "Cannot use pointers with promises.");
+
+        struct CreateKey {}; //note used to restrict construction to create, while still using std::make_shared
     public:
-        static std::shared_ptr<SharedPromiseState<T>> create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority);
+        static std::shared_ptr<SharedPromiseState<T>> create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority, celix::ContinuationPolicy continuationPolicy = celix::ContinuationPolicy::EXECUTOR);
+
+        SharedPromiseState(CreateKey, std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority, celix::ContinuationPolicy _continuationPolicy);
 
         ~SharedPromiseState() noexcept = default;
 
@@ -104,18 +146,31 @@ namespace celix::impl {
         [[nodiscard]] static std::shared_ptr<SharedPromiseState<T>>
         timeout(std::shared_ptr<SharedPromiseState<T>> state, std::chrono::duration<Rep, Period> duration);
 
-        void addChain(std::function<void()> chainFunction);
+        template<typename F>
+        void addChain(F&& chainFunction);
 
         [[nodiscard]] std::shared_ptr<celix::IExecutor> getExecutor() const;
 
         [[nodiscard]] std::shared_ptr<celix::IScheduledExecutor> getScheduledExecutor() const;
 
         int getPriority() const;
+
+        [[nodiscard]] celix::ContinuationPolicy getContinuationPolicy() const;
     private:
-        explicit SharedPromiseState(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority);
+        /**
+         * Returns whether a continuation can be executed inline on the current thread, based on the continuation
+         * policy and the current inline continuation depth.
+         */
+        bool isInlineContinuationAllowed() const;
 
         void setSelf(std::weak_ptr<SharedPromiseState<T>> self);
 
+        /**
+         * Execute the first continuation on the executor or inline. Called once, by either the resolving thread or the thread
+         * adding the first continuation.
+         */
+        void dispatchFirstContinuation();
+
         /**
          * Complete the resolving and call the registered tasks
          * A reference to the possible locked unique_lock.
@@ -130,21 +185,29 @@ namespace celix::impl {
         const std::shared_ptr<celix::IExecutor> executor;
         const std::shared_ptr<celix::IScheduledExecutor> scheduledExecutor;
         const int priority;
+        const celix::ContinuationPolicy continuationPolicy;
         std::weak_ptr<SharedPromiseState<T>> self{};
 
+        std::atomic<int> chainState{0}; //see CHAIN_* bits
+        InlineTask firstContinuation{}; //set once with CHAIN_FIRST_CLAIMED owned
+        std::shared_ptr<SharedPromiseState<T>> firstContinuationKeepAlive{}; //set while the first continuation is dispatched
+
         mutable std::mutex mutex{}; //protects below
         mutable std::condition_variable cond{};
         bool done = false;
         bool dataMoved = false;
-        std::vector<std::function<void()>> chain{}; //chain tasks are executed on thread pool.
+        std::vector<std::function<void()>> chain{}; //chain tasks are executed on thread pool or inline, see continuationPolicy.
         std::exception_ptr exp{nullptr};
         std::optional<T> data{};
     };
 
     template<>
     class SharedPromiseState<void> {
+        struct CreateKey {}; //note used to restrict construction to create, while still using std::make_shared
     public:
-        static std::shared_ptr<SharedPromiseState<void>> create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority);
+        static std::shared_ptr<SharedPromiseState<void>> create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority, celix::ContinuationPolicy continuationPolicy = celix::ContinuationPolicy::EXECUTOR);
+
+        SharedPromiseState(CreateKey, std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority, celix::ContinuationPolicy _continuationPolicy);
 
         ~SharedPromiseState() noexcept = default;
 
@@ -191,18 +254,31 @@ namespace celix::impl {
         static std::shared_ptr<SharedPromiseState<void>>
         timeout(std::shared_ptr<SharedPromiseState<void>> state, std::chrono::duration<Rep, Period> duration);
 
-        void addChain(std::function<void()> chainFunction);
+        template<typename F>
+        void addChain(F&& chainFunction);
 
         [[nodiscard]] std::shared_ptr<celix::IExecutor> getExecutor() const;
 
         [[nodiscard]] std::shared_ptr<celix::IScheduledExecutor> getScheduledExecutor() const;
 
         int getPriority() const;
+
+        [[nodiscard]] celix::ContinuationPolicy getContinuationPolicy() const;
     private:
-        explicit SharedPromiseState(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority);
+        /**
+         * Returns whether a continuation can be executed inline on the current thread, based on the continuation
+         * policy and the current inline continuation depth.
+         */
+        bool isInlineContinuationAllowed() const;
 
         void setSelf(std::weak_ptr<SharedPromiseState<void>> self);
 
+        /**
+         * Execute the first continuation on the executor or inline. Called once, by either the resolving thread or the thread
+         * adding the first continuation.
+         */
+        void dispatchFirstContinuation();
+
         /**
          * Complete the resolving and call the registered tasks
          * A reference to the possible locked unique_lock.
@@ -217,12 +293,17 @@ namespace celix::impl {
         const std::shared_ptr<celix::IExecutor> executor;
         const std::shared_ptr<celix::IScheduledExecutor> scheduledExecutor;
         const int priority;
+        const celix::ContinuationPolicy continuationPolicy;
         std::weak_ptr<SharedPromiseState<void>> self{};
 
+        std::atomic<int> chainState{0}; //see CHAIN_* bits
+        InlineTask firstContinuation{}; //set once with CHAIN_FIRST_CLAIMED owned
+        std::shared_ptr<SharedPromiseState<void>> firstContinuationKeepAlive{}; //set while the first continuation is dispatched
+
         mutable std::mutex mutex{}; //protects below
         mutable std::condition_variable cond{};
         bool done = false;
-        std::vector<std::function<void()>> chain{}; //chain tasks are executed on thread pool.
+        std::vector<std::function<void()>> chain{}; //chain tasks are executed on thread pool or inline, see continuationPolicy.
         std::exception_ptr exp{nullptr};
     };
 }
@@ -233,22 +314,22 @@ namespace celix::impl {
 *********************************************************************************/
 
 template<typename T>
-std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseState<T>::create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority) {
-    auto state = std::shared_ptr<celix::impl::SharedPromiseState<T>>{new celix::impl::SharedPromiseState<T>{std::move(_executor), std::move(_scheduledExecutor), priority}};
+std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseState<T>::create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority, celix::ContinuationPolicy continuationPolicy) {
+    auto state = std::make_shared<celix::impl::SharedPromiseState<T>>(CreateKey{}, std::move(_executor), std::move(_scheduledExecutor), priority, continuationPolicy);
     state->setSelf(state);
     return state;
 }
 
-inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::SharedPromiseState<void>::create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority) {
-    auto state = std::shared_ptr<celix::impl::SharedPromiseState<void>>{new celix::impl::SharedPromiseState<void>{std::move(_executor), std::move(_scheduledExecutor), priority}};
+inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::SharedPromiseState<void>::create(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int priority, celix::ContinuationPolicy continuationPolicy) {
+    auto state = std::make_shared<celix::impl::SharedPromiseState<void>>(CreateKey{}, std::move(_executor), std::move(_scheduledExecutor), priority, continuationPolicy);
     state->setSelf(state);
     return state;
 }
 
 template<typename T>
-celix::impl::SharedPromiseState<T>::SharedPromiseState(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority) : executor{std::move(_executor)}, scheduledExecutor{std::move(_scheduledExecutor)}, priority{_priority} {}
+celix::impl::SharedPromiseState<T>::SharedPromiseState(CreateKey, std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority, celix::ContinuationPolicy _continuationPolicy) : executor{std::move(_executor)}, scheduledExecutor{std::move(_scheduledExecutor)}, priority{_priority}, continuationPolicy{_continuationPolicy} {}
 
-inline celix::impl::SharedPromiseState<void>::SharedPromiseState(std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority) : executor{std::move(_executor)}, scheduledExecutor{std::move(_scheduledExecutor)}, priority{_priority} {}
+inline celix::impl::SharedPromiseState<void>::SharedPromiseState(CreateKey, std::shared_ptr<celix::IExecutor> _executor, std::shared_ptr<celix::IScheduledExecutor> _scheduledExecutor, int _priority, celix::ContinuationPolicy _continuationPolicy) : executor{std::move(_executor)}, scheduledExecutor{std::move(_scheduledExecutor)}, priority{_priority}, continuationPolicy{_continuationPolicy} {}
 
 template<typename T>
 void celix::impl::SharedPromiseState<T>::setSelf(std::weak_ptr<SharedPromiseState<T>> _self) {
@@ -363,24 +444,22 @@ inline void celix::impl::SharedPromiseState<void>::tryFail(std::exception_ptr e)
 
 template<typename T>
 bool celix::impl::SharedPromiseState<T>::isDone() const {
-    std::lock_guard lck{mutex};
-    return done;
+    return (chainState.load(std::memory_order_acquire) & CHAIN_DONE) != 0;
 }
 
 inline bool celix::impl::SharedPromiseState<void>::isDone() const {
-    std::lock_guard lck{mutex};
-    return done;
+    return (chainState.load(std::memory_order_acquire) & CHAIN_DONE) != 0;
 }
 
 template<typename T>
 bool celix::impl::SharedPromiseState<T>::isSuccessfullyResolved() const {
-    std::lock_guard lck{mutex};
-    return done && !exp;
+    //note exp is not updated after the promise is done
+    return isDone() && !exp;
 }
 
 inline bool celix::impl::SharedPromiseState<void>::isSuccessfullyResolved() const {
-    std::lock_guard lck{mutex};
-    return done && !exp;
+    //note exp is not updated after the promise is done
+    return isDone() && !exp;
 }
 
 
@@ -500,6 +579,24 @@ inline int celix::impl::SharedPromiseState<void>::getPriority() const {
     return priority;
 }
 
+template<typename T>
+celix::ContinuationPolicy celix::impl::SharedPromiseState<T>::getContinuationPolicy() const {
+    return continuationPolicy;
+}
+
+inline celix::ContinuationPolicy celix::impl::SharedPromiseState<void>::getContinuationPolicy() const {
+    return continuationPolicy;
+}
+
+template<typename T>
+bool celix::impl::SharedPromiseState<T>::isInlineContinuationAllowed() const {
+    return continuationPolicy == celix::ContinuationPolicy::INLINE && inlineContinuationDepth() < celix::MAX_INLINE_CONTINUATION_DEPTH;
+}
+
+inline bool celix::impl::SharedPromiseState<void>::isInlineContinuationAllowed() const {
+    return continuationPolicy == celix::ContinuationPolicy::INLINE && inlineContinuationDepth() < celix::MAX_INLINE_CONTINUATION_DEPTH;
+}
+
 template<typename T>
 void celix::impl::SharedPromiseState<T>::wait() const {
     std::unique_lock<std::mutex> lck{mutex};
@@ -548,7 +645,7 @@ inline void celix::impl::SharedPromiseState<void>::resolveWith(std::shared_ptr<S
 template<typename T>
 template<typename Rep, typename Period>
 std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseState<T>::timeout(std::shared_ptr<SharedPromiseState<T>> state, std::chrono::duration<Rep, Period> duration) {
-    auto p = celix::impl::SharedPromiseState<T>::create(state->executor, state->scheduledExecutor, state->priority);
+    auto p = celix::impl::SharedPromiseState<T>::create(state->executor, state->scheduledExecutor, state->priority, state->continuationPolicy);
     p->resolveWith(state);
     auto schedFuture = p->scheduledExecutor->schedule(p->priority, duration, [p]{
         p->tryFail(std::make_exception_ptr(celix::PromiseTimeoutException{}));
@@ -561,7 +658,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseSt
 
 template<typename Rep, typename Period>
 std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::SharedPromiseState<void>::timeout(std::shared_ptr<SharedPromiseState<void>> state, std::chrono::duration<Rep, Period> duration) {
-    auto p = celix::impl::SharedPromiseState<void>::create(state->executor, state->scheduledExecutor, state->priority);
+    auto p = celix::impl::SharedPromiseState<void>::create(state->executor, state->scheduledExecutor, state->priority, state->continuationPolicy);
     p->resolveWith(state);
     auto schedFuture = p->scheduledExecutor->schedule(p->priority, duration, [p]{
             p->tryFail(std::make_exception_ptr(celix::PromiseTimeoutException{}));
@@ -575,7 +672,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::SharedPromis
 template<typename T>
 template<typename Rep, typename Period>
 std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseState<T>::delay(std::chrono::duration<Rep, Period> duration) {
-    auto state = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority);
+    auto state = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
     addOnResolve([state, duration](std::optional<T> v, std::exception_ptr e) {
         state->scheduledExecutor->schedule(state->priority, duration, [v = std::move(v), e, state] {
             try {
@@ -596,7 +693,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseSt
 
 template<typename Rep, typename Period>
 std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::SharedPromiseState<void>::delay(std::chrono::duration<Rep, Period> duration) {
-    auto state = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority);
+    auto state = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority, continuationPolicy);
     addOnResolve([state, duration](std::optional<std::exception_ptr> e) {
         state->scheduledExecutor->schedule(state->priority, duration, [e, state] {
             try {
@@ -620,7 +717,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseSt
     if (!recover) {
         throw celix::PromiseInvocationException{"provided recover callback is not valid"};
     }
-    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
     addOnResolve([p, recover = std::move(recover)](std::optional<T> v, const std::exception_ptr& /*e*/) {
         if (v) {
             p->resolve(std::move(*v));
@@ -640,7 +737,7 @@ inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::Share
         throw celix::PromiseInvocationException{"provided recover callback is not valid"};
     }
 
-    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority, continuationPolicy);
 
     addOnResolve([p, recover = std::move(recover)](std::optional<std::exception_ptr> e) {
         if (!e) {
@@ -662,7 +759,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseSt
     if (!predicate) {
         throw celix::PromiseInvocationException{"provided predicate callback is not valid"};
     }
-    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
     auto chainFunction = [s = self.lock(), p, predicate = std::move(predicate)] {
         if (s->isSuccessfullyResolved()) {
             try {
@@ -685,7 +782,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseSt
 
 template<typename T>
 std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseState<T>::fallbackTo(std::shared_ptr<celix::impl::SharedPromiseState<T>> fallbackTo) {
-    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
     auto chainFunction = [s = self.lock(), p, fallbackTo = std::move(fallbackTo)] {
         if (s->isSuccessfullyResolved()) {
             p->resolve(s->moveOrGetValue());
@@ -702,7 +799,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseSt
 }
 
 inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::SharedPromiseState<void>::fallbackTo(std::shared_ptr<celix::impl::SharedPromiseState<void>> fallbackTo) {
-    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority, continuationPolicy);
     auto chainFunction = [s = self.lock(), p, fallbackTo = std::move(fallbackTo)] {
         if (s->isSuccessfullyResolved()) {
             s->getValue();
@@ -721,47 +818,114 @@ inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::Share
 }
 
 template<typename T>
-void celix::impl::SharedPromiseState<T>::addChain(std::function<void()> chainFunction) {
+template<typename F>
+void celix::impl::SharedPromiseState<T>::addChain(F&& chainFunction) {
+    int current = chainState.load(std::memory_order_acquire);
+    while ((current & CHAIN_FIRST_CLAIMED) == 0) {
+        if (chainState.compare_exchange_weak(current, current | CHAIN_FIRST_CLAIMED, std::memory_order_acq_rel)) {
+            firstContinuation = InlineTask{std::forward<F>(chainFunction)};
+            int prev = chainState.fetch_or(CHAIN_FIRST_SET, std::memory_order_acq_rel);
+            if ((prev & CHAIN_DONE) != 0) {
+                dispatchFirstContinuation();
+            }
+            return;
+        }
+    }
+
     std::function<void()> localChain{};
     {
         std::lock_guard lck{mutex};
         if (!done) {
-            chain.emplace_back([func = std::move(chainFunction)]() {
-                func();
-            });
+            chain.emplace_back(std::forward<F>(chainFunction));
         } else {
-            localChain = std::move(chainFunction);
+            localChain = std::forward<F>(chainFunction);
         }
     }
-    if (localChain) {
+    if (localChain && isInlineContinuationAllowed()) {
+        executeInlineContinuation(localChain);
+    } else if (localChain) {
         executor->execute(priority, std::move(localChain));
     }
 }
 
-inline void celix::impl::SharedPromiseState<void>::addChain(std::function<void()> chainFunction) {
+template<typename T>
+void celix::impl::SharedPromiseState<T>::dispatchFirstContinuation() {
+    if (isInlineContinuationAllowed()) {
+        InlineTask task = std::move(firstContinuation);
+        executeInlineContinuation(task);
+        return;
+    }
+    //note capturing only this, so that the std::function does not allocate. The keep alive ensures this stays valid.
+    firstContinuationKeepAlive = self.lock();
+    try {
+        executor->execute(priority, [this] {
+            InlineTask task = std::move(firstContinuation);
+            auto keepAlive = std::move(firstContinuationKeepAlive);
+            task();
+        });
+    } catch (...) {
+        firstContinuationKeepAlive = nullptr;
+        throw;
+    }
+}
+
+template<typename F>
+void celix::impl::SharedPromiseState<void>::addChain(F&& chainFunction) {
+    int current = chainState.load(std::memory_order_acquire);
+    while ((current & CHAIN_FIRST_CLAIMED) == 0) {
+        if (chainState.compare_exchange_weak(current, current | CHAIN_FIRST_CLAIMED, std::memory_order_acq_rel)) {
+            firstContinuation = InlineTask{std::forward<F>(chainFunction)};
+            int prev = chainState.fetch_or(CHAIN_FIRST_SET, std::memory_order_acq_rel);
+            if ((prev & CHAIN_DONE) != 0) {
+                dispatchFirstContinuation();
+            }
+            return;
+        }
+    }
+
     std::function<void()> localChain{};
     {
         std::lock_guard lck{mutex};
         if (!done) {
-            chain.emplace_back([func = std::move(chainFunction)]() {
-                func();
-            });
+            chain.emplace_back(std::forward<F>(chainFunction));
         } else {
-            localChain = std::move(chainFunction);
+            localChain = std::forward<F>(chainFunction);
         }
     }
-    if (localChain) {
+    if (localChain && isInlineContinuationAllowed()) {
+        executeInlineContinuation(localChain);
+    } else if (localChain) {
         executor->execute(priority, std::move(localChain));
     }
 }
 
+inline void celix::impl::SharedPromiseState<void>::dispatchFirstContinuation() {
+    if (isInlineContinuationAllowed()) {
+        InlineTask task = std::move(firstContinuation);
+        executeInlineContinuation(task);
+        return;
+    }
+    //note capturing only this, so that the std::function does not allocate. The keep alive ensures this stays valid.
+    firstContinuationKeepAlive = self.lock();
+    try {
+        executor->execute(priority, [this] {
+            InlineTask task = std::move(firstContinuation);
+            auto keepAlive = std::move(firstContinuationKeepAlive);
+            task();
+        });
+    } catch (...) {
+        firstContinuationKeepAlive = nullptr;
+        throw;
+    }
+}
+
 template<typename T>
 template<typename R>
 std::shared_ptr<celix::impl::SharedPromiseState<R>> celix::impl::SharedPromiseState<T>::map(std::function<R(T)> mapper) {
     if (!mapper) {
         throw celix::PromiseInvocationException("provided mapper is not valid");
     }
-    auto p = celix::impl::SharedPromiseState<R>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<R>::create(executor, scheduledExecutor, priority, continuationPolicy);
     auto chainFunction = [s = self.lock(), p, mapper = std::move(mapper)] {
         try {
             if (s->isSuccessfullyResolved()) {
@@ -782,7 +946,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<R>> celix::impl::SharedPromiseSt
     if (!mapper) {
         throw celix::PromiseInvocationException("provided mapper is not valid");
     }
-    auto p = celix::impl::SharedPromiseState<R>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<R>::create(executor, scheduledExecutor, priority, continuationPolicy);
     auto chainFunction = [s = self.lock(), p, mapper = std::move(mapper)] {
         try {
             if (s->isSuccessfullyResolved()) {
@@ -804,7 +968,7 @@ std::shared_ptr<celix::impl::SharedPromiseState<T>> celix::impl::SharedPromiseSt
     if (!consumer) {
         throw celix::PromiseInvocationException("provided consumer is not valid");
     }
-    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<T>::create(executor, scheduledExecutor, priority, continuationPolicy);
     auto chainFunction = [s = self.lock(), p, consumer = std::move(consumer)] {
         if (s->isSuccessfullyResolved()) {
             try {
@@ -825,7 +989,7 @@ inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::Share
     if (!consumer) {
         throw celix::PromiseInvocationException("provided consumer is not valid");
     }
-    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority);
+    auto p = celix::impl::SharedPromiseState<void>::create(executor, scheduledExecutor, priority, continuationPolicy);
     auto chainFunction = [s = self.lock(), p, consumer = std::move(consumer)] {
         if (s->isSuccessfullyResolved()) {
             try {
@@ -845,7 +1009,7 @@ inline std::shared_ptr<celix::impl::SharedPromiseState<void>> celix::impl::Share
 
 template<typename T>
 void celix::impl::SharedPromiseState<T>::addOnResolve(std::function<void(std::optional<T> val, std::exception_ptr exp)> callback) {
-    std::function<void()> task = [s = self.lock(), callback = std::move(callback)] {
+    addChain([s = self.lock(), callback = std::move(callback)] {
         std::exception_ptr e;
         {
             std::lock_guard<std::mutex> lck{s->mutex};
@@ -856,45 +1020,41 @@ void celix::impl::SharedPromiseState<T>::addOnResolve(std::function<void(std::op
         } else {
             callback(s->getValue(), e);
         }
-    };
-    addChain(task);
+    });
 }
 
 inline void celix::impl::SharedPromiseState<void>::addOnResolve(std::function<void(std::optional<std::exception_ptr> exp)> callback) {
-    std::function<void()> task = [s = self.lock(), callback = std::move(callback)] {
+    addChain([s = self.lock(), callback = std::move(callback)] {
         std::exception_ptr e;
         {
             std::lock_guard<std::mutex> lck{s->mutex};
             e = s->exp;
         }
         callback(e);
-    };
-    addChain(task);
+    });
 }
 
 template<typename T>
 void celix::impl::SharedPromiseState<T>::addOnSuccessConsumeCallback(std::function<void(T)> callback) {
-    std::function<void()> task = [s = self.lock(), callback = std::move(callback)] {
+    addChain([s = self.lock(), callback = std::move(callback)] {
         if (s->isSuccessfullyResolved()) {
             callback(s->getValue());
         }
-    };
-    addChain(task);
+    });
 }
 
 inline void celix::impl::SharedPromiseState<void>::addOnSuccessConsumeCallback(std::function<void()> callback) {
-    std::function<void()> task = [s = self.lock(), callback = std::move(callback)] {
+    addChain([s = self.lock(), callback = std::move(callback)] {
         if (s->isSuccessfullyResolved()) {
             s->getValue();
             callback();
         }
-    };
-    addChain(task);
+    });
 }
 
 template<typename T>
 void celix::impl::SharedPromiseState<T>::addOnFailureConsumeCallback(std::function<void(const std::exception&)> callback) {
-    std::function<void()> task = [s = self.lock(), callback = std::move(callback)] {
+    addChain([s = self.lock(), callback = std::move(callback)] {
         if (!s->isSuccessfullyResolved()) {
             try {
                 std::rethrow_exception(s->getFailure());
@@ -906,12 +1066,11 @@ void celix::impl::SharedPromiseState<T>::addOnFailureConsumeCallback(std::functi
                 callback(logicError);
             }
         }
-    };
-    addChain(task);
+    });
 }
 
 inline void celix::impl::SharedPromiseState<void>::addOnFailureConsumeCallback(std::function<void(const std::exception&)> callback) {
-    std::function<void()> task = [s = self.lock(), callback = std::move(callback)] {
+    addChain([s = self.lock(), callback = std::move(callback)] {
         if (!s->isSuccessfullyResolved()) {
             try {
                 std::rethrow_exception(s->getFailure());
@@ -923,8 +1082,7 @@ inline void celix::impl::SharedPromiseState<void>::addOnFailureConsumeCallback(s
                 callback(logicError);
             }
         }
-    };
-    addChain(task);
+    });
 }
 
 template<typename T>
@@ -937,12 +1095,22 @@ void celix::impl::SharedPromiseState<T>::complete(std::unique_lock<std::mutex>&
     }
     done = true;
     cond.notify_all();
+    int prevChainState = chainState.fetch_or(CHAIN_DONE, std::memory_order_acq_rel);
+    if ((prevChainState & CHAIN_FIRST_SET) != 0) {
+        lck.unlock();
+        dispatchFirstContinuation();
+        lck.lock();
+    }
     while (!chain.empty()) {
         std::vector<std::function<void()>> localChains{};
         localChains.swap(chain);
         lck.unlock();
         for (auto &chainTask : localChains) {
-            executor->execute(priority, std::move(chainTask));
+            if (isInlineContinuationAllowed()) {
+                executeInlineContinuation(chainTask);
+            } else {
+                executor->execute(priority, std::move(chainTask));
+            }
         }
         localChains.clear();
         lck.lock();
@@ -958,12 +1126,22 @@ inline void celix::impl::SharedPromiseState<void>::complete(std::unique_lock<std
     }
     done = true;
     cond.notify_all();
+    int prevChainState = chainState.fetch_or(CHAIN_DONE, std::memory_order_acq_rel);
+    if ((prevChainState & CHAIN_FIRST_SET) != 0) {
+        lck.unlock();
+        dispatchFirstContinuation();
+        lck.lock();
+    }
     while (!chain.empty()) {
         std::vector<std::function<void()>> localChains{};
         localChains.swap(chain);
         lck.unlock();
         for (auto &chainTask : localChains) {
-            executor->execute(priority, std::move(chainTask));
+            if (isInlineContinuationAllowed()) {
+                executeInlineContinuation(chainTask);
+            } else {
+                executor->execute(priority, std::move(chainTask));
+            }
         }
         localChains.clear();
         lck.lock();
@@ -0,0 +1,80 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <optional>
+
+#include "celix/PromiseFactory.h"
+#include "celix/DefaultExecutor.h"
+#include "celix/WorkStealingExecutor.h"
+
+/**
+ * Benchmark to measure the time needed to resolve a chain of alternating map and then continuations.
+ * The chain is created before the head of the chain is resolved.
+ */
+static void chainContinuations(benchmark::State& state, const std::shared_ptr<celix::IExecutor>& executor, celix::ContinuationPolicy policy = celix::ContinuationPolicy::EXECUTOR) {
+    celix::PromiseFactory factory{executor, {}, policy};
+    const int64_t chainLength = state.range(0);
+
+    for (auto _ : state) {
+        // This code gets timed
+        auto deferred = factory.deferred<int64_t>();
+        std::optional<celix::Promise<int64_t>> promise{deferred.getPromise()};
+        for (int64_t i = 0; i < chainLength; ++i) {
+            if (i % 2 == 0) {
+                promise.emplace(promise->map<int64_t>([](int64_t value) { return value + 1; }));
+            } else {
+                promise.emplace(promise->then<int64_t>([&factory](celix::Promise<int64_t> p) {
+                    return factory.resolved<int64_t>(p.getValue() + 1);
+                }));
+            }
+        }
+        deferred.resolve(0);
+        auto result = promise->getValue();
+        if (result != chainLength) {
+            state.SkipWithError("Unexpected chain result");
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * chainLength);
+}
+
+static void PromiseChainBenchmark_WorkStealingExecutor(benchmark::State& state) {
+    auto executor = std::make_shared<celix::WorkStealingExecutor>();
+    chainContinuations(state, executor);
+    state.counters["steals"] = benchmark::Counter{(double)executor->getStealCount(), benchmark::Counter::kAvgIterations};
+}
+
+static void PromiseChainBenchmark_WorkStealingExecutorInlineContinuations(benchmark::State& state) {
+    auto executor = std::make_shared<celix::WorkStealingExecutor>();
+    chainContinuations(state, executor, celix::ContinuationPolicy::INLINE);
+    state.counters["tasks"] = benchmark::Counter{(double)executor->getExecutedCount(), benchmark::Counter::kAvgIterations};
+}
+
+static void PromiseChainBenchmark_DefaultExecutor(benchmark::State& state) {
+    chainContinuations(state, std::make_shared<celix::DefaultExecutor>());
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMillisecond)
+
+CELIX_BENCHMARK(PromiseChainBenchmark_WorkStealingExecutor)->RangeMultiplier(100)->Range(100, 1000000);
+CELIX_BENCHMARK(PromiseChainBenchmark_WorkStealingExecutorInlineContinuations)->RangeMultiplier(100)->Range(100, 1000000);
+//note the DefaultExecutor starts a thread per continuation, so only short chains are benchmarked.
+CELIX_BENCHMARK(PromiseChainBenchmark_DefaultExecutor)->RangeMultiplier(100)->Range(100, 10000);
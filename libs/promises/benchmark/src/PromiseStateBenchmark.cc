@@ -0,0 +1,130 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#include "celix/PromiseFactory.h"
+#include "celix/WorkStealingExecutor.h"
+
+//note counting heap allocations, to track the number of allocations needed for a promise continuation.
+static std::atomic<std::size_t> nrOfAllocations{0};
+
+void* operator new(std::size_t size) {
+    nrOfAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = std::malloc(size == 0 ? 1 : size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc{};
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+    std::free(ptr);
+}
+
+/**
+ * Executor which executes the task directly on the calling thread, so that only the promise state is benchmarked.
+ */
+class CallingThreadExecutor : public celix::IExecutor {
+public:
+    void execute(int /*priority*/, std::function<void()> task) override {
+        task();
+    }
+
+    void wait() override {}
+};
+
+/**
+ * Benchmark to measure the time and heap allocations needed for a deferred which is resolved with a single map
+ * continuation.
+ */
+static void deferredResolveMap(benchmark::State& state, const std::shared_ptr<celix::IExecutor>& executor) {
+    celix::PromiseFactory factory{executor};
+    std::size_t allocations = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        auto startAllocations = nrOfAllocations.load(std::memory_order_relaxed);
+        auto deferred = factory.deferred<long>();
+        auto promise = deferred.getPromise().map<long>([](long value) { return value + 1; });
+        deferred.resolve(41);
+        benchmark::DoNotOptimize(promise.getValue());
+        allocations += nrOfAllocations.load(std::memory_order_relaxed) - startAllocations;
+    }
+    factory.wait();
+    state.counters["allocations"] = benchmark::Counter{(double)allocations, benchmark::Counter::kAvgIterations};
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void PromiseStateBenchmark_CallingThreadExecutorDeferredResolveMap(benchmark::State& state) {
+    deferredResolveMap(state, std::make_shared<CallingThreadExecutor>());
+}
+
+static void PromiseStateBenchmark_WorkStealingExecutorDeferredResolveMap(benchmark::State& state) {
+    deferredResolveMap(state, std::make_shared<celix::WorkStealingExecutor>());
+}
+
+/**
+ * Benchmark to measure the time and heap allocations needed to combine state.range(0) deferreds with
+ * PromiseFactory::all.
+ */
+static void PromiseStateBenchmark_CallingThreadExecutorAll(benchmark::State& state) {
+    celix::PromiseFactory factory{std::make_shared<CallingThreadExecutor>()};
+    const auto nrOfPromises = (std::size_t)state.range(0);
+    std::vector<celix::Deferred<long>> deferreds{};
+    std::vector<celix::Promise<long>> promises{};
+    deferreds.reserve(nrOfPromises);
+    promises.reserve(nrOfPromises);
+    std::size_t allocations = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        deferreds.clear();
+        promises.clear();
+        for (std::size_t i = 0; i < nrOfPromises; ++i) {
+            deferreds.emplace_back(factory.deferred<long>());
+            promises.emplace_back(deferreds.back().getPromise());
+        }
+        state.ResumeTiming();
+
+        // This code gets timed
+        auto startAllocations = nrOfAllocations.load(std::memory_order_relaxed);
+        auto all = factory.all(promises);
+        for (auto& deferred : deferreds) {
+            deferred.resolve(1);
+        }
+        benchmark::DoNotOptimize(all.getValue());
+        allocations += nrOfAllocations.load(std::memory_order_relaxed) - startAllocations;
+    }
+    state.counters["allocations"] = benchmark::Counter{(double)allocations, benchmark::Counter::kAvgIterations};
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMicrosecond)
+
+CELIX_BENCHMARK(PromiseStateBenchmark_CallingThreadExecutorDeferredResolveMap);
+CELIX_BENCHMARK(PromiseStateBenchmark_WorkStealingExecutorDeferredResolveMap);
+CELIX_BENCHMARK(PromiseStateBenchmark_CallingThreadExecutorAll)->RangeMultiplier(10)->Range(10, 1000);
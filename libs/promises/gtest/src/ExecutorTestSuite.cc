@@ -24,6 +24,8 @@
 
 #include "celix/DefaultExecutor.h"
 #include "celix/DefaultScheduledExecutor.h"
+#include "celix/WorkStealingExecutor.h"
+#include "celix/TimerWheelScheduledExecutor.h"
 
 class ExecutorTestSuite : public ::testing::Test {
 public:
@@ -53,4 +55,120 @@ TEST_F(ExecutorTestSuite, ScheduledExecuteTasks) {
     auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1);
     EXPECT_EQ(3, counter.load());
     EXPECT_GT(diff, std::chrono::milliseconds{49});
-}
\ No newline at end of file
+}
+
+TEST_F(ExecutorTestSuite, WorkStealingExecuteTasks) {
+    auto wsExecutor = std::make_shared<celix::WorkStealingExecutor>(4);
+    EXPECT_EQ(4, wsExecutor->getNrOfThreads());
+
+    std::atomic<int> counter{0};
+    for (int i = 0; i < 1000; ++i) {
+        wsExecutor->execute([&counter]{counter++;});
+    }
+    wsExecutor->execute([]{ throw std::logic_error{"ignored"}; });
+    wsExecutor->wait();
+    EXPECT_EQ(1000, counter.load());
+    EXPECT_EQ(1001, wsExecutor->getExecutedCount());
+    EXPECT_EQ(0, wsExecutor->getQueueDepth());
+}
+
+TEST_F(ExecutorTestSuite, WorkStealingExecutePriorityTasks) {
+    celix::WorkStealingExecutor wsExecutor{1};
+
+    std::promise<void> blockPromise{};
+    auto block = blockPromise.get_future().share();
+    std::promise<void> startedPromise{};
+    wsExecutor.execute([block, &startedPromise]{
+        startedPromise.set_value();
+        block.wait();
+    });
+    startedPromise.get_future().wait(); //ensure the only worker is busy
+
+    std::vector<int> order{};
+    wsExecutor.execute(-1, [&order]{ order.push_back(-1); });
+    wsExecutor.execute(0, [&order]{ order.push_back(0); });
+    wsExecutor.execute(10, [&order]{ order.push_back(10); });
+    EXPECT_EQ(3, wsExecutor.getQueueDepth());
+
+    blockPromise.set_value();
+    wsExecutor.wait();
+    EXPECT_EQ((std::vector<int>{10, 0, -1}), order);
+}
+
+TEST_F(ExecutorTestSuite, WorkStealingStealTasks) {
+    celix::WorkStealingExecutor wsExecutor{2};
+
+    //note tasks executed from a worker are queued on that worker, the other worker should steal them.
+    std::atomic<int> counter{0};
+    std::promise<void> stolenPromise{};
+    auto stolen = stolenPromise.get_future().share();
+    wsExecutor.execute([&wsExecutor, &counter, &stolenPromise, stolen]{
+        wsExecutor.execute([&counter, &stolenPromise]{
+            counter++;
+            stolenPromise.set_value();
+        });
+        stolen.wait(); //block this worker until the queued task is stolen
+    });
+    wsExecutor.wait();
+    EXPECT_EQ(1, counter.load());
+    EXPECT_EQ(1, wsExecutor.getStealCount());
+}
+
+TEST_F(ExecutorTestSuite, WorkStealingReleaseLastReferenceInTask) {
+    auto wsExecutor = std::make_shared<celix::WorkStealingExecutor>(2);
+
+    std::promise<void> releasedPromise{};
+    auto released = releasedPromise.get_future().share();
+    std::promise<void> destroyedPromise{};
+    auto destroyed = destroyedPromise.get_future();
+    wsExecutor->execute([exec = wsExecutor, released, &destroyedPromise]() mutable {
+        released.wait();
+        exec.reset(); //note last reference, destroys the executor on the worker thread
+        destroyedPromise.set_value();
+    });
+    wsExecutor.reset();
+    releasedPromise.set_value();
+    EXPECT_EQ(std::future_status::ready, destroyed.wait_for(std::chrono::seconds{5}));
+}
+
+TEST_F(ExecutorTestSuite, TimerWheelScheduledExecuteTasks) {
+    //note using a small wheel, so that the delays need multiple rounds
+    auto timerWheel = std::make_shared<celix::TimerWheelScheduledExecutor>(executor, std::chrono::milliseconds{1}, 8);
+    std::atomic<int> counter{0};
+    std::vector<std::shared_ptr<celix::IScheduledFuture>> futures{};
+    auto t1 = std::chrono::steady_clock::now();
+    futures.emplace_back(timerWheel->schedule(std::chrono::milliseconds{0}, [&counter]{counter++;}));
+    futures.emplace_back(timerWheel->schedule(std::chrono::milliseconds{5}, [&counter]{counter++;}));
+    futures.emplace_back(timerWheel->schedule(std::chrono::milliseconds{20}, [&counter]{counter++;}));
+    futures.emplace_back(timerWheel->schedule(std::chrono::milliseconds{50}, [&counter]{counter++;}));
+    timerWheel->wait();
+    auto t2 = std::chrono::steady_clock::now();
+    auto diff = std::chrono::duration_cast<std::chrono::milliseconds>(t2 - t1);
+    EXPECT_EQ(4, counter.load());
+    EXPECT_GE(diff, std::chrono::milliseconds{50});
+    for (auto& future : futures) {
+        EXPECT_TRUE(future->isDone());
+        EXPECT_FALSE(future->isCancelled());
+    }
+    EXPECT_EQ(0, timerWheel->getNrOfScheduledTasks());
+}
+
+TEST_F(ExecutorTestSuite, TimerWheelCancelScheduledTasks) {
+    auto timerWheel = std::make_shared<celix::TimerWheelScheduledExecutor>(executor);
+    std::atomic<int> counter{0};
+    std::vector<std::shared_ptr<celix::IScheduledFuture>> futures{};
+    for (int i = 0; i < 10000; ++i) {
+        futures.emplace_back(timerWheel->schedule(std::chrono::seconds{10 + i % 10}, [&counter]{counter++;}));
+    }
+    EXPECT_EQ(10000, timerWheel->getNrOfScheduledTasks());
+    for (auto& future : futures) {
+        future->cancel();
+    }
+    EXPECT_EQ(0, timerWheel->getNrOfScheduledTasks());
+    timerWheel->wait(); //note should not wait for the cancelled tasks
+    EXPECT_EQ(0, counter.load());
+    for (auto& future : futures) {
+        EXPECT_TRUE(future->isDone());
+        EXPECT_TRUE(future->isCancelled());
+    }
+}
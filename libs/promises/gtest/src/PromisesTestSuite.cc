@@ -20,6 +20,7 @@
 #include <gtest/gtest.h>
 
 #include <future>
+#include <optional>
 #include <utility>
 
 #include "celix/PromiseFactory.h"
@@ -511,6 +512,145 @@ TEST_F(PromiseTestSuite, getExecutorFromFactory) {
     EXPECT_EQ(executor.get(), exec.get());
 }
 
+TEST_F(PromiseTestSuite, multipleContinuations) {
+    //note the first continuation is stored inline, the others are added to the chain
+    auto deferred = factory->deferred<long>();
+    std::atomic<long> sum{0};
+    deferred.getPromise().onSuccess([&sum](long val) { sum += val; });
+    deferred.getPromise().onSuccess([&sum](long val) { sum += val * 10; });
+    deferred.resolve(1);
+    deferred.getPromise().onSuccess([&sum](long val) { sum += val * 100; }); //added after resolve
+    factory->wait();
+    EXPECT_EQ(111, sum.load());
+
+    //first continuation added after resolve
+    auto resolved = factory->resolved<long>(1L);
+    EXPECT_EQ(2, resolved.map<long>([](long val) { return val + 1; }).getValue());
+}
+
+TEST_F(PromiseTestSuite, inlineContinuationPolicy) {
+    auto inlineFactory = std::make_shared<celix::PromiseFactory>(executor, scheduledExecutor, celix::ContinuationPolicy::INLINE);
+    EXPECT_EQ(celix::ContinuationPolicy::INLINE, inlineFactory->getContinuationPolicy());
+
+    auto deferred = inlineFactory->deferred<long>();
+    std::thread::id continuationThread{};
+    auto promise = deferred.getPromise()
+            .map<long>([](long val) { return val + 1; })
+            .map<long>([](long val) { return val * 2; })
+            .thenAccept([&continuationThread](long /*val*/) { continuationThread = std::this_thread::get_id(); });
+    deferred.resolve(20);
+
+    //note all continuations are executed on the resolving thread, before resolve returns
+    EXPECT_TRUE(promise.isDone());
+    EXPECT_EQ(42, promise.getValue());
+    EXPECT_EQ(std::this_thread::get_id(), continuationThread);
+
+    //continuations added to a resolved promise are executed on the calling thread
+    EXPECT_TRUE(promise.map<long>([](long val) { return val + 1; }).isDone());
+
+    //per call continuation policy
+    auto inlineDeferred = factory->deferred<long>(0, celix::ContinuationPolicy::INLINE);
+    auto mapped = inlineDeferred.getPromise().map<long>([](long val) { return val + 1; });
+    inlineDeferred.resolve(41);
+    EXPECT_TRUE(mapped.isDone());
+    EXPECT_EQ(42, mapped.getValue());
+}
+
+TEST_F(PromiseTestSuite, inlineContinuationDepthLimit) {
+    //note a long chain should not overflow the stack, nested continuations above the max depth use the executor
+    auto inlineFactory = std::make_shared<celix::PromiseFactory>(executor, scheduledExecutor, celix::ContinuationPolicy::INLINE);
+    auto deferred = inlineFactory->deferred<long>();
+    const auto resolvingThread = std::this_thread::get_id();
+    std::atomic<int> nrOfInlineStages{0};
+    std::optional<celix::Promise<long>> promise{};
+    promise.emplace(deferred.getPromise());
+    for (int i = 0; i < 4 * celix::MAX_INLINE_CONTINUATION_DEPTH; ++i) {
+        promise.emplace(promise->map<long>([&nrOfInlineStages, resolvingThread](long val) {
+            if (std::this_thread::get_id() == resolvingThread) {
+                nrOfInlineStages += 1;
+            }
+            return val + 1;
+        }));
+    }
+    deferred.resolve(0);
+    EXPECT_EQ(4 * celix::MAX_INLINE_CONTINUATION_DEPTH, promise->getValue());
+    EXPECT_EQ(celix::MAX_INLINE_CONTINUATION_DEPTH, nrOfInlineStages.load());
+}
+
+TEST_F(PromiseTestSuite, allPromises) {
+    std::vector<celix::Deferred<long>> deferreds{};
+    std::vector<celix::Promise<long>> promises{};
+    for (long i = 0; i < 5; ++i) {
+        deferreds.emplace_back(factory->deferred<long>());
+        promises.emplace_back(deferreds.back().getPromise());
+    }
+    auto all = factory->all(promises);
+    for (auto it = deferreds.rbegin(); it != deferreds.rend(); ++it) {
+        EXPECT_FALSE(all.isDone());
+        it->resolve((long)(it - deferreds.rbegin()));
+    }
+    EXPECT_EQ((std::vector<long>{4, 3, 2, 1, 0}), all.getValue());
+
+    //failure
+    auto failed = factory->all(std::vector<celix::Promise<long>>{
+            factory->resolved<long>(1L),
+            factory->failed<long>(std::make_exception_ptr(std::logic_error{"failure"})),
+            factory->resolved<long>(3L)});
+    failed.wait();
+    EXPECT_FALSE(failed.isSuccessfullyResolved());
+    EXPECT_THROW(std::rethrow_exception(failed.getFailure()), std::logic_error);
+
+    //no promises
+    EXPECT_TRUE(factory->all(std::vector<celix::Promise<long>>{}).getValue().empty());
+}
+
+TEST_F(PromiseTestSuite, anyAndRacePromises) {
+    auto deferred1 = factory->deferred<long>();
+    auto deferred2 = factory->deferred<long>();
+    std::vector<celix::Promise<long>> promises{deferred1.getPromise(), deferred2.getPromise()};
+    auto any = factory->any(promises);
+    auto race = factory->race(promises);
+    deferred1.fail(std::logic_error{"failure"});
+    race.wait();
+    EXPECT_FALSE(race.isSuccessfullyResolved());
+    EXPECT_FALSE(any.isDone());
+    deferred2.resolve(42);
+    EXPECT_EQ(42, any.getValue());
+
+    //all failed
+    auto allFailed = factory->any(std::vector<celix::Promise<long>>{
+            factory->failed<long>(std::make_exception_ptr(std::logic_error{"failure"})),
+            factory->failed<long>(std::make_exception_ptr(std::logic_error{"failure"}))});
+    allFailed.wait();
+    EXPECT_FALSE(allFailed.isSuccessfullyResolved());
+
+    //no promises
+    auto noPromises = factory->race(std::vector<celix::Promise<long>>{});
+    EXPECT_THROW(std::rethrow_exception(noPromises.getFailure()), celix::PromiseInvocationException);
+}
+
+TEST_F(PromiseTestSuite, collectBatchPromises) {
+    std::vector<celix::Promise<long>> promises{};
+    for (long i = 1; i <= 10; ++i) {
+        promises.emplace_back(factory->deferredTask<long>([i](auto deferred) { deferred.resolve(i); }));
+    }
+    std::vector<std::size_t> batchSizes{};
+    long sum = 0;
+    auto done = factory->collectBatch<long>(promises, 3, [&batchSizes, &sum](std::vector<long> batch) {
+        //note consumer calls are serialized
+        batchSizes.emplace_back(batch.size());
+        for (auto val : batch) {
+            sum += val;
+        }
+    });
+    done.wait();
+    EXPECT_TRUE(done.isSuccessfullyResolved());
+    EXPECT_EQ((std::vector<std::size_t>{3, 3, 3, 1}), batchSizes);
+    EXPECT_EQ(55, sum);
+
+    EXPECT_THROW((void)factory->collectBatch<long>(promises, 0, [](std::vector<long>) {}), celix::PromiseInvocationException);
+}
+
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
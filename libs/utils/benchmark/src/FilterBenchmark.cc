@@ -0,0 +1,94 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <iostream>
+
+#include "celix_filter.h"
+#include "celix_properties.h"
+
+class FilterBenchmark {
+public:
+    explicit FilterBenchmark(int64_t nrOfExtraProperties) {
+        celix_properties_set(props, "objectClass", "org.example.Calculator");
+        celix_properties_set(props, "service.id", "42");
+        celix_properties_set(props, "service.ranking", "0");
+        celix_properties_set(props, "service.version", "1.2.0");
+        celix_properties_set(props, "service.lang", "C");
+        for (int64_t i = 0; i < nrOfExtraProperties; ++i) {
+            celix_properties_set(props, ("extra.property." + std::to_string(i)).c_str(), "value");
+        }
+    }
+
+    ~FilterBenchmark() {
+        celix_properties_destroy(props);
+    }
+
+    FilterBenchmark(FilterBenchmark&&) = delete;
+    FilterBenchmark& operator=(FilterBenchmark&&) = delete;
+    FilterBenchmark(const FilterBenchmark&) = delete;
+    FilterBenchmark& operator=(const FilterBenchmark&) = delete;
+
+    celix_properties_t* props{celix_properties_create()};
+};
+
+static const char* const TRACKER_FILTER = "(&(objectClass=org.example.Calculator)(service.version>=1.0.0)(service.version<2.0.0)(|(service.lang=C)(service.lang=C++)))";
+static const char* const NON_MATCHING_TRACKER_FILTER = "(&(objectClass=org.example.Shell)(service.version>=1.0.0)(service.version<2.0.0))";
+static const char* const SUBSTRING_FILTER = "(&(objectClass=org.example.*)(!(service.lang=J*)))";
+
+static void FilterBenchmark_match(benchmark::State& state, const char* filterStr) {
+    FilterBenchmark benchmark{state.range(0)};
+    celix_filter_t* filter = celix_filter_create(filterStr);
+    bool expected = celix_filter_match(filter, benchmark.props);
+    for (auto _ : state) {
+        // This code gets timed
+        if (celix_filter_match(filter, benchmark.props) != expected) {
+            std::cerr << "Unexpected match result for " << filterStr << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    celix_filter_destroy(filter);
+}
+
+static void FilterBenchmark_compiledMatch(benchmark::State& state, const char* filterStr) {
+    FilterBenchmark benchmark{state.range(0)};
+    celix_filter_t* filter = celix_filter_create(filterStr);
+    celix_compiled_filter_t* compiled = celix_filter_compile(filter);
+    bool expected = celix_filter_match(filter, benchmark.props);
+    for (auto _ : state) {
+        // This code gets timed
+        if (celix_compiledFilter_match(compiled, benchmark.props) != expected) {
+            std::cerr << "Unexpected compiled match result for " << filterStr << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+    celix_compiledFilter_destroy(compiled);
+    celix_filter_destroy(filter);
+}
+
+#define CELIX_BENCHMARK_CAPTURE(func, name, arg) \
+    BENCHMARK_CAPTURE(func, name, arg)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kNanosecond)
+
+CELIX_BENCHMARK_CAPTURE(FilterBenchmark_match, trackerFilter, TRACKER_FILTER)->Arg(0)->Arg(100);
+CELIX_BENCHMARK_CAPTURE(FilterBenchmark_compiledMatch, trackerFilter, TRACKER_FILTER)->Arg(0)->Arg(100);
+CELIX_BENCHMARK_CAPTURE(FilterBenchmark_match, nonMatchingTrackerFilter, NON_MATCHING_TRACKER_FILTER)->Arg(0)->Arg(100);
+CELIX_BENCHMARK_CAPTURE(FilterBenchmark_compiledMatch, nonMatchingTrackerFilter, NON_MATCHING_TRACKER_FILTER)->Arg(0)->Arg(100);
+CELIX_BENCHMARK_CAPTURE(FilterBenchmark_match, substringFilter, SUBSTRING_FILTER)->Arg(0)->Arg(100);
+CELIX_BENCHMARK_CAPTURE(FilterBenchmark_compiledMatch, substringFilter, SUBSTRING_FILTER)->Arg(0)->Arg(100);
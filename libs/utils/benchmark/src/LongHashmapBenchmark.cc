@@ -25,22 +25,30 @@
 #include <climits>
 
 #include "hash_map.h"
+#include "celix_long_hash_map.h"
 #include "celix_properties.h"
 
 
 class LongHashmapBenchmark {
 public:
-    explicit LongHashmapBenchmark(int64_t _nrOfEntries, bool fillCHashmap = false) : stdMap{createRandomMap(_nrOfEntries)} {
+    explicit LongHashmapBenchmark(int64_t _nrOfEntries, bool fillCHashmap = false, bool fillCLongHashMap = false) : stdMap{createRandomMap(_nrOfEntries)} {
         celixHashMap = hashMap_create(nullptr, nullptr, nullptr, nullptr);
         if (fillCHashmap) {
             for (const auto& pair : stdMap) {
                 hashMap_put(celixHashMap, reinterpret_cast<void*>(pair.first), reinterpret_cast<void*>(pair.second));
             }
         }
+        celixLongHashMap = celix_longHashMap_create();
+        if (fillCLongHashMap) {
+            for (const auto& pair : stdMap) {
+                celix_longHashMap_putLong(celixLongHashMap, pair.first, pair.second);
+            }
+        }
     }
 
     ~LongHashmapBenchmark() {
         hashMap_destroy(celixHashMap, false, false);
+        celix_longHashMap_destroy(celixLongHashMap);
     }
 
     LongHashmapBenchmark(LongHashmapBenchmark&&) = delete;
@@ -55,7 +63,7 @@ public:
             if (result.size() == (size_t)nrOfEntries/2) {
                 midEntryKey = key;
             }
-            stdMap[key] = createRandomValue();
+            result[key] = createRandomValue();
         }
         return result;
     }
@@ -75,6 +83,7 @@ public:
     long midEntryKey{0};
     std::unordered_map<long, int> stdMap;
     hash_map_t* celixHashMap{nullptr};
+    celix_long_hash_map_t* celixLongHashMap{nullptr};
 };
 
 static void LongHashmapBenchmark_addEntryToStdMap(benchmark::State& state) {
@@ -97,6 +106,41 @@ static void LongHashmapBenchmark_addEntryToCelixHashmap(benchmark::State& state)
     state.SetItemsProcessed(state.iterations());
 }
 
+static void LongHashmapBenchmark_addEntryToCelixLongHashmap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0), false, true};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_longHashMap_putLong(benchmark.celixLongHashMap, 42, 42);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void LongHashmapBenchmark_fillCelixHashmap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0)};
+    for (auto _ : state) {
+        // This code gets timed
+        hash_map_t* map = hashMap_create(nullptr, nullptr, nullptr, nullptr);
+        for (const auto& pair : benchmark.stdMap) {
+            hashMap_put(map, reinterpret_cast<void*>(pair.first), reinterpret_cast<void*>(pair.second));
+        }
+        hashMap_destroy(map, false, false);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void LongHashmapBenchmark_fillCelixLongHashmap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0)};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_long_hash_map_t* map = celix_longHashMap_create();
+        for (const auto& pair : benchmark.stdMap) {
+            celix_longHashMap_putLong(map, pair.first, pair.second);
+        }
+        celix_longHashMap_destroy(map);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 static void LongHashmapBenchmark_findEntryFromStdMap(benchmark::State& state) {
     LongHashmapBenchmark benchmark{state.range(0)};
     //std::cout << "std map size is " << benchmark.stdMap.size() << std::endl;
@@ -123,11 +167,28 @@ static void LongHashmapBenchmark_findEntryFromCelixMap(benchmark::State& state)
     state.SetItemsProcessed(state.iterations());
 }
 
+static void LongHashmapBenchmark_findEntryFromCelixLongHashmap(benchmark::State& state) {
+    LongHashmapBenchmark benchmark{state.range(0), false, true};
+    for (auto _ : state) {
+        // This code gets timed
+        bool found = celix_longHashMap_hasKey(benchmark.celixLongHashMap, benchmark.midEntryKey);
+        if (!found) {
+            std::cerr << "Cannot find entry " << benchmark.midEntryKey << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 #define CELIX_BENCHMARK(name) \
     BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMicrosecond)
 
 CELIX_BENCHMARK(LongHashmapBenchmark_addEntryToStdMap)->RangeMultiplier(10)->Range(100, 100000); //reference
 CELIX_BENCHMARK(LongHashmapBenchmark_addEntryToCelixHashmap)->RangeMultiplier(10)->Range(100, 100000);
+CELIX_BENCHMARK(LongHashmapBenchmark_addEntryToCelixLongHashmap)->RangeMultiplier(10)->Range(100, 100000);
+
+CELIX_BENCHMARK(LongHashmapBenchmark_fillCelixHashmap)->RangeMultiplier(10)->Range(100, 100000);
+CELIX_BENCHMARK(LongHashmapBenchmark_fillCelixLongHashmap)->RangeMultiplier(10)->Range(100, 100000);
 
 CELIX_BENCHMARK(LongHashmapBenchmark_findEntryFromStdMap)->RangeMultiplier(10)->Range(100, 100000); //reference
 CELIX_BENCHMARK(LongHashmapBenchmark_findEntryFromCelixMap)->RangeMultiplier(10)->Range(100, 100000);
+CELIX_BENCHMARK(LongHashmapBenchmark_findEntryFromCelixLongHashmap)->RangeMultiplier(10)->Range(100, 100000);
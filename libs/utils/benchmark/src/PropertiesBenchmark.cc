@@ -0,0 +1,144 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <iostream>
+
+#include "celix_properties.h"
+
+class PropertiesBenchmark {
+public:
+    explicit PropertiesBenchmark(int64_t nrOfEntries) {
+        //note mimics service properties: some short framework entries and some longer user entries
+        keys.emplace_back("objectClass");
+        values.emplace_back("org.example.Calculator");
+        keys.emplace_back("service.id");
+        values.emplace_back("42");
+        keys.emplace_back("service.bundleid");
+        values.emplace_back("3");
+        keys.emplace_back("service.scope");
+        values.emplace_back("singleton");
+        for (int64_t i = 4; i < nrOfEntries; ++i) {
+            keys.emplace_back("user.property." + std::to_string(i));
+            values.emplace_back("value-" + std::to_string(i));
+        }
+        keys.resize(nrOfEntries);
+        values.resize(nrOfEntries);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            celix_properties_set(props, keys[i].c_str(), values[i].c_str());
+            stdMap[keys[i]] = values[i];
+        }
+    }
+
+    ~PropertiesBenchmark() {
+        celix_properties_destroy(props);
+    }
+
+    PropertiesBenchmark(PropertiesBenchmark&&) = delete;
+    PropertiesBenchmark& operator=(PropertiesBenchmark&&) = delete;
+    PropertiesBenchmark(const PropertiesBenchmark&) = delete;
+    PropertiesBenchmark& operator=(const PropertiesBenchmark&) = delete;
+
+    std::vector<std::string> keys{};
+    std::vector<std::string> values{};
+    std::unordered_map<std::string, std::string> stdMap{};
+    celix_properties_t* props{celix_properties_create()};
+};
+
+static void PropertiesBenchmark_createAndSetStdMap(benchmark::State& state) {
+    PropertiesBenchmark benchmark{state.range(0)};
+    for (auto _ : state) {
+        // This code gets timed
+        std::unordered_map<std::string, std::string> map{};
+        for (size_t i = 0; i < benchmark.keys.size(); ++i) {
+            map[benchmark.keys[i]] = benchmark.values[i];
+        }
+        benchmark::DoNotOptimize(map);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void PropertiesBenchmark_createAndSetCelixProperties(benchmark::State& state) {
+    PropertiesBenchmark benchmark{state.range(0)};
+    for (auto _ : state) {
+        // This code gets timed
+        auto* props = celix_properties_create();
+        for (size_t i = 0; i < benchmark.keys.size(); ++i) {
+            celix_properties_set(props, benchmark.keys[i].c_str(), benchmark.values[i].c_str());
+        }
+        celix_properties_destroy(props);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void PropertiesBenchmark_updateCelixProperties(benchmark::State& state) {
+    PropertiesBenchmark benchmark{state.range(0)};
+    long count = 0;
+    for (auto _ : state) {
+        // This code gets timed
+        celix_properties_setLong(benchmark.props, "service.ranking", count++ % 100);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void PropertiesBenchmark_copyStdMap(benchmark::State& state) {
+    PropertiesBenchmark benchmark{state.range(0)};
+    for (auto _ : state) {
+        // This code gets timed
+        std::unordered_map<std::string, std::string> copy{benchmark.stdMap};
+        benchmark::DoNotOptimize(copy);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void PropertiesBenchmark_copyCelixProperties(benchmark::State& state) {
+    PropertiesBenchmark benchmark{state.range(0)};
+    for (auto _ : state) {
+        // This code gets timed
+        auto* copy = celix_properties_copy(benchmark.props);
+        celix_properties_destroy(copy);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void PropertiesBenchmark_getFromCelixProperties(benchmark::State& state) {
+    PropertiesBenchmark benchmark{state.range(0)};
+    const char* key = benchmark.keys[benchmark.keys.size() / 2].c_str();
+    for (auto _ : state) {
+        // This code gets timed
+        const char* val = celix_properties_get(benchmark.props, key, nullptr);
+        if (val == nullptr) {
+            std::cerr << "Cannot find entry " << key << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define CELIX_BENCHMARK(name) \
+    BENCHMARK(name)->MeasureProcessCPUTime()->UseRealTime()->Unit(benchmark::kMicrosecond)
+
+CELIX_BENCHMARK(PropertiesBenchmark_createAndSetStdMap)->RangeMultiplier(4)->Range(8, 128); //reference
+CELIX_BENCHMARK(PropertiesBenchmark_createAndSetCelixProperties)->RangeMultiplier(4)->Range(8, 128);
+CELIX_BENCHMARK(PropertiesBenchmark_updateCelixProperties)->RangeMultiplier(4)->Range(8, 128);
+CELIX_BENCHMARK(PropertiesBenchmark_copyStdMap)->RangeMultiplier(4)->Range(8, 128); //reference
+CELIX_BENCHMARK(PropertiesBenchmark_copyCelixProperties)->RangeMultiplier(4)->Range(8, 128);
+CELIX_BENCHMARK(PropertiesBenchmark_getFromCelixProperties)->RangeMultiplier(4)->Range(8, 128);
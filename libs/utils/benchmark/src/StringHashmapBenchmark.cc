@@ -26,18 +26,25 @@
 #include <climits>
 
 #include "hash_map.h"
+#include "celix_string_hash_map.h"
 #include "celix_properties.h"
 
 
 class StringHashmapBenchmark {
 public:
-    explicit StringHashmapBenchmark(int64_t _nrOfEntries, bool fillCHashmap = false, bool fillCProperties = false) : stdMap{createRandomMap(_nrOfEntries)} {
+    explicit StringHashmapBenchmark(int64_t _nrOfEntries, bool fillCHashmap = false, bool fillCProperties = false, bool fillCStringHashMap = false) : stdMap{createRandomMap(_nrOfEntries)} {
         celixHashMap = hashMap_create(utils_stringHash, nullptr, utils_stringEquals, nullptr);
         if (fillCHashmap) {
             for (const auto& pair : stdMap) {
                 hashMap_put(celixHashMap, (void*)pair.first.c_str(), reinterpret_cast<void*>(pair.second));
             }
         }
+        celixStringHashMap = celix_stringHashMap_create();
+        if (fillCStringHashMap) {
+            for (const auto& pair : stdMap) {
+                celix_stringHashMap_putLong(celixStringHashMap, pair.first.c_str(), pair.second); //note keys are copied
+            }
+        }
         if (fillCProperties) {
             for (const auto& pair : stdMap) {
                 celix_properties_set(celixProperties, pair.first.c_str(), std::to_string(pair.second).c_str()); //note adding entries to properties will always copy the strings.
@@ -48,6 +55,7 @@ public:
     ~StringHashmapBenchmark() {
         hashMap_destroy(celixHashMap, false, false);
         celix_properties_destroy(celixProperties);
+        celix_stringHashMap_destroy(celixStringHashMap);
     }
 
     StringHashmapBenchmark(StringHashmapBenchmark&&) = delete;
@@ -62,7 +70,7 @@ public:
             if (result.size() == (size_t)nrOfEntries/2) {
                 midEntryKey = key;
             }
-            stdMap[std::move(key)] = createRandomValue();
+            result[std::move(key)] = createRandomValue();
         }
         return result;
     }
@@ -90,6 +98,7 @@ public:
     std::string midEntryKey{};
     std::unordered_map<std::string, int> stdMap;
     hash_map_t* celixHashMap{nullptr};
+    celix_string_hash_map_t* celixStringHashMap{nullptr};
     celix_properties_t* celixProperties{celix_properties_create()};
 };
 
@@ -113,6 +122,15 @@ static void StringHashmapBenchmark_addEntryToCelixHashmap(benchmark::State& stat
     state.SetItemsProcessed(state.iterations());
 }
 
+static void StringHashmapBenchmark_addEntryToCelixStringHashmap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0), false, false, true};
+    for (auto _ : state) {
+        // This code gets timed
+        celix_stringHashMap_putLong(benchmark.celixStringHashMap, "latest_entry", 42);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 static void StringHashmapBenchmark_addEntryToCelixProperties(benchmark::State& state) {
     StringHashmapBenchmark benchmark{state.range(0), false, true};
     for (auto _ : state) {
@@ -122,6 +140,34 @@ static void StringHashmapBenchmark_addEntryToCelixProperties(benchmark::State& s
     state.SetItemsProcessed(state.iterations());
 }
 
+static void StringHashmapBenchmark_fillCelixHashmap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0)};
+    for (auto _ : state) {
+        // This code gets timed
+        hash_map_t* map = hashMap_create(utils_stringHash, nullptr, utils_stringEquals, nullptr);
+        for (const auto& pair : benchmark.stdMap) {
+            hashMap_put(map, (void*)pair.first.c_str(), reinterpret_cast<void*>(pair.second));
+        }
+        hashMap_destroy(map, false, false);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void StringHashmapBenchmark_fillCelixStringHashmap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0)};
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.storeKeysWeakly = true; //note same as the hash_map_t benchmark, keys are not copied
+    for (auto _ : state) {
+        // This code gets timed
+        celix_string_hash_map_t* map = celix_stringHashMap_createWithOptions(&opts);
+        for (const auto& pair : benchmark.stdMap) {
+            celix_stringHashMap_putLong(map, pair.first.c_str(), pair.second);
+        }
+        celix_stringHashMap_destroy(map);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 static void StringHashmapBenchmark_findEntryFromStdMap(benchmark::State& state) {
     StringHashmapBenchmark benchmark{state.range(0)};
     //std::cout << "std map size is " << benchmark.stdMap.size() << std::endl;
@@ -148,6 +194,18 @@ static void StringHashmapBenchmark_findEntryFromCelixMap(benchmark::State& state
     state.SetItemsProcessed(state.iterations());
 }
 
+static void StringHashmapBenchmark_findEntryFromCelixStringHashmap(benchmark::State& state) {
+    StringHashmapBenchmark benchmark{state.range(0), false, false, true};
+    for (auto _ : state) {
+        // This code gets timed
+        bool found = celix_stringHashMap_hasKey(benchmark.celixStringHashMap, benchmark.midEntryKey.c_str());
+        if (!found) {
+            std::cerr << "Cannot find entry " << benchmark.midEntryKey << std::endl;
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
 static void StringHashmapBenchmark_findEntryFromCelixProperties(benchmark::State& state) {
     StringHashmapBenchmark benchmark{state.range(0), false, true};
     for (auto _ : state) {
@@ -165,8 +223,13 @@ static void StringHashmapBenchmark_findEntryFromCelixProperties(benchmark::State
 
 CELIX_BENCHMARK(StringHashmapBenchmark_addEntryToStdMap)->RangeMultiplier(10)->Range(100, 100000); //reference
 CELIX_BENCHMARK(StringHashmapBenchmark_addEntryToCelixHashmap)->RangeMultiplier(10)->Range(100, 100000);
+CELIX_BENCHMARK(StringHashmapBenchmark_addEntryToCelixStringHashmap)->RangeMultiplier(10)->Range(100, 100000);
 CELIX_BENCHMARK(StringHashmapBenchmark_addEntryToCelixProperties)->RangeMultiplier(10)->Range(100, 100000);
 
+CELIX_BENCHMARK(StringHashmapBenchmark_fillCelixHashmap)->RangeMultiplier(10)->Range(100, 100000);
+CELIX_BENCHMARK(StringHashmapBenchmark_fillCelixStringHashmap)->RangeMultiplier(10)->Range(100, 100000);
+
 CELIX_BENCHMARK(StringHashmapBenchmark_findEntryFromStdMap)->RangeMultiplier(10)->Range(100, 100000); //reference
 CELIX_BENCHMARK(StringHashmapBenchmark_findEntryFromCelixMap)->RangeMultiplier(10)->Range(100, 100000);
+CELIX_BENCHMARK(StringHashmapBenchmark_findEntryFromCelixStringHashmap)->RangeMultiplier(10)->Range(100, 100000);
 CELIX_BENCHMARK(StringHashmapBenchmark_findEntryFromCelixProperties)->RangeMultiplier(10)->Range(100, 100000);
@@ -0,0 +1,79 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "celix_array_list.h"
+
+class ArrayListTestSuite : public ::testing::Test {};
+
+TEST_F(ArrayListTestSuite, InitOnStackTest) {
+    celix_array_list_storage_t storage;
+    celix_array_list_t* list = celix_arrayList_init(&storage);
+    EXPECT_EQ(0, celix_arrayList_size(list));
+
+    for (int i = 0; i < CELIX_ARRAY_LIST_INLINE_CAPACITY; ++i) {
+        celix_arrayList_addInt(list, i);
+    }
+    EXPECT_EQ(CELIX_ARRAY_LIST_INLINE_CAPACITY, celix_arrayList_size(list));
+
+    //outgrow the inline entries
+    for (int i = CELIX_ARRAY_LIST_INLINE_CAPACITY; i < 100; ++i) {
+        celix_arrayList_addInt(list, i);
+    }
+    EXPECT_EQ(100, celix_arrayList_size(list));
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(i, celix_arrayList_getInt(list, i));
+    }
+
+    celix_arrayList_destroy(list); //note only frees the entries, not the storage
+}
+
+TEST_F(ArrayListTestSuite, RemoveEntriesTest) {
+    auto* list = celix_arrayList_create();
+    for (int i = 0; i < 20; ++i) {
+        celix_arrayList_addLong(list, i);
+    }
+    celix_arrayList_removeAt(list, 0);
+    celix_arrayList_removeLong(list, 10);
+    celix_arrayList_removeAt(list, 17);
+    EXPECT_EQ(17, celix_arrayList_size(list));
+    EXPECT_EQ(1, celix_arrayList_getLong(list, 0));
+    EXPECT_EQ(9, celix_arrayList_getLong(list, 8));
+    EXPECT_EQ(11, celix_arrayList_getLong(list, 9));
+    EXPECT_EQ(18, celix_arrayList_getLong(list, 16));
+
+    celix_arrayList_clear(list);
+    EXPECT_EQ(0, celix_arrayList_size(list));
+    celix_arrayList_destroy(list);
+}
+
+TEST_F(ArrayListTestSuite, DoubleEntriesTest) {
+    celix_array_list_storage_t storage;
+    celix_array_list_t* list = celix_arrayList_init(&storage);
+    for (int i = 0; i < 20; ++i) {
+        celix_arrayList_addDouble(list, i + 0.5);
+    }
+    celix_arrayList_removeAt(list, 0);
+    EXPECT_EQ(19, celix_arrayList_size(list));
+    for (int i = 0; i < 19; ++i) {
+        EXPECT_DOUBLE_EQ(i + 1.5, celix_arrayList_getDouble(list, i));
+    }
+    celix_arrayList_destroy(list);
+}
@@ -0,0 +1,133 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <deque>
+#include <random>
+
+#include "celix_deque.h"
+
+class DequeTestSuite : public ::testing::Test {};
+
+TEST_F(DequeTestSuite, CreateDestroyTest) {
+    EXPECT_EQ(nullptr, celix_deque_create(0));
+
+    auto* deque = celix_deque_create(sizeof(int));
+    ASSERT_NE(nullptr, deque);
+    EXPECT_TRUE(celix_deque_isEmpty(deque));
+    EXPECT_EQ(nullptr, celix_deque_front(deque));
+    EXPECT_EQ(nullptr, celix_deque_back(deque));
+    EXPECT_FALSE(celix_deque_popFront(deque, nullptr));
+    EXPECT_FALSE(celix_deque_popBack(deque, nullptr));
+    celix_deque_destroy(deque);
+}
+
+TEST_F(DequeTestSuite, FifoTest) {
+    auto* deque = celix_deque_create(sizeof(long));
+    for (long i = 0; i < 1000; ++i) {
+        EXPECT_EQ(CELIX_SUCCESS, celix_deque_pushBack(deque, &i));
+        if (i % 3 == 0) {
+            long out;
+            EXPECT_TRUE(celix_deque_popFront(deque, &out));
+            EXPECT_EQ(i / 3, out);
+        }
+    }
+    EXPECT_EQ(666, celix_deque_size(deque));
+    EXPECT_EQ(334, *(long*)celix_deque_front(deque));
+    EXPECT_EQ(999, *(long*)celix_deque_back(deque));
+    EXPECT_EQ(434, *(long*)celix_deque_get(deque, 100));
+    EXPECT_EQ(nullptr, celix_deque_get(deque, 666));
+
+    celix_deque_clear(deque);
+    EXPECT_TRUE(celix_deque_isEmpty(deque));
+    celix_deque_destroy(deque);
+}
+
+TEST_F(DequeTestSuite, StructElementsTest) {
+    struct element {
+        int id;
+        double value;
+        char name[16];
+    };
+    auto* deque = celix_deque_create(sizeof(element));
+    for (int i = 0; i < 40; ++i) {
+        element e{i, i * 2.0, "element"};
+        celix_deque_pushBack(deque, &e);
+    }
+    element out{};
+    EXPECT_TRUE(celix_deque_popBack(deque, &out));
+    EXPECT_EQ(39, out.id);
+    EXPECT_DOUBLE_EQ(78.0, out.value);
+    EXPECT_STREQ("element", out.name);
+    EXPECT_EQ(20, ((element*)celix_deque_get(deque, 20))->id);
+    celix_deque_destroy(deque);
+}
+
+TEST_F(DequeTestSuite, PointerElementsTest) {
+    auto* deque = celix_deque_createForPointers();
+    int a = 1;
+    int b = 2;
+    celix_deque_pushBackPointer(deque, &a);
+    celix_deque_pushBackPointer(deque, &b);
+    EXPECT_EQ(&a, celix_deque_popFrontPointer(deque));
+    EXPECT_EQ(&b, celix_deque_popFrontPointer(deque));
+    EXPECT_EQ(nullptr, celix_deque_popFrontPointer(deque));
+    celix_deque_destroy(deque);
+}
+
+TEST_F(DequeTestSuite, RandomOperationsTest) {
+    std::mt19937 rng{42};
+    std::uniform_int_distribution<int> op{0, 5};
+    std::deque<int> expected{};
+    auto* deque = celix_deque_create(sizeof(int));
+    for (int i = 0; i < 100000; ++i) {
+        int out = 0;
+        switch (op(rng)) {
+            case 0:
+            case 1:
+                celix_deque_pushBack(deque, &i);
+                expected.push_back(i);
+                break;
+            case 2:
+                celix_deque_pushFront(deque, &i);
+                expected.push_front(i);
+                break;
+            case 3:
+            case 4:
+                ASSERT_EQ(!expected.empty(), celix_deque_popFront(deque, &out));
+                if (!expected.empty()) {
+                    ASSERT_EQ(expected.front(), out);
+                    expected.pop_front();
+                }
+                break;
+            default:
+                ASSERT_EQ(!expected.empty(), celix_deque_popBack(deque, &out));
+                if (!expected.empty()) {
+                    ASSERT_EQ(expected.back(), out);
+                    expected.pop_back();
+                }
+                break;
+        }
+        ASSERT_EQ(expected.size(), celix_deque_size(deque));
+    }
+    for (size_t i = 0; i < expected.size(); ++i) {
+        ASSERT_EQ(expected[i], *(int*)celix_deque_get(deque, i));
+    }
+    celix_deque_destroy(deque);
+}
@@ -0,0 +1,91 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "celix_filter.h"
+#include "celix_properties.h"
+
+class FilterTestSuite : public ::testing::Test {
+public:
+    FilterTestSuite() {
+        celix_properties_set(props, "objectClass", "org.example.Calculator");
+        celix_properties_set(props, "service.version", "1.2.0");
+        celix_properties_set(props, "service.lang", "C");
+        celix_properties_set(props, "name", "abcdef");
+    }
+
+    ~FilterTestSuite() override {
+        celix_properties_destroy(props);
+    }
+
+    FilterTestSuite(FilterTestSuite&&) = delete;
+    FilterTestSuite& operator=(FilterTestSuite&&) = delete;
+    FilterTestSuite(const FilterTestSuite&) = delete;
+    FilterTestSuite& operator=(const FilterTestSuite&) = delete;
+
+    void expectSameMatch(const char* filterStr, bool expected) {
+        celix_filter_t* filter = celix_filter_create(filterStr);
+        ASSERT_TRUE(filter != nullptr) << filterStr;
+        celix_compiled_filter_t* compiled = celix_filter_compile(filter);
+        ASSERT_TRUE(compiled != nullptr) << filterStr;
+        EXPECT_EQ(expected, celix_filter_match(filter, props)) << filterStr;
+        EXPECT_EQ(expected, celix_compiledFilter_match(compiled, props)) << filterStr;
+        EXPECT_EQ(celix_filter_match(filter, nullptr), celix_compiledFilter_match(compiled, nullptr)) << filterStr;
+        celix_compiledFilter_destroy(compiled);
+        celix_filter_destroy(filter);
+    }
+
+    celix_properties_t* props{celix_properties_create()};
+};
+
+TEST_F(FilterTestSuite, CompiledFilterMatchesLikeFilterTest) {
+    expectSameMatch("(objectClass=org.example.Calculator)", true);
+    expectSameMatch("(objectClass=org.example.Shell)", false);
+    expectSameMatch("(missing=value)", false);
+    expectSameMatch("(service.lang=*)", true);
+    expectSameMatch("(missing=*)", false);
+    expectSameMatch("(service.version>=1.0.0)", true);
+    expectSameMatch("(service.version<1.0.0)", false);
+    expectSameMatch("(service.version>1.2.0)", false);
+    expectSameMatch("(service.version<=1.2.0)", true);
+    expectSameMatch("(&(objectClass=org.example.Calculator)(service.version>=1.0.0)(service.version<2.0.0))", true);
+    expectSameMatch("(&(objectClass=org.example.Calculator)(service.version>=2.0.0))", false);
+    expectSameMatch("(|(service.lang=C++)(service.lang=C))", true);
+    expectSameMatch("(|(service.lang=C++)(service.lang=Java))", false);
+    expectSameMatch("(!(service.lang=C))", false);
+    expectSameMatch("(!(missing=*))", true);
+    expectSameMatch("(&(|(missing=*)(name=abc*))(!(|(service.lang=Java)(objectClass=org.example.Shell))))", true);
+    expectSameMatch("(&(!(name=abc*))(objectClass=org.example.Calculator))", false);
+}
+
+TEST_F(FilterTestSuite, CompiledFilterSubstringTest) {
+    expectSameMatch("(name=abc*)", true);
+    expectSameMatch("(name=*def)", true);
+    expectSameMatch("(name=a*f)", true);
+    expectSameMatch("(name=abd*)", false);
+    expectSameMatch("(name=*abd)", false);
+    expectSameMatch("(name=abcdefg*)", false);
+}
+
+TEST_F(FilterTestSuite, CompiledNullFilterTest) {
+    EXPECT_EQ(nullptr, celix_filter_compile(nullptr));
+    EXPECT_TRUE(celix_compiledFilter_match(nullptr, props));
+    celix_compiledFilter_destroy(nullptr); //should be no-op
+}
@@ -0,0 +1,208 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <random>
+#include <unordered_map>
+#include <climits>
+
+#include "celix_long_hash_map.h"
+#include "celix_string_hash_map.h"
+
+class HashMapTestSuite : public ::testing::Test {};
+
+TEST_F(HashMapTestSuite, CreateDestroyTest) {
+    auto* sMap = celix_stringHashMap_create();
+    EXPECT_EQ(0, celix_stringHashMap_size(sMap));
+    celix_stringHashMap_destroy(sMap);
+
+    auto* lMap = celix_longHashMap_create();
+    EXPECT_EQ(0, celix_longHashMap_size(lMap));
+    celix_longHashMap_destroy(lMap);
+}
+
+TEST_F(HashMapTestSuite, PutGetRemoveStringKeysTest) {
+    auto* map = celix_stringHashMap_create();
+    EXPECT_EQ(CELIX_SUCCESS, celix_stringHashMap_put(map, "key1", (void*)0x1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_stringHashMap_putLong(map, "key2", 42));
+    EXPECT_EQ(CELIX_SUCCESS, celix_stringHashMap_putDouble(map, "key3", 2.0));
+    EXPECT_EQ(CELIX_SUCCESS, celix_stringHashMap_putBool(map, "key4", true));
+    EXPECT_EQ(4, celix_stringHashMap_size(map));
+
+    std::string key1{"key1"}; //note different pointer
+    EXPECT_EQ((void*)0x1, celix_stringHashMap_get(map, key1.c_str()));
+    EXPECT_EQ(42, celix_stringHashMap_getLong(map, "key2", 0));
+    EXPECT_EQ(2.0, celix_stringHashMap_getDouble(map, "key3", 0.0));
+    EXPECT_TRUE(celix_stringHashMap_getBool(map, "key4", false));
+    EXPECT_EQ(nullptr, celix_stringHashMap_get(map, "key5"));
+    EXPECT_EQ(-1, celix_stringHashMap_getLong(map, "key5", -1));
+    EXPECT_TRUE(celix_stringHashMap_hasKey(map, "key1"));
+    EXPECT_FALSE(celix_stringHashMap_hasKey(map, "key5"));
+
+    //replace
+    EXPECT_EQ(CELIX_SUCCESS, celix_stringHashMap_putLong(map, "key2", 43));
+    EXPECT_EQ(43, celix_stringHashMap_getLong(map, "key2", 0));
+    EXPECT_EQ(4, celix_stringHashMap_size(map));
+
+    EXPECT_TRUE(celix_stringHashMap_remove(map, "key1"));
+    EXPECT_FALSE(celix_stringHashMap_remove(map, "key1"));
+    EXPECT_FALSE(celix_stringHashMap_hasKey(map, "key1"));
+    EXPECT_EQ(3, celix_stringHashMap_size(map));
+
+    celix_stringHashMap_clear(map);
+    EXPECT_EQ(0, celix_stringHashMap_size(map));
+    EXPECT_FALSE(celix_stringHashMap_hasKey(map, "key2"));
+    celix_stringHashMap_destroy(map);
+}
+
+TEST_F(HashMapTestSuite, PutGetRemoveLongKeysTest) {
+    auto* map = celix_longHashMap_create();
+    EXPECT_EQ(CELIX_SUCCESS, celix_longHashMap_put(map, 1, (void*)0x1));
+    EXPECT_EQ(CELIX_SUCCESS, celix_longHashMap_putLong(map, -2, 42));
+    EXPECT_EQ(CELIX_SUCCESS, celix_longHashMap_putDouble(map, 0, 2.0));
+    EXPECT_EQ(CELIX_SUCCESS, celix_longHashMap_putBool(map, LONG_MAX, true));
+    EXPECT_EQ(4, celix_longHashMap_size(map));
+
+    EXPECT_EQ((void*)0x1, celix_longHashMap_get(map, 1));
+    EXPECT_EQ(42, celix_longHashMap_getLong(map, -2, 0));
+    EXPECT_EQ(2.0, celix_longHashMap_getDouble(map, 0, 0.0));
+    EXPECT_TRUE(celix_longHashMap_getBool(map, LONG_MAX, false));
+    EXPECT_EQ(nullptr, celix_longHashMap_get(map, 5));
+    EXPECT_FALSE(celix_longHashMap_hasKey(map, 5));
+
+    EXPECT_TRUE(celix_longHashMap_remove(map, 1));
+    EXPECT_FALSE(celix_longHashMap_remove(map, 1));
+    EXPECT_EQ(3, celix_longHashMap_size(map));
+    celix_longHashMap_destroy(map);
+}
+
+TEST_F(HashMapTestSuite, ManyEntriesTest) {
+    //note compares the map with a std::unordered_map, including removal and reinsertion to exercise deleted slots
+    std::default_random_engine generator{};
+    std::uniform_int_distribution<long> keyDistribution{0, 50000};
+    std::unordered_map<long, long> reference{};
+    auto* lMap = celix_longHashMap_create();
+    auto* sMap = celix_stringHashMap_create();
+    for (int i = 0; i < 200000; ++i) {
+        long key = keyDistribution(generator);
+        auto strKey = std::to_string(key);
+        if (i % 3 == 0) {
+            EXPECT_EQ(reference.erase(key) == 1, celix_longHashMap_remove(lMap, key));
+            celix_stringHashMap_remove(sMap, strKey.c_str());
+        } else {
+            reference[key] = i;
+            celix_longHashMap_putLong(lMap, key, i);
+            celix_stringHashMap_putLong(sMap, strKey.c_str(), i);
+        }
+    }
+    EXPECT_EQ(reference.size(), celix_longHashMap_size(lMap));
+    EXPECT_EQ(reference.size(), celix_stringHashMap_size(sMap));
+    for (const auto& pair : reference) {
+        EXPECT_EQ(pair.second, celix_longHashMap_getLong(lMap, pair.first, -1));
+        EXPECT_EQ(pair.second, celix_stringHashMap_getLong(sMap, std::to_string(pair.first).c_str(), -1));
+    }
+    celix_longHashMap_destroy(lMap);
+    celix_stringHashMap_destroy(sMap);
+}
+
+TEST_F(HashMapTestSuite, IterateAndRemoveTest) {
+    auto* map = celix_longHashMap_create();
+    for (long i = 0; i < 100; ++i) {
+        celix_longHashMap_putLong(map, i, i * 2);
+    }
+
+    long sum = 0;
+    size_t count = 0;
+    CELIX_LONG_HASH_MAP_ITERATE(map, iter) {
+        EXPECT_EQ(count, iter.index);
+        EXPECT_EQ(iter.key * 2, iter.value.longValue);
+        sum += iter.key;
+        count += 1;
+    }
+    EXPECT_EQ(100, count);
+    EXPECT_EQ(4950, sum);
+
+    //remove all odd keys during iteration
+    auto iter = celix_longHashMap_begin(map);
+    while (!celix_longHashMapIterator_isEnd(&iter)) {
+        if (iter.key % 2 == 1) {
+            celix_longHashMapIterator_remove(&iter);
+        } else {
+            celix_longHashMapIterator_next(&iter);
+        }
+    }
+    EXPECT_EQ(50, celix_longHashMap_size(map));
+    EXPECT_TRUE(celix_longHashMap_hasKey(map, 2));
+    EXPECT_FALSE(celix_longHashMap_hasKey(map, 3));
+    celix_longHashMap_destroy(map);
+
+    auto* sMap = celix_stringHashMap_create();
+    auto sIter = celix_stringHashMap_begin(sMap);
+    EXPECT_TRUE(celix_stringHashMapIterator_isEnd(&sIter));
+    celix_stringHashMap_put(sMap, "key1", nullptr);
+    count = 0;
+    CELIX_STRING_HASH_MAP_ITERATE(sMap, it) {
+        EXPECT_STREQ("key1", it.key);
+        count += 1;
+    }
+    EXPECT_EQ(1, count);
+    celix_stringHashMap_destroy(sMap);
+}
+
+TEST_F(HashMapTestSuite, RemovedCallbacksTest) {
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.simpleRemovedCallback = free;
+    opts.initialCapacity = 100;
+    auto* map = celix_stringHashMap_createWithOptions(&opts);
+    celix_stringHashMap_put(map, "key1", strdup("value1"));
+    celix_stringHashMap_put(map, "key1", strdup("value2")); //note replaced value should be freed
+    celix_stringHashMap_put(map, "key2", strdup("value3"));
+    celix_stringHashMap_remove(map, "key2");
+    celix_stringHashMap_put(map, "key3", strdup("value4"));
+    celix_stringHashMap_destroy(map); //note remaining values should be freed
+
+    int count = 0;
+    celix_long_hash_map_create_options_t lOpts = CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS;
+    lOpts.removedCallbackData = &count;
+    lOpts.removedCallback = [](void* data, long key, celix_hash_map_value_t value) {
+        EXPECT_EQ(key, value.longValue);
+        *static_cast<int*>(data) += 1;
+    };
+    auto* lMap = celix_longHashMap_createWithOptions(&lOpts);
+    celix_longHashMap_putLong(lMap, 1, 1);
+    celix_longHashMap_putLong(lMap, 2, 2);
+    celix_longHashMap_putLong(lMap, 3, 3);
+    celix_longHashMap_remove(lMap, 1);
+    EXPECT_EQ(1, count);
+    celix_longHashMap_clear(lMap);
+    EXPECT_EQ(3, count);
+    celix_longHashMap_destroy(lMap);
+}
+
+TEST_F(HashMapTestSuite, StoreKeysWeaklyTest) {
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    opts.storeKeysWeakly = true;
+    auto* map = celix_stringHashMap_createWithOptions(&opts);
+    const char* key = "key1";
+    celix_stringHashMap_put(map, key, nullptr);
+    auto iter = celix_stringHashMap_begin(map);
+    EXPECT_EQ(key, iter.key); //note same pointer, key is not copied
+    celix_stringHashMap_destroy(map);
+}
@@ -0,0 +1,210 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+#include <set>
+#include <cstring>
+
+#include "celix_properties.h"
+
+class PropertiesTestSuite : public ::testing::Test {};
+
+TEST_F(PropertiesTestSuite, SetGetUnsetTest) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, "key1", "value1");
+    celix_properties_set(props, "key2", "value2");
+    EXPECT_EQ(2, celix_properties_size(props));
+    EXPECT_STREQ("value1", celix_properties_get(props, "key1", nullptr));
+    EXPECT_STREQ("value2", celix_properties_get(props, "key2", nullptr));
+    EXPECT_STREQ("default", celix_properties_get(props, "key3", "default"));
+
+    celix_properties_set(props, "key1", "a value which is longer than the original value");
+    EXPECT_STREQ("a value which is longer than the original value", celix_properties_get(props, "key1", nullptr));
+    celix_properties_set(props, "key1", "short");
+    EXPECT_STREQ("short", celix_properties_get(props, "key1", nullptr));
+    EXPECT_EQ(2, celix_properties_size(props));
+
+    celix_properties_unset(props, "key1");
+    EXPECT_EQ(1, celix_properties_size(props));
+    EXPECT_EQ(nullptr, celix_properties_get(props, "key1", nullptr));
+    celix_properties_set(props, "key1", "value1");
+    EXPECT_STREQ("value1", celix_properties_get(props, "key1", nullptr));
+    EXPECT_EQ(2, celix_properties_size(props));
+
+    celix_properties_setWithoutCopy(props, strdup("key3"), strdup("value3"));
+    EXPECT_STREQ("value3", celix_properties_get(props, "key3", nullptr));
+    celix_properties_setWithoutCopy(props, strdup("key3"), strdup("value4"));
+    EXPECT_STREQ("value4", celix_properties_get(props, "key3", nullptr));
+
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, ValueStaysValidWhenOtherKeysChangeTest) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, "key", "value");
+    const char* val = celix_properties_get(props, "key", nullptr);
+    for (int i = 0; i < 1000; ++i) {
+        auto k = std::string{"key"} + std::to_string(i);
+        celix_properties_set(props, k.c_str(), k.c_str());
+        if (i % 3 == 0) {
+            celix_properties_unset(props, k.c_str());
+        }
+    }
+    EXPECT_STREQ("value", val);
+    EXPECT_EQ(val, celix_properties_get(props, "key", nullptr));
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, ArenaStorageIsReusedTest) {
+    auto* props = celix_properties_create();
+    std::string longKey(100, 'k');
+    std::set<const char*> storage{};
+    for (int i = 0; i < 1000; ++i) {
+        //updates to values which do not fit the current value storage
+        celix_properties_set(props, "key", i % 2 == 0 ? "a" : "a value which does not fit in the storage of 'a'");
+        storage.insert(celix_properties_get(props, "key", nullptr));
+
+        //removed and re-added keys
+        auto k = std::string{"key"} + std::to_string(i);
+        celix_properties_set(props, k.c_str(), "value");
+        storage.insert(celix_properties_get(props, k.c_str(), nullptr));
+        celix_properties_unset(props, k.c_str());
+        celix_properties_set(props, longKey.c_str(), k.c_str());
+        celix_properties_unset(props, longKey.c_str());
+    }
+    EXPECT_LT(storage.size(), 10);
+    EXPECT_EQ(1, celix_properties_size(props));
+    EXPECT_STREQ("a value which does not fit in the storage of 'a'", celix_properties_get(props, "key", nullptr));
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, ManyEntriesTest) {
+    auto* props = celix_properties_create();
+    std::string longValue(1024, 'x');
+    for (int i = 0; i < 1000; ++i) {
+        auto k = std::string{"key"} + std::to_string(i);
+        celix_properties_set(props, k.c_str(), i % 10 == 0 ? longValue.c_str() : k.c_str());
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        auto k = std::string{"key"} + std::to_string(i);
+        celix_properties_unset(props, k.c_str());
+    }
+    EXPECT_EQ(500, celix_properties_size(props));
+
+    for (int i = 0; i < 1000; ++i) {
+        auto k = std::string{"key"} + std::to_string(i);
+        const char* val = celix_properties_get(props, k.c_str(), nullptr);
+        if (i % 2 == 0) {
+            EXPECT_EQ(nullptr, val);
+        } else {
+            EXPECT_STREQ(k.c_str(), val);
+        }
+    }
+
+    std::set<std::string> keys{};
+    const char* key;
+    CELIX_PROPERTIES_FOR_EACH(props, key) {
+        keys.insert(key);
+    }
+    EXPECT_EQ(500, keys.size());
+    celix_properties_destroy(props);
+}
+
+TEST_F(PropertiesTestSuite, CopyTest) {
+    auto* props = celix_properties_create();
+    std::string longValue(1024, 'x');
+    for (int i = 0; i < 100; ++i) {
+        auto k = std::string{"key"} + std::to_string(i);
+        celix_properties_set(props, k.c_str(), i % 10 == 0 ? longValue.c_str() : k.c_str());
+    }
+    celix_properties_unset(props, "key1");
+    celix_properties_set(props, "key2", nullptr);
+
+    auto* copy = celix_properties_copy(props);
+    celix_properties_destroy(props);
+
+    EXPECT_EQ(99, celix_properties_size(copy));
+    EXPECT_EQ(nullptr, celix_properties_get(copy, "key1", nullptr));
+    EXPECT_EQ(nullptr, celix_properties_get(copy, "key2", nullptr));
+    EXPECT_STREQ(longValue.c_str(), celix_properties_get(copy, "key10", nullptr));
+    EXPECT_STREQ("key99", celix_properties_get(copy, "key99", nullptr));
+
+    //copy must still be usable as normal properties
+    celix_properties_set(copy, "key99", "a updated value which is longer");
+    celix_properties_set(copy, "key100", "value100");
+    EXPECT_STREQ("a updated value which is longer", celix_properties_get(copy, "key99", nullptr));
+    EXPECT_STREQ("value100", celix_properties_get(copy, "key100", nullptr));
+    celix_properties_destroy(copy);
+
+    auto* emptyCopy = celix_properties_copy(nullptr);
+    EXPECT_EQ(0, celix_properties_size(emptyCopy));
+    celix_properties_destroy(emptyCopy);
+}
+
+TEST_F(PropertiesTestSuite, TypedValuesTest) {
+    auto* props = celix_properties_create();
+    celix_properties_set(props, "long", "42");
+    celix_properties_set(props, "double", "3.5");
+    celix_properties_set(props, "bool", "true");
+    celix_properties_set(props, "version", "1.2.3.qualifier");
+    celix_properties_set(props, "invalid", "not a number");
+
+    //note calling twice, so that the second call uses the cached value
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_EQ(42, celix_properties_getAsLong(props, "long", -1));
+        EXPECT_DOUBLE_EQ(3.5, celix_properties_getAsDouble(props, "double", -1.0));
+        EXPECT_TRUE(celix_properties_getAsBool(props, "bool", false));
+        EXPECT_EQ(-1, celix_properties_getAsLong(props, "invalid", -1));
+        EXPECT_FALSE(celix_properties_getAsBool(props, "invalid", false));
+        EXPECT_EQ(-1, celix_properties_getAsLong(props, "missing", -1));
+    }
+
+    //typed value of a different type than the cached type
+    EXPECT_DOUBLE_EQ(42.0, celix_properties_getAsDouble(props, "long", -1.0));
+    EXPECT_EQ(3, celix_properties_getAsLong(props, "double", -1));
+
+    const celix_version_t* version = celix_properties_getAsVersion(props, "version", nullptr);
+    ASSERT_TRUE(version != nullptr);
+    EXPECT_EQ(version, celix_properties_getAsVersion(props, "version", nullptr));
+    EXPECT_EQ(1, celix_version_getMajor(version));
+    EXPECT_EQ(2, celix_version_getMinor(version));
+    EXPECT_EQ(3, celix_version_getMicro(version));
+    EXPECT_STREQ("qualifier", celix_version_getQualifier(version));
+    EXPECT_EQ(nullptr, celix_properties_getAsVersion(props, "invalid", nullptr));
+
+    //update invalidates the cached values
+    celix_properties_set(props, "long", "43");
+    EXPECT_EQ(43, celix_properties_getAsLong(props, "long", -1));
+    celix_properties_set(props, "bool", "false");
+    EXPECT_TRUE(!celix_properties_getAsBool(props, "bool", true));
+    celix_properties_set(props, "version", "2.0.0");
+    EXPECT_EQ(2, celix_version_getMajor(celix_properties_getAsVersion(props, "version", nullptr)));
+    celix_properties_setLong(props, "long", 44);
+    EXPECT_EQ(44, celix_properties_getAsLong(props, "long", -1));
+    celix_properties_unset(props, "long");
+    EXPECT_EQ(-1, celix_properties_getAsLong(props, "long", -1));
+
+    //copies do not share cached versions
+    auto* copy = celix_properties_copy(props);
+    celix_properties_destroy(props);
+    EXPECT_EQ(2, celix_version_getMajor(celix_properties_getAsVersion(copy, "version", nullptr)));
+    EXPECT_DOUBLE_EQ(3.5, celix_properties_getAsDouble(copy, "double", -1.0));
+    celix_properties_destroy(copy);
+}
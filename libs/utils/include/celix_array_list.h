@@ -43,6 +43,23 @@ typedef union celix_array_list_entry {
 
 typedef struct celix_array_list celix_array_list_t;
 
+/**
+ * @brief The number of entries an array list can hold before it needs a separate heap allocation for its entries.
+ */
+#define CELIX_ARRAY_LIST_INLINE_CAPACITY 8
+
+/**
+ * @brief Storage for an array list which is not allocated on the heap, e.g. a list on the stack or embedded in a
+ * struct.
+ *
+ * The content of the storage is private. Use celix_arrayList_init to initialize the storage and only use the returned
+ * list pointer to access the list.
+ */
+typedef struct celix_array_list_storage {
+    void* _private[6];
+    celix_array_list_entry_t _inlineEntries[CELIX_ARRAY_LIST_INLINE_CAPACITY];
+} celix_array_list_storage_t;
+
 typedef bool (*celix_arrayList_equals_fp)(celix_array_list_entry_t, celix_array_list_entry_t);
 
 typedef int (*celix_arrayList_sort_fp)(const void *, const void *);
@@ -52,6 +69,27 @@ celix_array_list_t* celix_arrayList_create();
 
 celix_array_list_t* celix_arrayList_createWithEquals(celix_arrayList_equals_fp equals);
 
+/**
+ * @brief Initializes an array list in the provided storage.
+ *
+ * As long as the list contains no more than CELIX_ARRAY_LIST_INLINE_CAPACITY entries, the list does not allocate
+ * any memory. The list must be released with celix_arrayList_destroy, which will not free the storage itself.
+ *
+ * @param storage The storage to use for the list. Must outlive the returned list.
+ * @return The initialized list.
+ */
+celix_array_list_t* celix_arrayList_init(celix_array_list_storage_t* storage);
+
+/**
+ * @brief Initializes an array list with a custom equals in the provided storage.
+ * @see celix_arrayList_init
+ */
+celix_array_list_t* celix_arrayList_initWithEquals(celix_array_list_storage_t* storage, celix_arrayList_equals_fp equals);
+
+/**
+ * @brief Destroys the array list. For a list created with celix_arrayList_init, only the (possible) heap allocated
+ * entries are freed.
+ */
 void celix_arrayList_destroy(celix_array_list_t *list);
 
 int celix_arrayList_size(const celix_array_list_t *list);
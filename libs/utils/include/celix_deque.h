@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_DEQUE_H_
+#define CELIX_DEQUE_H_
+
+#include <stddef.h>
+
+#include "celixbool.h"
+#include "celix_errno.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A double-ended queue of fixed size elements.
+ *
+ * The elements are copied into a ring buffer, so pushing and popping at both ends is O(1) and (once the buffer has
+ * grown to its working size) does not allocate. This makes the deque a better fit for FIFO usage than a
+ * celix_array_list_t, where removing the first entry moves all other entries.
+ *
+ * The deque is not thread safe.
+ */
+typedef struct celix_deque celix_deque_t;
+
+/**
+ * @brief Creates a new deque for elements of the given size.
+ * @param elementSize The size of a single element in bytes, e.g. sizeof(my_struct_t). Must be > 0.
+ * @return The new deque or NULL if elementSize is 0 or memory could not be allocated.
+ */
+celix_deque_t* celix_deque_create(size_t elementSize);
+
+/**
+ * @brief Creates a new deque for pointer elements; convenience for celix_deque_create(sizeof(void*)).
+ */
+celix_deque_t* celix_deque_createForPointers();
+
+/**
+ * @brief Destroys the deque. Pointer elements are not freed.
+ */
+void celix_deque_destroy(celix_deque_t* deque);
+
+/**
+ * @brief Returns the number of elements in the deque.
+ */
+size_t celix_deque_size(const celix_deque_t* deque);
+
+/**
+ * @brief Returns whether the deque is empty.
+ */
+bool celix_deque_isEmpty(const celix_deque_t* deque);
+
+/**
+ * @brief Copies the element to the back of the deque.
+ * @return CELIX_SUCCESS or CELIX_ENOMEM if the deque needed to grow and memory could not be allocated.
+ */
+celix_status_t celix_deque_pushBack(celix_deque_t* deque, const void* element);
+
+/**
+ * @brief Copies the element to the front of the deque.
+ * @return CELIX_SUCCESS or CELIX_ENOMEM if the deque needed to grow and memory could not be allocated.
+ */
+celix_status_t celix_deque_pushFront(celix_deque_t* deque, const void* element);
+
+/**
+ * @brief Removes the first element of the deque.
+ * @param out If not NULL, the removed element is copied to out.
+ * @return False if the deque is empty.
+ */
+bool celix_deque_popFront(celix_deque_t* deque, void* out);
+
+/**
+ * @brief Removes the last element of the deque.
+ * @param out If not NULL, the removed element is copied to out.
+ * @return False if the deque is empty.
+ */
+bool celix_deque_popBack(celix_deque_t* deque, void* out);
+
+/**
+ * @brief Returns a pointer to the element at the given index, counted from the front of the deque.
+ *
+ * The pointer is valid until the deque is modified.
+ *
+ * @return The pointer to the element or NULL if the index is out of range.
+ */
+void* celix_deque_get(const celix_deque_t* deque, size_t index);
+
+/**
+ * @brief Returns a pointer to the first element or NULL if the deque is empty.
+ */
+void* celix_deque_front(const celix_deque_t* deque);
+
+/**
+ * @brief Returns a pointer to the last element or NULL if the deque is empty.
+ */
+void* celix_deque_back(const celix_deque_t* deque);
+
+/**
+ * @brief Pushes a pointer to the back of a deque created with celix_deque_createForPointers.
+ */
+celix_status_t celix_deque_pushBackPointer(celix_deque_t* deque, void* ptr);
+
+/**
+ * @brief Pops a pointer from the front of a deque created with celix_deque_createForPointers.
+ * @return The pointer or NULL if the deque is empty.
+ */
+void* celix_deque_popFrontPointer(celix_deque_t* deque);
+
+/**
+ * @brief Removes all elements from the deque. The allocated buffer is kept.
+ */
+void celix_deque_clear(celix_deque_t* deque);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_DEQUE_H_ */
@@ -73,6 +73,27 @@ const char* celix_filter_getFilterString(const celix_filter_t *filter);
  */
 const char* celix_filter_findAttribute(const celix_filter_t *filter, const char *attribute);
 
+/**
+ * A filter compiled to a flat instruction array with pre-hashed attribute keys, for repeated matching.
+ */
+typedef struct celix_compiled_filter celix_compiled_filter_t;
+
+/**
+ * Compile the filter for faster matching.
+ * The compiled filter refers to the attributes and values of the provided filter and as result the
+ * compiled filter should be destroyed before the filter is destroyed.
+ * @return The compiled filter or NULL if filter is NULL.
+ */
+celix_compiled_filter_t* celix_filter_compile(const celix_filter_t *filter);
+
+void celix_compiledFilter_destroy(celix_compiled_filter_t *compiled);
+
+/**
+ * Match the compiled filter against the properties. Same result as celix_filter_match on the source filter.
+ * Matching on a NULL compiled filter is always true.
+ */
+bool celix_compiledFilter_match(const celix_compiled_filter_t *compiled, const celix_properties_t *props);
+
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,182 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef CELIX_LONG_HASH_MAP_H_
+#define CELIX_LONG_HASH_MAP_H_
+
+#include <stddef.h>
+
+#include "celixbool.h"
+#include "celix_errno.h"
+#include "celix_hash_map_value.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief A hash map with long keys.
+ *
+ * The map uses open addressing: the entries are stored inline in a single array (no allocation per entry) and are
+ * probed in groups of 8 using a control byte per entry.
+ *
+ * The map is not thread safe.
+ */
+typedef struct celix_long_hash_map celix_long_hash_map_t;
+
+/**
+ * @brief Iterator for a celix_long_hash_map_t.
+ *
+ * Entries can be removed during iteration using celix_longHashMapIterator_remove, but adding entries during
+ * iteration invalidates the iterator.
+ */
+typedef struct celix_long_hash_map_iterator {
+    size_t index; //iteration index, starting at 0
+    long key;
+    celix_hash_map_value_t value;
+
+    void* _internal[2]; //internal data, do not use
+} celix_long_hash_map_iterator_t;
+
+/**
+ * @brief Optional create options when creating a celix_long_hash_map_t.
+ */
+typedef struct celix_long_hash_map_create_options {
+    /**
+     * @brief A simple removed callback, which if provided will be called if a value is removed from the hash map.
+     * The removed value is provided as pointer, e.g. to free the value.
+     *
+     * @note Also called if the hash map is cleared or destroyed and if a value is replaced.
+     */
+    void (*simpleRemovedCallback)(void* value);
+
+    /**
+     * @brief Optional callback data, which will be provided to the removedCallback callback.
+     */
+    void* removedCallbackData;
+
+    /**
+     * @brief A removed callback, which if provided will be called if a entry is removed from the hash map.
+     *
+     * @note Also called if the hash map is cleared or destroyed and if a value is replaced.
+     */
+    void (*removedCallback)(void* data, long removedKey, celix_hash_map_value_t removedValue);
+
+    /**
+     * @brief The initial number of entries the hash map can contain without growing. Default is 0 (use the default
+     * capacity).
+     */
+    unsigned int initialCapacity;
+} celix_long_hash_map_create_options_t;
+
+#define CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS {NULL, NULL, NULL, 0}
+
+/**
+ * @brief Creates a new empty long hash map.
+ */
+celix_long_hash_map_t* celix_longHashMap_create();
+
+/**
+ * @brief Creates a new empty long hash map using the provided create options.
+ */
+celix_long_hash_map_t* celix_longHashMap_createWithOptions(const celix_long_hash_map_create_options_t* opts);
+
+/**
+ * @brief Destroys the hash map. If configured, the removed callbacks are called for all entries.
+ */
+void celix_longHashMap_destroy(celix_long_hash_map_t* map);
+
+/**
+ * @brief Returns the number of entries in the hash map.
+ */
+size_t celix_longHashMap_size(const celix_long_hash_map_t* map);
+
+/**
+ * @brief Adds or replaces the value for the provided key.
+ * If a value is replaced, the removed callbacks are called for the replaced value.
+ *
+ * @return CELIX_SUCCESS or CELIX_ENOMEM if the hash map could not grow.
+ */
+celix_status_t celix_longHashMap_put(celix_long_hash_map_t* map, long key, void* value);
+
+//more of the same for the different value types
+celix_status_t celix_longHashMap_putLong(celix_long_hash_map_t* map, long key, long value);
+celix_status_t celix_longHashMap_putDouble(celix_long_hash_map_t* map, long key, double value);
+celix_status_t celix_longHashMap_putBool(celix_long_hash_map_t* map, long key, bool value);
+
+/**
+ * @brief Returns the value for the provided key or NULL if the key is not present.
+ */
+void* celix_longHashMap_get(const celix_long_hash_map_t* map, long key);
+
+//more of the same for the different value types, returning the default value if the key is not present
+long celix_longHashMap_getLong(const celix_long_hash_map_t* map, long key, long defaultValue);
+double celix_longHashMap_getDouble(const celix_long_hash_map_t* map, long key, double defaultValue);
+bool celix_longHashMap_getBool(const celix_long_hash_map_t* map, long key, bool defaultValue);
+
+/**
+ * @brief Returns true if the hash map contains the provided key.
+ */
+bool celix_longHashMap_hasKey(const celix_long_hash_map_t* map, long key);
+
+/**
+ * @brief Removes the entry for the provided key. If configured, the removed callbacks are called.
+ *
+ * @return True if an entry was removed.
+ */
+bool celix_longHashMap_remove(celix_long_hash_map_t* map, long key);
+
+/**
+ * @brief Removes all entries of the hash map. If configured, the removed callbacks are called for all entries.
+ */
+void celix_longHashMap_clear(celix_long_hash_map_t* map);
+
+/**
+ * @brief Returns an iterator pointing to the first entry of the hash map.
+ * If the hash map is empty, the iterator is an end iterator.
+ */
+celix_long_hash_map_iterator_t celix_longHashMap_begin(const celix_long_hash_map_t* map);
+
+/**
+ * @brief Returns true if the iterator is past the last entry of the hash map.
+ */
+bool celix_longHashMapIterator_isEnd(const celix_long_hash_map_iterator_t* iter);
+
+/**
+ * @brief Moves the iterator to the next entry of the hash map.
+ */
+void celix_longHashMapIterator_next(celix_long_hash_map_iterator_t* iter);
+
+/**
+ * @brief Removes the entry the iterator points to and moves the iterator to the next entry.
+ * If configured, the removed callbacks are called.
+ */
+void celix_longHashMapIterator_remove(celix_long_hash_map_iterator_t* iter);
+
+/**
+ * @brief Iterates over the entries of a long hash map, with iterName as a celix_long_hash_map_iterator_t.
+ */
+#define CELIX_LONG_HASH_MAP_ITERATE(map, iterName) \
+    for (celix_long_hash_map_iterator_t iterName = celix_longHashMap_begin(map); !celix_longHashMapIterator_isEnd(&(iterName)); celix_longHashMapIterator_next(&(iterName)))
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CELIX_LONG_HASH_MAP_H_ */
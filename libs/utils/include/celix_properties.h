@@ -22,6 +22,7 @@
 #include "hash_map.h"
 #include "exports.h"
 #include "celix_errno.h"
+#include "celix_version.h"
 
 #ifndef CELIX_PROPERTIES_H_
 #define CELIX_PROPERTIES_H_
@@ -30,8 +31,13 @@
 extern "C" {
 #endif
 
-typedef hash_map_t celix_properties_t;
-typedef hash_map_iterator_t celix_properties_iterator_t;
+typedef struct celix_properties celix_properties_t;
+
+typedef struct celix_properties_iterator {
+    //private data
+    const celix_properties_t *props;
+    unsigned int index;
+} celix_properties_iterator_t;
 
 
 /**********************************************************************************************************************
@@ -62,6 +68,7 @@ void celix_properties_unset(celix_properties_t *properties, const char *key);
 
 celix_properties_t* celix_properties_copy(const celix_properties_t *properties);
 
+//note the typed getters cache the parsed value until the property is updated or removed
 long celix_properties_getAsLong(const celix_properties_t *props, const char *key, long defaultValue);
 void celix_properties_setLong(celix_properties_t *props, const char *key, long value);
 
@@ -72,6 +79,13 @@ void celix_properties_setBool(celix_properties_t *props, const char *key, bool v
 void celix_properties_setDouble(celix_properties_t *props, const char *key, double val);
 double celix_properties_getAsDouble(const celix_properties_t *props, const char *key, double defaultValue);
 
+/**
+ * Get the property value as version.
+ * The parsed version is owned by the properties and is valid until the property is updated or removed.
+ * @return The version or the defaultValue if the property is not present or not a valid version.
+ */
+const celix_version_t* celix_properties_getAsVersion(const celix_properties_t *props, const char *key, const celix_version_t *defaultValue);
+
 int celix_properties_size(const celix_properties_t *properties);
 
 celix_properties_iterator_t celix_propertiesIterator_construct(const celix_properties_t *properties);
@@ -79,7 +93,7 @@ bool celix_propertiesIterator_hasNext(celix_properties_iterator_t *iter);
 const char* celix_propertiesIterator_nextKey(celix_properties_iterator_t *iter);
 
 #define CELIX_PROPERTIES_FOR_EACH(props, key) \
-    for(hash_map_iterator_t iter = celix_propertiesIterator_construct(props); \
+    for(celix_properties_iterator_t iter = celix_propertiesIterator_construct(props); \
         celix_propertiesIterator_hasNext(&iter), (key) = celix_propertiesIterator_nextKey(&iter);)
 
 
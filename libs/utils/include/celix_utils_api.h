@@ -25,6 +25,9 @@
 #include "celix_threads.h"
 #include "array_list.h"
 #include "hash_map.h"
+#include "celix_long_hash_map.h"
+#include "celix_string_hash_map.h"
+#include "celix_deque.h"
 #include "properties.h"
 #include "utils.h"
 #include "celix_utils.h"
@@ -89,11 +89,27 @@ TEST(array_list, trimToSize) {
 
     arrayList_add(list, entry);
     LONGS_EQUAL(1, list->size);
-    LONGS_EQUAL(10, list->capacity);
+    LONGS_EQUAL(CELIX_ARRAY_LIST_INLINE_CAPACITY, list->capacity);
 
+    //note inline entries are never trimmed
     arrayList_trimToSize(list);
     LONGS_EQUAL(1, list->size);
-    LONGS_EQUAL(1, list->capacity);
+    LONGS_EQUAL(CELIX_ARRAY_LIST_INLINE_CAPACITY, list->capacity);
+
+    for (int i = 0; i < 19; ++i) {
+        arrayList_add(list, entry);
+    }
+    LONGS_EQUAL(20, list->size);
+    arrayList_trimToSize(list);
+    LONGS_EQUAL(20, list->size);
+    LONGS_EQUAL(20, list->capacity);
+
+    arrayList_clear(list);
+    arrayList_add(list, entry);
+    arrayList_trimToSize(list);
+    LONGS_EQUAL(1, list->size);
+    LONGS_EQUAL(CELIX_ARRAY_LIST_INLINE_CAPACITY, list->capacity);
+    POINTERS_EQUAL(entry, arrayList_get(list, 0));
 
     free(entry);
 }
@@ -102,14 +118,14 @@ TEST(array_list, ensureCapacity) {
     int i;
     arrayList_clear(list);
 
-    LONGS_EQUAL(10, list->capacity);
+    LONGS_EQUAL(CELIX_ARRAY_LIST_INLINE_CAPACITY, list->capacity);
     LONGS_EQUAL(0, list->size);
 
     for (i = 0; i < 100; i++) {
         char * entry = my_strdup("entry");
         arrayList_add(list, entry);
     }
-    LONGS_EQUAL(133, list->capacity);
+    LONGS_EQUAL(107, list->capacity);
     LONGS_EQUAL(100, list->size);
 
     for (i = 99; i >= 0; i--) {
@@ -121,7 +137,7 @@ TEST(array_list, clone) {
     int i;
     arrayList_clear(list);
 
-    LONGS_EQUAL(10, list->capacity);
+    LONGS_EQUAL(CELIX_ARRAY_LIST_INLINE_CAPACITY, list->capacity);
     LONGS_EQUAL(0, list->size);
 
     for (i = 0; i < 12; i++) {
@@ -131,13 +147,13 @@ TEST(array_list, clone) {
         added = arrayList_add(list, my_strdup(entry));
         CHECK(added);
     }
-    LONGS_EQUAL(16, list->capacity);
+    LONGS_EQUAL(13, list->capacity);
     LONGS_EQUAL(12, list->size);
 
     array_list_pt clone = NULL;
     clone = arrayList_clone(list);
 
-    LONGS_EQUAL(16, clone->capacity);
+    LONGS_EQUAL(13, clone->capacity);
     LONGS_EQUAL(12, clone->size);
 
     unsigned int j;
@@ -36,6 +36,9 @@ static celix_status_t arrayList_elementEquals(const void *a, const void *b, bool
 static bool celix_arrayList_defaultEquals(const celix_array_list_entry_t a, const celix_array_list_entry_t b);
 static bool celix_arrayList_equalsForElement(celix_array_list_t *list, celix_array_list_entry_t a, celix_array_list_entry_t b);
 
+_Static_assert(sizeof(celix_array_list_t) <= sizeof(celix_array_list_storage_t), "celix_array_list_storage_t is too small");
+_Static_assert(_Alignof(celix_array_list_t) <= _Alignof(celix_array_list_storage_t), "celix_array_list_storage_t is not aligned");
+
 
 celix_status_t arrayList_create(array_list_pt *list) {
     return arrayList_createWithEquals(arrayList_elementEquals, list);
@@ -77,11 +80,20 @@ static bool celix_arrayList_equalsForElement(celix_array_list_t *list, celix_arr
 
 void arrayList_trimToSize(array_list_pt list) {
     list->modCount++;
-    size_t oldCapacity = list->capacity;
-    if (list->size < oldCapacity) {
+    if (list->elementData == list->inlineEntries || list->size == list->capacity) {
+        return;
+    }
+    if (list->size <= CELIX_ARRAY_LIST_INLINE_CAPACITY) {
+        memcpy(list->inlineEntries, list->elementData, sizeof(celix_array_list_entry_t) * list->size);
+        free(list->elementData);
+        list->elementData = list->inlineEntries;
+        list->capacity = CELIX_ARRAY_LIST_INLINE_CAPACITY;
+    } else {
         celix_array_list_entry_t * newList = realloc(list->elementData, sizeof(celix_array_list_entry_t) * list->size);
-        list->capacity = list->size;
-        list->elementData = newList;
+        if (newList != NULL) {
+            list->capacity = list->size;
+            list->elementData = newList;
+        }
     }
 }
 
@@ -94,7 +106,14 @@ void arrayList_ensureCapacity(array_list_pt list, int capacity) {
         if (newCapacity < capacity) {
             newCapacity = capacity;
         }
-        newList = realloc(list->elementData, sizeof(celix_array_list_entry_t) * newCapacity);
+        if (list->elementData == list->inlineEntries) {
+            newList = malloc(sizeof(celix_array_list_entry_t) * newCapacity);
+            if (newList != NULL) {
+                memcpy(newList, list->inlineEntries, sizeof(celix_array_list_entry_t) * list->size);
+            }
+        } else {
+            newList = realloc(list->elementData, sizeof(celix_array_list_entry_t) * newCapacity);
+        }
         list->capacity = newCapacity;
         list->elementData = newList;
     }
@@ -195,7 +214,7 @@ int arrayList_addIndex(array_list_pt list, unsigned int index, void * element) {
     }
     arrayList_ensureCapacity(list, (int)list->size+1);
     numMoved = list->size - index;
-    memmove(list->elementData+(index+1), list->elementData+index, sizeof(void *) * numMoved);
+    memmove(list->elementData+(index+1), list->elementData+index, sizeof(celix_array_list_entry_t) * numMoved);
 
     list->elementData[index].voidPtrVal = element;
     list->size++;
@@ -212,7 +231,7 @@ void * arrayList_remove(array_list_pt list, unsigned int index) {
     list->modCount++;
     oldElement = list->elementData[index].voidPtrVal;
     numMoved = list->size - index - 1;
-    memmove(list->elementData+index, list->elementData+index+1, sizeof(void *) * numMoved);
+    memmove(list->elementData+index, list->elementData+index+1, sizeof(celix_array_list_entry_t) * numMoved);
     memset(&list->elementData[--list->size], 0, sizeof(celix_array_list_entry_t));
 
     return oldElement;
@@ -223,7 +242,7 @@ void arrayList_fastRemove(array_list_pt list, unsigned int index) {
     list->modCount++;
 
     numMoved = list->size - index - 1;
-    memmove(list->elementData+index, list->elementData+index+1, sizeof(void *) * numMoved);
+    memmove(list->elementData+index, list->elementData+index+1, sizeof(celix_array_list_entry_t) * numMoved);
     memset(&list->elementData[--list->size], 0, sizeof(celix_array_list_entry_t));
 }
 
@@ -361,21 +380,43 @@ celix_array_list_t* celix_arrayList_create() {
     return celix_arrayList_createWithEquals(celix_arrayList_defaultEquals);
 }
 
+static void celix_arrayList_setup(celix_array_list_t *list, bool heapAllocated, celix_arrayList_equals_fp equals) {
+    list->elementData = list->inlineEntries;
+    list->size = 0;
+    list->capacity = CELIX_ARRAY_LIST_INLINE_CAPACITY;
+    list->modCount = 0;
+    list->heapAllocated = heapAllocated;
+    list->equalsDeprecated = NULL;
+    list->equals = equals;
+}
+
 celix_array_list_t* celix_arrayList_createWithEquals(celix_arrayList_equals_fp equals) {
-    array_list_t *list = calloc(1, sizeof(*list));
+    array_list_t *list = malloc(sizeof(*list));
     if (list != NULL) {
-        list->capacity = 10;
-        list->elementData = malloc(sizeof(celix_array_list_entry_t) * list->capacity);
-        list->equals = equals;
+        celix_arrayList_setup(list, true, equals);
     }
     return list;
 }
 
+celix_array_list_t* celix_arrayList_init(celix_array_list_storage_t* storage) {
+    return celix_arrayList_initWithEquals(storage, celix_arrayList_defaultEquals);
+}
+
+celix_array_list_t* celix_arrayList_initWithEquals(celix_array_list_storage_t* storage, celix_arrayList_equals_fp equals) {
+    celix_array_list_t* list = (celix_array_list_t*)storage;
+    celix_arrayList_setup(list, false, equals);
+    return list;
+}
+
 void celix_arrayList_destroy(celix_array_list_t *list) {
     if (list != NULL) {
         list->size = 0;
-        free(list->elementData);
-        free(list);
+        if (list->elementData != list->inlineEntries) {
+            free(list->elementData);
+        }
+        if (list->heapAllocated) {
+            free(list);
+        }
     }
 }
 
@@ -482,7 +523,7 @@ void celix_arrayList_removeAt(celix_array_list_t *list, int index) {
     if (index >= 0 && index < list->size) {
         list->modCount++;
         size_t numMoved = list->size - index - 1;
-        memmove(list->elementData+index, list->elementData+index+1, sizeof(void *) * numMoved);
+        memmove(list->elementData+index, list->elementData+index+1, sizeof(celix_array_list_entry_t) * numMoved);
         memset(&list->elementData[--list->size], 0, sizeof(celix_array_list_entry_t));
     }
 }
@@ -28,16 +28,20 @@
 #define array_list_t_PRIVATE_H_
 
 #include "array_list.h"
+#include "celix_array_list.h"
 
 struct celix_array_list {
-    celix_array_list_entry_t* elementData;
+    celix_array_list_entry_t* elementData; //points to inlineEntries until the list outgrows the inline capacity
     size_t size;
     size_t capacity;
 
     unsigned int modCount;
+    bool heapAllocated; //false if initialized in a celix_array_list_storage_t
 
     array_list_element_equals_pt equalsDeprecated;
     celix_arrayList_equals_fp  equals;
+
+    celix_array_list_entry_t inlineEntries[CELIX_ARRAY_LIST_INLINE_CAPACITY];
 };
 
 struct celix_array_list_iterator {
@@ -0,0 +1,163 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_deque.h"
+
+#define CELIX_DEQUE_INITIAL_CAPACITY 16
+
+struct celix_deque {
+    char* buffer; //lazy allocated on the first push
+    size_t elementSize;
+    size_t capacity; //power of 2
+    size_t head; //index of the first element
+    size_t size;
+};
+
+static inline char* celix_deque_slot(const celix_deque_t* deque, size_t index) {
+    return deque->buffer + ((deque->head + index) & (deque->capacity - 1)) * deque->elementSize;
+}
+
+celix_deque_t* celix_deque_create(size_t elementSize) {
+    if (elementSize == 0) {
+        return NULL;
+    }
+    celix_deque_t* deque = calloc(1, sizeof(*deque));
+    if (deque != NULL) {
+        deque->elementSize = elementSize;
+    }
+    return deque;
+}
+
+celix_deque_t* celix_deque_createForPointers() {
+    return celix_deque_create(sizeof(void*));
+}
+
+void celix_deque_destroy(celix_deque_t* deque) {
+    if (deque != NULL) {
+        free(deque->buffer);
+        free(deque);
+    }
+}
+
+size_t celix_deque_size(const celix_deque_t* deque) {
+    return deque->size;
+}
+
+bool celix_deque_isEmpty(const celix_deque_t* deque) {
+    return deque->size == 0;
+}
+
+/**
+ * Grows the buffer if full. The elements are copied to the new buffer in order, so the head is 0 afterwards.
+ */
+static celix_status_t celix_deque_ensureSpace(celix_deque_t* deque) {
+    if (deque->size < deque->capacity) {
+        return CELIX_SUCCESS;
+    }
+    size_t newCapacity = deque->capacity == 0 ? CELIX_DEQUE_INITIAL_CAPACITY : deque->capacity * 2;
+    char* newBuffer = malloc(newCapacity * deque->elementSize);
+    if (newBuffer == NULL) {
+        return CELIX_ENOMEM;
+    }
+    if (deque->size > 0) {
+        size_t firstPart = deque->capacity - deque->head;
+        if (firstPart > deque->size) {
+            firstPart = deque->size;
+        }
+        memcpy(newBuffer, deque->buffer + deque->head * deque->elementSize, firstPart * deque->elementSize);
+        memcpy(newBuffer + firstPart * deque->elementSize, deque->buffer, (deque->size - firstPart) * deque->elementSize);
+    }
+    free(deque->buffer);
+    deque->buffer = newBuffer;
+    deque->capacity = newCapacity;
+    deque->head = 0;
+    return CELIX_SUCCESS;
+}
+
+celix_status_t celix_deque_pushBack(celix_deque_t* deque, const void* element) {
+    celix_status_t status = celix_deque_ensureSpace(deque);
+    if (status == CELIX_SUCCESS) {
+        memcpy(celix_deque_slot(deque, deque->size), element, deque->elementSize);
+        deque->size += 1;
+    }
+    return status;
+}
+
+celix_status_t celix_deque_pushFront(celix_deque_t* deque, const void* element) {
+    celix_status_t status = celix_deque_ensureSpace(deque);
+    if (status == CELIX_SUCCESS) {
+        deque->head = (deque->head + deque->capacity - 1) & (deque->capacity - 1);
+        memcpy(deque->buffer + deque->head * deque->elementSize, element, deque->elementSize);
+        deque->size += 1;
+    }
+    return status;
+}
+
+bool celix_deque_popFront(celix_deque_t* deque, void* out) {
+    if (deque->size == 0) {
+        return false;
+    }
+    if (out != NULL) {
+        memcpy(out, celix_deque_slot(deque, 0), deque->elementSize);
+    }
+    deque->head = (deque->head + 1) & (deque->capacity - 1);
+    deque->size -= 1;
+    return true;
+}
+
+bool celix_deque_popBack(celix_deque_t* deque, void* out) {
+    if (deque->size == 0) {
+        return false;
+    }
+    if (out != NULL) {
+        memcpy(out, celix_deque_slot(deque, deque->size - 1), deque->elementSize);
+    }
+    deque->size -= 1;
+    return true;
+}
+
+void* celix_deque_get(const celix_deque_t* deque, size_t index) {
+    return index < deque->size ? celix_deque_slot(deque, index) : NULL;
+}
+
+void* celix_deque_front(const celix_deque_t* deque) {
+    return celix_deque_get(deque, 0);
+}
+
+void* celix_deque_back(const celix_deque_t* deque) {
+    return deque->size > 0 ? celix_deque_get(deque, deque->size - 1) : NULL;
+}
+
+celix_status_t celix_deque_pushBackPointer(celix_deque_t* deque, void* ptr) {
+    return celix_deque_pushBack(deque, &ptr);
+}
+
+void* celix_deque_popFrontPointer(celix_deque_t* deque) {
+    void* ptr = NULL;
+    celix_deque_popFront(deque, &ptr);
+    return ptr;
+}
+
+void celix_deque_clear(celix_deque_t* deque) {
+    deque->head = 0;
+    deque->size = 0;
+}
@@ -0,0 +1,633 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "celix_long_hash_map.h"
+#include "celix_string_hash_map.h"
+#include "celix_utils.h"
+
+/**
+ * Open addressing hash map shared by celix_long_hash_map_t and celix_string_hash_map_t.
+ *
+ * Every slot has a control byte, which is either EMPTY, DELETED or - for a full slot - the 7 lowest bits of the
+ * key hash. The slots are probed in groups of 8 and the 8 control bytes of a group are matched at once (SWAR),
+ * so that the keys only need to be compared for slots with a matching control byte.
+ * A lookup stops at the first group containing an EMPTY slot; removed entries are marked DELETED unless their
+ * group already contains an EMPTY slot.
+ */
+
+#define CELIX_HASH_MAP_GROUP_SIZE 8
+#define CELIX_HASH_MAP_DEFAULT_CAPACITY 16
+#define CELIX_HASH_MAP_CTRL_EMPTY ((uint8_t)0x80)
+#define CELIX_HASH_MAP_CTRL_DELETED ((uint8_t)0xFE)
+#define CELIX_HASH_MAP_LSBS 0x0101010101010101ULL
+#define CELIX_HASH_MAP_MSBS 0x8080808080808080ULL
+#define CELIX_HASH_MAP_NOT_FOUND SIZE_MAX
+
+typedef union celix_hash_map_key {
+    const char* strKey;
+    long longKey;
+} celix_hash_map_key_t;
+
+typedef struct celix_hash_map_entry {
+    celix_hash_map_key_t key;
+    celix_hash_map_value_t value;
+} celix_hash_map_entry_t;
+
+typedef struct celix_hash_map {
+    celix_hash_map_entry_t* entries;
+    uint8_t* ctrl; //note allocated together with the entries
+    size_t capacity; //power of 2 and a multiple of the group size
+    size_t size;
+    size_t growthLeft; //nr of EMPTY slots which can be used before the map needs to be rehashed
+
+    bool stringKeys;
+    bool storeKeysWeakly;
+    void (*simpleRemovedCallback)(void* value);
+    void* removedCallbackData;
+    void (*removedLongEntryCallback)(void* data, long removedKey, celix_hash_map_value_t removedValue);
+    void (*removedStringEntryCallback)(void* data, const char* removedKey, celix_hash_map_value_t removedValue);
+} celix_hash_map_t;
+
+struct celix_long_hash_map {
+    celix_hash_map_t genericMap;
+};
+
+struct celix_string_hash_map {
+    celix_hash_map_t genericMap;
+};
+
+static inline uint64_t celix_hashMap_hashLong(long key) {
+    //fibonacci hashing, the high bits of the product are folded in the low bits used for the control byte
+    uint64_t h = (uint64_t)key * 0x9e3779b97f4a7c15ULL;
+    return h ^ (h >> 32);
+}
+
+static uint64_t celix_hashMap_hashString(const char* str) {
+    //MurmurHash64A, hashes 8 bytes per step
+    const uint64_t m = 0xc6a4a7935bd1e995ULL;
+    const int r = 47;
+    size_t len = strlen(str);
+    uint64_t h = 0x9e3779b97f4a7c15ULL ^ (len * m);
+
+    const unsigned char* data = (const unsigned char*)str;
+    const unsigned char* end = data + (len & ~(size_t)7);
+    while (data != end) {
+        uint64_t k;
+        memcpy(&k, data, sizeof(k));
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+        data += 8;
+    }
+    switch (len & 7) {
+        case 7: h ^= (uint64_t)data[6] << 48; //fall through
+        case 6: h ^= (uint64_t)data[5] << 40; //fall through
+        case 5: h ^= (uint64_t)data[4] << 32; //fall through
+        case 4: h ^= (uint64_t)data[3] << 24; //fall through
+        case 3: h ^= (uint64_t)data[2] << 16; //fall through
+        case 2: h ^= (uint64_t)data[1] << 8; //fall through
+        case 1: h ^= (uint64_t)data[0];
+                h *= m;
+                break;
+        default:
+            break;
+    }
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+static inline uint64_t celix_hashMap_hash(bool stringKeys, celix_hash_map_key_t key) {
+    return stringKeys ? celix_hashMap_hashString(key.strKey) : celix_hashMap_hashLong(key.longKey);
+}
+
+static inline bool celix_hashMap_keyEquals(bool stringKeys, celix_hash_map_key_t a, celix_hash_map_key_t b) {
+    if (stringKeys) {
+        return a.strKey == b.strKey || strcmp(a.strKey, b.strKey) == 0;
+    }
+    return a.longKey == b.longKey;
+}
+
+static inline uint8_t celix_hashMap_h2(uint64_t hash) {
+    return (uint8_t)(hash & 0x7F);
+}
+
+static inline uint64_t celix_hashMap_loadGroup(const celix_hash_map_t* map, size_t group) {
+    uint64_t ctrl;
+    memcpy(&ctrl, map->ctrl + group * CELIX_HASH_MAP_GROUP_SIZE, sizeof(ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    ctrl = __builtin_bswap64(ctrl);
+#endif
+    return ctrl;
+}
+
+/**
+ * Returns a bit mask with the msb set of every control byte equal to h2. Can contain false positives.
+ */
+static inline uint64_t celix_hashMap_matchH2(uint64_t ctrl, uint8_t h2) {
+    uint64_t x = ctrl ^ (CELIX_HASH_MAP_LSBS * h2);
+    return (x - CELIX_HASH_MAP_LSBS) & ~x & CELIX_HASH_MAP_MSBS;
+}
+
+static inline uint64_t celix_hashMap_matchEmpty(uint64_t ctrl) {
+    //note EMPTY is 0b10000000 and DELETED is 0b11111110
+    return ctrl & ~(ctrl << 6) & CELIX_HASH_MAP_MSBS;
+}
+
+static inline uint64_t celix_hashMap_matchEmptyOrDeleted(uint64_t ctrl) {
+    return ctrl & CELIX_HASH_MAP_MSBS;
+}
+
+static inline size_t celix_hashMap_firstMatch(uint64_t match) {
+    return (size_t)__builtin_ctzll(match) >> 3;
+}
+
+static size_t celix_hashMap_maxLoad(size_t capacity) {
+    return capacity - capacity / 8;
+}
+
+static bool celix_hashMap_allocate(celix_hash_map_t* map, size_t capacity) {
+    void* mem = malloc(capacity * (sizeof(celix_hash_map_entry_t) + 1));
+    if (mem == NULL) {
+        return false;
+    }
+    map->entries = mem;
+    map->ctrl = (uint8_t*)(map->entries + capacity);
+    memset(map->ctrl, CELIX_HASH_MAP_CTRL_EMPTY, capacity);
+    map->capacity = capacity;
+    map->growthLeft = celix_hashMap_maxLoad(capacity) - map->size;
+    return true;
+}
+
+static void celix_hashMap_init(celix_hash_map_t* map, bool stringKeys, unsigned int initialCapacity) {
+    memset(map, 0, sizeof(*map));
+    map->stringKeys = stringKeys;
+    size_t capacity = CELIX_HASH_MAP_DEFAULT_CAPACITY;
+    while (celix_hashMap_maxLoad(capacity) < initialCapacity) {
+        capacity *= 2;
+    }
+    if (!celix_hashMap_allocate(map, capacity)) {
+        map->capacity = 0;
+    }
+}
+
+/**
+ * Returns the slot index of the key or CELIX_HASH_MAP_NOT_FOUND.
+ * Note stringKeys is provided as a (constant) argument, so that the lookup is specialized for the key type.
+ */
+static inline __attribute__((always_inline)) size_t celix_hashMap_find(const celix_hash_map_t* map, bool stringKeys, celix_hash_map_key_t key, uint64_t hash) {
+    if (map->capacity == 0) {
+        return CELIX_HASH_MAP_NOT_FOUND;
+    }
+    size_t groupMask = map->capacity / CELIX_HASH_MAP_GROUP_SIZE - 1;
+    size_t group = (size_t)(hash >> 7) & groupMask;
+    uint8_t h2 = celix_hashMap_h2(hash);
+    for (size_t step = 1; ; ++step) {
+        uint64_t ctrl = celix_hashMap_loadGroup(map, group);
+        uint64_t match = celix_hashMap_matchH2(ctrl, h2);
+        while (match != 0) {
+            size_t index = group * CELIX_HASH_MAP_GROUP_SIZE + celix_hashMap_firstMatch(match);
+            if (celix_hashMap_keyEquals(stringKeys, map->entries[index].key, key)) {
+                return index;
+            }
+            match &= match - 1;
+        }
+        if (celix_hashMap_matchEmpty(ctrl) != 0) {
+            return CELIX_HASH_MAP_NOT_FOUND;
+        }
+        group = (group + step) & groupMask; //note triangular probing visits all groups
+    }
+}
+
+/**
+ * Returns the first EMPTY or DELETED slot index in the probe sequence of the hash.
+ */
+static size_t celix_hashMap_findInsertSlot(const celix_hash_map_t* map, uint64_t hash) {
+    size_t groupMask = map->capacity / CELIX_HASH_MAP_GROUP_SIZE - 1;
+    size_t group = (size_t)(hash >> 7) & groupMask;
+    for (size_t step = 1; ; ++step) {
+        uint64_t match = celix_hashMap_matchEmptyOrDeleted(celix_hashMap_loadGroup(map, group));
+        if (match != 0) {
+            return group * CELIX_HASH_MAP_GROUP_SIZE + celix_hashMap_firstMatch(match);
+        }
+        group = (group + step) & groupMask;
+    }
+}
+
+static bool celix_hashMap_rehash(celix_hash_map_t* map) {
+    celix_hash_map_entry_t* oldEntries = map->entries;
+    uint8_t* oldCtrl = map->ctrl;
+    size_t oldCapacity = map->capacity;
+
+    //note if the map is mostly filled with DELETED slots, rehash with the same capacity
+    size_t capacity = oldCapacity == 0 ? CELIX_HASH_MAP_DEFAULT_CAPACITY : oldCapacity;
+    if (map->size + 1 > celix_hashMap_maxLoad(capacity) / 2) {
+        capacity *= 2;
+    }
+    if (!celix_hashMap_allocate(map, capacity)) {
+        map->entries = oldEntries;
+        map->ctrl = oldCtrl;
+        return false;
+    }
+    for (size_t i = 0; i < oldCapacity; ++i) {
+        if ((oldCtrl[i] & 0x80) == 0) {
+            uint64_t hash = celix_hashMap_hash(map->stringKeys, oldEntries[i].key);
+            size_t index = celix_hashMap_findInsertSlot(map, hash);
+            map->ctrl[index] = celix_hashMap_h2(hash);
+            map->entries[index] = oldEntries[i];
+        }
+    }
+    free(oldEntries);
+    return true;
+}
+
+static void celix_hashMap_callRemovedCallbacks(celix_hash_map_t* map, celix_hash_map_key_t key, celix_hash_map_value_t value) {
+    if (map->simpleRemovedCallback != NULL) {
+        map->simpleRemovedCallback(value.ptrValue);
+    }
+    if (map->removedLongEntryCallback != NULL) {
+        map->removedLongEntryCallback(map->removedCallbackData, key.longKey, value);
+    } else if (map->removedStringEntryCallback != NULL) {
+        map->removedStringEntryCallback(map->removedCallbackData, key.strKey, value);
+    }
+}
+
+static void celix_hashMap_destroyEntry(celix_hash_map_t* map, celix_hash_map_entry_t* entry) {
+    celix_hashMap_callRemovedCallbacks(map, entry->key, entry->value);
+    if (map->stringKeys && !map->storeKeysWeakly) {
+        free((char*)entry->key.strKey);
+    }
+}
+
+static inline __attribute__((always_inline)) celix_status_t celix_hashMap_put(celix_hash_map_t* map, bool stringKeys, celix_hash_map_key_t key, celix_hash_map_value_t value) {
+    uint64_t hash = celix_hashMap_hash(stringKeys, key);
+    size_t index = celix_hashMap_find(map, stringKeys, key, hash);
+    if (index != CELIX_HASH_MAP_NOT_FOUND) {
+        celix_hash_map_value_t old = map->entries[index].value;
+        map->entries[index].value = value;
+        celix_hashMap_callRemovedCallbacks(map, map->entries[index].key, old);
+        return CELIX_SUCCESS;
+    }
+
+    if (map->growthLeft == 0 && !celix_hashMap_rehash(map)) {
+        return CELIX_ENOMEM;
+    }
+    if (stringKeys && !map->storeKeysWeakly) {
+        key.strKey = celix_utils_strdup(key.strKey);
+        if (key.strKey == NULL) {
+            return CELIX_ENOMEM;
+        }
+    }
+    index = celix_hashMap_findInsertSlot(map, hash);
+    if (map->ctrl[index] == CELIX_HASH_MAP_CTRL_EMPTY) {
+        map->growthLeft -= 1;
+    }
+    map->ctrl[index] = celix_hashMap_h2(hash);
+    map->entries[index].key = key;
+    map->entries[index].value = value;
+    map->size += 1;
+    return CELIX_SUCCESS;
+}
+
+static void celix_hashMap_removeAt(celix_hash_map_t* map, size_t index) {
+    celix_hash_map_entry_t entry = map->entries[index];
+    size_t group = index / CELIX_HASH_MAP_GROUP_SIZE;
+    if (celix_hashMap_matchEmpty(celix_hashMap_loadGroup(map, group)) != 0) {
+        //note lookups stop at this group anyway, so the slot can be marked EMPTY
+        map->ctrl[index] = CELIX_HASH_MAP_CTRL_EMPTY;
+        map->growthLeft += 1;
+    } else {
+        map->ctrl[index] = CELIX_HASH_MAP_CTRL_DELETED;
+    }
+    map->size -= 1;
+    celix_hashMap_destroyEntry(map, &entry);
+}
+
+static inline bool celix_hashMap_remove(celix_hash_map_t* map, bool stringKeys, celix_hash_map_key_t key) {
+    size_t index = celix_hashMap_find(map, stringKeys, key, celix_hashMap_hash(stringKeys, key));
+    if (index == CELIX_HASH_MAP_NOT_FOUND) {
+        return false;
+    }
+    celix_hashMap_removeAt(map, index);
+    return true;
+}
+
+static inline const celix_hash_map_value_t* celix_hashMap_get(const celix_hash_map_t* map, bool stringKeys, celix_hash_map_key_t key) {
+    size_t index = celix_hashMap_find(map, stringKeys, key, celix_hashMap_hash(stringKeys, key));
+    return index == CELIX_HASH_MAP_NOT_FOUND ? NULL : &map->entries[index].value;
+}
+
+static void celix_hashMap_clear(celix_hash_map_t* map) {
+    for (size_t i = 0; i < map->capacity; ++i) {
+        if ((map->ctrl[i] & 0x80) == 0) {
+            celix_hashMap_destroyEntry(map, &map->entries[i]);
+        }
+    }
+    if (map->capacity > 0) {
+        memset(map->ctrl, CELIX_HASH_MAP_CTRL_EMPTY, map->capacity);
+    }
+    map->size = 0;
+    map->growthLeft = celix_hashMap_maxLoad(map->capacity);
+}
+
+static void celix_hashMap_deinit(celix_hash_map_t* map) {
+    celix_hashMap_clear(map);
+    free(map->entries);
+}
+
+/**
+ * Returns the first full slot index starting at the provided index, or the capacity if there is none.
+ */
+static size_t celix_hashMap_nextFullSlot(const celix_hash_map_t* map, size_t index) {
+    while (index < map->capacity && (map->ctrl[index] & 0x80) != 0) {
+        ++index;
+    }
+    return index;
+}
+
+static celix_hash_map_value_t celix_hashMap_value(void* ptr) {
+    celix_hash_map_value_t value;
+    memset(&value, 0, sizeof(value));
+    value.ptrValue = ptr;
+    return value;
+}
+
+/**********************************************************************************************************************
+ * long hash map
+ **********************************************************************************************************************/
+
+static celix_hash_map_key_t celix_longHashMap_key(long key) {
+    celix_hash_map_key_t k;
+    k.longKey = key;
+    return k;
+}
+
+celix_long_hash_map_t* celix_longHashMap_create() {
+    celix_long_hash_map_create_options_t opts = CELIX_EMPTY_LONG_HASH_MAP_CREATE_OPTIONS;
+    return celix_longHashMap_createWithOptions(&opts);
+}
+
+celix_long_hash_map_t* celix_longHashMap_createWithOptions(const celix_long_hash_map_create_options_t* opts) {
+    celix_long_hash_map_t* map = malloc(sizeof(*map));
+    if (map != NULL) {
+        celix_hashMap_init(&map->genericMap, false, opts->initialCapacity);
+        map->genericMap.simpleRemovedCallback = opts->simpleRemovedCallback;
+        map->genericMap.removedCallbackData = opts->removedCallbackData;
+        map->genericMap.removedLongEntryCallback = opts->removedCallback;
+    }
+    return map;
+}
+
+void celix_longHashMap_destroy(celix_long_hash_map_t* map) {
+    if (map != NULL) {
+        celix_hashMap_deinit(&map->genericMap);
+        free(map);
+    }
+}
+
+size_t celix_longHashMap_size(const celix_long_hash_map_t* map) {
+    return map->genericMap.size;
+}
+
+celix_status_t celix_longHashMap_put(celix_long_hash_map_t* map, long key, void* value) {
+    return celix_hashMap_put(&map->genericMap, false, celix_longHashMap_key(key), celix_hashMap_value(value));
+}
+
+celix_status_t celix_longHashMap_putLong(celix_long_hash_map_t* map, long key, long value) {
+    celix_hash_map_value_t v = celix_hashMap_value(NULL);
+    v.longValue = value;
+    return celix_hashMap_put(&map->genericMap, false, celix_longHashMap_key(key), v);
+}
+
+celix_status_t celix_longHashMap_putDouble(celix_long_hash_map_t* map, long key, double value) {
+    celix_hash_map_value_t v = celix_hashMap_value(NULL);
+    v.doubleValue = value;
+    return celix_hashMap_put(&map->genericMap, false, celix_longHashMap_key(key), v);
+}
+
+celix_status_t celix_longHashMap_putBool(celix_long_hash_map_t* map, long key, bool value) {
+    celix_hash_map_value_t v = celix_hashMap_value(NULL);
+    v.boolValue = value;
+    return celix_hashMap_put(&map->genericMap, false, celix_longHashMap_key(key), v);
+}
+
+void* celix_longHashMap_get(const celix_long_hash_map_t* map, long key) {
+    const celix_hash_map_value_t* value = celix_hashMap_get(&map->genericMap, false, celix_longHashMap_key(key));
+    return value != NULL ? value->ptrValue : NULL;
+}
+
+long celix_longHashMap_getLong(const celix_long_hash_map_t* map, long key, long defaultValue) {
+    const celix_hash_map_value_t* value = celix_hashMap_get(&map->genericMap, false, celix_longHashMap_key(key));
+    return value != NULL ? value->longValue : defaultValue;
+}
+
+double celix_longHashMap_getDouble(const celix_long_hash_map_t* map, long key, double defaultValue) {
+    const celix_hash_map_value_t* value = celix_hashMap_get(&map->genericMap, false, celix_longHashMap_key(key));
+    return value != NULL ? value->doubleValue : defaultValue;
+}
+
+bool celix_longHashMap_getBool(const celix_long_hash_map_t* map, long key, bool defaultValue) {
+    const celix_hash_map_value_t* value = celix_hashMap_get(&map->genericMap, false, celix_longHashMap_key(key));
+    return value != NULL ? value->boolValue : defaultValue;
+}
+
+bool celix_longHashMap_hasKey(const celix_long_hash_map_t* map, long key) {
+    return celix_hashMap_get(&map->genericMap, false, celix_longHashMap_key(key)) != NULL;
+}
+
+bool celix_longHashMap_remove(celix_long_hash_map_t* map, long key) {
+    return celix_hashMap_remove(&map->genericMap, false, celix_longHashMap_key(key));
+}
+
+void celix_longHashMap_clear(celix_long_hash_map_t* map) {
+    celix_hashMap_clear(&map->genericMap);
+}
+
+static void celix_longHashMapIterator_update(celix_long_hash_map_iterator_t* iter, size_t slot) {
+    const celix_hash_map_t* map = iter->_internal[0];
+    iter->_internal[1] = (void*)(uintptr_t)slot;
+    if (slot < map->capacity) {
+        iter->key = map->entries[slot].key.longKey;
+        iter->value = map->entries[slot].value;
+    }
+}
+
+celix_long_hash_map_iterator_t celix_longHashMap_begin(const celix_long_hash_map_t* map) {
+    celix_long_hash_map_iterator_t iter;
+    memset(&iter, 0, sizeof(iter));
+    iter._internal[0] = (void*)&map->genericMap;
+    celix_longHashMapIterator_update(&iter, celix_hashMap_nextFullSlot(&map->genericMap, 0));
+    return iter;
+}
+
+bool celix_longHashMapIterator_isEnd(const celix_long_hash_map_iterator_t* iter) {
+    const celix_hash_map_t* map = iter->_internal[0];
+    return (size_t)(uintptr_t)iter->_internal[1] >= map->capacity;
+}
+
+void celix_longHashMapIterator_next(celix_long_hash_map_iterator_t* iter) {
+    const celix_hash_map_t* map = iter->_internal[0];
+    size_t slot = (size_t)(uintptr_t)iter->_internal[1];
+    iter->index += 1;
+    celix_longHashMapIterator_update(iter, celix_hashMap_nextFullSlot(map, slot + 1));
+}
+
+void celix_longHashMapIterator_remove(celix_long_hash_map_iterator_t* iter) {
+    celix_hash_map_t* map = iter->_internal[0];
+    size_t slot = (size_t)(uintptr_t)iter->_internal[1];
+    celix_hashMap_removeAt(map, slot); //note removing does not move other entries
+    celix_longHashMapIterator_update(iter, celix_hashMap_nextFullSlot(map, slot + 1));
+}
+
+/**********************************************************************************************************************
+ * string hash map
+ **********************************************************************************************************************/
+
+static celix_hash_map_key_t celix_stringHashMap_key(const char* key) {
+    celix_hash_map_key_t k;
+    k.strKey = key;
+    return k;
+}
+
+celix_string_hash_map_t* celix_stringHashMap_create() {
+    celix_string_hash_map_create_options_t opts = CELIX_EMPTY_STRING_HASH_MAP_CREATE_OPTIONS;
+    return celix_stringHashMap_createWithOptions(&opts);
+}
+
+celix_string_hash_map_t* celix_stringHashMap_createWithOptions(const celix_string_hash_map_create_options_t* opts) {
+    celix_string_hash_map_t* map = malloc(sizeof(*map));
+    if (map != NULL) {
+        celix_hashMap_init(&map->genericMap, true, opts->initialCapacity);
+        map->genericMap.storeKeysWeakly = opts->storeKeysWeakly;
+        map->genericMap.simpleRemovedCallback = opts->simpleRemovedCallback;
+        map->genericMap.removedCallbackData = opts->removedCallbackData;
+        map->genericMap.removedStringEntryCallback = opts->removedCallback;
+    }
+    return map;
+}
+
+void celix_stringHashMap_destroy(celix_string_hash_map_t* map) {
+    if (map != NULL) {
+        celix_hashMap_deinit(&map->genericMap);
+        free(map);
+    }
+}
+
+size_t celix_stringHashMap_size(const celix_string_hash_map_t* map) {
+    return map->genericMap.size;
+}
+
+celix_status_t celix_stringHashMap_put(celix_string_hash_map_t* map, const char* key, void* value) {
+    return celix_hashMap_put(&map->genericMap, true, celix_stringHashMap_key(key), celix_hashMap_value(value));
+}
+
+celix_status_t celix_stringHashMap_putLong(celix_string_hash_map_t* map, const char* key, long value) {
+    celix_hash_map_value_t v = celix_hashMap_value(NULL);
+    v.longValue = value;
+    return celix_hashMap_put(&map->genericMap, true, celix_stringHashMap_key(key), v);
+}
+
+celix_status_t celix_stringHashMap_putDouble(celix_string_hash_map_t* map, const char* key, double value) {
+    celix_hash_map_value_t v = celix_hashMap_value(NULL);
+    v.doubleValue = value;
+    return celix_hashMap_put(&map->genericMap, true, celix_stringHashMap_key(key), v);
+}
+
+celix_status_t celix_stringHashMap_putBool(celix_string_hash_map_t* map, const char* key, bool value) {
+    celix_hash_map_value_t v = celix_hashMap_value(NULL);
+    v.boolValue = value;
+    return celix_hashMap_put(&map->genericMap, true, celix_stringHashMap_key(key), v);
+}
+
+void* celix_stringHashMap_get(const celix_string_hash_map_t* map, const char* key) {
+    const celix_hash_map_value_t* value = celix_hashMap_get(&map->genericMap, true, celix_stringHashMap_key(key));
+    return value != NULL ? value->ptrValue : NULL;
+}
+
+long celix_stringHashMap_getLong(const celix_string_hash_map_t* map, const char* key, long defaultValue) {
+    const celix_hash_map_value_t* value = celix_hashMap_get(&map->genericMap, true, celix_stringHashMap_key(key));
+    return value != NULL ? value->longValue : defaultValue;
+}
+
+double celix_stringHashMap_getDouble(const celix_string_hash_map_t* map, const char* key, double defaultValue) {
+    const celix_hash_map_value_t* value = celix_hashMap_get(&map->genericMap, true, celix_stringHashMap_key(key));
+    return value != NULL ? value->doubleValue : defaultValue;
+}
+
+bool celix_stringHashMap_getBool(const celix_string_hash_map_t* map, const char* key, bool defaultValue) {
+    const celix_hash_map_value_t* value = celix_hashMap_get(&map->genericMap, true, celix_stringHashMap_key(key));
+    return value != NULL ? value->boolValue : defaultValue;
+}
+
+bool celix_stringHashMap_hasKey(const celix_string_hash_map_t* map, const char* key) {
+    return celix_hashMap_get(&map->genericMap, true, celix_stringHashMap_key(key)) != NULL;
+}
+
+bool celix_stringHashMap_remove(celix_string_hash_map_t* map, const char* key) {
+    return celix_hashMap_remove(&map->genericMap, true, celix_stringHashMap_key(key));
+}
+
+void celix_stringHashMap_clear(celix_string_hash_map_t* map) {
+    celix_hashMap_clear(&map->genericMap);
+}
+
+static void celix_stringHashMapIterator_update(celix_string_hash_map_iterator_t* iter, size_t slot) {
+    const celix_hash_map_t* map = iter->_internal[0];
+    iter->_internal[1] = (void*)(uintptr_t)slot;
+    if (slot < map->capacity) {
+        iter->key = map->entries[slot].key.strKey;
+        iter->value = map->entries[slot].value;
+    } else {
+        iter->key = NULL;
+    }
+}
+
+celix_string_hash_map_iterator_t celix_stringHashMap_begin(const celix_string_hash_map_t* map) {
+    celix_string_hash_map_iterator_t iter;
+    memset(&iter, 0, sizeof(iter));
+    iter._internal[0] = (void*)&map->genericMap;
+    celix_stringHashMapIterator_update(&iter, celix_hashMap_nextFullSlot(&map->genericMap, 0));
+    return iter;
+}
+
+bool celix_stringHashMapIterator_isEnd(const celix_string_hash_map_iterator_t* iter) {
+    const celix_hash_map_t* map = iter->_internal[0];
+    return (size_t)(uintptr_t)iter->_internal[1] >= map->capacity;
+}
+
+void celix_stringHashMapIterator_next(celix_string_hash_map_iterator_t* iter) {
+    const celix_hash_map_t* map = iter->_internal[0];
+    size_t slot = (size_t)(uintptr_t)iter->_internal[1];
+    iter->index += 1;
+    celix_stringHashMapIterator_update(iter, celix_hashMap_nextFullSlot(map, slot + 1));
+}
+
+void celix_stringHashMapIterator_remove(celix_string_hash_map_iterator_t* iter) {
+    celix_hash_map_t* map = iter->_internal[0];
+    size_t slot = (size_t)(uintptr_t)iter->_internal[1];
+    celix_hashMap_removeAt(map, slot); //note removing does not move other entries
+    celix_stringHashMapIterator_update(iter, celix_hashMap_nextFullSlot(map, slot + 1));
+}
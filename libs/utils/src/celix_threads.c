@@ -164,6 +164,8 @@ celix_status_t celixThreadCondition_timedwaitRelative(celix_thread_cond_t *cond,
     TIMEVAL_TO_TIMESPEC(&tv, &time)
     time.tv_sec += seconds;
     time.tv_nsec += nanoseconds;
+    time.tv_sec += time.tv_nsec / 1000000000L;
+    time.tv_nsec = time.tv_nsec % 1000000000L;
     return pthread_cond_timedwait(cond, mutex, &time);
 }
 #else
@@ -172,6 +174,8 @@ celix_status_t celixThreadCondition_timedwaitRelative(celix_thread_cond_t *cond,
     clock_gettime(CLOCK_REALTIME, &time);
     time.tv_sec += seconds;
     time.tv_nsec += nanoseconds;
+    time.tv_sec += time.tv_nsec / 1000000000L;
+    time.tv_nsec = time.tv_nsec % 1000000000L;
     return pthread_cond_timedwait(cond, mutex, &time);
 }
 #endif
@@ -27,6 +27,27 @@
 #include "celix_filter.h"
 #include "filter.h"
 #include "celix_errno.h"
+#include "properties_private.h"
+
+/**
+ * A single instruction of a compiled filter.
+ * The instructions are stored in pre-order, so the children of a AND, OR or NOT instruction directly follow the
+ * instruction and the next sibling can be found by skipping size instructions.
+ */
+typedef struct celix_filter_instruction {
+    celix_filter_operand_t operand;
+    unsigned int attributeHash; //pre-calculated properties key hash of the attribute
+    const char *attribute; //NULL for operands AND, OR and NOT
+    const char *value; //NULL for operands AND, OR, NOT, PRESENT and SUBSTRING
+    const celix_array_list_t *substrings; //only for operand SUBSTRING
+    unsigned int nrOfChildren; //only for operands AND, OR and NOT
+    unsigned int size; //nr of instructions for this instruction including its children
+} celix_filter_instruction_t;
+
+struct celix_compiled_filter {
+    unsigned int nrOfInstructions;
+    celix_filter_instruction_t instructions[];
+};
 
 static void filter_skipWhiteSpace(char* filterString, int* pos);
 static celix_filter_t * filter_parseFilter(char* filterString, int* pos);
@@ -39,6 +60,8 @@ static char * filter_parseValue(char* filterString, int* pos);
 static celix_array_list_t* filter_parseSubstring(char* filterString, int* pos);
 
 static celix_status_t filter_compare(const celix_filter_t* filter, const char *propertyValue, bool *result);
+static bool filter_compareOperand(celix_filter_operand_t operand, const char *value, const celix_array_list_t *substrings, const char *propertyValue);
+static bool filter_compareSubstring(const celix_array_list_t *substrings, const char *propertyValue);
 
 static void filter_skipWhiteSpace(char * filterString, int * pos) {
     int length;
@@ -417,103 +440,82 @@ celix_status_t filter_match(celix_filter_t * filter, celix_properties_t *propert
 }
 
 static celix_status_t filter_compare(const celix_filter_t* filter, const char *propertyValue, bool *out) {
-    celix_status_t  status = CELIX_SUCCESS;
-    bool result = false;
-
     if (filter == NULL || propertyValue == NULL) {
         *out = false;
-        return status;
+        return CELIX_SUCCESS;
     }
+    *out = filter_compareOperand(filter->operand, filter->value, filter->children, propertyValue);
+    return CELIX_SUCCESS;
+}
 
-    switch (filter->operand) {
-        case CELIX_FILTER_OPERAND_SUBSTRING: {
-            int pos = 0;
-            unsigned int i;
-            int size = celix_arrayList_size(filter->children);
-            for (i = 0; i < size; i++) {
-                char * substr = (char *) celix_arrayList_get(filter->children, i);
-
-                if (i + 1 < size) {
-                    if (substr == NULL) {
-                        unsigned int index;
-                        char * substr2 = (char *) celix_arrayList_get(filter->children, i + 1);
-                        if (substr2 == NULL) {
-                            continue;
-                        }
-                        index = strcspn(propertyValue+pos, substr2);
-                        if (index == strlen(propertyValue+pos)) {
-                            *out = false;
-                            return CELIX_SUCCESS;
-                        }
-
-                        pos = index + strlen(substr2);
-                        if (i + 2 < size) {
-                            i++;
-                        }
-                    } else {
-                        unsigned int len = strlen(substr);
-                        char * region = (char *)calloc(1, len+1);
-                        strncpy(region, propertyValue+pos, len);
-                        region[len]    = '\0';
-                        if (strcmp(region, substr) == 0) {
-                            pos += len;
-                        } else {
-                            free(region);
-                            *out = false;
-                            return CELIX_SUCCESS;
-                        }
-                        free(region);
-                    }
-                } else {
-                    unsigned int len;
-                    int begin;
-
-                    if (substr == NULL) {
-                        *out = true;
-                        return CELIX_SUCCESS;
-                    }
-                    len = strlen(substr);
-                    begin = strlen(propertyValue)-len;
-                    *out = (strcmp(propertyValue+begin, substr) == 0);
-                    return CELIX_SUCCESS;
-                }
-            }
-            *out = true;
-            return CELIX_SUCCESS;
-        }
+static bool filter_compareOperand(celix_filter_operand_t operand, const char *value, const celix_array_list_t *substrings, const char *propertyValue) {
+    switch (operand) {
+        case CELIX_FILTER_OPERAND_SUBSTRING:
+            return filter_compareSubstring(substrings, propertyValue);
         case CELIX_FILTER_OPERAND_APPROX: //TODO: Implement strcmp with ignorecase and ignorespaces
-        case CELIX_FILTER_OPERAND_EQUAL: {
-            *out = (strcmp(propertyValue, filter->value) == 0);
-            return CELIX_SUCCESS;
-        }
-        case CELIX_FILTER_OPERAND_GREATER: {
-            *out = (strcmp(propertyValue, filter->value) > 0);
-            return CELIX_SUCCESS;
-        }
-        case CELIX_FILTER_OPERAND_GREATEREQUAL: {
-            *out = (strcmp(propertyValue, filter->value) >= 0);
-            return CELIX_SUCCESS;
-        }
-        case CELIX_FILTER_OPERAND_LESS: {
-            *out = (strcmp(propertyValue, filter->value) < 0);
-            return CELIX_SUCCESS;
-        }
-        case CELIX_FILTER_OPERAND_LESSEQUAL: {
-            *out = (strcmp(propertyValue, filter->value) <= 0);
-            return CELIX_SUCCESS;
-        }
+        case CELIX_FILTER_OPERAND_EQUAL:
+            return strcmp(propertyValue, value) == 0;
+        case CELIX_FILTER_OPERAND_GREATER:
+            return strcmp(propertyValue, value) > 0;
+        case CELIX_FILTER_OPERAND_GREATEREQUAL:
+            return strcmp(propertyValue, value) >= 0;
+        case CELIX_FILTER_OPERAND_LESS:
+            return strcmp(propertyValue, value) < 0;
+        case CELIX_FILTER_OPERAND_LESSEQUAL:
+            return strcmp(propertyValue, value) <= 0;
         case CELIX_FILTER_OPERAND_AND:
         case CELIX_FILTER_OPERAND_NOT:
         case CELIX_FILTER_OPERAND_OR:
-        case CELIX_FILTER_OPERAND_PRESENT: {
-        }
-            /* no break */
+        case CELIX_FILTER_OPERAND_PRESENT:
+            break;
     }
+    return false;
+}
 
-    if (status == CELIX_SUCCESS && out != NULL) {
-        *out = result;
+static bool filter_compareSubstring(const celix_array_list_t *substrings, const char *propertyValue) {
+    int pos = 0;
+    unsigned int i;
+    int size = celix_arrayList_size(substrings);
+    for (i = 0; i < size; i++) {
+        char * substr = (char *) celix_arrayList_get(substrings, i);
+
+        if (i + 1 < size) {
+            if (substr == NULL) {
+                unsigned int index;
+                char * substr2 = (char *) celix_arrayList_get(substrings, i + 1);
+                if (substr2 == NULL) {
+                    continue;
+                }
+                index = strcspn(propertyValue+pos, substr2);
+                if (index == strlen(propertyValue+pos)) {
+                    return false;
+                }
+
+                pos = index + strlen(substr2);
+                if (i + 2 < size) {
+                    i++;
+                }
+            } else {
+                unsigned int len = strlen(substr);
+                if (strncmp(propertyValue+pos, substr, len) == 0) {
+                    pos += len;
+                } else {
+                    return false;
+                }
+            }
+        } else {
+            unsigned int len;
+            int begin;
+
+            if (substr == NULL) {
+                return true;
+            }
+            len = strlen(substr);
+            begin = strlen(propertyValue)-len;
+            return strcmp(propertyValue+begin, substr) == 0;
+        }
     }
-    return status;
+    return true;
 }
 
 celix_status_t filter_getString(celix_filter_t * filter, const char **filterStr) {
@@ -725,4 +727,103 @@ const char* celix_filter_findAttribute(const celix_filter_t *filter, const char
         }
     }
     return result;
-}
\ No newline at end of file
+}
+
+
+static unsigned int celix_filter_countInstructions(const celix_filter_t *filter) {
+    unsigned int count = 1;
+    if (filter->operand == CELIX_FILTER_OPERAND_AND || filter->operand == CELIX_FILTER_OPERAND_OR || filter->operand == CELIX_FILTER_OPERAND_NOT) {
+        int size = celix_arrayList_size(filter->children);
+        for (int i = 0; i < size; ++i) {
+            count += celix_filter_countInstructions(celix_arrayList_get(filter->children, i));
+        }
+    }
+    return count;
+}
+
+/**
+ * Adds the instructions for filter (pre-order) to compiled starting at index and returns the nr of added instructions.
+ */
+static unsigned int celix_filter_compileInstructions(const celix_filter_t *filter, celix_compiled_filter_t *compiled, unsigned int index) {
+    celix_filter_instruction_t *instr = &compiled->instructions[index];
+    instr->operand = filter->operand;
+    instr->attribute = NULL;
+    instr->attributeHash = 0;
+    instr->value = NULL;
+    instr->substrings = NULL;
+    instr->nrOfChildren = 0;
+    instr->size = 1;
+    if (filter->operand == CELIX_FILTER_OPERAND_AND || filter->operand == CELIX_FILTER_OPERAND_OR || filter->operand == CELIX_FILTER_OPERAND_NOT) {
+        instr->nrOfChildren = celix_arrayList_size(filter->children);
+        for (unsigned int i = 0; i < instr->nrOfChildren; ++i) {
+            instr->size += celix_filter_compileInstructions(celix_arrayList_get(filter->children, i), compiled, index + instr->size);
+        }
+    } else {
+        instr->attribute = filter->attribute;
+        instr->attributeHash = celix_properties_keyHash(filter->attribute);
+        instr->value = filter->value;
+        if (filter->operand == CELIX_FILTER_OPERAND_SUBSTRING) {
+            instr->substrings = filter->children;
+        }
+    }
+    return instr->size;
+}
+
+celix_compiled_filter_t* celix_filter_compile(const celix_filter_t *filter) {
+    if (filter == NULL) {
+        return NULL;
+    }
+    unsigned int nrOfInstructions = celix_filter_countInstructions(filter);
+    celix_compiled_filter_t *compiled = malloc(sizeof(*compiled) + nrOfInstructions * sizeof(celix_filter_instruction_t));
+    if (compiled != NULL) {
+        compiled->nrOfInstructions = nrOfInstructions;
+        celix_filter_compileInstructions(filter, compiled, 0);
+    }
+    return compiled;
+}
+
+void celix_compiledFilter_destroy(celix_compiled_filter_t *compiled) {
+    free(compiled);
+}
+
+static bool celix_compiledFilter_matchInstruction(const celix_filter_instruction_t *instr, const celix_properties_t *properties) {
+    switch (instr->operand) {
+        case CELIX_FILTER_OPERAND_AND: {
+            const celix_filter_instruction_t *child = instr + 1;
+            for (unsigned int i = 0; i < instr->nrOfChildren; ++i) {
+                if (!celix_compiledFilter_matchInstruction(child, properties)) {
+                    return false;
+                }
+                child += child->size;
+            }
+            return true;
+        }
+        case CELIX_FILTER_OPERAND_OR: {
+            const celix_filter_instruction_t *child = instr + 1;
+            for (unsigned int i = 0; i < instr->nrOfChildren; ++i) {
+                if (celix_compiledFilter_matchInstruction(child, properties)) {
+                    return true;
+                }
+                child += child->size;
+            }
+            return false;
+        }
+        case CELIX_FILTER_OPERAND_NOT:
+            return !celix_compiledFilter_matchInstruction(instr + 1, properties);
+        case CELIX_FILTER_OPERAND_PRESENT: {
+            const char *value = properties == NULL ? NULL : celix_properties_getWithKeyHash(properties, instr->attribute, instr->attributeHash);
+            return value != NULL;
+        }
+        default: {
+            const char *value = properties == NULL ? NULL : celix_properties_getWithKeyHash(properties, instr->attribute, instr->attributeHash);
+            return value != NULL && filter_compareOperand(instr->operand, instr->value, instr->substrings, value);
+        }
+    }
+}
+
+bool celix_compiledFilter_match(const celix_compiled_filter_t *compiled, const celix_properties_t *properties) {
+    if (compiled == NULL) {
+        return true; //matching on null(empty) filter is always true
+    }
+    return celix_compiledFilter_matchInstruction(&compiled->instructions[0], properties);
+}
@@ -32,12 +32,81 @@
 #include "properties.h"
 #include "celix_properties.h"
 #include "utils.h"
-#include "hash_map_private.h"
+#include "properties_private.h"
+#include "celix_version.h"
 #include <errno.h>
 
 
 #define MALLOC_BLOCK_SIZE        5
 
+#define CELIX_PROPERTIES_INLINE_CAPACITY        16
+#define CELIX_PROPERTIES_INLINE_ARENA_SIZE      256
+#define CELIX_PROPERTIES_SHORT_VALUE_MAX_SIZE   64
+#define CELIX_PROPERTIES_ARENA_CHUNK_ALIGN      8
+#define CELIX_PROPERTIES_NR_OF_FREE_LISTS       (CELIX_PROPERTIES_SHORT_VALUE_MAX_SIZE / CELIX_PROPERTIES_ARENA_CHUNK_ALIGN)
+
+/**
+ * Marker for removed entries. Removed entries are needed to keep the (linear) probe sequences intact.
+ */
+#define CELIX_PROPERTIES_REMOVED_KEY            celix_properties_removedKey
+static const char celix_properties_removedKey[] = "";
+
+/**
+ * The type of the cached typed value of a entry.
+ * The cached type is atomically updated, because typed values are lazily parsed on (concurrent) read access.
+ */
+typedef enum celix_properties_cached_type {
+    CELIX_PROPERTIES_CACHED_NONE = 0,
+    CELIX_PROPERTIES_CACHED_BUSY = 1, //a thread is filling the cached value
+    CELIX_PROPERTIES_CACHED_LONG = 2,
+    CELIX_PROPERTIES_CACHED_DOUBLE = 3,
+    CELIX_PROPERTIES_CACHED_BOOL = 4,
+} celix_properties_cached_type_e;
+
+typedef struct celix_properties_entry {
+    const char *key; //NULL for a unused slot and CELIX_PROPERTIES_REMOVED_KEY for a removed entry. Keys longer than the short value max size are separately allocated
+    char *value;
+    unsigned int hash;
+    unsigned short valueCapacity; //capacity of the value storage in the arena, 0 if value is allocated or NULL
+    bool valueIsAllocated; //true if the value is too large for the arena and is separately allocated
+    unsigned char cachedType; //celix_properties_cached_type_e, only read/written atomically
+    union {
+        long longValue;
+        double doubleValue;
+        bool boolValue;
+    } cached; //only valid if cachedType is LONG, DOUBLE or BOOL
+    celix_version_t *cachedVersion; //lazily parsed version, only read/written atomically
+} celix_properties_entry_t;
+
+typedef struct celix_properties_arena_block {
+    struct celix_properties_arena_block *next;
+    char data[];
+} celix_properties_arena_block_t;
+
+/**
+ * Properties are stored in an open addressing (linear probing) table.
+ * Keys and short values are stored in an arena, which start inline and grows with extra blocks.
+ * Arena memory is never moved, so returned values stay valid until the key is updated or removed.
+ * Arena storage is handed out in chunks of a multiple of 8 bytes (max 64). Chunks of removed keys and replaced
+ * values are put on a free list per chunk size and reused by later allocations; short value storage has some slack,
+ * so that most updates of an existing key can be done in place.
+ */
+struct celix_properties {
+    celix_properties_entry_t *table;
+    unsigned int capacity; //power of 2
+    unsigned int size;
+    unsigned int used; //nr of used slots, including removed entries
+
+    char *arenaPos;
+    size_t arenaRemaining;
+    size_t lastBlockSize;
+    celix_properties_arena_block_t *blocks;
+    char *freeChunks[CELIX_PROPERTIES_NR_OF_FREE_LISTS]; //per chunk size, the next chunk is stored in the chunk itself
+
+    celix_properties_entry_t inlineTable[CELIX_PROPERTIES_INLINE_CAPACITY];
+    char inlineArena[CELIX_PROPERTIES_INLINE_ARENA_SIZE];
+};
+
 static void parseLine(const char* line, celix_properties_t *props);
 
 properties_pt properties_create(void) {
@@ -217,19 +286,240 @@ static void parseLine(const char* line, celix_properties_t *props) {
 
 
 
+static unsigned int celix_properties_mixHash(unsigned int keyHash) {
+    //same supplemental hash as the hash map, to spread the string hash over the lower bits
+    keyHash += ~(keyHash << 9);
+    keyHash ^= ((keyHash >> 14) | (keyHash << 18));
+    keyHash += (keyHash << 4);
+    keyHash ^= ((keyHash >> 10) | (keyHash << 22));
+    return keyHash;
+}
+
+static void celix_properties_addArenaBlock(celix_properties_t *properties, size_t blockSize) {
+    celix_properties_arena_block_t *block = malloc(sizeof(*block) + blockSize);
+    block->next = properties->blocks;
+    properties->blocks = block;
+    properties->lastBlockSize = blockSize;
+    properties->arenaPos = block->data;
+    properties->arenaRemaining = blockSize;
+}
+
+static size_t celix_properties_arenaChunkSize(size_t len) {
+    return (len + CELIX_PROPERTIES_ARENA_CHUNK_ALIGN - 1) & ~((size_t)CELIX_PROPERTIES_ARENA_CHUNK_ALIGN - 1);
+}
+
+/**
+ * Allocates a chunk from the arena. len must be a chunk size (see celix_properties_arenaChunkSize) and at most
+ * CELIX_PROPERTIES_SHORT_VALUE_MAX_SIZE.
+ */
+static char* celix_properties_allocFromArena(celix_properties_t *properties, size_t len) {
+    char **freeList = &properties->freeChunks[len / CELIX_PROPERTIES_ARENA_CHUNK_ALIGN - 1];
+    if (*freeList != NULL) {
+        char *chunk = *freeList;
+        memcpy(freeList, chunk, sizeof(*freeList)); //note chunks are not guaranteed to be pointer aligned
+        return chunk;
+    }
+    if (len > properties->arenaRemaining) {
+        size_t blockSize = properties->lastBlockSize * 2;
+        celix_properties_addArenaBlock(properties, blockSize < len ? len : blockSize);
+    }
+    char *result = properties->arenaPos;
+    properties->arenaPos += len;
+    properties->arenaRemaining -= len;
+    return result;
+}
+
+static void celix_properties_freeToArena(celix_properties_t *properties, char *chunk, size_t len) {
+    char **freeList = &properties->freeChunks[len / CELIX_PROPERTIES_ARENA_CHUNK_ALIGN - 1];
+    memcpy(chunk, freeList, sizeof(*freeList));
+    *freeList = chunk;
+}
+
+static bool celix_properties_isLongKey(size_t keyLen) {
+    return keyLen + 1 > CELIX_PROPERTIES_SHORT_VALUE_MAX_SIZE;
+}
+
+static void celix_properties_releaseKey(celix_properties_t *properties, const char *key) {
+    size_t keyLen = strlen(key);
+    if (celix_properties_isLongKey(keyLen)) {
+        free((char*)key);
+    } else {
+        celix_properties_freeToArena(properties, (char*)key, celix_properties_arenaChunkSize(keyLen + 1));
+    }
+}
+
+static void celix_properties_releaseValue(celix_properties_t *properties, celix_properties_entry_t *entry) {
+    if (entry->valueIsAllocated) {
+        free(entry->value);
+    } else if (entry->value != NULL) {
+        celix_properties_freeToArena(properties, entry->value, entry->valueCapacity);
+    }
+    entry->value = NULL;
+    entry->valueCapacity = 0;
+    entry->valueIsAllocated = false;
+}
+
+static celix_properties_entry_t* celix_properties_findEntry(const celix_properties_t *properties, const char *key, unsigned int hash) {
+    unsigned int mask = properties->capacity - 1;
+    for (unsigned int i = hash & mask; ; i = (i + 1) & mask) {
+        celix_properties_entry_t *entry = &properties->table[i];
+        if (entry->key == NULL) {
+            return NULL;
+        } else if (entry->key != CELIX_PROPERTIES_REMOVED_KEY && entry->hash == hash && strcmp(entry->key, key) == 0) {
+            return entry;
+        }
+    }
+}
+
+static celix_properties_entry_t* celix_properties_findFreeSlot(celix_properties_entry_t *table, unsigned int capacity, unsigned int hash) {
+    unsigned int mask = capacity - 1;
+    unsigned int i = hash & mask;
+    while (table[i].key != NULL && table[i].key != CELIX_PROPERTIES_REMOVED_KEY) {
+        i = (i + 1) & mask;
+    }
+    return &table[i];
+}
+
+static void celix_properties_rehash(celix_properties_t *properties, unsigned int newCapacity) {
+    celix_properties_entry_t *oldTable = properties->table;
+    unsigned int oldCapacity = properties->capacity;
+    celix_properties_entry_t *tmp = NULL;
+    if (oldTable == properties->inlineTable) {
+        //note moving entries out of the inline table, so that it can be reused (when purging removed entries)
+        tmp = malloc(sizeof(*tmp) * oldCapacity);
+        memcpy(tmp, oldTable, sizeof(*tmp) * oldCapacity);
+        oldTable = tmp;
+    }
+
+    if (newCapacity <= CELIX_PROPERTIES_INLINE_CAPACITY) {
+        newCapacity = CELIX_PROPERTIES_INLINE_CAPACITY;
+        properties->table = properties->inlineTable;
+        memset(properties->table, 0, sizeof(properties->inlineTable));
+    } else {
+        properties->table = calloc(newCapacity, sizeof(*properties->table));
+    }
+    properties->capacity = newCapacity;
+
+    for (unsigned int i = 0; i < oldCapacity; ++i) {
+        celix_properties_entry_t *entry = &oldTable[i];
+        if (entry->key != NULL && entry->key != CELIX_PROPERTIES_REMOVED_KEY) {
+            *celix_properties_findFreeSlot(properties->table, newCapacity, entry->hash) = *entry;
+        }
+    }
+    properties->used = properties->size;
+    free(tmp);
+    if (oldTable != tmp) {
+        free(oldTable);
+    }
+}
+
+static celix_properties_entry_t* celix_properties_addEntry(celix_properties_t *properties, const char *key, size_t keyLen, unsigned int hash) {
+    if ((properties->used + 1) * 4 > properties->capacity * 3) {
+        //more than 75% of the slots used (incl removed entries) -> grow or purge removed entries.
+        unsigned int newCapacity = properties->capacity;
+        if ((properties->size + 1) * 2 > properties->capacity) {
+            newCapacity *= 2;
+        }
+        celix_properties_rehash(properties, newCapacity);
+    }
+    celix_properties_entry_t *entry = celix_properties_findFreeSlot(properties->table, properties->capacity, hash);
+    if (entry->key == NULL) {
+        properties->used += 1;
+    }
+    properties->size += 1;
+    char *keyCopy = celix_properties_isLongKey(keyLen) ?
+                    malloc(keyLen + 1) :
+                    celix_properties_allocFromArena(properties, celix_properties_arenaChunkSize(keyLen + 1));
+    memcpy(keyCopy, key, keyLen + 1);
+    entry->key = keyCopy;
+    entry->hash = hash;
+    entry->value = NULL;
+    entry->valueCapacity = 0;
+    entry->valueIsAllocated = false;
+    entry->cachedType = CELIX_PROPERTIES_CACHED_NONE;
+    entry->cachedVersion = NULL;
+    return entry;
+}
+
+static void celix_properties_invalidateCache(celix_properties_entry_t *entry) {
+    entry->cachedType = CELIX_PROPERTIES_CACHED_NONE;
+    celix_version_destroy(entry->cachedVersion);
+    entry->cachedVersion = NULL;
+}
+
+static void celix_properties_setEntryValue(celix_properties_t *properties, celix_properties_entry_t *entry, const char *value) {
+    if (value == entry->value) {
+        return;
+    }
+    celix_properties_invalidateCache(entry);
+    if (value == NULL) {
+        celix_properties_releaseValue(properties, entry);
+        return;
+    }
+
+    size_t len = strlen(value) + 1;
+    if (entry->value != NULL && !entry->valueIsAllocated && len <= entry->valueCapacity) {
+        //reuse value storage in the arena
+        memmove(entry->value, value, len);
+        return;
+    }
+
+    size_t capacity = 0;
+    char *newValue;
+    if (len <= CELIX_PROPERTIES_SHORT_VALUE_MAX_SIZE) {
+        capacity = celix_properties_arenaChunkSize(len); //some slack, so that updates of short values can be done in place
+        newValue = celix_properties_allocFromArena(properties, capacity);
+    } else {
+        newValue = malloc(len);
+    }
+    memcpy(newValue, value, len);
+    celix_properties_releaseValue(properties, entry); //note after the copy, value can point into the old value
+    entry->value = newValue;
+    entry->valueCapacity = (unsigned short)capacity;
+    entry->valueIsAllocated = capacity == 0;
+}
+
+static celix_properties_t* celix_properties_createWithArenaSize(size_t arenaSize) {
+    celix_properties_t *props = calloc(1, sizeof(*props));
+    if (props != NULL) {
+        props->table = props->inlineTable;
+        props->capacity = CELIX_PROPERTIES_INLINE_CAPACITY;
+        props->arenaPos = props->inlineArena;
+        props->arenaRemaining = sizeof(props->inlineArena);
+        props->lastBlockSize = sizeof(props->inlineArena);
+        if (arenaSize > sizeof(props->inlineArena)) {
+            celix_properties_addArenaBlock(props, arenaSize);
+        }
+    }
+    return props;
+}
+
 celix_properties_t* celix_properties_create(void) {
-    return hashMap_create(utils_stringHash, utils_stringHash, utils_stringEquals, utils_stringEquals);
+    return celix_properties_createWithArenaSize(0);
 }
 
 void celix_properties_destroy(celix_properties_t *properties) {
     if (properties != NULL) {
-        hash_map_iterator_pt iter = hashMapIterator_create(properties);
-        while (hashMapIterator_hasNext(iter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(iter);
-            hashMapEntry_clear(entry, true, true);
+        for (unsigned int i = 0; i < properties->capacity; ++i) {
+            celix_properties_entry_t *entry = &properties->table[i];
+            if (entry->valueIsAllocated) {
+                free(entry->value);
+            }
+            if (entry->key != NULL && entry->key != CELIX_PROPERTIES_REMOVED_KEY && celix_properties_isLongKey(strlen(entry->key))) {
+                free((char*)entry->key);
+            }
+            celix_version_destroy(entry->cachedVersion);
         }
-        hashMapIterator_destroy(iter);
-        hashMap_destroy(properties, false, false);
+        if (properties->table != properties->inlineTable) {
+            free(properties->table);
+        }
+        celix_properties_arena_block_t *block = properties->blocks;
+        while (block != NULL) {
+            celix_properties_arena_block_t *next = block->next;
+            free(block);
+            block = next;
+        }
+        free(properties);
     }
 }
 
@@ -311,32 +601,27 @@ void celix_properties_store(celix_properties_t *properties, const char *filename
     char *str;
 
     if (file != NULL) {
-        if (hashMap_size(properties) > 0) {
-            hash_map_iterator_pt iterator = hashMapIterator_create(properties);
-            while (hashMapIterator_hasNext(iterator)) {
-                hash_map_entry_pt entry = hashMapIterator_nextEntry(iterator);
-                str = hashMapEntry_getKey(entry);
-                for (int i = 0; i < strlen(str); i += 1) {
-                    if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
-                        fputc('\\', file);
-                    }
-                    fputc(str[i], file);
+        const char *key;
+        CELIX_PROPERTIES_FOR_EACH(properties, key) {
+            str = (char*)key;
+            for (int i = 0; i < strlen(str); i += 1) {
+                if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
+                    fputc('\\', file);
                 }
+                fputc(str[i], file);
+            }
 
-                fputc('=', file);
+            fputc('=', file);
 
-                str = hashMapEntry_getValue(entry);
-                for (int i = 0; i < strlen(str); i += 1) {
-                    if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
-                        fputc('\\', file);
-                    }
-                    fputc(str[i], file);
+            str = (char*)celix_properties_get(properties, key, "");
+            for (int i = 0; i < strlen(str); i += 1) {
+                if (str[i] == '#' || str[i] == '!' || str[i] == '=' || str[i] == ':') {
+                    fputc('\\', file);
                 }
-
-                fputc('\n', file);
-
+                fputc(str[i], file);
             }
-            hashMapIterator_destroy(iterator);
+
+            fputc('\n', file);
         }
         fclose(file);
     } else {
@@ -345,14 +630,54 @@ void celix_properties_store(celix_properties_t *properties, const char *filename
 }
 
 celix_properties_t* celix_properties_copy(const celix_properties_t *properties) {
-    celix_properties_t *copy = celix_properties_create();
-    if (properties != NULL) {
-        hash_map_iterator_t iter = hashMapIterator_construct((hash_map_t*)properties);
-        while (hashMapIterator_hasNext(&iter)) {
-            hash_map_entry_pt entry = hashMapIterator_nextEntry(&iter);
-            char *key = hashMapEntry_getKey(entry);
-            char *value = hashMapEntry_getValue(entry);
-            celix_properties_set(copy, key, value);
+    if (properties == NULL) {
+        return celix_properties_create();
+    }
+
+    //note copying the table as-is (same slots) and packing all key/values in a single arena block, so no rehashing
+    //is needed and unused arena space of the source is not copied.
+    size_t arenaSize = 0;
+    for (unsigned int i = 0; i < properties->capacity; ++i) {
+        const celix_properties_entry_t *entry = &properties->table[i];
+        if (entry->key != NULL && entry->key != CELIX_PROPERTIES_REMOVED_KEY) {
+            size_t keyLen = strlen(entry->key);
+            arenaSize += celix_properties_isLongKey(keyLen) ? 0 : celix_properties_arenaChunkSize(keyLen + 1);
+            arenaSize += entry->valueCapacity;
+        }
+    }
+
+    celix_properties_t *copy = celix_properties_createWithArenaSize(arenaSize);
+    if (copy == NULL) {
+        return NULL;
+    }
+    if (properties->capacity > CELIX_PROPERTIES_INLINE_CAPACITY) {
+        copy->table = malloc(sizeof(*copy->table) * properties->capacity);
+        copy->capacity = properties->capacity;
+    }
+    memcpy(copy->table, properties->table, sizeof(*copy->table) * properties->capacity);
+    copy->size = properties->size;
+    copy->used = properties->used;
+
+    for (unsigned int i = 0; i < copy->capacity; ++i) {
+        celix_properties_entry_t *entry = &copy->table[i];
+        if (entry->key != NULL && entry->key != CELIX_PROPERTIES_REMOVED_KEY) {
+            size_t keyLen = strlen(entry->key);
+            char *key = celix_properties_isLongKey(keyLen) ?
+                        malloc(keyLen + 1) :
+                        celix_properties_allocFromArena(copy, celix_properties_arenaChunkSize(keyLen + 1));
+            memcpy(key, entry->key, keyLen + 1);
+            entry->key = key;
+            if (__atomic_load_n(&entry->cachedType, __ATOMIC_ACQUIRE) == CELIX_PROPERTIES_CACHED_BUSY) {
+                entry->cachedType = CELIX_PROPERTIES_CACHED_NONE;
+            }
+            entry->cachedVersion = NULL; //note versions are not shared, will be lazily parsed again if needed
+            if (entry->valueIsAllocated) {
+                entry->value = strdup(entry->value);
+            } else if (entry->value != NULL) {
+                char *value = celix_properties_allocFromArena(copy, entry->valueCapacity);
+                memcpy(value, entry->value, strlen(entry->value) + 1);
+                entry->value = value;
+            }
         }
     }
     return copy;
@@ -360,57 +685,98 @@ celix_properties_t* celix_properties_copy(const celix_properties_t *properties)
 
 const char* celix_properties_get(const celix_properties_t *properties, const char *key, const char *defaultValue) {
     const char* value = NULL;
-    if (properties != NULL) {
-        value = hashMap_get((hash_map_t*)properties, (void*)key);
+    if (properties != NULL && key != NULL) {
+        value = celix_properties_getWithKeyHash(properties, key, celix_properties_keyHash(key));
     }
     return value == NULL ? defaultValue : value;
 }
 
+unsigned int celix_properties_keyHash(const char *key) {
+    return utils_stringHash(key);
+}
+
+const char* celix_properties_getWithKeyHash(const celix_properties_t *properties, const char *key, unsigned int keyHash) {
+    const char* value = NULL;
+    if (properties != NULL && key != NULL) {
+        celix_properties_entry_t *entry = celix_properties_findEntry(properties, key, celix_properties_mixHash(keyHash));
+        value = entry == NULL ? NULL : entry->value;
+    }
+    return value;
+}
+
 void celix_properties_set(celix_properties_t *properties, const char *key, const char *value) {
-    if (properties != NULL) {
-        hash_map_entry_pt entry = hashMap_getEntry(properties, key);
-        char *oldVal = NULL;
-        char *newVal = value == NULL ? NULL : strndup(value, 1024 * 1024);
-        if (entry != NULL) {
-            char *oldKey = hashMapEntry_getKey(entry);
-            oldVal = hashMapEntry_getValue(entry);
-            hashMap_put(properties, oldKey, newVal);
-        } else {
-            hashMap_put(properties, strndup(key, 1024 * 1024), newVal);
+    if (properties != NULL && key != NULL) {
+        unsigned int hash = celix_properties_mixHash(celix_properties_keyHash(key));
+        celix_properties_entry_t *entry = celix_properties_findEntry(properties, key, hash);
+        if (entry == NULL) {
+            entry = celix_properties_addEntry(properties, key, strlen(key), hash);
         }
-        free(oldVal);
+        celix_properties_setEntryValue(properties, entry, value);
     }
 }
 
 void celix_properties_setWithoutCopy(celix_properties_t *properties, char *key, char *value) {
-    if (properties != NULL) {
-        hash_map_entry_pt entry = hashMap_getEntry(properties, key);
-        char *oldVal = NULL;
+    //note key/values are always stored in the properties arena, so the provided key/value are copied and freed.
+    celix_properties_set(properties, key, value);
+    free(key);
+    free(value);
+}
+
+void celix_properties_unset(celix_properties_t *properties, const char *key) {
+    if (properties != NULL && key != NULL) {
+        celix_properties_entry_t *entry = celix_properties_findEntry(properties, key, celix_properties_mixHash(celix_properties_keyHash(key)));
         if (entry != NULL) {
-            char *oldKey = hashMapEntry_getKey(entry);
-            oldVal = hashMapEntry_getValue(entry);
-            hashMap_put(properties, oldKey, value);
-        } else {
-            hashMap_put(properties, key, value);
+            celix_properties_invalidateCache(entry);
+            celix_properties_releaseValue(properties, entry);
+            celix_properties_releaseKey(properties, entry->key);
+            entry->key = CELIX_PROPERTIES_REMOVED_KEY;
+            properties->size -= 1;
         }
-        free(oldVal);
     }
 }
 
-void celix_properties_unset(celix_properties_t *properties, const char *key) {
-    char* oldValue = hashMap_remove(properties, key);
-    free(oldValue);
+static celix_properties_entry_t* celix_properties_getEntry(const celix_properties_t *properties, const char *key) {
+    celix_properties_entry_t *entry = NULL;
+    if (properties != NULL && key != NULL) {
+        entry = celix_properties_findEntry(properties, key, celix_properties_mixHash(celix_properties_keyHash(key)));
+    }
+    return entry;
+}
+
+static celix_properties_cached_type_e celix_properties_getCachedType(const celix_properties_entry_t *entry) {
+    return __atomic_load_n(&entry->cachedType, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * Try to claim the (empty) typed value cache of a entry.
+ * If claimed, the caller must fill the cached value and publish it with celix_properties_publishCachedType.
+ */
+static bool celix_properties_claimCache(celix_properties_entry_t *entry) {
+    unsigned char expected = CELIX_PROPERTIES_CACHED_NONE;
+    return __atomic_compare_exchange_n(&entry->cachedType, &expected, CELIX_PROPERTIES_CACHED_BUSY, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+static void celix_properties_publishCachedType(celix_properties_entry_t *entry, celix_properties_cached_type_e type) {
+    __atomic_store_n(&entry->cachedType, type, __ATOMIC_RELEASE);
 }
 
 long celix_properties_getAsLong(const celix_properties_t *props, const char *key, long defaultValue) {
+    celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    if (entry == NULL || entry->value == NULL) {
+        return defaultValue;
+    } else if (celix_properties_getCachedType(entry) == CELIX_PROPERTIES_CACHED_LONG) {
+        return entry->cached.longValue;
+    }
+
     long result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
-    if (val != NULL) {
-        char *enptr = NULL;
-        errno = 0;
-        long r = strtol(val, &enptr, 10);
-        if (enptr != val && errno == 0) {
-            result = r;
+    char *enptr = NULL;
+    errno = 0;
+    long r = strtol(entry->value, &enptr, 10);
+    if (enptr != entry->value && errno == 0) {
+        result = r;
+        if (celix_properties_claimCache(entry)) {
+            entry->cached.longValue = r;
+            celix_properties_publishCachedType(entry, CELIX_PROPERTIES_CACHED_LONG);
         }
     }
     return result;
@@ -421,20 +787,33 @@ void celix_properties_setLong(celix_properties_t *props, const char *key, long v
     int writen = snprintf(buf, 32, "%li", value);
     if (writen <= 31) {
         celix_properties_set(props, key, buf);
+        celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+        if (entry != NULL && celix_properties_claimCache(entry)) {
+            entry->cached.longValue = value;
+            celix_properties_publishCachedType(entry, CELIX_PROPERTIES_CACHED_LONG);
+        }
     } else {
         fprintf(stderr,"buf to small for value '%li'\n", value);
     }
 }
 
 double celix_properties_getAsDouble(const celix_properties_t *props, const char *key, double defaultValue) {
+    celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    if (entry == NULL || entry->value == NULL) {
+        return defaultValue;
+    } else if (celix_properties_getCachedType(entry) == CELIX_PROPERTIES_CACHED_DOUBLE) {
+        return entry->cached.doubleValue;
+    }
+
     double result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
-    if (val != NULL) {
-        char *enptr = NULL;
-        errno = 0;
-        double r = strtod(val, &enptr);
-        if (enptr != val && errno == 0) {
-            result = r;
+    char *enptr = NULL;
+    errno = 0;
+    double r = strtod(entry->value, &enptr);
+    if (enptr != entry->value && errno == 0) {
+        result = r;
+        if (celix_properties_claimCache(entry)) {
+            entry->cached.doubleValue = r;
+            celix_properties_publishCachedType(entry, CELIX_PROPERTIES_CACHED_DOUBLE);
         }
     }
     return result;
@@ -451,17 +830,28 @@ void celix_properties_setDouble(celix_properties_t *props, const char *key, doub
 }
 
 bool celix_properties_getAsBool(const celix_properties_t *props, const char *key, bool defaultValue) {
+    celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    if (entry == NULL || entry->value == NULL) {
+        return defaultValue;
+    } else if (celix_properties_getCachedType(entry) == CELIX_PROPERTIES_CACHED_BOOL) {
+        return entry->cached.boolValue;
+    }
+
     bool result = defaultValue;
-    const char *val = celix_properties_get(props, key, NULL);
-    if (val != NULL) {
-        char buf[32];
-        snprintf(buf, 32, "%s", val);
-        char *trimmed = utils_stringTrim(buf);
-        if (strncasecmp("true", trimmed, strlen("true")) == 0) {
-            result = true;
-        } else if (strncasecmp("false", trimmed, strlen("false")) == 0) {
-            result = false;
-        }
+    bool parsed = false;
+    char buf[32];
+    snprintf(buf, 32, "%s", entry->value);
+    char *trimmed = utils_stringTrim(buf);
+    if (strncasecmp("true", trimmed, strlen("true")) == 0) {
+        result = true;
+        parsed = true;
+    } else if (strncasecmp("false", trimmed, strlen("false")) == 0) {
+        result = false;
+        parsed = true;
+    }
+    if (parsed && celix_properties_claimCache(entry)) {
+        entry->cached.boolValue = result;
+        celix_properties_publishCachedType(entry, CELIX_PROPERTIES_CACHED_BOOL);
     }
     return result;
 }
@@ -470,16 +860,57 @@ void celix_properties_setBool(celix_properties_t *props, const char *key, bool v
     celix_properties_set(props, key, val ? "true" : "false");
 }
 
+const celix_version_t* celix_properties_getAsVersion(const celix_properties_t *props, const char *key, const celix_version_t *defaultValue) {
+    celix_properties_entry_t *entry = celix_properties_getEntry(props, key);
+    if (entry == NULL || entry->value == NULL) {
+        return defaultValue;
+    }
+    celix_version_t *version = __atomic_load_n(&entry->cachedVersion, __ATOMIC_ACQUIRE);
+    if (version == NULL) {
+        celix_version_t *parsed = celix_version_createVersionFromString(entry->value);
+        if (parsed == NULL) {
+            return defaultValue;
+        }
+        if (__atomic_compare_exchange_n(&entry->cachedVersion, &version, parsed, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+            version = parsed;
+        } else {
+            //another thread already parsed the version, note version is updated to the current cached version
+            celix_version_destroy(parsed);
+        }
+    }
+    return version;
+}
+
 int celix_properties_size(const celix_properties_t *properties) {
-    return hashMap_size((hash_map_t*)properties);
+    return properties == NULL ? 0 : (int)properties->size;
 }
 
 celix_properties_iterator_t celix_propertiesIterator_construct(const celix_properties_t *properties) {
-    return hashMapIterator_construct((hash_map_t*)properties);
+    celix_properties_iterator_t iter;
+    iter.props = properties;
+    iter.index = 0;
+    return iter;
 }
+
 bool celix_propertiesIterator_hasNext(celix_properties_iterator_t *iter) {
-    return hashMapIterator_hasNext(iter);
+    if (iter->props == NULL) {
+        return false;
+    }
+    while (iter->index < iter->props->capacity) {
+        const char *key = iter->props->table[iter->index].key;
+        if (key != NULL && key != CELIX_PROPERTIES_REMOVED_KEY) {
+            return true;
+        }
+        iter->index += 1;
+    }
+    return false;
 }
+
 const char* celix_propertiesIterator_nextKey(celix_properties_iterator_t *iter) {
-    return (const char*)hashMapIterator_nextKey(iter);
+    const char *key = NULL;
+    if (celix_propertiesIterator_hasNext(iter)) {
+        key = iter->props->table[iter->index].key;
+        iter->index += 1;
+    }
+    return key;
 }